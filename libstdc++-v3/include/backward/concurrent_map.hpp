@@ -0,0 +1,6 @@
+#ifndef CONCURRENT_MAP_H_
+#define CONCURRENT_MAP_H_
+
+#include "../std/std_concurrent_map.h"
+
+#endif // CONCURRENT_MAP_H_
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef CONCURRENT_SKIPLIST_MAP_H_
+#define CONCURRENT_SKIPLIST_MAP_H_
+
+#include "../std/std_concurrent_skiplist_map.h"
+
+#endif // CONCURRENT_SKIPLIST_MAP_H_
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef CONCURRENT_STACK_H_
+#define CONCURRENT_STACK_H_
+
+#include "../std/std_concurrent_stack.h"
+
+#endif // CONCURRENT_STACK_H_
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef DEQUE_H_
+#define DEQUE_H_
+
+#include "../std/std_deque.h"
+
+#endif // DEQUE_H_
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef INTERVAL_MAP_H_
+#define INTERVAL_MAP_H_
+
+#include "../std/std_interval_map.h"
+
+#endif // INTERVAL_MAP_H_
\ No newline at end of file
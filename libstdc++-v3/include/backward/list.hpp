@@ -0,0 +1,6 @@
+#ifndef LIST_H_
+#define LIST_H_
+
+#include "../std/std_list.h"
+
+#endif // LIST_H_
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include "../std/std_parallel.h"
+
+#endif // PARALLEL_H_
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef PARALLEL_ALGORITHM_H_
+#define PARALLEL_ALGORITHM_H_
+
+#include "../std/std_parallel_algorithm.h"
+
+#endif // PARALLEL_ALGORITHM_H_
\ No newline at end of file
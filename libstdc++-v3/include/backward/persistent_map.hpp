@@ -0,0 +1,6 @@
+#ifndef PERSISTENT_MAP_H_
+#define PERSISTENT_MAP_H_
+
+#include "../std/std_persistent_map.h"
+
+#endif // PERSISTENT_MAP_H_
\ No newline at end of file
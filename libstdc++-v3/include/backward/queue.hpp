@@ -0,0 +1,6 @@
+#ifndef QUEUE_H_
+#define QUEUE_H_
+
+#include "../std/std_queue.h"
+
+#endif // QUEUE_H_
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef RING_QUEUE_H_
+#define RING_QUEUE_H_
+
+#include "../std/std_ring_queue.h"
+
+#endif // RING_QUEUE_H_
\ No newline at end of file
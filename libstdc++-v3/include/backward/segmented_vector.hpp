@@ -0,0 +1,6 @@
+#ifndef SEGMENTED_VECTOR_H_
+#define SEGMENTED_VECTOR_H_
+
+#include "../std/std_segmented_vector.h"
+
+#endif // SEGMENTED_VECTOR_H_
\ No newline at end of file
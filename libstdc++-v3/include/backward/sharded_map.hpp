@@ -0,0 +1,6 @@
+#ifndef SHARDED_MAP_H_
+#define SHARDED_MAP_H_
+
+#include "../std/std_sharded_map.h"
+
+#endif // SHARDED_MAP_H_
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include "../std/std_thread_pool.h"
+
+#endif // THREAD_POOL_H_
\ No newline at end of file
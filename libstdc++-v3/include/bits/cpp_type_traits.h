@@ -136,6 +136,48 @@ struct is_integer<unsigned long long>
   typedef __true_type type;
 };
 
+//
+// Floating point types
+//
+template <typename Tp>
+struct is_floating
+{
+  enum { value = 0 };
+  typedef __false_type type;
+};
+
+template<>
+struct is_floating<float>
+{
+  enum { value = 1 };
+  typedef __true_type type;
+};
+
+template<>
+struct is_floating<double>
+{
+  enum { value = 1 };
+  typedef __true_type type;
+};
+
+template<>
+struct is_floating<long double>
+{
+  enum { value = 1 };
+  typedef __true_type type;
+};
+
+//
+// An arithmetic type is an integer type or a floating point type
+//
+template <typename Tp>
+struct is_arithmetic
+{
+  enum { value = is_integer<Tp>::value || is_floating<Tp>::value };
+  typedef typename truth_type<value>::type type;
+};
+
+
 
 
 // For the immediate use, the following is a good approximation.
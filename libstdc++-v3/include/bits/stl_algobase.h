@@ -24,7 +24,7 @@ InputIterator2 first2)
   for (; first1 != last1; ++first1, ++first2 )
     if (!(*first1 == *first2))
       return false;
-    return true;
+  return true;
 }
 
 /**
@@ -50,7 +50,7 @@ BinaryPredicate binary_pred)
   for (; first1 != last1; ++first1, ++first2 )
     if (!binary_pred(*first1, *first2))
       return false;
-    return true;
+  return true;
 }
 
 /**
@@ -0,0 +1,412 @@
+// Concurrent map implementation -*- C++ -*-
+
+/** @file stl_concurrent_map.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_CONCURRENT_MAP_H_
+#define STL_CONCURRENT_MAP_H_
+
+#include <memory>
+#include <pthread.h>
+
+#include "stl_pair.h"
+#include "stl_persistent_map.h"
+#include "stl_epoch.h"
+
+
+namespace ft {
+/**
+ *  @brief An ordered map for many concurrent readers and few writers.
+ *
+ *  @ingroup Containers
+ *  @ingroup Assoc_containers
+ *
+ *  The contents are an immutable %persistent_map version, published
+ *  through one pointer.  Readers pin an epoch, load the pointer and
+ *  search that version: they take no lock, write no shared node and
+ *  never wait for a writer.  Writers are serialized by a mutex; each
+ *  one snapshots the published version in constant time, updates the
+ *  snapshot (copying O(log n) nodes) and publishes it.  The replaced
+ *  version is retired to an epoch domain and released only once no
+ *  reader can still be inside it, which frees the nodes it alone held.
+ *
+ *  Lookups return copies, since an element may be reclaimed once the
+ *  reader leaves; visit() runs a function on an element in place, and
+ *  snapshot() gives a %persistent_map that stays consistent for any
+ *  number of reads and for iteration.
+ *
+ *  @param  Key  Type of key objects.
+ *  @param  Tp  Type of mapped objects.
+ *  @param  Compare  Comparison function object type.
+ *  @param  Alloc  Allocator type.
+*/
+template <typename Key, typename Tp, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<ft::pair<const Key, Tp> > >
+class concurrent_map
+{
+public:
+  typedef Key                                          key_type;
+  typedef Tp                                           mapped_type;
+  typedef ft::pair<const Key, Tp>                      value_type;
+  typedef Compare                                      key_compare;
+  typedef Alloc                                        allocator_type;
+  typedef persistent_map<Key, Tp, Compare, Alloc>      snapshot_type;
+  typedef typename snapshot_type::size_type            size_type;
+
+private:
+  typedef typename snapshot_type::const_iterator       Const_iterator;
+
+  snapshot_type* volatile M_published;
+  mutable Epoch_domain    M_epochs;
+  pthread_mutex_t         M_write_mutex;
+
+  concurrent_map(const concurrent_map&);
+  concurrent_map& operator=(const concurrent_map&);
+
+  static void
+  S_delete_version(void* p)
+  { delete static_cast<snapshot_type*>(p); }
+
+  const snapshot_type*
+  M_load() const
+  { return __atomic_load_n(&M_published, __ATOMIC_ACQUIRE); }
+
+  // Writer side, with M_write_mutex held: a private copy of the
+  // published version to update.
+  snapshot_type*
+  M_begin_write()
+  {
+    pthread_mutex_lock(&M_write_mutex);
+    try
+    {
+      return new snapshot_type(*M_published);
+    }
+    catch(...)
+    {
+      pthread_mutex_unlock(&M_write_mutex);
+      throw;
+    }
+  }
+
+  void
+  M_abort_write(snapshot_type* next)
+  {
+    delete next;
+    pthread_mutex_unlock(&M_write_mutex);
+  }
+
+  // Publishes next and retires the version it replaces.  If that cannot
+  // be arranged, nothing is published and the write fails.
+  void
+  M_commit_write(snapshot_type* next)
+  {
+    Epoch_retired* r;
+    try
+    {
+      r = Epoch_domain::S_make_retired(M_published, &S_delete_version);
+    }
+    catch(...)
+    {
+      M_abort_write(next);
+      throw;
+    }
+    __atomic_store_n(&M_published, next, __ATOMIC_RELEASE);
+    M_epochs.M_retire(r);
+    M_epochs.M_collect();
+    pthread_mutex_unlock(&M_write_mutex);
+  }
+
+public:
+  /**
+   *  @brief  Default constructor creates no elements.
+   */
+  concurrent_map()
+  : M_published(new snapshot_type())
+  { pthread_mutex_init(&M_write_mutex, 0); }
+
+  explicit
+  concurrent_map(const Compare& comp,
+                 const allocator_type& a = allocator_type())
+  : M_published(new snapshot_type(comp, a))
+  { pthread_mutex_init(&M_write_mutex, 0); }
+
+  /**
+   *  @brief  Publishes the contents of a snapshot.
+   *  @param  x  A %persistent_map; it is shared, not copied.
+   */
+  explicit
+  concurrent_map(const snapshot_type& x)
+  : M_published(new snapshot_type(x))
+  { pthread_mutex_init(&M_write_mutex, 0); }
+
+  /**
+   *  No reader or writer may still be running.
+   */
+  ~concurrent_map()
+  {
+    delete M_published;
+    pthread_mutex_destroy(&M_write_mutex);
+  }
+
+  // readers
+  /**
+   *  @brief  Takes a consistent snapshot of the %map.
+   *  @return  A %persistent_map holding the contents as last published.
+   *
+   *  Constant time.  The snapshot is unaffected by later writes, and may
+   *  be searched and iterated without further synchronization.
+   */
+  snapshot_type
+  snapshot() const
+  {
+    Epoch_guard guard(M_epochs);
+    return *M_load();
+  }
+
+  /** Returns the size of the %map as last published.  */
+  size_type
+  size() const
+  {
+    Epoch_guard guard(M_epochs);
+    return M_load()->size();
+  }
+
+  /** Returns true if the %map was empty as last published.  */
+  bool
+  empty() const
+  { return size() == 0; }
+
+  /**
+   *  @brief  Finds the number of elements with given key.
+   *  @param  x  Key of (key, value) pairs to be located.
+   *  @return  Number of elements with specified key.
+   */
+  size_type
+  count(const key_type& x) const
+  {
+    Epoch_guard guard(M_epochs);
+    return M_load()->count(x);
+  }
+
+  /**
+   *  @brief  Copies out the data mapped to a key.
+   *  @param  x  Key to be located.
+   *  @param  result  Set to the mapped data if @a x is present.
+   *  @return  True if @a x was found.
+   */
+  bool
+  find(const key_type& x, mapped_type& result) const
+  {
+    Epoch_guard guard(M_epochs);
+    const snapshot_type* v = M_load();
+    Const_iterator i = v->find(x);
+    if (i == v->end())
+      return false;
+    result = (*i).second;
+    return true;
+  }
+
+  /**
+   *  @brief  Applies a function to the element with a given key.
+   *  @param  x  Key to be located.
+   *  @param  f  Called as f(const value_type&) while the element is
+   *             guaranteed to stay allocated.
+   *  @return  True if @a x was found and @a f called.
+   *
+   *  No copy is made; @a f must not keep references to the element, and
+   *  should be short, since it delays reclamation.
+   */
+  template <typename Function>
+  bool
+  visit(const key_type& x, Function f) const
+  {
+    Epoch_guard guard(M_epochs);
+    const snapshot_type* v = M_load();
+    Const_iterator i = v->find(x);
+    if (i == v->end())
+      return false;
+    f(*i);
+    return true;
+  }
+
+  /**
+   *  @brief  Copies out the first element not less than a key.
+   *  @param  x  Key to be located.
+   *  @param  result  Set to the element found, if any.
+   *  @return  False if every key is less than @a x.
+   */
+  bool
+  lower_bound(const key_type& x,
+              ft::pair<key_type, mapped_type>& result) const
+  {
+    Epoch_guard guard(M_epochs);
+    const snapshot_type* v = M_load();
+    Const_iterator i = v->lower_bound(x);
+    if (i == v->end())
+      return false;
+    result = ft::pair<key_type, mapped_type>((*i).first, (*i).second);
+    return true;
+  }
+
+  /**
+   *  @brief  Copies out the first element greater than a key.
+   *  @param  x  Key to be located.
+   *  @param  result  Set to the element found, if any.
+   *  @return  False if no key is greater than @a x.
+   */
+  bool
+  upper_bound(const key_type& x,
+              ft::pair<key_type, mapped_type>& result) const
+  {
+    Epoch_guard guard(M_epochs);
+    const snapshot_type* v = M_load();
+    Const_iterator i = v->upper_bound(x);
+    if (i == v->end())
+      return false;
+    result = ft::pair<key_type, mapped_type>((*i).first, (*i).second);
+    return true;
+  }
+
+  // writers
+  /**
+   *  @brief  Inserts an element unless its key is present.
+   *  @param  x  Pair to be inserted.
+   *  @return  True if @a x was inserted.
+   *
+   *  Publishes a new version only when something changed.
+   */
+  bool
+  insert(const value_type& x)
+  {
+    snapshot_type* next = M_begin_write();
+    bool inserted;
+    try
+    {
+      inserted = next->insert(x).second;
+    }
+    catch(...)
+    {
+      M_abort_write(next);
+      throw;
+    }
+    if (inserted)
+      M_commit_write(next);
+    else
+      M_abort_write(next);
+    return inserted;
+  }
+
+  /**
+   *  @brief  Inserts an element, or assigns to the existing one.
+   *  @param  k  Key of the element.
+   *  @param  obj  Value for the mapped part.
+   *  @return  True if the element was inserted, false if assigned.
+   */
+  template <typename Obj>
+  bool
+  insert_or_assign(const key_type& k, const Obj& obj)
+  {
+    snapshot_type* next = M_begin_write();
+    bool inserted;
+    try
+    {
+      inserted = next->insert_or_assign(k, obj).second;
+    }
+    catch(...)
+    {
+      M_abort_write(next);
+      throw;
+    }
+    M_commit_write(next);
+    return inserted;
+  }
+
+  /**
+   *  @brief  Erases the element with a given key.
+   *  @param  x  Key of element to be erased.
+   *  @return  The number of elements erased.
+   */
+  size_type
+  erase(const key_type& x)
+  {
+    snapshot_type* next = M_begin_write();
+    size_type n;
+    try
+    {
+      n = next->erase(x);
+    }
+    catch(...)
+    {
+      M_abort_write(next);
+      throw;
+    }
+    if (n != 0)
+      M_commit_write(next);
+    else
+      M_abort_write(next);
+    return n;
+  }
+
+  /**
+   *  @brief  Applies several updates and publishes them at once.
+   *  @param  f  Called as f(snapshot_type&) on a private copy of the
+   *             published version.
+   *
+   *  Readers see either none or all of the changes made by @a f, and the
+   *  nodes copied by successive changes to the same path are reused, so
+   *  a batch is much cheaper than as many single writes.  If @a f throws,
+   *  nothing is published.
+   */
+  template <typename Function>
+  void
+  update(Function f)
+  {
+    snapshot_type* next = M_begin_write();
+    try
+    {
+      f(*next);
+    }
+    catch(...)
+    {
+      M_abort_write(next);
+      throw;
+    }
+    M_commit_write(next);
+  }
+
+  /**
+   *  Publishes an empty %map.
+   */
+  void
+  clear()
+  {
+    snapshot_type* next = M_begin_write();
+    next->clear();
+    M_commit_write(next);
+  }
+
+  /**
+   *  Returns the key comparison object out of which the %map was
+   *  constructed.
+   */
+  key_compare
+  key_comp() const
+  {
+    Epoch_guard guard(M_epochs);
+    return M_load()->key_comp();
+  }
+
+  /// Get a copy of the memory allocation object.
+  allocator_type
+  get_allocator() const
+  {
+    Epoch_guard guard(M_epochs);
+    return M_load()->get_allocator();
+  }
+};
+
+} // ft
+
+#endif // STL_CONCURRENT_MAP_H_
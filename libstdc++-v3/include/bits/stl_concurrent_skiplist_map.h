@@ -0,0 +1,1102 @@
+// Concurrent skip list map implementation -*- C++ -*-
+
+/** @file stl_concurrent_skiplist_map.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_CONCURRENT_SKIPLIST_MAP_H_
+#define STL_CONCURRENT_SKIPLIST_MAP_H_
+
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+#include "stl_pair.h"
+#include "stl_function.h"
+#include "stl_iterator.h"
+#include "stl_algobase.h"
+#include "stl_epoch.h"
+
+
+namespace ft {
+
+// A skip list node.  M_next holds M_level links, level 0 first; the low
+// bit of M_next[i] set means that the node is deleted as far as level i
+// is concerned, and the link can then no longer change.  M_links counts
+// the levels at which the node is linked, plus one while its insertion
+// runs: the node is unreachable once it drops to zero.
+struct Skiplist_node_base
+{
+  typedef Skiplist_node_base* Base_ptr;
+
+  std::size_t           M_level;
+  Base_ptr volatile*    M_next;
+  volatile std::size_t  M_links;
+  Base_ptr              M_retired_next;
+};
+
+template <typename Val>
+struct Skiplist_node : public Skiplist_node_base
+{
+  Val M_value_field;
+};
+
+inline bool
+Skiplist_is_marked(Skiplist_node_base* x)
+{ return (reinterpret_cast<std::size_t>(x) & 1) != 0; }
+
+inline Skiplist_node_base*
+Skiplist_mark(Skiplist_node_base* x)
+{
+  return reinterpret_cast<Skiplist_node_base*>(
+      reinterpret_cast<std::size_t>(x) | 1);
+}
+
+inline Skiplist_node_base*
+Skiplist_unmark(Skiplist_node_base* x)
+{
+  return reinterpret_cast<Skiplist_node_base*>(
+      reinterpret_cast<std::size_t>(x) & ~std::size_t(1));
+}
+
+inline Skiplist_node_base*
+Skiplist_load(Skiplist_node_base* volatile* link)
+{ return __atomic_load_n(link, __ATOMIC_ACQUIRE); }
+
+inline bool
+Skiplist_cas(Skiplist_node_base* volatile* link, Skiplist_node_base* expected,
+             Skiplist_node_base* desired)
+{ return __sync_bool_compare_and_swap(link, expected, desired); }
+
+// The first node from x on, x included, that is not deleted.
+inline Skiplist_node_base*
+Skiplist_first_live(Skiplist_node_base* x)
+{
+  while (x != 0)
+  {
+    Skiplist_node_base* succ = Skiplist_load(&x->M_next[0]);
+    if (!Skiplist_is_marked(succ))
+      break;
+    x = Skiplist_unmark(succ);
+  }
+  return x;
+}
+
+template <typename List, typename Ref, typename Ptr>
+struct Skiplist_iterator
+{
+  typedef typename List::value_type         value_type;
+  typedef Ref                               reference;
+  typedef Ptr                               pointer;
+
+  typedef Skiplist_iterator<List, value_type&, value_type*>
+                                            iterator;
+
+  typedef std::bidirectional_iterator_tag   iterator_category;
+  typedef ptrdiff_t                         difference_type;
+
+  typedef Skiplist_iterator<List, Ref, Ptr> Self;
+  typedef Skiplist_node<value_type>*        Link_type;
+
+  Skiplist_iterator()
+  : M_node(), M_list() { }
+
+  Skiplist_iterator(Skiplist_node_base* x, const List* list)
+  : M_node(x), M_list(list) { }
+
+  // iterator to const_iterator.  A template, so that it is never taken
+  // for the copy constructor and the copy operations stay implicit.
+  template <typename Ref2>
+  Skiplist_iterator(const Skiplist_iterator<List, Ref2,
+                    typename ft::enable_if<
+                      ft::are_same<Ref2, value_type&>::value,
+                      value_type*>::type>& it)
+  : M_node(it.M_node), M_list(it.M_list) { }
+
+  reference
+  operator*() const
+  { return static_cast<Link_type>(M_node)->M_value_field; }
+
+  pointer
+  operator->() const
+  { return &static_cast<Link_type>(M_node)->M_value_field; }
+
+  Self&
+  operator++()
+  {
+    M_node = Skiplist_first_live(
+        Skiplist_unmark(Skiplist_load(&M_node->M_next[0])));
+    return *this;
+  }
+
+  Self
+  operator++(int)
+  {
+    Self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  // Singly linked: the predecessor is searched for from the head.
+  Self&
+  operator--()
+  {
+    M_node = M_list->M_predecessor(M_node);
+    return *this;
+  }
+
+  Self
+  operator--(int)
+  {
+    Self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  Skiplist_node_base* M_node;
+  const List*         M_list;
+};
+
+template <typename List, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator==(const Skiplist_iterator<List, RefL, PtrL>& x,
+           const Skiplist_iterator<List, RefR, PtrR>& y)
+{ return x.M_node == y.M_node; }
+
+template <typename List, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator!=(const Skiplist_iterator<List, RefL, PtrL>& x,
+           const Skiplist_iterator<List, RefR, PtrR>& y)
+{ return x.M_node != y.M_node; }
+
+/**
+ *  @brief An ordered map that any number of threads may search, iterate,
+ *  insert into and erase from at the same time.
+ *
+ *  @ingroup Containers
+ *  @ingroup Assoc_containers
+ *
+ *  A lock-free skip list.  insert() links a node with compare-and-swap,
+ *  bottom level first; erase() deletes lazily: it marks the links of the
+ *  node, the level 0 mark being the erasure proper, and the marked node
+ *  is then unlinked by whichever thread next passes it while updating.
+ *  Lookups and iteration only read, skipping marked nodes.  No operation
+ *  takes a lock.
+ *
+ *  Erased nodes are reclaimed through an epoch domain, as in
+ *  concurrent_map: a node unlinked from every level is retired, in
+ *  batches, and freed once no thread can still be inside it.  Every
+ *  member function pins the domain for its own duration.  A thread that
+ *  keeps iterators or references across calls while other threads
+ *  erase holds a concurrent_skiplist_map::pin meanwhile; without one,
+ *  they stay valid only as long as nothing is erased.
+ *
+ *  Iteration is ordered and forward steps are constant time; a step
+ *  back searches from the head, so reverse iteration is O(log n) per
+ *  element.  Iterators show each element present throughout the walk,
+ *  and may or may not show those inserted or erased meanwhile.  size()
+ *  is exact only when no update is running.  Writing a mapped value that
+ *  other threads read is up to the caller to synchronize.
+ *
+ *  @param  Key  Type of key objects.
+ *  @param  Tp  Type of mapped objects.
+ *  @param  Compare  Comparison function object type.
+ *  @param  Alloc  Allocator type.
+*/
+template <typename Key, typename Tp, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<ft::pair<const Key, Tp> > >
+class concurrent_skiplist_map
+{
+public:
+  typedef Key                         key_type;
+  typedef Tp                          mapped_type;
+  typedef ft::pair<const Key, Tp>     value_type;
+  typedef Compare                     key_compare;
+  typedef Alloc                       allocator_type;
+
+public:
+  class value_compare
+  : public std::binary_function<value_type, value_type, bool>
+  {
+    friend class concurrent_skiplist_map<Key, Tp, Compare, Alloc>;
+    protected:
+      Compare comp;
+
+      value_compare(Compare c)
+      : comp(c) { }
+
+    public:
+      bool operator()(const value_type& x, const value_type& y) const
+      { return comp(x.first, y.first); }
+  };
+
+  /**
+   *  @brief  Keeps erased elements allocated while it lives.
+   *
+   *  Hold one around any use of iterators or references that spans
+   *  several calls while other threads may erase; each thread needs its
+   *  own.  Pins are cheap (one compare-and-swap) but delay reclamation,
+   *  so keep them short.
+   */
+  class pin
+  {
+    Epoch_guard M_guard;
+
+  public:
+    explicit
+    pin(const concurrent_skiplist_map& m)
+    : M_guard(m.M_epochs) { }
+  };
+
+private:
+  typedef concurrent_skiplist_map<Key, Tp, Compare, Alloc>    Self;
+  typedef typename Alloc::template rebind<value_type>::other  Pair_alloc_type;
+  typedef typename Alloc::template rebind<char>::other        Byte_allocator;
+  typedef Skiplist_node_base*                                 Base_ptr;
+  typedef Skiplist_node<value_type>*                          Link_type;
+
+  // p = 1/4 per extra level: 4^16 elements before the top level fills.
+  enum { S_max_level = 16 };
+
+  // Unreachable nodes wait on M_retired until this many have gathered,
+  // then go to the epoch domain under one retirement record.
+  enum { S_retire_batch = 64 };
+
+public:
+  typedef typename Pair_alloc_type::pointer         pointer;
+  typedef typename Pair_alloc_type::const_pointer   const_pointer;
+  typedef typename Pair_alloc_type::reference       reference;
+  typedef typename Pair_alloc_type::const_reference const_reference;
+  typedef Skiplist_iterator<Self, value_type&, value_type*>
+                                                    iterator;
+  typedef Skiplist_iterator<Self, const value_type&, const value_type*>
+                                                    const_iterator;
+  typedef size_t                                    size_type;
+  typedef ptrdiff_t                                 difference_type;
+  typedef ft::reverse_iterator<iterator>            reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator>      const_reverse_iterator;
+
+private:
+  struct Skiplist_impl : public Byte_allocator
+  {
+    Compare              M_key_compare;
+    Skiplist_node_base   M_head;
+    Base_ptr volatile    M_head_next[S_max_level];
+    volatile size_type   M_node_count;
+    volatile size_type   M_seed;
+    Base_ptr volatile    M_retired;
+    volatile size_type   M_retired_count;
+
+    Skiplist_impl(const Byte_allocator& a, const Compare& comp)
+    : Byte_allocator(a), M_key_compare(comp), M_node_count(0), M_seed(0),
+      M_retired(0), M_retired_count(0)
+    {
+      M_head.M_level = S_max_level;
+      M_head.M_next = M_head_next;
+      M_head.M_links = 1;
+      M_head.M_retired_next = 0;
+      for (size_type i = 0; i < S_max_level; ++i)
+        M_head_next[i] = 0;
+    }
+  };
+
+  // A run of nodes retired together, and the map that frees them.
+  struct Retired_batch
+  {
+    Self*     M_map;
+    Base_ptr  M_head;
+  };
+
+  Skiplist_impl         M_impl;
+  // Declared last: destroyed first, it may still free nodes through
+  // M_impl.
+  mutable Epoch_domain  M_epochs;
+
+  static const Key&
+  S_key(Base_ptr x)
+  { return static_cast<Link_type>(x)->M_value_field.first; }
+
+  // The links follow the node in the same block.
+  static size_type
+  S_links_offset()
+  {
+    const size_type a = sizeof(Base_ptr);
+    return (sizeof(Skiplist_node<value_type>) + a - 1) / a * a;
+  }
+
+  static size_type
+  S_node_bytes(size_type level)
+  { return S_links_offset() + level * sizeof(Base_ptr); }
+
+  // Geometric, from a hashed counter: no shared random state to fight
+  // over beyond one fetch-and-add.
+  size_type
+  M_random_level()
+  {
+    unsigned int h = static_cast<unsigned int>(
+        __sync_fetch_and_add(&M_impl.M_seed, size_type(1)));
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    size_type level = 1;
+    while (level < S_max_level && (h & 3) == 0)
+    {
+      ++level;
+      h >>= 2;
+    }
+    return level;
+  }
+
+  Link_type
+  M_create_node(const value_type& x, size_type level)
+  {
+    char* raw = M_impl.Byte_allocator::allocate(S_node_bytes(level));
+    Link_type tmp = reinterpret_cast<Link_type>(raw);
+    try
+    {
+      get_allocator().construct(&tmp->M_value_field, x);
+    }
+    catch(...)
+    {
+      M_impl.Byte_allocator::deallocate(raw, S_node_bytes(level));
+      throw;
+    }
+    tmp->M_level = level;
+    tmp->M_next = reinterpret_cast<Base_ptr volatile*>(
+        raw + S_links_offset());
+    // Its insertion, and the level 0 link it is about to be given.
+    tmp->M_links = 2;
+    tmp->M_retired_next = 0;
+    return tmp;
+  }
+
+  void
+  M_destroy_node(Base_ptr x)
+  {
+    Link_type p = static_cast<Link_type>(x);
+    const size_type bytes = S_node_bytes(p->M_level);
+    get_allocator().destroy(&p->M_value_field);
+    M_impl.Byte_allocator::deallocate(reinterpret_cast<char*>(p), bytes);
+  }
+
+  // Locates k, filling preds and succs with its neighbours at every
+  // level, and unlinks on the way any marked node it meets.  Returns
+  // true if succs[0] holds k.
+  bool
+  M_find(const key_type& k, Base_ptr* preds, Base_ptr* succs)
+  {
+  retry:
+    Base_ptr pred = &M_impl.M_head;
+    for (size_type l = S_max_level; l-- > 0; )
+    {
+      Base_ptr curr = Skiplist_unmark(Skiplist_load(&pred->M_next[l]));
+      while (curr != 0)
+      {
+        Base_ptr succ = Skiplist_load(&curr->M_next[l]);
+        if (Skiplist_is_marked(succ))
+        {
+          if (!Skiplist_cas(&pred->M_next[l], curr, Skiplist_unmark(succ)))
+            goto retry;
+          M_release(curr);
+          curr = Skiplist_unmark(succ);
+          continue;
+        }
+        if (!M_impl.M_key_compare(S_key(curr), k))
+          break;
+        pred = curr;
+        curr = succ;
+      }
+      preds[l] = pred;
+      succs[l] = curr;
+    }
+    return succs[0] != 0 && !M_impl.M_key_compare(k, S_key(succs[0]));
+  }
+
+  // Read-only descent: the last live node before k (or the head), and
+  // the first live node not less than k.  upper looks past k instead.
+  Base_ptr
+  M_bound(const key_type& k, bool upper) const
+  {
+    Base_ptr pred = const_cast<Base_ptr>(&M_impl.M_head);
+    Base_ptr curr = 0;
+    for (size_type l = S_max_level; l-- > 0; )
+    {
+      curr = Skiplist_unmark(Skiplist_load(&pred->M_next[l]));
+      while (curr != 0)
+      {
+        Base_ptr succ = Skiplist_load(&curr->M_next[l]);
+        if (Skiplist_is_marked(succ))
+        {
+          curr = Skiplist_unmark(succ);
+          continue;
+        }
+        if (upper ? M_impl.M_key_compare(k, S_key(curr))
+                  : !M_impl.M_key_compare(S_key(curr), k))
+          break;
+        pred = curr;
+        curr = succ;
+      }
+    }
+    return curr;
+  }
+
+  // Pushes the chain first ... last, linked by M_retired_next.
+  void
+  M_push_retired(Base_ptr first, Base_ptr last)
+  {
+    Base_ptr head;
+    do
+    {
+      head = Skiplist_load(&M_impl.M_retired);
+      last->M_retired_next = head;
+    }
+    while (!Skiplist_cas(&M_impl.M_retired, head, first));
+  }
+
+  // Drops one of x's links; the last one retires it.
+  void
+  M_release(Base_ptr x)
+  {
+    if (__sync_sub_and_fetch(&x->M_links, size_type(1)) != 0)
+      return;
+    M_push_retired(x, x);
+    if (__sync_add_and_fetch(&M_impl.M_retired_count, size_type(1))
+        % S_retire_batch == 0)
+      M_retire_batch();
+  }
+
+  static void
+  S_free_chain(Self* map, Base_ptr x)
+  {
+    while (x != 0)
+    {
+      Base_ptr next = x->M_retired_next;
+      map->M_destroy_node(x);
+      x = next;
+    }
+  }
+
+  static void
+  S_free_batch(void* p)
+  {
+    Retired_batch* b = static_cast<Retired_batch*>(p);
+    S_free_chain(b->M_map, b->M_head);
+    delete b;
+  }
+
+  // Hands the nodes on M_retired to the epoch domain and frees what
+  // has become safe to.  If the records cannot be allocated, the nodes
+  // go back to wait for the next batch.
+  void
+  M_retire_batch()
+  {
+    Base_ptr head = __atomic_exchange_n(&M_impl.M_retired, Base_ptr(0),
+                                        __ATOMIC_ACQ_REL);
+    if (head == 0)
+      return;
+    Retired_batch* b = 0;
+    Epoch_retired* r;
+    try
+    {
+      b = new Retired_batch;
+      r = Epoch_domain::S_make_retired(b, &S_free_batch);
+    }
+    catch(...)
+    {
+      delete b;
+      Base_ptr last = head;
+      while (last->M_retired_next != 0)
+        last = last->M_retired_next;
+      M_push_retired(head, last);
+      return;
+    }
+    b->M_map = this;
+    b->M_head = head;
+    M_epochs.M_retire(r);
+    M_epochs.M_collect();
+  }
+
+  // Unlinks every marked node at every level, then frees all retired
+  // nodes.  Exclusive access only.
+  void
+  M_reclaim()
+  {
+    for (size_type l = 0; l < S_max_level; ++l)
+    {
+      Base_ptr pred = &M_impl.M_head;
+      Base_ptr curr = Skiplist_unmark(pred->M_next[l]);
+      while (curr != 0)
+      {
+        Base_ptr succ = curr->M_next[l];
+        if (Skiplist_is_marked(succ))
+        {
+          pred->M_next[l] = Skiplist_unmark(succ);
+          M_release(curr);
+        }
+        else
+          pred = curr;
+        curr = Skiplist_unmark(succ);
+      }
+    }
+    Base_ptr x = M_impl.M_retired;
+    M_impl.M_retired = 0;
+    S_free_chain(this, x);
+    // No thread is pinned: two steps of the epoch free every batch.
+    M_epochs.M_collect();
+    M_epochs.M_collect();
+  }
+
+  void
+  M_erase_all()
+  {
+    M_reclaim();
+    Base_ptr x = M_impl.M_head.M_next[0];
+    while (x != 0)
+    {
+      Base_ptr next = x->M_next[0];
+      M_destroy_node(x);
+      x = next;
+    }
+    for (size_type l = 0; l < S_max_level; ++l)
+      M_impl.M_head_next[l] = 0;
+    M_impl.M_node_count = 0;
+  }
+
+public:
+  // For the iterators.
+  Base_ptr
+  M_predecessor(Base_ptr x) const
+  {
+    Base_ptr pred = const_cast<Base_ptr>(&M_impl.M_head);
+    for (size_type l = S_max_level; l-- > 0; )
+    {
+      Base_ptr curr = Skiplist_unmark(Skiplist_load(&pred->M_next[l]));
+      while (curr != 0)
+      {
+        Base_ptr succ = Skiplist_load(&curr->M_next[l]);
+        if (Skiplist_is_marked(succ))
+        {
+          curr = Skiplist_unmark(succ);
+          continue;
+        }
+        if (x != 0 && !M_impl.M_key_compare(S_key(curr), S_key(x)))
+          break;
+        pred = curr;
+        curr = succ;
+      }
+    }
+    return pred;
+  }
+
+  // construct/copy/destroy
+  /**
+   *  @brief  Default constructor creates no elements.
+   */
+  concurrent_skiplist_map()
+  : M_impl(Byte_allocator(), Compare()) { }
+
+  explicit
+  concurrent_skiplist_map(const Compare& comp,
+                          const allocator_type& a = allocator_type())
+  : M_impl(Byte_allocator(a), comp) { }
+
+  /**
+   *  @brief  Copy constructor.
+   *
+   *  @a x may be updated meanwhile; the copy then holds at least the
+   *  elements present in @a x throughout.
+   */
+  concurrent_skiplist_map(const concurrent_skiplist_map& x)
+  : M_impl(Byte_allocator(x.get_allocator()), x.M_impl.M_key_compare)
+  {
+    Epoch_guard guard(x.M_epochs);
+    try
+    {
+      insert(x.begin(), x.end());
+    }
+    catch(...)
+    {
+      M_erase_all();
+      throw;
+    }
+  }
+
+  /**
+   *  @brief  Builds a %concurrent_skiplist_map from a range.
+   *  @param  first  An input iterator.
+   *  @param  last  An input iterator.
+   */
+  template <typename InputIterator>
+  concurrent_skiplist_map(InputIterator first, InputIterator last,
+                          const Compare& comp = Compare(),
+                          const allocator_type& a = allocator_type())
+  : M_impl(Byte_allocator(a), comp)
+  {
+    try
+    {
+      insert(first, last);
+    }
+    catch(...)
+    {
+      M_erase_all();
+      throw;
+    }
+  }
+
+  /**
+   *  No other thread may still be using the %map.
+   */
+  ~concurrent_skiplist_map()
+  { M_erase_all(); }
+
+  /**
+   *  @brief  Assignment; neither %map may be in use by other threads.
+   */
+  concurrent_skiplist_map&
+  operator=(const concurrent_skiplist_map& x)
+  {
+    if (this != &x)
+    {
+      clear();
+      M_impl.M_key_compare = x.M_impl.M_key_compare;
+      insert(x.begin(), x.end());
+    }
+    return *this;
+  }
+
+  /// Get a copy of the memory allocation object.
+  allocator_type
+  get_allocator() const
+  { return allocator_type(*static_cast<const Byte_allocator*>(&M_impl)); }
+
+  // iterators
+  /**
+   *  Returns an iterator to the first element, in ascending key order.
+   */
+  iterator
+  begin()
+  {
+    Epoch_guard guard(M_epochs);
+    return iterator(Skiplist_first_live(
+        Skiplist_load(&M_impl.M_head.M_next[0])), this);
+  }
+
+  const_iterator
+  begin() const
+  {
+    Epoch_guard guard(M_epochs);
+    return const_iterator(Skiplist_first_live(
+        Skiplist_load(&M_impl.M_head.M_next[0])), this);
+  }
+
+  /**
+   *  Returns an iterator one past the last element.
+   */
+  iterator
+  end()
+  { return iterator(0, this); }
+
+  const_iterator
+  end() const
+  { return const_iterator(0, this); }
+
+  /**
+   *  Returns a reverse iterator to the last element.  Each step costs a
+   *  search from the head.
+   */
+  reverse_iterator
+  rbegin()
+  { return reverse_iterator(end()); }
+
+  const_reverse_iterator
+  rbegin() const
+  { return const_reverse_iterator(end()); }
+
+  reverse_iterator
+  rend()
+  { return reverse_iterator(begin()); }
+
+  const_reverse_iterator
+  rend() const
+  { return const_reverse_iterator(begin()); }
+
+  // capacity
+  /** Returns true if the %map is empty.  */
+  bool
+  empty() const
+  { return begin() == end(); }
+
+  /** Returns the number of elements, exact when no update is running.  */
+  size_type
+  size() const
+  { return __atomic_load_n(&M_impl.M_node_count, __ATOMIC_RELAXED); }
+
+  /** Returns the maximum size of the %map.  */
+  size_type
+  max_size() const
+  { return get_allocator().max_size(); }
+
+  // element access
+  /**
+   *  @brief  Subscript ( @c [] ) access to %map data.
+   *  @param  k  The key for which data should be retrieved.
+   *  @return  A reference to the data of the (key,data) %pair.
+   *
+   *  If the key does not exist, a pair with that key is created using
+   *  default values.  The reference stays valid until the element is
+   *  erased, and after that for as long as the caller holds a pin.
+   */
+  mapped_type&
+  operator[](const key_type& k)
+  {
+    iterator i = find(k);
+    if (i == end())
+      i = insert(value_type(k, mapped_type())).first;
+    return (*i).second;
+  }
+
+  /**
+   *  @brief  Access to %map data.
+   *  @throw  std::out_of_range  If no such data is present.
+   */
+  mapped_type&
+  at(const key_type& k)
+  {
+    iterator i = find(k);
+    if (i == end())
+      throw std::out_of_range("concurrent_skiplist_map::at");
+    return (*i).second;
+  }
+
+  const mapped_type&
+  at(const key_type& k) const
+  {
+    const_iterator i = find(k);
+    if (i == end())
+      throw std::out_of_range("concurrent_skiplist_map::at");
+    return (*i).second;
+  }
+
+  // modifiers
+  /**
+   *  @brief Attempts to insert a std::pair into the %map.
+   *  @param  x  Pair to be inserted.
+   *  @return  A pair of an iterator to the element with the key of @a x
+   *           and a bool that is true if @a x was inserted.
+   *
+   *  Lock-free: the node is published by one compare-and-swap at level
+   *  0, which is when it becomes visible, then linked at its upper levels.
+   *  Expected O(log n).
+   */
+  ft::pair<iterator, bool>
+  insert(const value_type& x)
+  {
+    Epoch_guard guard(M_epochs);
+    Base_ptr preds[S_max_level];
+    Base_ptr succs[S_max_level];
+    const key_type& k = x.first;
+    Link_type z = 0;
+    size_type level = 0;
+    for (;;)
+    {
+      if (M_find(k, preds, succs))
+      {
+        if (z != 0)
+          M_destroy_node(z);
+        return ft::pair<iterator, bool>(iterator(succs[0], this), false);
+      }
+      if (z == 0)
+      {
+        level = M_random_level();
+        z = M_create_node(x, level);
+      }
+      for (size_type l = 0; l < level; ++l)
+        z->M_next[l] = succs[l];
+      if (Skiplist_cas(&preds[0]->M_next[0], succs[0], z))
+        break;
+    }
+    for (size_type l = 1; l < level; ++l)
+    {
+      for (;;)
+      {
+        __sync_fetch_and_add(&z->M_links, size_type(1));
+        if (Skiplist_cas(&preds[l]->M_next[l], succs[l], z))
+          break;
+        __sync_fetch_and_sub(&z->M_links, size_type(1));
+        M_find(k, preds, succs);
+        // Stop if z was erased meanwhile: its links are then marked.
+        Base_ptr old = Skiplist_load(&z->M_next[l]);
+        if (Skiplist_is_marked(old)
+            || (old != succs[l] && !Skiplist_cas(&z->M_next[l], old, succs[l])))
+          goto linked;
+      }
+    }
+  linked:
+    __sync_fetch_and_add(&M_impl.M_node_count, size_type(1));
+    M_release(z);
+    return ft::pair<iterator, bool>(iterator(z, this), true);
+  }
+
+  /**
+   *  @brief Attempts to insert a std::pair into the %map.
+   *  @param  position  Ignored; kept for the %map interface.
+   */
+  iterator
+  insert(iterator position, const value_type& x)
+  {
+    (void)position;
+    return insert(x).first;
+  }
+
+  /**
+   *  @brief Template function that attemps to insert a range of elements.
+   */
+  template <typename InputIterator>
+  void
+  insert(InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  /**
+   *  @brief Erases elements according to the provided key.
+   *  @param  x  Key of element to be erased.
+   *  @return  The number of elements erased.
+   *
+   *  Lock-free.  The element is gone once its level 0 link is marked;
+   *  only one of several threads erasing the same key succeeds.  The
+   *  node is then unlinked, and freed once no pinned thread remains
+   *  that could hold it.
+   */
+  size_type
+  erase(const key_type& x)
+  {
+    Epoch_guard guard(M_epochs);
+    Base_ptr preds[S_max_level];
+    Base_ptr succs[S_max_level];
+    if (!M_find(x, preds, succs))
+      return 0;
+    Base_ptr victim = succs[0];
+    for (size_type l = victim->M_level; l-- > 1; )
+    {
+      Base_ptr succ = Skiplist_load(&victim->M_next[l]);
+      while (!Skiplist_is_marked(succ))
+      {
+        Skiplist_cas(&victim->M_next[l], succ, Skiplist_mark(succ));
+        succ = Skiplist_load(&victim->M_next[l]);
+      }
+    }
+    Base_ptr succ = Skiplist_load(&victim->M_next[0]);
+    for (;;)
+    {
+      if (Skiplist_is_marked(succ))
+        return 0;
+      if (Skiplist_cas(&victim->M_next[0], succ, Skiplist_mark(succ)))
+        break;
+      succ = Skiplist_load(&victim->M_next[0]);
+    }
+    __sync_fetch_and_sub(&M_impl.M_node_count, size_type(1));
+    // Unlinks victim wherever it is still linked.
+    M_find(x, preds, succs);
+    return 1;
+  }
+
+  /**
+   *  @brief Erases an element from a %map.
+   *  @param  position  An iterator pointing to the element to be erased.
+   */
+  void
+  erase(iterator position)
+  { erase((*position).first); }
+
+  /**
+   *  @brief Erases a [first,last) range of elements, key by key.
+   */
+  void
+  erase(iterator first, iterator last)
+  {
+    while (first != last)
+      erase((*first++).first);
+  }
+
+  /**
+   *  @brief  Frees the nodes of erased elements at once.
+   *
+   *  Erased nodes are reclaimed as the %map is used; this frees those
+   *  still waiting, e.g. before a quiet period.  Must not run
+   *  concurrently with any other use of the %map, and invalidates
+   *  iterators to erased elements.  Linear.
+   */
+  void
+  quiesce()
+  { M_reclaim(); }
+
+  /**
+   *  Erases all elements.  Must not run concurrently with any other use
+   *  of the %map.
+   */
+  void
+  clear()
+  { M_erase_all(); }
+
+  /**
+   *  @brief  Swaps data with another %map; neither may be in use by
+   *  other threads.
+   */
+  void
+  swap(concurrent_skiplist_map& x)
+  {
+    // Nothing is left retired, to be freed by the other map.
+    M_reclaim();
+    x.M_reclaim();
+    for (size_type l = 0; l < S_max_level; ++l)
+      std::swap(M_impl.M_head_next[l], x.M_impl.M_head_next[l]);
+    std::swap(M_impl.M_node_count, x.M_impl.M_node_count);
+    std::swap(M_impl.M_key_compare, x.M_impl.M_key_compare);
+  }
+
+  // observers
+  key_compare
+  key_comp() const
+  { return M_impl.M_key_compare; }
+
+  value_compare
+  value_comp() const
+  { return value_compare(M_impl.M_key_compare); }
+
+  // map operations
+  /**
+   *  @brief Tries to locate an element in a %map.
+   *  @param  x  Key of (key, value) %pair to be located.
+   *  @return  Iterator pointing to sought-after element, or end() if not
+   *           found.
+   *
+   *  Wait-free with respect to other lookups; it never writes.
+   */
+  iterator
+  find(const key_type& x)
+  {
+    Epoch_guard guard(M_epochs);
+    Base_ptr y = M_bound(x, false);
+    if (y != 0 && M_impl.M_key_compare(x, S_key(y)))
+      y = 0;
+    return iterator(y, this);
+  }
+
+  const_iterator
+  find(const key_type& x) const
+  {
+    Epoch_guard guard(M_epochs);
+    Base_ptr y = M_bound(x, false);
+    if (y != 0 && M_impl.M_key_compare(x, S_key(y)))
+      y = 0;
+    return const_iterator(y, this);
+  }
+
+  size_type
+  count(const key_type& x) const
+  { return find(x) == end() ? 0 : 1; }
+
+  iterator
+  lower_bound(const key_type& x)
+  {
+    Epoch_guard guard(M_epochs);
+    return iterator(M_bound(x, false), this);
+  }
+
+  const_iterator
+  lower_bound(const key_type& x) const
+  {
+    Epoch_guard guard(M_epochs);
+    return const_iterator(M_bound(x, false), this);
+  }
+
+  iterator
+  upper_bound(const key_type& x)
+  {
+    Epoch_guard guard(M_epochs);
+    return iterator(M_bound(x, true), this);
+  }
+
+  const_iterator
+  upper_bound(const key_type& x) const
+  {
+    Epoch_guard guard(M_epochs);
+    return const_iterator(M_bound(x, true), this);
+  }
+
+  ft::pair<iterator, iterator>
+  equal_range(const key_type& x)
+  { return ft::pair<iterator, iterator>(lower_bound(x), upper_bound(x)); }
+
+  ft::pair<const_iterator, const_iterator>
+  equal_range(const key_type& x) const
+  {
+    return ft::pair<const_iterator, const_iterator>(lower_bound(x),
+                                                    upper_bound(x));
+  }
+};
+
+/**
+ *  @brief  Element-wise comparison; neither %map may be updated meanwhile.
+ */
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator==(const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& x,
+           const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& y)
+{ return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()); }
+
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator<(const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& x,
+          const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& y)
+{
+  return ft::lexicographical_compare(x.begin(), x.end(),
+                                     y.begin(), y.end());
+}
+
+/// Based on operator==
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator!=(const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& x,
+           const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& y)
+{ return !(x == y); }
+
+/// Based on operator<
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator>(const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& x,
+          const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& y)
+{ return y < x; }
+
+/// Based on operator<
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator<=(const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& x,
+           const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& y)
+{ return !(y < x); }
+
+/// Based on operator<
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator>=(const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& x,
+           const concurrent_skiplist_map<Key, Tp, Compare, Alloc>& y)
+{ return !(x < y); }
+
+/// See concurrent_skiplist_map::swap().
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+void
+swap(concurrent_skiplist_map<Key, Tp, Compare, Alloc>& x,
+     concurrent_skiplist_map<Key, Tp, Compare, Alloc>& y)
+{ x.swap(y); }
+
+} // ft
+
+#endif // STL_CONCURRENT_SKIPLIST_MAP_H_
@@ -0,0 +1,466 @@
+// Concurrent stack implementation -*- C++ -*-
+
+/** @file stl_concurrent_stack.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_CONCURRENT_STACK_H_
+#define STL_CONCURRENT_STACK_H_
+
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <pthread.h>
+#include <sched.h>
+
+#include "stl_epoch.h"
+
+
+namespace ft {
+
+/**
+ *  @brief  A lock-free LIFO stack for any number of threads.
+ *
+ *  @ingroup Containers
+ *
+ *  This is Treiber's stack: a singly linked list whose head is moved by
+ *  compare-and-swap.  Popping reads the next link of a node that another
+ *  thread may pop and free meanwhile, and a freed node may come back at
+ *  the same address (the ABA problem).  Both are ruled out by epoch-based
+ *  reclamation: a popper pins an Epoch_domain around its attempt, and
+ *  popped nodes are retired, 64 at a time, to be freed only once no
+ *  attempt that could have seen them is still pinned.  A node therefore
+ *  cannot be reused while anyone might compare against its address.
+ *
+ *  Under heavy contention an elimination array helps: a push or pop whose
+ *  compare-and-swap failed meets a partner of the other kind in a random
+ *  slot, and the two cancel out without touching the head.  It is off
+ *  unless slots are asked for at construction.
+ *
+ *  There is no size(); empty() is a snapshot.  The destructor must not
+ *  run concurrently with anything else.
+ *
+ *  @param  Tp  Type of element.
+ *  @param  Alloc  Allocator type, defaults to allocator<Tp>.
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp> >
+class concurrent_stack
+{
+public:
+  typedef Tp                                  value_type;
+  typedef std::size_t                         size_type;
+  typedef Alloc                               allocator_type;
+
+private:
+  struct Node
+  {
+    value_type    M_value;
+    Node*         M_next;   // Read by stale poppers: atomic accesses only.
+  };
+
+  typedef typename Alloc::template rebind<Node>::other  Node_alloc;
+
+  enum
+  {
+    S_cache_line = 64,
+    S_retire_batch = 64,
+    S_elimination_spins = 128
+  };
+
+  // An offered node, S_taken once a popper has claimed it, or null.
+  struct Exchanger
+  {
+    Node* volatile  M_offer;
+    char            M_pad[S_cache_line - sizeof(Node*)];
+  };
+
+  // Popped nodes handed to the epoch domain together.
+  struct Retired_batch
+  {
+    Node*       M_chain;
+    Node_alloc  M_alloc;
+  };
+
+  char                  M_pad0[S_cache_line];
+  Node* volatile        M_head;
+  char                  M_pad1[S_cache_line - sizeof(Node*)];
+  Node* volatile        M_retired;
+  volatile size_type    M_retired_count;
+  char                  M_pad2[S_cache_line - sizeof(Node*)
+                               - sizeof(size_type)];
+  Exchanger*            M_exchangers;
+  size_type             M_exchanger_count;
+  Node_alloc            M_alloc;
+  mutable Epoch_domain  M_epochs;
+
+  concurrent_stack(const concurrent_stack&);
+  concurrent_stack& operator=(const concurrent_stack&);
+
+  static Node*
+  S_taken()
+  { return reinterpret_cast<Node*>(1); }
+
+  static Node*
+  S_next(Node* n)
+  { return __atomic_load_n(&n->M_next, __ATOMIC_RELAXED); }
+
+  static void
+  S_set_next(Node* n, Node* next)
+  { __atomic_store_n(&n->M_next, next, __ATOMIC_RELAXED); }
+
+  // A slot of the elimination array, varying by thread and by call.
+  size_type
+  M_exchanger_hint() const
+  {
+    static volatile size_type ticket;
+    int local;
+    std::size_t h = reinterpret_cast<std::size_t>(&local) >> 12;
+    h += __atomic_add_fetch(&ticket, size_type(1), __ATOMIC_RELAXED);
+    h *= 2654435761u;
+    h ^= h >> 15;
+    return h % M_exchanger_count;
+  }
+
+  Node*
+  M_create_node(const value_type& x)
+  {
+    Node* n = M_alloc.allocate(1);
+    try
+    {
+      get_allocator().construct(&n->M_value, x);
+    }
+    catch(...)
+    {
+      M_alloc.deallocate(n, 1);
+      throw;
+    }
+    return n;
+  }
+
+  void
+  M_destroy_node(Node* n)
+  {
+    get_allocator().destroy(&n->M_value);
+    M_alloc.deallocate(n, 1);
+  }
+
+  static void
+  S_free_batch(void* p)
+  {
+    Retired_batch* b = static_cast<Retired_batch*>(p);
+    for (Node* n = b->M_chain; n != 0; )
+    {
+      Node* next = n->M_next;
+      b->M_alloc.deallocate(n, 1);
+      n = next;
+    }
+    delete b;
+  }
+
+  // Links first..last, already chained, on top with a single swap.
+  void
+  M_push_chain(Node* first, Node* last)
+  {
+    Node* h = __atomic_load_n(&M_head, __ATOMIC_RELAXED);
+    for (;;)
+    {
+      S_set_next(last, h);
+      if (__atomic_compare_exchange_n(&M_head, &h, first, true,
+                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        return;
+      if (M_exchanger_count != 0 && first == last && M_offer(first))
+        return;
+      h = __atomic_load_n(&M_head, __ATOMIC_RELAXED);
+    }
+  }
+
+  // Offers n to a popper for a while; true if one took it.
+  bool
+  M_offer(Node* n)
+  {
+    Exchanger& e = M_exchangers[M_exchanger_hint()];
+    Node* expected = 0;
+    if (!__atomic_compare_exchange_n(&e.M_offer, &expected, n, false,
+                                     __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+      return false;
+    for (int i = 0; i < S_elimination_spins; ++i)
+    {
+      if (__atomic_load_n(&e.M_offer, __ATOMIC_RELAXED) == S_taken())
+        break;
+      __asm__ __volatile__("" ::: "memory");
+    }
+    expected = n;
+    if (__atomic_compare_exchange_n(&e.M_offer, &expected, (Node*)0, false,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      return false;
+    // Taken: nobody else touches a slot marked so, free it again.
+    __atomic_store_n(&e.M_offer, (Node*)0, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  // A node offered by a pusher, or null.
+  Node*
+  M_take_offer()
+  {
+    Exchanger& e = M_exchangers[M_exchanger_hint()];
+    Node* n = __atomic_load_n(&e.M_offer, __ATOMIC_RELAXED);
+    if (n == 0 || n == S_taken())
+      return 0;
+    if (__atomic_compare_exchange_n(&e.M_offer, &n, S_taken(), false,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+      return n;
+    return 0;
+  }
+
+  // Unlinks the top node, or takes one from the elimination array, in
+  // which case shared is set false: nobody else has seen that node.
+  Node*
+  M_take(bool& shared)
+  {
+    for (;;)
+    {
+      Epoch_guard guard(M_epochs);
+      Node* h = __atomic_load_n(&M_head, __ATOMIC_ACQUIRE);
+      if (h == 0)
+        return 0;
+      if (__atomic_compare_exchange_n(&M_head, &h, S_next(h), false,
+                                      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+      {
+        shared = true;
+        return h;
+      }
+      if (M_exchanger_count != 0)
+        if (Node* n = M_take_offer())
+        {
+          shared = false;
+          return n;
+        }
+    }
+  }
+
+  // Queues a popped node, whose value is destroyed, for reclamation.
+  void
+  M_retire(Node* n)
+  {
+    Node* old = __atomic_load_n(&M_retired, __ATOMIC_RELAXED);
+    do
+      S_set_next(n, old);
+    while (!__atomic_compare_exchange_n(&M_retired, &old, n, true,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    if (__atomic_add_fetch(&M_retired_count, size_type(1), __ATOMIC_RELAXED)
+        % S_retire_batch == 0)
+      M_flush_retired();
+  }
+
+  // Hands the queued nodes to the epoch domain as one batch.  Should
+  // memory run out, they are queued again for a later try.
+  void
+  M_flush_retired()
+  {
+    Node* chain = __atomic_exchange_n(&M_retired, (Node*)0,
+                                      __ATOMIC_ACQUIRE);
+    if (chain == 0)
+      return;
+    Retired_batch* b = new(std::nothrow) Retired_batch;
+    Epoch_retired* r = 0;
+    if (b != 0)
+    {
+      b->M_chain = chain;
+      b->M_alloc = M_alloc;
+      try
+      {
+        r = Epoch_domain::S_make_retired(b, &S_free_batch);
+      }
+      catch(...)
+      {
+        delete b;
+      }
+    }
+    if (r == 0)
+    {
+      Node* last = chain;
+      while (S_next(last) != 0)
+        last = S_next(last);
+      Node* old = __atomic_load_n(&M_retired, __ATOMIC_RELAXED);
+      do
+        S_set_next(last, old);
+      while (!__atomic_compare_exchange_n(&M_retired, &old, chain, true,
+                                          __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED));
+      return;
+    }
+    M_epochs.M_retire(r);
+    M_epochs.M_collect();
+  }
+
+  // Pushes back a taken node after a failed pop.  One that was on the
+  // stack may not go back itself: a stale popper could still mistake it
+  // for the top it saw.  It goes back as a copy.
+  void
+  M_restore(Node* n, bool shared)
+  {
+    if (!shared)
+    {
+      M_push_chain(n, n);
+      return;
+    }
+    Node* copy = 0;
+    try
+    {
+      copy = M_create_node(n->M_value);
+    }
+    catch(...)
+    {
+    }
+    get_allocator().destroy(&n->M_value);
+    M_retire(n);
+    if (copy != 0)
+      M_push_chain(copy, copy);
+  }
+
+public:
+  /**
+   *  @brief  Creates an empty stack.
+   *  @param  elimination  Slots of the elimination array; none by
+   *                       default.  A few per contending thread pair.
+   */
+  explicit
+  concurrent_stack(size_type elimination = 0,
+                   const allocator_type& a = allocator_type())
+  : M_head(0), M_retired(0), M_retired_count(0), M_exchangers(0),
+    M_exchanger_count(0), M_alloc(a)
+  {
+    if (elimination != 0)
+    {
+      M_exchangers = new Exchanger[elimination];
+      for (size_type i = 0; i < elimination; ++i)
+        M_exchangers[i].M_offer = 0;
+      M_exchanger_count = elimination;
+    }
+  }
+
+  ~concurrent_stack()
+  {
+    for (Node* n = M_head; n != 0; )
+    {
+      Node* next = n->M_next;
+      M_destroy_node(n);
+      n = next;
+    }
+    for (Node* n = M_retired; n != 0; )
+    {
+      Node* next = n->M_next;
+      M_alloc.deallocate(n, 1);
+      n = next;
+    }
+    delete[] M_exchangers;
+  }
+
+  allocator_type
+  get_allocator() const
+  { return allocator_type(M_alloc); }
+
+  /**  Returns true if the stack was empty when looked at.  */
+  bool
+  empty() const
+  { return __atomic_load_n(&M_head, __ATOMIC_ACQUIRE) == 0; }
+
+  /**
+   *  @brief  Pushes a copy of @a x.
+   */
+  void
+  push(const value_type& x)
+  {
+    Node* n = M_create_node(x);
+    M_push_chain(n, n);
+  }
+
+  /**
+   *  @brief  Pushes the elements of [first, last) with one swap of the
+   *  head, as if pushed one by one with nothing in between: *(last - 1)
+   *  ends on top.
+   */
+  template <typename InputIterator>
+  void
+  push(InputIterator first, InputIterator last)
+  {
+    Node* top = 0;
+    Node* bottom = 0;
+    try
+    {
+      for (; first != last; ++first)
+      {
+        Node* n = M_create_node(*first);
+        n->M_next = top;
+        top = n;
+        if (bottom == 0)
+          bottom = n;
+      }
+    }
+    catch(...)
+    {
+      while (top != 0)
+      {
+        Node* next = top->M_next;
+        M_destroy_node(top);
+        top = next;
+      }
+      throw;
+    }
+    if (top != 0)
+      M_push_chain(top, bottom);
+  }
+
+  /**
+   *  @brief  Pops the top element into @a x unless the stack is empty.
+   *  @return  True if an element was popped.
+   *
+   *  Should assigning to @a x throw, the element is pushed back, unless
+   *  copying it throws too.
+   */
+  bool
+  try_pop(value_type& x)
+  {
+    bool shared;
+    Node* n = M_take(shared);
+    if (n == 0)
+      return false;
+    try
+    {
+      x = n->M_value;
+    }
+    catch(...)
+    {
+      M_restore(n, shared);
+      throw;
+    }
+    if (shared)
+    {
+      get_allocator().destroy(&n->M_value);
+      M_retire(n);
+    }
+    else
+      M_destroy_node(n);
+    return true;
+  }
+
+  /**
+   *  @brief  Pops the top element into @a x, waiting while the stack is
+   *  empty.
+   */
+  void
+  pop(value_type& x)
+  {
+    for (unsigned round = 0; !try_pop(x); ++round)
+      if (round < 6)
+        for (unsigned i = 0; i < (1u << round); ++i)
+          __asm__ __volatile__("" ::: "memory");
+      else
+        sched_yield();
+  }
+};
+
+} // ft
+
+#endif // STL_CONCURRENT_STACK_H_
@@ -1,6 +1,8 @@
 #ifndef STL_CONSTRUCT_H_
 #define STL_CONSTRUCT_H_
 
+#include <new>
+
 namespace ft {
 
 /**
@@ -20,6 +22,52 @@ Destroy(ForwardIterator first, ForwardIterator last,
     alloc.destroy(&*first);
 }
 
+/**
+ * @if maint
+ * Deferred constructors: each one remembers the arguments for a Tp and
+ * builds it in place when applied to raw storage.  They stand in for
+ * variadic forwarding, so a container can decide first whether an
+ * object is needed at all.
+ * @endif
+ */
+
+template <typename Tp>
+struct Construct_from0
+{
+  void
+  operator()(Tp* p) const
+  { ::new(static_cast<void*>(p)) Tp(); }
+};
+
+template <typename Tp, typename Arg1>
+struct Construct_from1
+{
+  const Arg1& M_arg1;
+
+  explicit
+  Construct_from1(const Arg1& a1)
+  : M_arg1(a1)
+  { }
+
+  void
+  operator()(Tp* p) const
+  { ::new(static_cast<void*>(p)) Tp(M_arg1); }
+};
+
+template <typename Tp, typename Arg1, typename Arg2>
+struct Construct_from2
+{
+  const Arg1& M_arg1;
+  const Arg2& M_arg2;
+
+  Construct_from2(const Arg1& a1, const Arg2& a2)
+  : M_arg1(a1), M_arg2(a2)
+  { }
+
+  void
+  operator()(Tp* p) const
+  { ::new(static_cast<void*>(p)) Tp(M_arg1, M_arg2); }
+};
 
 } // ft
 #endif // STL_CONSTRUCT_H_
\ No newline at end of file
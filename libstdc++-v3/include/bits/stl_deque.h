@@ -0,0 +1,1351 @@
+// Deque implementation -*- C++ -*-
+
+/** @file stl_deque.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_DEQUE_H_
+#define STL_DEQUE_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include "cpp_type_traits.h"
+#include "stl_iterator.h"
+#include "stl_algobase.h"
+
+namespace ft {
+
+/**
+ *  @if maint
+ *  Elements per block of a deque: @a BlockSize if it is not zero,
+ *  otherwise as many as fit in 4096 bytes, but never fewer than 16.
+ *  @endif
+ */
+template <typename Tp, std::size_t BlockSize>
+struct Deque_block
+{
+  static const std::size_t value = BlockSize != 0 ? BlockSize
+    : sizeof(Tp) < 4096 / 16 ? 4096 / sizeof(Tp) : 16;
+};
+
+/**
+ *  @brief A deque::iterator.
+ *
+ *  An element pointer together with the bounds of its block and the
+ *  block's slot in the map, so that stepping within a block is a
+ *  pointer increment.
+ */
+template <typename Tp, typename Ref, typename Ptr, std::size_t Block>
+struct Deque_iterator
+{
+  typedef Deque_iterator<Tp, Tp&, Tp*, Block>              iterator;
+  typedef Deque_iterator<Tp, const Tp&, const Tp*, Block>  const_iterator;
+  typedef Deque_iterator                                   Self;
+  typedef Tp**                                             Map_pointer;
+
+  typedef std::random_access_iterator_tag  iterator_category;
+  typedef Tp                               value_type;
+  typedef Ptr                              pointer;
+  typedef Ref                              reference;
+  typedef std::ptrdiff_t                   difference_type;
+
+  Tp*         M_cur;
+  Tp*         M_first;
+  Tp*         M_last;
+  Map_pointer M_node;
+
+  Deque_iterator()
+  : M_cur(0), M_first(0), M_last(0), M_node(0) { }
+
+  Deque_iterator(Tp* x, Map_pointer y)
+  : M_cur(x), M_first(*y), M_last(*y + Block), M_node(y) { }
+
+  // iterator to const_iterator.  A template, so that it is never taken
+  // for the copy constructor and the copy operations stay implicit.
+  template <typename Ref2>
+  Deque_iterator(const Deque_iterator<Tp, Ref2,
+                 typename ft::enable_if<ft::are_same<Ref2, Tp&>::value,
+                                        Tp*>::type, Block>& x)
+  : M_cur(x.M_cur), M_first(x.M_first), M_last(x.M_last),
+    M_node(x.M_node) { }
+
+  reference
+  operator*() const
+  { return *M_cur; }
+
+  pointer
+  operator->() const
+  { return M_cur; }
+
+  Self&
+  operator++()
+  {
+    ++M_cur;
+    if (M_cur == M_last)
+    {
+      M_set_node(M_node + 1);
+      M_cur = M_first;
+    }
+    return *this;
+  }
+
+  Self
+  operator++(int)
+  {
+    Self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  Self&
+  operator--()
+  {
+    if (M_cur == M_first)
+    {
+      M_set_node(M_node - 1);
+      M_cur = M_last;
+    }
+    --M_cur;
+    return *this;
+  }
+
+  Self
+  operator--(int)
+  {
+    Self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  Self&
+  operator+=(difference_type n)
+  {
+    const difference_type block = Block;
+    const difference_type offset = n + (M_cur - M_first);
+    if (offset >= 0 && offset < block)
+      M_cur += n;
+    else
+    {
+      const difference_type node_offset = offset > 0
+        ? offset / block : -((-offset - 1) / block) - 1;
+      M_set_node(M_node + node_offset);
+      M_cur = M_first + (offset - node_offset * block);
+    }
+    return *this;
+  }
+
+  Self&
+  operator-=(difference_type n)
+  { return *this += -n; }
+
+  Self
+  operator+(difference_type n) const
+  {
+    Self tmp = *this;
+    return tmp += n;
+  }
+
+  Self
+  operator-(difference_type n) const
+  {
+    Self tmp = *this;
+    return tmp -= n;
+  }
+
+  reference
+  operator[](difference_type n) const
+  { return *(*this + n); }
+
+  // Moves to another block, leaving M_cur for the caller to set.
+  void
+  M_set_node(Map_pointer new_node)
+  {
+    M_node = new_node;
+    M_first = *new_node;
+    M_last = M_first + difference_type(Block);
+  }
+};
+
+// Comparisons take mixed const and non-const iterators, as
+// ft::normal_iterator's do.
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR, std::size_t Block>
+inline bool
+operator==(const Deque_iterator<Tp, RefL, PtrL, Block>& x,
+           const Deque_iterator<Tp, RefR, PtrR, Block>& y)
+{ return x.M_cur == y.M_cur; }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR, std::size_t Block>
+inline bool
+operator!=(const Deque_iterator<Tp, RefL, PtrL, Block>& x,
+           const Deque_iterator<Tp, RefR, PtrR, Block>& y)
+{ return !(x == y); }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR, std::size_t Block>
+inline bool
+operator<(const Deque_iterator<Tp, RefL, PtrL, Block>& x,
+          const Deque_iterator<Tp, RefR, PtrR, Block>& y)
+{
+  return x.M_node == y.M_node ? x.M_cur < y.M_cur
+                              : x.M_node < y.M_node;
+}
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR, std::size_t Block>
+inline bool
+operator>(const Deque_iterator<Tp, RefL, PtrL, Block>& x,
+          const Deque_iterator<Tp, RefR, PtrR, Block>& y)
+{ return y < x; }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR, std::size_t Block>
+inline bool
+operator<=(const Deque_iterator<Tp, RefL, PtrL, Block>& x,
+           const Deque_iterator<Tp, RefR, PtrR, Block>& y)
+{ return !(y < x); }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR, std::size_t Block>
+inline bool
+operator>=(const Deque_iterator<Tp, RefL, PtrL, Block>& x,
+           const Deque_iterator<Tp, RefR, PtrR, Block>& y)
+{ return !(x < y); }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR, std::size_t Block>
+inline std::ptrdiff_t
+operator-(const Deque_iterator<Tp, RefL, PtrL, Block>& x,
+          const Deque_iterator<Tp, RefR, PtrR, Block>& y)
+{
+  return std::ptrdiff_t(Block) * (x.M_node - y.M_node - 1)
+    + (x.M_cur - x.M_first) + (y.M_last - y.M_cur);
+}
+
+template <typename Tp, typename Ref, typename Ptr, std::size_t Block>
+inline Deque_iterator<Tp, Ref, Ptr, Block>
+operator+(std::ptrdiff_t n, const Deque_iterator<Tp, Ref, Ptr, Block>& x)
+{ return x + n; }
+
+/**
+ *  @brief A standard container using fixed-size memory allocation and
+ *  constant-time manipulation of elements at either end.
+ *
+ *  @ingroup Containers
+ *  @ingroup Sequences
+ *
+ *  Meets the requirements of a container, a reversible container and a
+ *  sequence, including the optional sequence requirements.
+ *
+ *  Elements are kept in blocks of Deque_block<Tp, BlockSize>::value
+ *  elements; the third template parameter sets that count, and the
+ *  default of zero picks about 4KB per block.  A map of block pointers,
+ *  with the used part kept in its middle, strings the blocks together.
+ *  When one end of the map runs out while the map is at most half
+ *  used, the used part is recentred in place rather than the map being
+ *  reallocated.  Elements are never moved by push_back or push_front,
+ *  so references to them stay valid; iterators do not.
+ *
+ *  A few blocks freed by pop_front, pop_back or erase are kept and
+ *  handed out again, so a deque used as a FIFO, or one that hovers
+ *  around a block boundary, settles into allocating nothing.
+ *  shrink_to_fit releases them.
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp>,
+          std::size_t BlockSize = 0>
+class deque
+{
+  enum { S_block = Deque_block<Tp, BlockSize>::value };
+  enum { S_initial_map_size = 8, S_spare_blocks = 4 };
+
+  typedef typename Alloc::template rebind<Tp>::other   Tp_alloc_type;
+  typedef typename Alloc::template rebind<Tp*>::other  Map_alloc_type;
+  typedef Tp**                                         Map_pointer;
+
+public:
+  typedef Tp                                           value_type;
+  typedef typename Tp_alloc_type::pointer              pointer;
+  typedef typename Tp_alloc_type::const_pointer        const_pointer;
+  typedef typename Tp_alloc_type::reference            reference;
+  typedef typename Tp_alloc_type::const_reference      const_reference;
+  typedef Deque_iterator<Tp, Tp&, Tp*, S_block>        iterator;
+  typedef Deque_iterator<Tp, const Tp&, const Tp*, S_block>
+                                                       const_iterator;
+  typedef ft::reverse_iterator<const_iterator>         const_reverse_iterator;
+  typedef ft::reverse_iterator<iterator>               reverse_iterator;
+  typedef std::size_t                                  size_type;
+  typedef std::ptrdiff_t                               difference_type;
+  typedef Alloc                                        allocator_type;
+
+private:
+  Tp_alloc_type M_alloc;
+  Map_pointer   M_map;
+  size_type     M_map_size;
+  iterator      M_start;
+  iterator      M_finish;
+  Tp*           M_spare[S_spare_blocks];   // Freed blocks kept for reuse.
+  size_type     M_spares;
+
+public:
+  /**
+   * @brief Default constructor creates no elements.
+   */
+  explicit
+  deque(const allocator_type& a = allocator_type())
+  : M_alloc(a), M_map(0), M_map_size(0), M_spares(0)
+  { M_initialize_map(0); }
+
+  /**
+   * @brief Create a %deque with copies of an exemplar element.
+   * @param n The number of elements to initially create.
+   * @param value An element to copy.
+   *
+   * This constructor fills the %deque with @a n copies of @a value.
+   */
+  explicit
+  deque(size_type n, const value_type& value = value_type(),
+        const allocator_type& a = allocator_type())
+  : M_alloc(a), M_map(0), M_map_size(0), M_spares(0)
+  { M_fill_initialize(n, value); }
+
+  /**
+   * @brief %Deque copy constructor.
+   * @param x A %deque of identical element and allocator types.
+   */
+  deque(const deque& x)
+  : M_alloc(x.M_alloc), M_map(0), M_map_size(0), M_spares(0)
+  { M_range_initialize(x.begin(), x.end()); }
+
+  /**
+   * @brief Builds a %deque from a range.
+   * @param first An input iterator.
+   * @param last An input iterator.
+   *
+   * Create a %deque consisting of copies of the elements from
+   * [first,last).
+   */
+  template <typename InputIterator>
+  deque(InputIterator first, InputIterator last,
+        const allocator_type& a = allocator_type())
+  : M_alloc(a), M_map(0), M_map_size(0), M_spares(0)
+  {
+    // Check whether it's an integral type. If so, it's not an iterator.
+    typedef typename ft::is_integer<InputIterator>::type Integral;
+    M_initialize_dispatch(first, last, Integral());
+  }
+
+  /**
+   * The dtor only erases the elements, and note that if the elements
+   * themselves are pointers, the pointed-to memory is not touched in
+   * any way. Managing the pointer is the user's responsibilty.
+   */
+  ~deque()
+  {
+    M_erase_at_end(begin());
+    M_deallocate_storage();
+  }
+
+  /**
+   * @brief %Deque assignment operator.
+   * @param x A %deque of identical element and allocator types.
+   *
+   * All the elements of @a x are copied, but unlike the copy
+   * constructor, the allocator object is not copied.
+   */
+  deque&
+  operator=(const deque& x)
+  {
+    if (&x != this)
+    {
+      const size_type len = size();
+      if (len >= x.size())
+        M_erase_at_end(std::copy(x.begin(), x.end(), begin()));
+      else
+      {
+        const_iterator mid = x.begin() + difference_type(len);
+        std::copy(x.begin(), mid, begin());
+        insert(end(), mid, x.end());
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Assigns a given value to a %deque.
+   * @param n Number of elements to be assigned.
+   * @param val Value to be assigned.
+   *
+   * This function fills a %deque with @a n copies of the given value.
+   * Note that the assignment completely changes the %deque and that the
+   * resulting %deque's size is the same as the number of elements
+   * assigned. Old data may be lost.
+   */
+  void
+  assign(size_type n, const value_type& val)
+  { M_fill_assign(n, val); }
+
+  /**
+   * @brief Assigns a range to a %deque.
+   * @param first An input iterator.
+   * @param last An input iterator.
+   *
+   * This function fills a %deque with copies of the elements in the
+   * range [first,last).
+   */
+  template <typename InputIterator>
+  void
+  assign(InputIterator first, InputIterator last)
+  {
+    typedef typename ft::is_integer<InputIterator>::type Integral;
+    M_assign_dispatch(first, last, Integral());
+  }
+
+  /// Get a copy of the memory allocation object.
+  allocator_type
+  get_allocator() const
+  { return allocator_type(M_alloc); }
+
+  // iterators
+  /**
+   * Returns a read/write iterator that points to the first element in
+   * the %deque. Iteration is done in ordinary element order.
+   */
+  iterator
+  begin()
+  { return M_start; }
+
+  /**
+   * Returns a read-only (constant) iterator that points to the first
+   * element in the %deque. Iteration is done in ordinary element order.
+   */
+  const_iterator
+  begin() const
+  { return M_start; }
+
+  /**
+   * Returns a read/write iterator that points one past the last element
+   * in the %deque. Iteration is done in ordinary element order.
+   */
+  iterator
+  end()
+  { return M_finish; }
+
+  /**
+   * Returns a read-only (constant) iterator that points one past the last
+   * element in the %deque. Iteration is done in ordinary element order.
+   */
+  const_iterator
+  end() const
+  { return M_finish; }
+
+  /**
+   * Returns a read/write reverse iterator that points to the last element
+   * in the %deque. Iteration is done in reverse element order.
+   */
+  reverse_iterator
+  rbegin()
+  { return reverse_iterator(end()); }
+
+  /**
+   * Returns a read-only (constant) reverse iterator that points to the
+   * last element in the %deque. Iteration is done in reverse element
+   * order.
+   */
+  const_reverse_iterator
+  rbegin() const
+  { return const_reverse_iterator(end()); }
+
+  /**
+   * Returns a read/write reverse iterator that points to one before the
+   * first element in the %deque. Iteration is done in reverse element
+   * order.
+   */
+  reverse_iterator
+  rend()
+  { return reverse_iterator(begin()); }
+
+  /**
+   * Returns a read-only (constant) reverse iterator that points to one
+   * before the first element in the %deque. Iteration is done in reverse
+   * element order.
+   */
+  const_reverse_iterator
+  rend() const
+  { return const_reverse_iterator(begin()); }
+
+  // capacity
+  /**  Returns the number of elements in the %deque.  */
+  size_type
+  size() const
+  { return M_finish - M_start; }
+
+  /**  Returns the size() of the largest possible %deque.  */
+  size_type
+  max_size() const
+  { return M_alloc.max_size(); }
+
+  /**
+   * @brief Resizes the %deque to the specified number of elements.
+   * @param new_size Number of elements the %deque should contain.
+   * @param x Data with which new elements should be populated.
+   *
+   * This function will %resize the %deque to the specified number of
+   * elements. If the number is smaller than the %deque's current size
+   * the %deque is truncated, otherwise the %deque is extended and new
+   * elements are populated with given data.
+   */
+  void
+  resize(size_type new_size, value_type x = value_type())
+  {
+    const size_type len = size();
+    if (new_size < len)
+      M_erase_at_end(M_start + difference_type(new_size));
+    else
+      insert(M_finish, new_size - len, x);
+  }
+
+  /**
+   * Returns true if the %deque is empty. (Thus begin() would equal
+   * end().)
+   */
+  bool
+  empty() const
+  { return M_finish == M_start; }
+
+  /**
+   * Frees the blocks kept for reuse. The elements and the map are left
+   * alone.
+   */
+  void
+  shrink_to_fit()
+  {
+    while (M_spares != 0)
+      M_alloc.deallocate(M_spare[--M_spares], S_block);
+  }
+
+  // element access
+  /**
+   * @brief Subscript access to the data contained in the %deque.
+   * @param n The index of the element for which data should be accessed.
+   * @return Read/write reference to data.
+   *
+   * This operator allows for easy, array-style, data access.
+   * Note that data access with this operator is unchecked and
+   * out_of_range lookups are not defined. (For checked lookups
+   * see at().)
+   */
+  reference
+  operator[](size_type n)
+  { return M_start[difference_type(n)]; }
+
+  /**
+   * @brief Subscript access to the data contained in the %deque.
+   * @param n The index of the element for which data should be accessed.
+   * @return Read-only (constant) reference to data.
+   *
+   * This operator allows for easy, array-style, data access.
+   * Note that data access with this operator is unchecked and
+   * out_of_range lookups are not defined. (For checked lookups
+   * see at().)
+   */
+  const_reference
+  operator[](size_type n) const
+  { return M_start[difference_type(n)]; }
+
+protected:
+  /// @if maint Safety check used only from at().  The message is
+  /// worded as libstdc++'s, so the two are interchangeable in output.
+  /// @endif
+  void
+  M_range_check(size_type n) const
+  {
+    if (n >= this->size())
+    {
+      char what[128];
+      std::sprintf(what, "deque::_M_range_check: __n (which is %lu)>= "
+                   "this->size() (which is %lu)",
+                   static_cast<unsigned long>(n),
+                   static_cast<unsigned long>(this->size()));
+      throw std::out_of_range(what);
+    }
+  }
+
+public:
+  /**
+   * @brief Provides access to the data contained in the %deque.
+   * @param n The index of the element for which data should be accessed.
+   * @return Read/write reference to data.
+   * @throw std::out_of_range If @a n is an invalid index.
+   *
+   * This function provides for safer data access. The parameter is
+   * first checked that it is in the range of the deque. The function
+   * throws out_of_range if the check fails.
+   */
+  reference
+  at(size_type n)
+  {
+    M_range_check(n);
+    return (*this)[n];
+  }
+
+  /**
+   * @brief Provides access to the data contained in the %deque.
+   * @param n The index of the element for which data should be accessed.
+   * @return Read-only (constant) reference to data.
+   * @throw std::out_of_range If @a n is an invalid index.
+   *
+   * This function provides for safer data access. The parameter is
+   * first checked that it is in the range of the deque. The function
+   * throws out_of_range if the check fails.
+   */
+  const_reference
+  at(size_type n) const
+  {
+    M_range_check(n);
+    return (*this)[n];
+  }
+
+  /**
+   * Returns a read/write reference to the data at the first element of
+   * the %deque.
+   */
+  reference
+  front()
+  { return *M_start; }
+
+  /**
+   * Returns a read-only (constant) reference to the data at the first
+   * element of the %deque.
+   */
+  const_reference
+  front() const
+  { return *M_start; }
+
+  /**
+   * Returns a read/write reference to the data at the last element of
+   * the %deque.
+   */
+  reference
+  back()
+  {
+    iterator tmp = M_finish;
+    --tmp;
+    return *tmp;
+  }
+
+  /**
+   * Returns a read-only (constant) reference to the data at the last
+   * element of the %deque.
+   */
+  const_reference
+  back() const
+  {
+    const_iterator tmp = M_finish;
+    --tmp;
+    return *tmp;
+  }
+
+  // modifiers
+  /**
+   * @brief Add data to the front of the %deque.
+   * @param x Data to be added.
+   *
+   * This is a typical stack operation. The function creates an element
+   * at the front of the %deque and assigns the given data to it. Due to
+   * the nature of a %deque this operation can be done in constant time.
+   */
+  void
+  push_front(const value_type& x)
+  {
+    if (M_start.M_cur != M_start.M_first)
+    {
+      M_alloc.construct(M_start.M_cur - 1, x);
+      --M_start.M_cur;
+    }
+    else
+      M_push_front_aux(x);
+  }
+
+  /**
+   * @brief Add data to the end of the %deque.
+   * @param x Data to be added.
+   *
+   * This is a typical stack operation. The function creates an element
+   * at the end of the %deque and assigns the given data to it. Due to
+   * the nature of a %deque this operation can be done in constant time.
+   */
+  void
+  push_back(const value_type& x)
+  {
+    if (M_finish.M_cur != M_finish.M_last - 1)
+    {
+      M_alloc.construct(M_finish.M_cur, x);
+      ++M_finish.M_cur;
+    }
+    else
+      M_push_back_aux(x);
+  }
+
+  /**
+   * @brief Removes first element.
+   *
+   * This is a typical stack operation. It shrinks the %deque by one.
+   *
+   * Note that no data is returned, and if the first element's data is
+   * needed, it should be retrieved before pop_front() is called.
+   */
+  void
+  pop_front()
+  {
+    M_alloc.destroy(M_start.M_cur);
+    if (M_start.M_cur != M_start.M_last - 1)
+      ++M_start.M_cur;
+    else
+    {
+      M_deallocate_node(M_start.M_first);
+      M_start.M_set_node(M_start.M_node + 1);
+      M_start.M_cur = M_start.M_first;
+    }
+  }
+
+  /**
+   * @brief Removes last element.
+   *
+   * This is a typical stack operation. It shrinks the %deque by one.
+   *
+   * Note that no data is returned, and if the last element's data is
+   * needed, it should be retrieved before pop_back() is called.
+   */
+  void
+  pop_back()
+  {
+    if (M_finish.M_cur == M_finish.M_first)
+    {
+      M_deallocate_node(M_finish.M_first);
+      M_finish.M_set_node(M_finish.M_node - 1);
+      M_finish.M_cur = M_finish.M_last;
+    }
+    --M_finish.M_cur;
+    M_alloc.destroy(M_finish.M_cur);
+  }
+
+  /**
+   * @brief Inserts given value into %deque before specified iterator.
+   * @param position An iterator into the %deque.
+   * @param x Data to be inserted.
+   * @return An iterator that points to the inserted data.
+   *
+   * This function will insert a copy of the given value before the
+   * specified location. The elements on the shorter side of
+   * @a position are shifted.
+   */
+  iterator
+  insert(iterator position, const value_type& x)
+  {
+    if (position.M_cur == M_start.M_cur)
+    {
+      push_front(x);
+      return M_start;
+    }
+    else if (position.M_cur == M_finish.M_cur)
+    {
+      push_back(x);
+      iterator tmp = M_finish;
+      --tmp;
+      return tmp;
+    }
+    else
+      return M_insert_aux(position, x);
+  }
+
+  /**
+   * @brief Inserts a number of copies of given data into the %deque.
+   * @param position An iterator into the %deque.
+   * @param n Number of elements to be inserted.
+   * @param x Data to be inserted.
+   *
+   * This function will insert a specified number of copies of the given
+   * data before the location specified by @a position.
+   */
+  void
+  insert(iterator position, size_type n, const value_type& x)
+  { M_fill_insert(position, n, x); }
+
+  /**
+   * @brief Inserts a range into the %deque.
+   * @param position An iterator into the %deque.
+   * @param first An input iterator.
+   * @param last An input iterator.
+   *
+   * This function will insert copies of the data in the range
+   * [first,last) into the %deque before the location specified by
+   * @a position.
+   */
+  template <typename InputIterator>
+  void
+  insert(iterator position, InputIterator first, InputIterator last)
+  {
+    // Check whether it's an integral type. If so, it's not an iterator.
+    typedef typename ft::is_integer<InputIterator>::type Integral;
+    M_insert_dispatch(position, first, last, Integral());
+  }
+
+  /**
+   * @brief Remove element at given position.
+   * @param position Iterator pointing to element to be erased.
+   * @return An iterator pointing to the next element (or end()).
+   *
+   * This function will erase the element at the given position and thus
+   * shorten the %deque by one. The elements on the shorter side of
+   * @a position are shifted.
+   */
+  iterator
+  erase(iterator position)
+  {
+    iterator next = position;
+    ++next;
+    const difference_type index = position - M_start;
+    if (size_type(index) < size() / 2)
+    {
+      std::copy_backward(M_start, position, next);
+      pop_front();
+    }
+    else
+    {
+      std::copy(next, M_finish, position);
+      pop_back();
+    }
+    return M_start + index;
+  }
+
+  /**
+   * @brief Remove a range of elements.
+   * @param first Iterator pointing to the first element to be erased.
+   * @param last Iterator pointing to one past the last element to be
+   * erased.
+   * @return An iterator pointing to the element pointed to by @a last
+   * prior to erasing (or end()).
+   *
+   * This function will erase the elements in the range [first,last)
+   * and shorten the %deque accordingly.
+   */
+  iterator
+  erase(iterator first, iterator last)
+  {
+    if (first == M_start && last == M_finish)
+    {
+      clear();
+      return M_finish;
+    }
+    const difference_type n = last - first;
+    const difference_type elems_before = first - M_start;
+    if (size_type(elems_before) < (size() - n) / 2)
+    {
+      std::copy_backward(M_start, first, last);
+      M_erase_at_begin(M_start + n);
+    }
+    else
+      M_erase_at_end(std::copy(last, M_finish, first));
+    return M_start + elems_before;
+  }
+
+  /**
+   * @brief Swaps data with another %deque.
+   * @param x A %deque of the same element and allocator types.
+   *
+   * This exchanges the elements between two deques in constant time.
+   */
+  void
+  swap(deque& x)
+  {
+    std::swap(M_map, x.M_map);
+    std::swap(M_map_size, x.M_map_size);
+    std::swap(M_start, x.M_start);
+    std::swap(M_finish, x.M_finish);
+    for (size_type i = 0; i < S_spare_blocks; ++i)
+      std::swap(M_spare[i], x.M_spare[i]);
+    std::swap(M_spares, x.M_spares);
+  }
+
+  /**
+   * Erases all the elements. Note that this function only erases the
+   * elements, and that if the elements themselves are pointers, the
+   * pointed-to memory is not touched in any way. Managing the pointer is
+   * the user's responsibilty.
+   */
+  void
+  clear()
+  { M_erase_at_end(M_start); }
+
+private:
+  // Internal constructor functions follow.
+
+  // Called by the range constructor to implement [23.1.1]/9
+  template <typename Integer>
+  void
+  M_initialize_dispatch(Integer n, Integer x, __true_type)
+  { M_fill_initialize(static_cast<size_type>(n), x); }
+
+  // Called by the range constructor to implement [23.1.1]/9
+  template <typename InputIterator>
+  void
+  M_initialize_dispatch(InputIterator first, InputIterator last,
+                        __false_type)
+  { M_range_initialize(first, last); }
+
+  void
+  M_fill_initialize(size_type n, const value_type& value)
+  {
+    M_initialize_map(n);
+    iterator cur = M_start;
+    try
+    {
+      for (; cur != M_finish; ++cur)
+        M_alloc.construct(cur.M_cur, value);
+    }
+    catch(...)
+    {
+      for (iterator i = M_start; i != cur; ++i)
+        M_alloc.destroy(i.M_cur);
+      M_deallocate_storage();
+      throw;
+    }
+  }
+
+  template <typename InputIterator>
+  void
+  M_range_initialize(InputIterator first, InputIterator last)
+  {
+    M_initialize_map(0);
+    try
+    {
+      for (; first != last; ++first)
+        push_back(*first);
+    }
+    catch(...)
+    {
+      M_erase_at_end(M_start);
+      M_deallocate_storage();
+      throw;
+    }
+  }
+
+  // Allocates a map with room to grow either way and enough blocks for
+  // num_elements, and points M_start and M_finish at them.
+  void
+  M_initialize_map(size_type num_elements)
+  {
+    const size_type num_nodes = num_elements / S_block + 1;
+    M_map_size = std::max(size_type(S_initial_map_size), num_nodes + 2);
+    M_map = Map_alloc_type(M_alloc).allocate(M_map_size);
+    Map_pointer nstart = M_map + (M_map_size - num_nodes) / 2;
+    Map_pointer nfinish = nstart + num_nodes;
+    Map_pointer cur = nstart;
+    try
+    {
+      for (; cur < nfinish; ++cur)
+        *cur = M_alloc.allocate(S_block);
+    }
+    catch(...)
+    {
+      while (cur != nstart)
+        M_alloc.deallocate(*--cur, S_block);
+      Map_alloc_type(M_alloc).deallocate(M_map, M_map_size);
+      M_map = 0;
+      throw;
+    }
+    M_start.M_set_node(nstart);
+    M_finish.M_set_node(nfinish - 1);
+    M_start.M_cur = M_start.M_first;
+    M_finish.M_cur = M_finish.M_first + num_elements % S_block;
+  }
+
+  // Frees the blocks from M_start to M_finish, the spare blocks and the
+  // map; the elements must already be destroyed.
+  void
+  M_deallocate_storage()
+  {
+    for (Map_pointer n = M_start.M_node; n <= M_finish.M_node; ++n)
+      M_alloc.deallocate(*n, S_block);
+    shrink_to_fit();
+    Map_alloc_type(M_alloc).deallocate(M_map, M_map_size);
+    M_map = 0;
+  }
+
+  // Internal assign functions follow.
+
+  // Called by the range assign to implement [23.1.1]/9
+  template <typename Integer>
+  void
+  M_assign_dispatch(Integer n, Integer val, __true_type)
+  {
+    M_fill_assign(static_cast<size_type>(n),
+                  static_cast<value_type>(val));
+  }
+
+  // Called by the range assign to implement [23.1.1]/9
+  template <typename InputIterator>
+  void
+  M_assign_dispatch(InputIterator first, InputIterator last,
+                    __false_type)
+  {
+    iterator cur = M_start;
+    for (; first != last && cur != M_finish; ++cur, ++first)
+      *cur = *first;
+    if (first == last)
+      M_erase_at_end(cur);
+    else
+      insert(M_finish, first, last);
+  }
+
+  void
+  M_fill_assign(size_type n, const value_type& val)
+  {
+    if (n > size())
+    {
+      std::fill(M_start, M_finish, val);
+      insert(M_finish, n - size(), val);
+    }
+    else
+    {
+      M_erase_at_end(M_start + difference_type(n));
+      std::fill(M_start, M_finish, val);
+    }
+  }
+
+  // Internal insert functions follow.
+
+  // Called by the range insert to implement [23.1.1]/9
+  template <typename Integer>
+  void
+  M_insert_dispatch(iterator pos, Integer n, Integer x, __true_type)
+  {
+    M_fill_insert(pos, static_cast<size_type>(n),
+                  static_cast<value_type>(x));
+  }
+
+  // Called by the range insert to implement [23.1.1]/9.  The new
+  // elements are pushed on the end nearer to @a pos, then rotated into
+  // place, so only the shorter side moves.
+  template <typename InputIterator>
+  void
+  M_insert_dispatch(iterator pos, InputIterator first,
+                    InputIterator last, __false_type)
+  {
+    const difference_type index = pos - M_start;
+    size_type pushed = 0;
+    if (size_type(index) < size() / 2)
+    {
+      try
+      {
+        for (; first != last; ++first, ++pushed)
+          push_front(*first);
+      }
+      catch(...)
+      {
+        M_erase_at_begin(M_start + difference_type(pushed));
+        throw;
+      }
+      const iterator mid = M_start + difference_type(pushed);
+      std::reverse(M_start, mid);
+      std::rotate(M_start, mid, mid + index);
+    }
+    else
+    {
+      const difference_type old_size = size();
+      try
+      {
+        for (; first != last; ++first, ++pushed)
+          push_back(*first);
+      }
+      catch(...)
+      {
+        M_erase_at_end(M_start + old_size);
+        throw;
+      }
+      std::rotate(M_start + index, M_start + old_size, M_finish);
+    }
+  }
+
+  // Called by insert(p,n,x), and the range insert when it turns out to
+  // be the same thing.
+  void
+  M_fill_insert(iterator pos, size_type n, const value_type& x)
+  {
+    const difference_type index = pos - M_start;
+    size_type pushed = 0;
+    if (size_type(index) < size() / 2)
+    {
+      try
+      {
+        for (; pushed < n; ++pushed)
+          push_front(x);
+      }
+      catch(...)
+      {
+        M_erase_at_begin(M_start + difference_type(pushed));
+        throw;
+      }
+      const iterator mid = M_start + difference_type(n);
+      std::rotate(M_start, mid, mid + index);
+    }
+    else
+    {
+      const difference_type old_size = size();
+      try
+      {
+        for (; pushed < n; ++pushed)
+          push_back(x);
+      }
+      catch(...)
+      {
+        M_erase_at_end(M_start + old_size);
+        throw;
+      }
+      std::rotate(M_start + index, M_start + old_size, M_finish);
+    }
+  }
+
+  // Called by insert(p,x) away from both ends: grows the shorter side
+  // by one and shifts it towards the gap.
+  iterator
+  M_insert_aux(iterator pos, const value_type& x)
+  {
+    const value_type x_copy = x;
+    const difference_type index = pos - M_start;
+    if (size_type(index) < size() / 2)
+    {
+      push_front(front());
+      iterator front1 = M_start;
+      ++front1;
+      iterator front2 = front1;
+      ++front2;
+      pos = M_start + index;
+      iterator pos1 = pos;
+      ++pos1;
+      std::copy(front2, pos1, front1);
+    }
+    else
+    {
+      push_back(back());
+      iterator back1 = M_finish;
+      --back1;
+      iterator back2 = back1;
+      --back2;
+      pos = M_start + index;
+      std::copy_backward(pos, back2, back1);
+    }
+    *pos = x_copy;
+    return pos;
+  }
+
+  // Internal erase functions follow.
+
+  // Destroys [M_start, pos) and frees the blocks before pos's.
+  void
+  M_erase_at_begin(iterator pos)
+  {
+    for (iterator i = M_start; i != pos; ++i)
+      M_alloc.destroy(i.M_cur);
+    for (Map_pointer n = M_start.M_node; n < pos.M_node; ++n)
+      M_deallocate_node(*n);
+    M_start = pos;
+  }
+
+  // Destroys [pos, M_finish) and frees the blocks after pos's.
+  void
+  M_erase_at_end(iterator pos)
+  {
+    for (iterator i = pos; i != M_finish; ++i)
+      M_alloc.destroy(i.M_cur);
+    for (Map_pointer n = pos.M_node + 1; n <= M_finish.M_node; ++n)
+      M_deallocate_node(*n);
+    M_finish = pos;
+  }
+
+  // Internal block and map functions follow.
+
+  // Called by push_back when the last block is full.
+  void
+  M_push_back_aux(const value_type& x)
+  {
+    M_reserve_map_at_back();
+    *(M_finish.M_node + 1) = M_allocate_node();
+    try
+    {
+      M_alloc.construct(M_finish.M_cur, x);
+    }
+    catch(...)
+    {
+      M_deallocate_node(*(M_finish.M_node + 1));
+      throw;
+    }
+    M_finish.M_set_node(M_finish.M_node + 1);
+    M_finish.M_cur = M_finish.M_first;
+  }
+
+  // Called by push_front when the first block is full.
+  void
+  M_push_front_aux(const value_type& x)
+  {
+    M_reserve_map_at_front();
+    *(M_start.M_node - 1) = M_allocate_node();
+    try
+    {
+      M_alloc.construct(*(M_start.M_node - 1) + (S_block - 1), x);
+    }
+    catch(...)
+    {
+      M_deallocate_node(*(M_start.M_node - 1));
+      throw;
+    }
+    M_start.M_set_node(M_start.M_node - 1);
+    M_start.M_cur = M_start.M_last - 1;
+  }
+
+  void
+  M_reserve_map_at_back(size_type nodes_to_add = 1)
+  {
+    if (nodes_to_add + 1 > M_map_size - (M_finish.M_node - M_map))
+      M_reallocate_map(nodes_to_add, false);
+  }
+
+  void
+  M_reserve_map_at_front(size_type nodes_to_add = 1)
+  {
+    if (nodes_to_add > size_type(M_start.M_node - M_map))
+      M_reallocate_map(nodes_to_add, true);
+  }
+
+  // Makes room for nodes_to_add more block pointers at one end of the
+  // map.  While at most half the map would be in use, the used part is
+  // slid back to the middle; only otherwise is a larger map allocated.
+  // Either way only block pointers move, never elements.
+  void
+  M_reallocate_map(size_type nodes_to_add, bool add_at_front)
+  {
+    const size_type old_num_nodes = M_finish.M_node - M_start.M_node + 1;
+    const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+    Map_pointer new_nstart;
+    if (M_map_size > 2 * new_num_nodes)
+    {
+      new_nstart = M_map + (M_map_size - new_num_nodes) / 2
+        + (add_at_front ? nodes_to_add : 0);
+      if (new_nstart < M_start.M_node)
+        std::copy(M_start.M_node, M_finish.M_node + 1, new_nstart);
+      else
+        std::copy_backward(M_start.M_node, M_finish.M_node + 1,
+                           new_nstart + old_num_nodes);
+    }
+    else
+    {
+      const size_type new_map_size =
+        M_map_size + std::max(M_map_size, nodes_to_add) + 2;
+      Map_alloc_type map_alloc(M_alloc);
+      Map_pointer new_map = map_alloc.allocate(new_map_size);
+      new_nstart = new_map + (new_map_size - new_num_nodes) / 2
+        + (add_at_front ? nodes_to_add : 0);
+      std::copy(M_start.M_node, M_finish.M_node + 1, new_nstart);
+      map_alloc.deallocate(M_map, M_map_size);
+      M_map = new_map;
+      M_map_size = new_map_size;
+    }
+    M_start.M_set_node(new_nstart);
+    M_finish.M_set_node(new_nstart + old_num_nodes - 1);
+  }
+
+  Tp*
+  M_allocate_node()
+  {
+    if (M_spares != 0)
+      return M_spare[--M_spares];
+    return M_alloc.allocate(S_block);
+  }
+
+  void
+  M_deallocate_node(Tp* p)
+  {
+    if (M_spares < S_spare_blocks)
+      M_spare[M_spares++] = p;
+    else
+      M_alloc.deallocate(p, S_block);
+  }
+};
+
+/**
+ * @brief Deque equality comparison.
+ * @param x A %deque.
+ * @param y A %deque of the same type as @a x.
+ * @return True iff the size and elements of the deques are equal.
+ *
+ * This is an equivalence relation. It is linear in the size of the
+ * deques. Deques are considered equivalent if their sizes are equal,
+ * and if corresponding elements compare equal.
+ */
+template <typename Tp, typename Alloc, std::size_t BlockSize>
+inline bool
+operator==(const deque<Tp, Alloc, BlockSize>& x,
+           const deque<Tp, Alloc, BlockSize>& y)
+{ return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()); }
+
+/**
+ * @brief Deque ordering relation.
+ * @param x A %deque.
+ * @param y A %deque of the same type as @a x.
+ * @return True iff @a x is lexicographically less than @a y.
+ *
+ * This is a total ordering relation. It is linear in the size of the
+ * deques. The elements must be comparable with @c <.
+ */
+template <typename Tp, typename Alloc, std::size_t BlockSize>
+inline bool
+operator<(const deque<Tp, Alloc, BlockSize>& x,
+          const deque<Tp, Alloc, BlockSize>& y)
+{
+  return ft::lexicographical_compare(x.begin(), x.end(),
+                                     y.begin(), y.end());
+}
+
+/// Based on operator==
+template <typename Tp, typename Alloc, std::size_t BlockSize>
+inline bool
+operator!=(const deque<Tp, Alloc, BlockSize>& x,
+           const deque<Tp, Alloc, BlockSize>& y)
+{ return !(x == y); }
+
+/// Based on operator<
+template <typename Tp, typename Alloc, std::size_t BlockSize>
+inline bool
+operator>(const deque<Tp, Alloc, BlockSize>& x,
+          const deque<Tp, Alloc, BlockSize>& y)
+{ return y < x; }
+
+/// Based on operator<
+template <typename Tp, typename Alloc, std::size_t BlockSize>
+inline bool
+operator<=(const deque<Tp, Alloc, BlockSize>& x,
+           const deque<Tp, Alloc, BlockSize>& y)
+{ return !(y < x); }
+
+/// Based on operator<
+template <typename Tp, typename Alloc, std::size_t BlockSize>
+inline bool
+operator>=(const deque<Tp, Alloc, BlockSize>& x,
+           const deque<Tp, Alloc, BlockSize>& y)
+{ return !(x < y); }
+
+/// See ft::deque::swap().
+template <typename Tp, typename Alloc, std::size_t BlockSize>
+inline void
+swap(deque<Tp, Alloc, BlockSize>& x, deque<Tp, Alloc, BlockSize>& y)
+{ x.swap(y); }
+
+} // ft
+
+#endif // STL_DEQUE_H_
@@ -0,0 +1,225 @@
+// Epoch-based reclamation -*- C++ -*-
+
+/** @file stl_epoch.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_EPOCH_H_
+#define STL_EPOCH_H_
+
+#include <cstddef>
+#include <pthread.h>
+
+namespace ft {
+
+// An object unlinked from a shared structure, waiting until no reader
+// can still hold a pointer to it.
+struct Epoch_retired
+{
+  void*          M_ptr;
+  void           (*M_deleter)(void*);
+  std::size_t    M_epoch;
+  Epoch_retired* M_next;
+};
+
+/**
+ *  @if maint
+ *  Epoch-based reclamation for structures read without locks.
+ *
+ *  A reader pins the domain around each access: it claims one of
+ *  S_slots slots and announces in it the global epoch it saw.  A writer
+ *  that unlinks an object retires it, stamped with the global epoch; it
+ *  is freed by a later M_collect once the global epoch has moved two
+ *  steps on.  The epoch moves from e to e + 1 only when every pinned slot
+ *  announces e, so a reader pinned at e holds it back at e + 1 at most,
+ *  and anything it could have reached stays allocated until it unpins.
+ *
+ *  Pinning costs one compare-and-swap on a slot chosen from the
+ *  reader's stack address, each slot on its own cache line; readers
+ *  never wait for writers.  Retiring and collecting take an internal
+ *  mutex, so any number of writers may share a domain.
+ *  @endif
+ */
+class Epoch_domain
+{
+public:
+  enum { S_slots = 128 };
+
+private:
+  enum { S_cache_line = 64 };
+
+  // Zero when free, else (epoch << 1) | 1.
+  struct Epoch_slot
+  {
+    volatile std::size_t M_word;
+    char                 M_pad[S_cache_line - sizeof(std::size_t)];
+  };
+
+  Epoch_slot           M_slots[S_slots];
+  volatile std::size_t M_global;
+  pthread_mutex_t      M_mutex;
+  Epoch_retired*       M_head;
+  Epoch_retired*       M_tail;
+
+  Epoch_domain(const Epoch_domain&);
+  Epoch_domain& operator=(const Epoch_domain&);
+
+  // Spreads the threads over the slots; distinct threads have distinct
+  // stacks, which are usually aligned alike, hence the mixing.
+  static std::size_t
+  S_thread_hint()
+  {
+    int local;
+    std::size_t h = reinterpret_cast<std::size_t>(&local) >> 16;
+    h ^= h >> 7;
+    h *= 2654435761u;
+    h ^= h >> 15;
+    return h;
+  }
+
+  // Moves the epoch on if every pinned reader has seen the current one.
+  // Called with M_mutex held.
+  void
+  M_try_advance()
+  {
+    const std::size_t e = M_global;
+    for (std::size_t i = 0; i < S_slots; ++i)
+    {
+      const std::size_t w = __atomic_load_n(&M_slots[i].M_word,
+                                            __ATOMIC_ACQUIRE);
+      if ((w & 1) != 0 && (w >> 1) != e)
+        return;
+    }
+    __atomic_store_n(&M_global, e + 1, __ATOMIC_RELEASE);
+  }
+
+  static void
+  S_free(Epoch_retired* r)
+  {
+    while (r != 0)
+    {
+      Epoch_retired* next = r->M_next;
+      r->M_deleter(r->M_ptr);
+      delete r;
+      r = next;
+    }
+  }
+
+public:
+  Epoch_domain()
+  : M_global(0), M_head(0), M_tail(0)
+  {
+    for (std::size_t i = 0; i < S_slots; ++i)
+      M_slots[i].M_word = 0;
+    pthread_mutex_init(&M_mutex, 0);
+  }
+
+  // No reader may still be pinned.
+  ~Epoch_domain()
+  {
+    S_free(M_head);
+    pthread_mutex_destroy(&M_mutex);
+  }
+
+  // Enters a read-side critical section; returns the slot to unpin.
+  std::size_t
+  M_pin()
+  {
+    std::size_t i = S_thread_hint() % S_slots;
+    for (;;)
+    {
+      const std::size_t e = __atomic_load_n(&M_global, __ATOMIC_ACQUIRE);
+      // A full barrier: the loads of the section cannot move above it.
+      if (__sync_bool_compare_and_swap(&M_slots[i].M_word, std::size_t(0),
+                                       (e << 1) | 1))
+        return i;
+      i = (i + 1) % S_slots;
+    }
+  }
+
+  void
+  M_unpin(std::size_t slot)
+  {
+    __atomic_store_n(&M_slots[slot].M_word, std::size_t(0),
+                     __ATOMIC_RELEASE);
+  }
+
+  // A retirement record for p, made ahead so that retiring cannot fail.
+  static Epoch_retired*
+  S_make_retired(void* p, void (*deleter)(void*))
+  {
+    Epoch_retired* r = new Epoch_retired;
+    r->M_ptr = p;
+    r->M_deleter = deleter;
+    r->M_epoch = 0;
+    r->M_next = 0;
+    return r;
+  }
+
+  // Hands over r->M_ptr, already unreachable for new readers, to be
+  // passed to r->M_deleter once no pinned reader can hold it.
+  void
+  M_retire(Epoch_retired* r)
+  {
+    // The unlink must be visible before the epoch is read.
+    __sync_synchronize();
+    pthread_mutex_lock(&M_mutex);
+    r->M_epoch = M_global;
+    if (M_tail != 0)
+      M_tail->M_next = r;
+    else
+      M_head = r;
+    M_tail = r;
+    pthread_mutex_unlock(&M_mutex);
+  }
+
+  void
+  M_retire(void* p, void (*deleter)(void*))
+  { M_retire(S_make_retired(p, deleter)); }
+
+  // Tries to move the epoch on and frees what has become unreachable.
+  void
+  M_collect()
+  {
+    pthread_mutex_lock(&M_mutex);
+    M_try_advance();
+    const std::size_t g = M_global;
+    Epoch_retired* first = M_head;
+    Epoch_retired* last = 0;
+    for (Epoch_retired* r = M_head; r != 0 && r->M_epoch + 2 <= g;
+         r = r->M_next)
+      last = r;
+    if (last != 0)
+    {
+      M_head = last->M_next;
+      if (M_head == 0)
+        M_tail = 0;
+      last->M_next = 0;
+    }
+    pthread_mutex_unlock(&M_mutex);
+    if (last != 0)
+      S_free(first);
+  }
+};
+
+// Keeps a domain pinned for the lifetime of the guard.
+class Epoch_guard
+{
+  Epoch_domain& M_domain;
+  std::size_t   M_slot;
+
+  Epoch_guard(const Epoch_guard&);
+  Epoch_guard& operator=(const Epoch_guard&);
+
+public:
+  explicit
+  Epoch_guard(Epoch_domain& d)
+  : M_domain(d), M_slot(d.M_pin()) { }
+
+  ~Epoch_guard()
+  { M_domain.M_unpin(M_slot); }
+};
+
+} // ft
+#endif // STL_EPOCH_H_
@@ -16,6 +16,12 @@ struct Select1st
   const typename Pair::first_type&
   operator()(const Pair& x) const
   { return x.first; }
+
+  // Reads the key of another pair type without converting it to Pair.
+  template <typename Pair2>
+  const typename Pair2::first_type&
+  operator()(const Pair2& x) const
+  { return x.first; }
 };
 
 template <typename Tp>
@@ -36,6 +42,30 @@ template <typename Tp>
 struct Identity <const Tp>
 : Identity<Tp> { };
 
+/**
+ *  @if maint
+ *  Detects a comparison functor that declares a nested @c is_transparent
+ *  type, i.e. one that can compare keys against other types directly.
+ *  The second parameter is never used; it only makes the result depend on
+ *  a member template's own argument so that enable_if can SFINAE on it.
+ *  @endif
+ */
+template <typename Func, typename SfinaeType>
+struct has_is_transparent
+{
+private:
+  template <typename Up>
+  static char
+  S_test(typename Up::is_transparent*);
+
+  template <typename Up>
+  static long
+  S_test(...);
+
+public:
+  enum { value = sizeof(S_test<Func>(0)) == sizeof(char) };
+};
+
 
 } // ft
 #endif // STL_FUNCTION_H_
\ No newline at end of file
@@ -0,0 +1,454 @@
+// Interval map implementation -*- C++ -*-
+
+/** @file stl_interval_map.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_INTERVAL_MAP_H_
+#define STL_INTERVAL_MAP_H_
+
+#include <memory>
+#include <new>
+
+#include "stl_pair.h"
+#include "stl_tree.h"
+#include "stl_function.h"
+
+
+namespace ft {
+/// Orders half-open intervals by lower end, then by upper end.
+template <typename Key, typename Compare>
+struct Interval_compare
+: public std::binary_function<ft::pair<Key, Key>, ft::pair<Key, Key>, bool>
+{
+  Compare comp;
+
+  Interval_compare()
+  : comp() { }
+
+  Interval_compare(const Compare& c)
+  : comp(c) { }
+
+  bool
+  operator()(const ft::pair<Key, Key>& x, const ft::pair<Key, Key>& y) const
+  {
+    return comp(x.first, y.first)
+      || (!comp(y.first, x.first) && comp(x.second, y.second));
+  }
+};
+
+// Keeps the greatest upper end found in every subtree, which lets an
+// overlap search skip any subtree that ends before the query starts.
+template <typename Key, typename Compare>
+struct Rb_tree_interval_node_update
+{
+  typedef Key                                 aggregate_type;
+
+  template <typename Val>
+  struct node
+  {
+    typedef Rb_tree_aug_node<Val, Key>          type;
+    typedef Rb_tree_node_updater<Rb_tree_interval_node_update,
+                                 type>          updater;
+  };
+
+  template <typename Node>
+  static void
+  construct(Node* x)
+  { ::new(static_cast<void*>(&x->M_aug)) Key(x->M_value_field.first.second); }
+
+  template <typename Node>
+  static void
+  destroy(Node* x)
+  { x->M_aug.~Key(); }
+
+  template <typename Node>
+  static const Key&
+  max_end(const Rb_tree_node_base* x)
+  { return static_cast<const Node*>(x)->M_aug; }
+
+  template <typename Node>
+  static void
+  update(Node* x)
+  {
+    x->M_aug = x->M_value_field.first.second;
+    if (x->M_left && Compare()(x->M_aug, max_end<Node>(x->M_left)))
+      x->M_aug = max_end<Node>(x->M_left);
+    if (x->M_right && Compare()(x->M_aug, max_end<Node>(x->M_right)))
+      x->M_aug = max_end<Node>(x->M_right);
+  }
+
+  template <typename Node>
+  static void
+  copy(Node* x, const Node* y)
+  { x->M_aug = y->M_aug; }
+};
+
+/**
+ *  @brief A container of (interval,value) pairs which can be searched for
+ *  the intervals overlapping a query interval.
+ *
+ *  @ingroup Containers
+ *  @ingroup Assoc_containers
+ *
+ *  The key_type is @c pair<Key,Key>, read as the half-open interval
+ *  [first, second).  Elements are kept sorted by lower end, then upper
+ *  end, and otherwise behave as in a %map with unique keys.  Every
+ *  node also records the greatest upper end in its subtree, so
+ *  find_overlap() is logarithmic and find_overlaps() costs
+ *  O(min(n, (k + 1) log n)) for k intervals reported.
+ *
+ *  @param  Key  Type of the interval ends.
+ *  @param  Tp  Type of the mapped values.
+ *  @param  Compare  Ordering of the ends; it is default-constructed to
+ *                   maintain the node data, so it should be stateless.
+ *  @param  Alloc  Allocator type.
+*/
+template <typename Key, typename Tp, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<ft::pair<const ft::pair<Key, Key>,
+                                                   Tp> > >
+class interval_map
+{
+public:
+  typedef ft::pair<Key, Key>                        key_type;
+  typedef Tp                                        mapped_type;
+  typedef ft::pair<const key_type, Tp>              value_type;
+  typedef Interval_compare<Key, Compare>            key_compare;
+  typedef Alloc                                     allocator_type;
+
+private:
+  typedef typename Alloc::template rebind<value_type>::other  Pair_alloc_type;
+  typedef Rb_tree<key_type, value_type, Select1st<value_type>,
+                  key_compare, Pair_alloc_type,
+                  Rb_tree_interval_node_update<Key, Compare> >  Rep_type;
+  typedef Rb_tree_interval_node_update<Key, Compare>            Update_type;
+  typedef typename Rep_type::Const_Link_type                    Const_Link_type;
+  typedef Rb_tree_aug_node<value_type, Key>                     Node_type;
+
+  Rep_type M_t;
+
+public:
+  typedef typename Pair_alloc_type::pointer         pointer;
+  typedef typename Pair_alloc_type::const_pointer   const_pointer;
+  typedef typename Pair_alloc_type::reference       reference;
+  typedef typename Pair_alloc_type::const_reference const_reference;
+  typedef typename Rep_type::iterator               iterator;
+  typedef typename Rep_type::const_iterator         const_iterator;
+  typedef typename Rep_type::size_type              size_type;
+  typedef typename Rep_type::difference_type        difference_type;
+  typedef typename Rep_type::reverse_iterator       reverse_iterator;
+  typedef typename Rep_type::const_reverse_iterator const_reverse_iterator;
+
+  /// Default constructor creates no elements.
+  interval_map()
+  : M_t(key_compare(), allocator_type()) { }
+
+  explicit
+  interval_map(const Compare& comp, const allocator_type& a = allocator_type())
+  : M_t(key_compare(comp), a) { }
+
+  interval_map(const interval_map& x)
+  : M_t(x.M_t) { }
+
+  /// Builds an %interval_map from a range of (interval,value) pairs.
+  template <typename InputIterator>
+  interval_map(InputIterator first, InputIterator last)
+  : M_t(key_compare(), allocator_type())
+  { M_t.M_insert_unique(first, last); }
+
+  interval_map&
+  operator=(const interval_map& x)
+  {
+    M_t = x.M_t;
+    return *this;
+  }
+
+  allocator_type
+  get_allocator() const
+  { return M_t.get_allocator(); }
+
+  // iterators
+  iterator
+  begin()
+  { return M_t.begin(); }
+
+  const_iterator
+  begin() const
+  { return M_t.begin(); }
+
+  iterator
+  end()
+  { return M_t.end(); }
+
+  const_iterator
+  end() const
+  { return M_t.end(); }
+
+  reverse_iterator
+  rbegin()
+  { return M_t.rbegin(); }
+
+  const_reverse_iterator
+  rbegin() const
+  { return M_t.rbegin(); }
+
+  reverse_iterator
+  rend()
+  { return M_t.rend(); }
+
+  const_reverse_iterator
+  rend() const
+  { return M_t.rend(); }
+
+  // capacity
+  bool
+  empty() const
+  { return M_t.empty(); }
+
+  size_type
+  size() const
+  { return M_t.size(); }
+
+  size_type
+  max_size() const
+  { return M_t.max_size(); }
+
+  // element access
+  /**
+   *  @brief  Subscript access to the value mapped to interval @a k.
+   *
+   *  If no element has exactly the interval @a k, one is created with a
+   *  default value.
+   */
+  mapped_type&
+  operator[](const key_type& k)
+  {
+    return (*M_t.M_emplace_unique_key(k,
+        Construct_from0<mapped_type>()).first).second;
+  }
+
+  // modifiers
+  ft::pair<iterator, bool>
+  insert(const value_type& x)
+  { return M_t.M_insert_unique(x); }
+
+  iterator
+  insert(iterator position, const value_type& x)
+  { return M_t.M_insert_unique(position, x); }
+
+  template <typename InputIterator>
+  void
+  insert(InputIterator first, InputIterator last)
+  { M_t.M_insert_unique(first, last); }
+
+  void
+  erase(iterator position)
+  { M_t.erase(position); }
+
+  size_type
+  erase(const key_type& x)
+  { return M_t.erase(x); }
+
+  void
+  erase(iterator first, iterator last)
+  { M_t.erase(first, last); }
+
+  void
+  swap(interval_map& x)
+  { M_t.swap(x.M_t); }
+
+  void
+  clear()
+  { M_t.clear(); }
+
+  // observers
+  key_compare
+  key_comp() const
+  { return M_t.key_comp(); }
+
+  // lookup of exact intervals
+  iterator
+  find(const key_type& x)
+  { return M_t.find(x); }
+
+  const_iterator
+  find(const key_type& x) const
+  { return M_t.find(x); }
+
+  size_type
+  count(const key_type& x) const
+  { return M_t.find(x) == M_t.end() ? 0 : 1; }
+
+  iterator
+  lower_bound(const key_type& x)
+  { return M_t.lower_bound(x); }
+
+  const_iterator
+  lower_bound(const key_type& x) const
+  { return M_t.lower_bound(x); }
+
+  iterator
+  upper_bound(const key_type& x)
+  { return M_t.upper_bound(x); }
+
+  const_iterator
+  upper_bound(const key_type& x) const
+  { return M_t.upper_bound(x); }
+
+  // overlap queries
+  /**
+   *  @brief  Finds the first interval overlapping [@a lo, @a hi).
+   *  @return  Iterator to the overlapping element that comes first in
+   *           key order, or end() if there is none.
+   *
+   *  Logarithmic.  If the left subtree reaches past @a lo and holds no
+   *  overlap, its far-reaching interval starts at or after @a hi, and so
+   *  does everything to its right: the search never backtracks.
+   */
+  const_iterator
+  find_overlap(const Key& lo, const Key& hi) const
+  {
+    const Compare comp = Compare();
+    const Rb_tree_node_base* x = S_root(M_t);
+    while (x != 0)
+    {
+      if (x->M_left
+          && comp(lo, Update_type::template max_end<Node_type>(x->M_left)))
+        x = x->M_left;
+      else if (S_overlaps(x, lo, hi, comp))
+        return const_iterator(static_cast<Const_Link_type>(x));
+      else if (comp(S_interval(x).first, hi))
+        x = x->M_right;
+      else
+        break;
+    }
+    return end();
+  }
+
+  iterator
+  find_overlap(const Key& lo, const Key& hi)
+  {
+    const interval_map* const_this = this;
+    return const_this->find_overlap(lo, hi).M_const_cast();
+  }
+
+  /**
+   *  @brief  Reports every interval overlapping [@a lo, @a hi).
+   *  @param  out  Output iterator receiving a const_iterator per match.
+   *  @return  @a out past the last match.
+   *
+   *  Matches are reported in key order.  Subtrees whose intervals all
+   *  end at or before @a lo, or start at or after @a hi, are skipped,
+   *  but a subtree that passes both tests can still hold no match: the
+   *  walk costs O(log n) per match, O(min(n, (k + 1) log n)) in all for
+   *  k matches.  Reaching O(log n + k) would take an interval tree
+   *  ordered on both ends.
+   */
+  template <typename OutputIterator>
+  OutputIterator
+  find_overlaps(const Key& lo, const Key& hi, OutputIterator out) const
+  { return S_collect(S_root(M_t), lo, hi, Compare(), out); }
+
+  /// Whether any interval overlaps [@a lo, @a hi).
+  bool
+  overlaps(const Key& lo, const Key& hi) const
+  { return find_overlap(lo, hi) != end(); }
+
+private:
+  // The header's parent is the root.
+  static const Rb_tree_node_base*
+  S_root(const Rep_type& t)
+  { return t.end().M_node->M_parent; }
+
+  static const key_type&
+  S_interval(const Rb_tree_node_base* x)
+  { return static_cast<Const_Link_type>(x)->M_value_field.first; }
+
+  static bool
+  S_overlaps(const Rb_tree_node_base* x, const Key& lo, const Key& hi,
+             const Compare& comp)
+  {
+    const key_type& i = S_interval(x);
+    return comp(i.first, hi) && comp(lo, i.second);
+  }
+
+  template <typename OutputIterator>
+  static OutputIterator
+  S_collect(const Rb_tree_node_base* x, const Key& lo, const Key& hi,
+            const Compare& comp, OutputIterator out)
+  {
+    while (x != 0
+           && comp(lo, Update_type::template max_end<Node_type>(x)))
+    {
+      out = S_collect(x->M_left, lo, hi, comp, out);
+      if (!comp(S_interval(x).first, hi))
+        break;
+      if (comp(lo, S_interval(x).second))
+        *out++ = const_iterator(static_cast<Const_Link_type>(x));
+      x = x->M_right;
+    }
+    return out;
+  }
+
+  template <typename K1, typename T1, typename C1, typename A1>
+  friend bool
+  operator== (const interval_map<K1, T1, C1, A1>&,
+              const interval_map<K1, T1, C1, A1>&);
+
+  template <typename K1, typename T1, typename C1, typename A1>
+  friend bool
+  operator< (const interval_map<K1, T1, C1, A1>&,
+             const interval_map<K1, T1, C1, A1>&);
+};
+
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator==(const interval_map<Key, Tp, Compare, Alloc>& x,
+           const interval_map<Key, Tp, Compare, Alloc>& y)
+{ return x.M_t == y.M_t; }
+
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator<(const interval_map<Key, Tp, Compare, Alloc>& x,
+          const interval_map<Key, Tp, Compare, Alloc>& y)
+{ return x.M_t < y.M_t; }
+
+/// Based on operator==
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator!=(const interval_map<Key, Tp, Compare, Alloc>& x,
+           const interval_map<Key, Tp, Compare, Alloc>& y)
+{ return !(x == y); }
+
+/// Based on operator<
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator>(const interval_map<Key, Tp, Compare, Alloc>& x,
+          const interval_map<Key, Tp, Compare, Alloc>& y)
+{ return y < x; }
+
+/// Based on operator<
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator<=(const interval_map<Key, Tp, Compare, Alloc>& x,
+           const interval_map<Key, Tp, Compare, Alloc>& y)
+{ return !(y < x); }
+
+/// Based on operator<
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator>=(const interval_map<Key, Tp, Compare, Alloc>& x,
+           const interval_map<Key, Tp, Compare, Alloc>& y)
+{ return !(x < y); }
+
+/// See interval_map::swap().
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+void
+swap(interval_map<Key, Tp, Compare, Alloc>& x,
+     interval_map<Key, Tp, Compare, Alloc>& y)
+{ x.swap(y); }
+
+} // ft
+
+#endif // STL_INTERVAL_MAP_H_
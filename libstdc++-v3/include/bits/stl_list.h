@@ -0,0 +1,1354 @@
+// List implementation -*- C++ -*-
+
+/** @file stl_list.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_LIST_H_
+#define STL_LIST_H_
+
+#include <cstddef>
+#include <memory>
+#include <iterator>
+#include <functional>
+#include "cpp_type_traits.h"
+#include "stl_iterator.h"
+#include "stl_algobase.h"
+#include "stl_pool_allocator.h"
+
+namespace ft {
+
+/// @if maint Common part of a node in the %list. @endif
+struct List_node_base
+{
+  List_node_base* M_next;   ///< Self-explanatory
+  List_node_base* M_prev;   ///< Self-explanatory
+
+  // Links this node in before @a position.
+  void
+  M_hook(List_node_base* position)
+  {
+    M_next = position;
+    M_prev = position->M_prev;
+    position->M_prev->M_next = this;
+    position->M_prev = this;
+  }
+
+  void
+  M_unhook()
+  {
+    M_prev->M_next = M_next;
+    M_next->M_prev = M_prev;
+  }
+
+  // Moves [first, last) in before this node, in constant time.
+  void
+  M_transfer(List_node_base* first, List_node_base* last)
+  {
+    if (this == last || first == last)
+      return;
+    // Remove [first, last) from its old position.
+    last->M_prev->M_next = this;
+    first->M_prev->M_next = last;
+    M_prev->M_next = first;
+    // Splice [first, last) into its new position.
+    List_node_base* const tmp = M_prev;
+    M_prev = last->M_prev;
+    last->M_prev = first->M_prev;
+    first->M_prev = tmp;
+  }
+
+  // Reverses the circular list this node heads.
+  void
+  M_reverse()
+  {
+    List_node_base* tmp = this;
+    do
+    {
+      List_node_base* const next = tmp->M_next;
+      tmp->M_next = tmp->M_prev;
+      tmp->M_prev = next;
+      tmp = next;
+    }
+    while (tmp != this);
+  }
+};
+
+/// @if maint An actual node in the %list. @endif
+template <typename Tp>
+struct List_node : public List_node_base
+{
+  Tp M_data;                ///< User's data.
+};
+
+/**
+ *  @brief A list::iterator.
+ *
+ *  All the functions are op overloads.
+ */
+template <typename Tp, typename Ref, typename Ptr>
+struct List_iterator
+{
+  typedef List_iterator<Tp, Tp&, Tp*>              iterator;
+  typedef List_iterator<Tp, const Tp&, const Tp*>  const_iterator;
+  typedef List_iterator                            Self;
+  typedef List_node<Tp>                            Node;
+
+  typedef std::bidirectional_iterator_tag  iterator_category;
+  typedef Tp                               value_type;
+  typedef Ptr                              pointer;
+  typedef Ref                              reference;
+  typedef std::ptrdiff_t                   difference_type;
+
+  List_node_base* M_node;   ///< The only member points to the %list node.
+
+  List_iterator()
+  : M_node(0) { }
+
+  explicit
+  List_iterator(const List_node_base* x)
+  : M_node(const_cast<List_node_base*>(x)) { }
+
+  // iterator to const_iterator.  A template, so that it is never taken
+  // for the copy constructor and the copy operations stay implicit.
+  template <typename Ref2>
+  List_iterator(const List_iterator<Tp, Ref2,
+                typename ft::enable_if<ft::are_same<Ref2, Tp&>::value,
+                                       Tp*>::type>& x)
+  : M_node(x.M_node) { }
+
+  reference
+  operator*() const
+  { return static_cast<Node*>(M_node)->M_data; }
+
+  pointer
+  operator->() const
+  { return &static_cast<Node*>(M_node)->M_data; }
+
+  Self&
+  operator++()
+  {
+    M_node = M_node->M_next;
+    return *this;
+  }
+
+  Self
+  operator++(int)
+  {
+    Self tmp = *this;
+    M_node = M_node->M_next;
+    return tmp;
+  }
+
+  Self&
+  operator--()
+  {
+    M_node = M_node->M_prev;
+    return *this;
+  }
+
+  Self
+  operator--(int)
+  {
+    Self tmp = *this;
+    M_node = M_node->M_prev;
+    return tmp;
+  }
+};
+
+// Comparisons take mixed const and non-const iterators, as
+// ft::normal_iterator's do.
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator==(const List_iterator<Tp, RefL, PtrL>& x,
+           const List_iterator<Tp, RefR, PtrR>& y)
+{ return x.M_node == y.M_node; }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator!=(const List_iterator<Tp, RefL, PtrL>& x,
+           const List_iterator<Tp, RefR, PtrR>& y)
+{ return x.M_node != y.M_node; }
+
+/**
+ * @if maint
+ * List base class. This class provides the unified face for %list's
+ * allocation. It owns the sentinel node, which doubles as end(), and
+ * its destructor frees every node, so a %list constructor that throws
+ * half-way leaks nothing.
+ * @endif
+ */
+template <typename Tp, typename Alloc>
+struct List_base
+{
+  typedef typename Alloc::template rebind<List_node<Tp> >::other
+    Node_alloc_type;
+  typedef typename Alloc::template rebind<Tp>::other Tp_alloc_type;
+
+  struct List_impl
+    : public Node_alloc_type
+    {
+      List_node_base M_node;
+      List_impl(Node_alloc_type const& a)
+      : Node_alloc_type(a)
+      { }
+    };
+
+  typedef Alloc allocator_type;
+  List_impl     M_impl;
+
+  Node_alloc_type&
+  M_get_Node_allocator()
+  { return *static_cast<Node_alloc_type*>(&this->M_impl); }
+
+  const Node_alloc_type&
+  M_get_Node_allocator() const
+  { return *static_cast<const Node_alloc_type*>(&this->M_impl); }
+
+  allocator_type
+  get_allocator() const
+  { return allocator_type(M_get_Node_allocator()); }
+
+  List_base(const allocator_type& a)
+  : M_impl(a)
+  { M_init(); }
+
+  ~List_base()
+  { M_clear(); }
+
+  List_node<Tp>*
+  M_get_node()
+  { return M_impl.Node_alloc_type::allocate(1); }
+
+  void
+  M_put_node(List_node<Tp>* p)
+  { M_impl.Node_alloc_type::deallocate(p, 1); }
+
+  // Destroys and frees every node, front to back.
+  void
+  M_clear()
+  {
+    Tp_alloc_type tp_alloc(M_get_Node_allocator());
+    List_node_base* cur = M_impl.M_node.M_next;
+    while (cur != &M_impl.M_node)
+    {
+      List_node<Tp>* tmp = static_cast<List_node<Tp>*>(cur);
+      cur = cur->M_next;
+      tp_alloc.destroy(&tmp->M_data);
+      M_put_node(tmp);
+    }
+  }
+
+  void
+  M_init()
+  {
+    M_impl.M_node.M_next = &M_impl.M_node;
+    M_impl.M_node.M_prev = &M_impl.M_node;
+  }
+};
+
+/**
+ *  @brief A standard container with linear time access to elements,
+ *  and fixed time insertion/deletion at any point in the sequence.
+ *
+ *  @ingroup Containers
+ *  @ingroup Sequences
+ *
+ *  Meets the requirements of a container, a reversible container and a
+ *  sequence, including the optional sequence requirements with the
+ *  exception of @c at and @c operator[].
+ *
+ *  This is a @e doubly @e linked %list. Traversal up and down the
+ *  %list requires linear time, but adding and removing elements (or
+ *  @e nodes) is done in constant time, regardless of where the change
+ *  takes place. Unlike ft::vector and ft::deque, random-access
+ *  iterators are not provided, so subscripting ( @c [] ) access is not
+ *  allowed.
+ *
+ *  As in the C++98 library, the element count is not stored: size()
+ *  walks the %list, and in exchange every form of splice() is constant
+ *  time.
+ *
+ *  Nodes come from the allocator one at a time; with
+ *  ft::pool_allocator<Tp> as @a Alloc they are served from a shared
+ *  free list instead of operator new.
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp> >
+class list : protected List_base<Tp, Alloc>
+{
+  typedef List_base<Tp, Alloc>                      Base;
+  typedef typename Base::Tp_alloc_type              Tp_alloc_type;
+
+public:
+  typedef Tp                                        value_type;
+  typedef typename Tp_alloc_type::pointer           pointer;
+  typedef typename Tp_alloc_type::const_pointer     const_pointer;
+  typedef typename Tp_alloc_type::reference         reference;
+  typedef typename Tp_alloc_type::const_reference   const_reference;
+  typedef List_iterator<Tp, Tp&, Tp*>               iterator;
+  typedef List_iterator<Tp, const Tp&, const Tp*>   const_iterator;
+  typedef ft::reverse_iterator<const_iterator>      const_reverse_iterator;
+  typedef ft::reverse_iterator<iterator>            reverse_iterator;
+  typedef std::size_t                               size_type;
+  typedef std::ptrdiff_t                            difference_type;
+  typedef typename Base::allocator_type             allocator_type;
+
+protected:
+  typedef List_node<Tp>                             Node;
+
+  enum { S_sort_bins = 64 };
+
+  using Base::M_impl;
+  using Base::M_put_node;
+  using Base::M_get_node;
+  using Base::M_get_Node_allocator;
+
+  /**
+   * @if maint
+   * Allocates space for a new node and constructs a copy of @a x in it.
+   * @endif
+   */
+  Node*
+  M_create_node(const value_type& x)
+  {
+    Node* p = this->M_get_node();
+    try
+    {
+      Tp_alloc_type(M_get_Node_allocator()).construct(&p->M_data, x);
+    }
+    catch(...)
+    {
+      M_put_node(p);
+      throw;
+    }
+    return p;
+  }
+
+public:
+  /**
+   * @brief Default constructor creates no elements.
+   */
+  explicit
+  list(const allocator_type& a = allocator_type())
+  : Base(a) { }
+
+  /**
+   * @brief Create a %list with copies of an exemplar element.
+   * @param n The number of elements to initially create.
+   * @param value An element to copy.
+   *
+   * This constructor fills the %list with @a n copies of @a value.
+   */
+  explicit
+  list(size_type n, const value_type& value = value_type(),
+       const allocator_type& a = allocator_type())
+  : Base(a)
+  { M_fill_initialize(n, value); }
+
+  /**
+   * @brief %List copy constructor.
+   * @param x A %list of identical element and allocator types.
+   *
+   * The newly-created %list uses a copy of the allocation object used
+   * by @a x.
+   */
+  list(const list& x)
+  : Base(x.get_allocator())
+  { M_initialize_dispatch(x.begin(), x.end(), __false_type()); }
+
+  /**
+   * @brief Builds a %list from a range.
+   * @param first An input iterator.
+   * @param last An input iterator.
+   *
+   * Create a %list consisting of copies of the elements from
+   * [@a first,@a last).
+   */
+  template <typename InputIterator>
+  list(InputIterator first, InputIterator last,
+       const allocator_type& a = allocator_type())
+  : Base(a)
+  {
+    // Check whether it's an integral type. If so, it's not an iterator.
+    typedef typename ft::is_integer<InputIterator>::type Integral;
+    M_initialize_dispatch(first, last, Integral());
+  }
+
+  /**
+   * No explicit dtor needed as the List_base dtor takes care of things.
+   * The List_base dtor only erases the elements, and note that if the
+   * elements themselves are pointers, the pointed-to memory is not
+   * touched in any way. Managing the pointer is the user's
+   * responsibilty.
+   */
+
+  /**
+   * @brief %List assignment operator.
+   * @param x A %list of identical element and allocator types.
+   *
+   * All the elements of @a x are copied, but unlike the copy
+   * constructor, the allocator object is not copied.
+   */
+  list&
+  operator=(const list& x)
+  {
+    if (this != &x)
+      M_assign_dispatch(x.begin(), x.end(), __false_type());
+    return *this;
+  }
+
+  /**
+   * @brief Assigns a given value to a %list.
+   * @param n Number of elements to be assigned.
+   * @param val Value to be assigned.
+   *
+   * This function fills a %list with @a n copies of the given value.
+   * Note that the assignment completely changes the %list and that the
+   * resulting %list's size is the same as the number of elements
+   * assigned. Old data may be lost.
+   */
+  void
+  assign(size_type n, const value_type& val)
+  { M_fill_assign(n, val); }
+
+  /**
+   * @brief Assigns a range to a %list.
+   * @param first An input iterator.
+   * @param last An input iterator.
+   *
+   * This function fills a %list with copies of the elements in the
+   * range [@a first,@a last).
+   */
+  template <typename InputIterator>
+  void
+  assign(InputIterator first, InputIterator last)
+  {
+    // Check whether it's an integral type. If so, it's not an iterator.
+    typedef typename ft::is_integer<InputIterator>::type Integral;
+    M_assign_dispatch(first, last, Integral());
+  }
+
+  /// Get a copy of the memory allocation object.
+  allocator_type
+  get_allocator() const
+  { return Base::get_allocator(); }
+
+  // iterators
+  /**
+   * Returns a read/write iterator that points to the first element in
+   * the %list. Iteration is done in ordinary element order.
+   */
+  iterator
+  begin()
+  { return iterator(M_impl.M_node.M_next); }
+
+  /**
+   * Returns a read-only (constant) iterator that points to the first
+   * element in the %list. Iteration is done in ordinary element order.
+   */
+  const_iterator
+  begin() const
+  { return const_iterator(M_impl.M_node.M_next); }
+
+  /**
+   * Returns a read/write iterator that points one past the last element
+   * in the %list. Iteration is done in ordinary element order.
+   */
+  iterator
+  end()
+  { return iterator(&M_impl.M_node); }
+
+  /**
+   * Returns a read-only (constant) iterator that points one past the last
+   * element in the %list. Iteration is done in ordinary element order.
+   */
+  const_iterator
+  end() const
+  { return const_iterator(&M_impl.M_node); }
+
+  /**
+   * Returns a read/write reverse iterator that points to the last element
+   * in the %list. Iteration is done in reverse element order.
+   */
+  reverse_iterator
+  rbegin()
+  { return reverse_iterator(end()); }
+
+  /**
+   * Returns a read-only (constant) reverse iterator that points to the
+   * last element in the %list. Iteration is done in reverse element
+   * order.
+   */
+  const_reverse_iterator
+  rbegin() const
+  { return const_reverse_iterator(end()); }
+
+  /**
+   * Returns a read/write reverse iterator that points to one before the
+   * first element in the %list. Iteration is done in reverse element
+   * order.
+   */
+  reverse_iterator
+  rend()
+  { return reverse_iterator(begin()); }
+
+  /**
+   * Returns a read-only (constant) reverse iterator that points to one
+   * before the first element in the %list. Iteration is done in reverse
+   * element order.
+   */
+  const_reverse_iterator
+  rend() const
+  { return const_reverse_iterator(begin()); }
+
+  // capacity
+  /**
+   * Returns true if the %list is empty. (Thus begin() would equal
+   * end().)
+   */
+  bool
+  empty() const
+  { return M_impl.M_node.M_next == &M_impl.M_node; }
+
+  /**  Returns the number of elements in the %list; linear time.  */
+  size_type
+  size() const
+  {
+    size_type n = 0;
+    for (const List_node_base* p = M_impl.M_node.M_next;
+         p != &M_impl.M_node; p = p->M_next)
+      ++n;
+    return n;
+  }
+
+  /**  Returns the size() of the largest possible %list.  */
+  size_type
+  max_size() const
+  { return M_get_Node_allocator().max_size(); }
+
+  /**
+   * @brief Resizes the %list to the specified number of elements.
+   * @param new_size Number of elements the %list should contain.
+   * @param x Data with which new elements should be populated.
+   *
+   * This function will %resize the %list to the specified number of
+   * elements. If the number is smaller than the %list's current size
+   * the %list is truncated, otherwise the %list is extended and new
+   * elements are populated with given data.
+   */
+  void
+  resize(size_type new_size, value_type x = value_type())
+  {
+    iterator i = begin();
+    size_type len = 0;
+    for (; i != end() && len < new_size; ++i, ++len)
+      ;
+    if (len == new_size)
+      erase(i, end());
+    else
+      insert(end(), new_size - len, x);
+  }
+
+  // element access
+  /**
+   * Returns a read/write reference to the data at the first element of
+   * the %list.
+   */
+  reference
+  front()
+  { return *begin(); }
+
+  /**
+   * Returns a read-only (constant) reference to the data at the first
+   * element of the %list.
+   */
+  const_reference
+  front() const
+  { return *begin(); }
+
+  /**
+   * Returns a read/write reference to the data at the last element of
+   * the %list.
+   */
+  reference
+  back()
+  { return *--end(); }
+
+  /**
+   * Returns a read-only (constant) reference to the data at the last
+   * element of the %list.
+   */
+  const_reference
+  back() const
+  { return *--end(); }
+
+  // modifiers
+  /**
+   * @brief Add data to the front of the %list.
+   * @param x Data to be added.
+   *
+   * This is a typical stack operation. The function creates an element
+   * at the front of the %list and assigns the given data to it. Due to
+   * the nature of a %list this operation can be done in constant time,
+   * and does not invalidate iterators and references.
+   */
+  void
+  push_front(const value_type& x)
+  { M_create_node(x)->M_hook(M_impl.M_node.M_next); }
+
+  /**
+   * @brief Removes first element.
+   *
+   * This is a typical stack operation. It shrinks the %list by one. Due
+   * to the nature of a %list this operation can be done in constant
+   * time, and only invalidates iterators/references to the element
+   * being removed.
+   */
+  void
+  pop_front()
+  { M_erase(begin()); }
+
+  /**
+   * @brief Add data to the end of the %list.
+   * @param x Data to be added.
+   *
+   * This is a typical stack operation. The function creates an element
+   * at the end of the %list and assigns the given data to it. Due to the
+   * nature of a %list this operation can be done in constant time, and
+   * does not invalidate iterators and references.
+   */
+  void
+  push_back(const value_type& x)
+  { M_create_node(x)->M_hook(&M_impl.M_node); }
+
+  /**
+   * @brief Removes last element.
+   *
+   * This is a typical stack operation. It shrinks the %list by one. Due
+   * to the nature of a %list this operation can be done in constant
+   * time, and only invalidates iterators/references to the element
+   * being removed.
+   */
+  void
+  pop_back()
+  { M_erase(iterator(M_impl.M_node.M_prev)); }
+
+  /**
+   * @brief Inserts given value into %list before specified iterator.
+   * @param position An iterator into the %list.
+   * @param x Data to be inserted.
+   * @return An iterator that points to the inserted data.
+   *
+   * This function will insert a copy of the given value before the
+   * specified location. Due to the nature of a %list this operation can
+   * be done in constant time, and does not invalidate iterators and
+   * references.
+   */
+  iterator
+  insert(iterator position, const value_type& x)
+  {
+    Node* tmp = M_create_node(x);
+    tmp->M_hook(position.M_node);
+    return iterator(tmp);
+  }
+
+  /**
+   * @brief Inserts a number of copies of given data into the %list.
+   * @param position An iterator into the %list.
+   * @param n Number of elements to be inserted.
+   * @param x Data to be inserted.
+   *
+   * The copies are made in a temporary %list first and spliced in, so
+   * if one of them throws the %list is left unchanged.
+   */
+  void
+  insert(iterator position, size_type n, const value_type& x)
+  {
+    list tmp(n, x, get_allocator());
+    splice(position, tmp);
+  }
+
+  /**
+   * @brief Inserts a range into the %list.
+   * @param position An iterator into the %list.
+   * @param first An input iterator.
+   * @param last An input iterator.
+   *
+   * This function will insert copies of the data in the range
+   * [@a first,@a last) into the %list before the location specified by
+   * @a position. As for the fill insert, the %list is left unchanged if
+   * a copy throws.
+   */
+  template <typename InputIterator>
+  void
+  insert(iterator position, InputIterator first, InputIterator last)
+  {
+    list tmp(first, last, get_allocator());
+    splice(position, tmp);
+  }
+
+  /**
+   * @brief Remove element at given position.
+   * @param position Iterator pointing to element to be erased.
+   * @return An iterator pointing to the next element (or end()).
+   *
+   * This function will erase the element at the given position and thus
+   * shorten the %list by one.
+   */
+  iterator
+  erase(iterator position)
+  {
+    iterator ret = iterator(position.M_node->M_next);
+    M_erase(position);
+    return ret;
+  }
+
+  /**
+   * @brief Remove a range of elements.
+   * @param first Iterator pointing to the first element to be erased.
+   * @param last Iterator pointing to one past the last element to be
+   * erased.
+   * @return An iterator pointing to the element pointed to by @a last
+   * prior to erasing (or end()).
+   *
+   * This function will erase the elements in the range @a [first,last)
+   * and shorten the %list accordingly.
+   */
+  iterator
+  erase(iterator first, iterator last)
+  {
+    while (first != last)
+      first = erase(first);
+    return last;
+  }
+
+  /**
+   * @brief Swaps data with another %list.
+   * @param x A %list of the same element and allocator types.
+   *
+   * This exchanges the elements between two lists in constant time.
+   */
+  void
+  swap(list& x)
+  {
+    List_node_base tmp;
+    tmp.M_next = &tmp;
+    tmp.M_prev = &tmp;
+    tmp.M_transfer(x.M_impl.M_node.M_next, &x.M_impl.M_node);
+    x.M_impl.M_node.M_transfer(M_impl.M_node.M_next, &M_impl.M_node);
+    M_impl.M_node.M_transfer(tmp.M_next, &tmp);
+  }
+
+  /**
+   * Erases all the elements. Note that this function only erases the
+   * elements, and that if the elements themselves are pointers, the
+   * pointed-to memory is not touched in any way. Managing the pointer is
+   * the user's responsibilty.
+   */
+  void
+  clear()
+  {
+    Base::M_clear();
+    Base::M_init();
+  }
+
+  // [23.2.2.4] list operations
+  /**
+   * @brief Insert contents of another %list.
+   * @param position Iterator referencing the element to insert before.
+   * @param x Source list.
+   *
+   * The elements of @a x are inserted in constant time in front of the
+   * element referenced by @a position. @a x becomes an empty list.
+   */
+  void
+  splice(iterator position, list& x)
+  {
+    if (!x.empty())
+      position.M_node->M_transfer(x.M_impl.M_node.M_next,
+                                  &x.M_impl.M_node);
+  }
+
+  /**
+   * @brief Insert element from another %list.
+   * @param position Iterator referencing the element to insert before.
+   * @param x Source list.
+   * @param i Iterator referencing the element to move.
+   *
+   * Removes the element in list @a x referenced by @a i and inserts it
+   * into the current list before @a position.
+   */
+  void
+  splice(iterator position, list&, iterator i)
+  {
+    iterator j = i;
+    ++j;
+    if (position == i || position == j)
+      return;
+    position.M_node->M_transfer(i.M_node, j.M_node);
+  }
+
+  /**
+   * @brief Insert range from another %list.
+   * @param position Iterator referencing the element to insert before.
+   * @param x Source list.
+   * @param first Iterator referencing the start of range in x.
+   * @param last Iterator referencing the end of range in x.
+   *
+   * Removes elements in the range [first,last) and inserts them before
+   * @a position in constant time.
+   *
+   * Undefined if @a position is in [first,last).
+   */
+  void
+  splice(iterator position, list&, iterator first, iterator last)
+  {
+    if (first != last)
+      position.M_node->M_transfer(first.M_node, last.M_node);
+  }
+
+  /**
+   * @brief Remove all elements equal to value.
+   * @param value The value to remove.
+   *
+   * Removes every element in the list equal to @a value.
+   */
+  void
+  remove(const Tp& value)
+  { remove_if(Remove_equal(value)); }
+
+  /**
+   * @brief Remove all elements satisfying a predicate.
+   * @param pred Unary predicate function or object.
+   *
+   * Removes every element in the list for which the predicate returns
+   * true.
+   *
+   * One pass: the matching nodes are unlinked as the walk goes, and
+   * destroyed together after it, so @a pred may refer to an element
+   * being removed and the walk is not interleaved with freeing.
+   */
+  template <typename Predicate>
+  void
+  remove_if(Predicate pred)
+  {
+    List_node_base* doomed = 0;
+    List_node_base** tail = &doomed;
+    List_node_base* cur = M_impl.M_node.M_next;
+    try
+    {
+      while (cur != &M_impl.M_node)
+      {
+        List_node_base* const next = cur->M_next;
+        if (pred(static_cast<Node*>(cur)->M_data))
+        {
+          cur->M_unhook();
+          cur->M_next = 0;
+          *tail = cur;
+          tail = &cur->M_next;
+        }
+        cur = next;
+      }
+    }
+    catch(...)
+    {
+      M_destroy_chain(doomed);
+      throw;
+    }
+    M_destroy_chain(doomed);
+  }
+
+  /**
+   * @brief Remove consecutive duplicate elements.
+   *
+   * For each consecutive set of elements with the same value, remove
+   * all but the first one. Remaining elements stay in list order. Note
+   * that this function only erases the elements, and that if the
+   * elements themselves are pointers, the pointed-to memory is not
+   * touched in any way. Managing the pointer is the user's
+   * responsibilty.
+   */
+  void
+  unique()
+  { unique(std::equal_to<Tp>()); }
+
+  /**
+   * @brief Remove consecutive elements satisfying a predicate.
+   * @param binary_pred Binary predicate function or object.
+   *
+   * For each consecutive set of elements [first,last) that satisfy
+   * predicate(first,i) where i is an iterator in [first,last), remove
+   * all but the first one. As for remove_if, the walk is a single pass
+   * and the removed nodes are destroyed after it.
+   */
+  template <typename BinaryPredicate>
+  void
+  unique(BinaryPredicate binary_pred)
+  {
+    List_node_base* doomed = 0;
+    List_node_base* first = M_impl.M_node.M_next;
+    if (first == &M_impl.M_node)
+      return;
+    List_node_base** tail = &doomed;
+    try
+    {
+      List_node_base* next = first->M_next;
+      while (next != &M_impl.M_node)
+      {
+        List_node_base* const after = next->M_next;
+        if (binary_pred(static_cast<Node*>(first)->M_data,
+                        static_cast<Node*>(next)->M_data))
+        {
+          next->M_unhook();
+          next->M_next = 0;
+          *tail = next;
+          tail = &next->M_next;
+        }
+        else
+          first = next;
+        next = after;
+      }
+    }
+    catch(...)
+    {
+      M_destroy_chain(doomed);
+      throw;
+    }
+    M_destroy_chain(doomed);
+  }
+
+  /**
+   * @brief Merge sorted lists.
+   * @param x Sorted list to merge.
+   *
+   * Assumes that both @a x and this list are sorted according to
+   * operator<(). Merges elements of @a x into this list in sorted order,
+   * leaving @a x empty when complete. Elements in this list precede
+   * elements in @a x that are equal.
+   */
+  void
+  merge(list& x)
+  { merge(x, std::less<Tp>()); }
+
+  /**
+   * @brief Merge sorted lists according to comparison function.
+   * @param x Sorted list to merge.
+   * @param comp Comparison function defining sort order.
+   *
+   * Assumes that both @a x and this list are sorted according to comp.
+   * Merges elements of @a x into this list in sorted order, leaving
+   * @a x empty when complete. Elements in this list precede elements in
+   * @a x that are equivalent according to comp().
+   */
+  template <typename StrictWeakOrdering>
+  void
+  merge(list& x, StrictWeakOrdering comp)
+  {
+    // _GLIBCXX_RESOLVE_LIB_DEFECTS
+    // 300. list::merge() specification incomplete
+    if (this == &x)
+      return;
+    iterator first1 = begin();
+    iterator last1 = end();
+    iterator first2 = x.begin();
+    iterator last2 = x.end();
+    while (first1 != last1 && first2 != last2)
+      if (comp(*first2, *first1))
+      {
+        iterator next = first2;
+        ++next;
+        first1.M_node->M_transfer(first2.M_node, next.M_node);
+        first2 = next;
+      }
+      else
+        ++first1;
+    if (first2 != last2)
+      last1.M_node->M_transfer(first2.M_node, last2.M_node);
+  }
+
+  /**
+   * @brief Reverse the elements in list.
+   *
+   * Reverse the order of elements in the list in linear time.
+   */
+  void
+  reverse()
+  { M_impl.M_node.M_reverse(); }
+
+  /**
+   * @brief Sort the elements.
+   *
+   * Sorts the elements of this list in NlogN time. Equivalent elements
+   * remain in list order.
+   */
+  void
+  sort()
+  { sort(std::less<Tp>()); }
+
+  /**
+   * @brief Sort the elements according to comparison function.
+   *
+   * Sorts the elements of this list in NlogN time. Equivalent elements
+   * remain in list order.
+   *
+   * A bottom-up merge sort on the nodes themselves: runs of 2^i nodes
+   * are kept in S_sort_bins bins as chains linked through M_next only,
+   * merged like a binary counter; the last merge rebuilds the M_prev
+   * links as it goes, sparing a pass over the scattered nodes. Nothing
+   * is allocated or copied. If @a comp throws, every node is put back
+   * in some order.
+   */
+  template <typename StrictWeakOrdering>
+  void
+  sort(StrictWeakOrdering comp)
+  {
+    List_node_base* const head = &M_impl.M_node;
+    if (head->M_next == head || head->M_next->M_next == head)
+      return;
+
+    List_node_base* rest = head->M_next;
+    head->M_prev->M_next = 0;
+    List_node_base* bins[S_sort_bins];
+    std::size_t fill = 0;
+    List_node_base* carry = 0;
+    try
+    {
+      while (rest != 0)
+      {
+        carry = rest;
+        rest = rest->M_next;
+        carry->M_next = 0;
+        std::size_t i = 0;
+        for (; i < fill && bins[i] != 0; ++i)
+        {
+          List_node_base* const run = bins[i];
+          List_node_base* const later = carry;
+          bins[i] = 0;
+          carry = 0;
+          S_merge_runs(carry, run, later, comp);
+        }
+        if (i == fill)
+          ++fill;
+        bins[i] = carry;
+        carry = 0;
+      }
+      // Lower bins hold later elements, so fold them in from the bottom.
+      // The top bin is never empty; it is merged last, into the list.
+      for (std::size_t i = 0; i + 1 < fill; ++i)
+        if (bins[i] != 0)
+        {
+          List_node_base* const run = bins[i];
+          List_node_base* const later = carry;
+          bins[i] = 0;
+          carry = 0;
+          S_merge_runs(carry, run, later, comp);
+        }
+    }
+    catch(...)
+    {
+      List_node_base* all = S_concat(carry, rest);
+      for (std::size_t i = 0; i < fill; ++i)
+        all = S_concat(bins[i], all);
+      M_relink(all);
+      throw;
+    }
+    M_merge_relink(bins[fill - 1], carry, comp);
+  }
+
+protected:
+  // Internal constructor functions follow.
+
+  // Called by the range constructor to implement [23.1.1]/9
+  template <typename Integer>
+  void
+  M_initialize_dispatch(Integer n, Integer x, __true_type)
+  { M_fill_initialize(static_cast<size_type>(n), x); }
+
+  // Called by the range constructor to implement [23.1.1]/9
+  template <typename InputIterator>
+  void
+  M_initialize_dispatch(InputIterator first, InputIterator last,
+                        __false_type)
+  {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  // Called by list(n,v,a), and the range constructor when it turns out
+  // to be the same thing.
+  void
+  M_fill_initialize(size_type n, const value_type& x)
+  {
+    for (; n > 0; --n)
+      push_back(x);
+  }
+
+  // Internal assign functions follow.
+
+  // Called by the range assign to implement [23.1.1]/9
+  template <typename Integer>
+  void
+  M_assign_dispatch(Integer n, Integer val, __true_type)
+  { M_fill_assign(static_cast<size_type>(n), static_cast<Tp>(val)); }
+
+  // Called by the range assign to implement [23.1.1]/9
+  template <typename InputIterator>
+  void
+  M_assign_dispatch(InputIterator first2, InputIterator last2,
+                    __false_type)
+  {
+    iterator first1 = begin();
+    iterator last1 = end();
+    for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+      *first1 = *first2;
+    if (first2 == last2)
+      erase(first1, last1);
+    else
+      insert(last1, first2, last2);
+  }
+
+  // Called by assign(n,t), and the range assign when it turns out to
+  // be the same thing.
+  void
+  M_fill_assign(size_type n, const value_type& val)
+  {
+    iterator i = begin();
+    for (; i != end() && n > 0; ++i, --n)
+      *i = val;
+    if (n > 0)
+      insert(end(), n, val);
+    else
+      erase(i, end());
+  }
+
+  // Erases element at position given.
+  void
+  M_erase(iterator position)
+  {
+    position.M_node->M_unhook();
+    Node* n = static_cast<Node*>(position.M_node);
+    Tp_alloc_type(M_get_Node_allocator()).destroy(&n->M_data);
+    M_put_node(n);
+  }
+
+  // Destroys and frees a chain of unlinked nodes, linked through
+  // M_next and ending in a null pointer.
+  void
+  M_destroy_chain(List_node_base* p)
+  {
+    Tp_alloc_type tp_alloc(M_get_Node_allocator());
+    while (p != 0)
+    {
+      Node* n = static_cast<Node*>(p);
+      p = p->M_next;
+      tp_alloc.destroy(&n->M_data);
+      M_put_node(n);
+    }
+  }
+
+  // Makes the null-terminated chain from @a first the whole list,
+  // rebuilding the M_prev links.
+  void
+  M_relink(List_node_base* first)
+  {
+    List_node_base* prev = &M_impl.M_node;
+    for (; first != 0; first = first->M_next)
+    {
+      prev->M_next = first;
+      first->M_prev = prev;
+      prev = first;
+    }
+    prev->M_next = &M_impl.M_node;
+    M_impl.M_node.M_prev = prev;
+  }
+
+  // S_merge_runs() of @a a and @a b into the list, linking each node
+  // both ways as it is placed. Should @a comp throw, the nodes left
+  // follow those placed.
+  template <typename StrictWeakOrdering>
+  void
+  M_merge_relink(List_node_base* a, List_node_base* b,
+                 StrictWeakOrdering& comp)
+  {
+    List_node_base* prev = &M_impl.M_node;
+    try
+    {
+      while (a != 0 && b != 0)
+      {
+        List_node_base* n;
+        if (comp(static_cast<Node*>(b)->M_data,
+                 static_cast<Node*>(a)->M_data))
+        {
+          n = b;
+          b = b->M_next;
+        }
+        else
+        {
+          n = a;
+          a = a->M_next;
+        }
+        prev->M_next = n;
+        n->M_prev = prev;
+        prev = n;
+      }
+    }
+    catch(...)
+    {
+      prev->M_next = S_concat(a, b);
+      M_relink(M_impl.M_node.M_next);
+      throw;
+    }
+    for (a = a != 0 ? a : b; a != 0; a = a->M_next)
+    {
+      prev->M_next = a;
+      a->M_prev = prev;
+      prev = a;
+    }
+    prev->M_next = &M_impl.M_node;
+    M_impl.M_node.M_prev = prev;
+  }
+
+  // Appends the null-terminated chain @a b to the chain @a a.
+  static List_node_base*
+  S_concat(List_node_base* a, List_node_base* b)
+  {
+    if (a == 0)
+      return b;
+    List_node_base* p = a;
+    while (p->M_next != 0)
+      p = p->M_next;
+    p->M_next = b;
+    return a;
+  }
+
+  // Stable merge of the sorted null-terminated chains @a a and @a b, the
+  // elements of @a a coming first among equals, stored through @a out
+  // as it goes. Should @a comp throw, @a out still ends up holding
+  // every node of both.
+  template <typename StrictWeakOrdering>
+  static void
+  S_merge_runs(List_node_base*& out, List_node_base* a, List_node_base* b,
+               StrictWeakOrdering& comp)
+  {
+    List_node_base** tail = &out;
+    try
+    {
+      while (a != 0 && b != 0)
+        if (comp(static_cast<Node*>(b)->M_data,
+                 static_cast<Node*>(a)->M_data))
+        {
+          *tail = b;
+          tail = &b->M_next;
+          b = b->M_next;
+        }
+        else
+        {
+          *tail = a;
+          tail = &a->M_next;
+          a = a->M_next;
+        }
+    }
+    catch(...)
+    {
+      *tail = S_concat(a, b);
+      throw;
+    }
+    *tail = a != 0 ? a : b;
+  }
+
+  // Equality predicate for remove().
+  struct Remove_equal
+  {
+    const Tp& M_value;
+
+    explicit
+    Remove_equal(const Tp& value)
+    : M_value(value) { }
+
+    bool
+    operator()(const Tp& x) const
+    { return x == M_value; }
+  };
+};
+
+/**
+ * @brief List equality comparison.
+ * @param x A %list.
+ * @param y A %list of the same type as @a x.
+ * @return True iff the size and elements of the lists are equal.
+ *
+ * This is an equivalence relation. It is linear in the size of the
+ * lists. Lists are considered equivalent if their sizes are equal, and
+ * if corresponding elements compare equal.
+ */
+template <typename Tp, typename Alloc>
+inline bool
+operator==(const list<Tp, Alloc>& x, const list<Tp, Alloc>& y)
+{
+  typedef typename list<Tp, Alloc>::const_iterator const_iterator;
+  const_iterator end1 = x.end();
+  const_iterator end2 = y.end();
+
+  const_iterator i1 = x.begin();
+  const_iterator i2 = y.begin();
+  while (i1 != end1 && i2 != end2 && *i1 == *i2)
+  {
+    ++i1;
+    ++i2;
+  }
+  return i1 == end1 && i2 == end2;
+}
+
+/**
+ * @brief List ordering relation.
+ * @param x A %list.
+ * @param y A %list of the same type as @a x.
+ * @return True iff @a x is lexicographically less than @a y.
+ *
+ * This is a total ordering relation. It is linear in the size of the
+ * lists. The elements must be comparable with @c <.
+ */
+template <typename Tp, typename Alloc>
+inline bool
+operator<(const list<Tp, Alloc>& x, const list<Tp, Alloc>& y)
+{
+  return ft::lexicographical_compare(x.begin(), x.end(),
+                                     y.begin(), y.end());
+}
+
+/// Based on operator==
+template <typename Tp, typename Alloc>
+inline bool
+operator!=(const list<Tp, Alloc>& x, const list<Tp, Alloc>& y)
+{ return !(x == y); }
+
+/// Based on operator<
+template <typename Tp, typename Alloc>
+inline bool
+operator>(const list<Tp, Alloc>& x, const list<Tp, Alloc>& y)
+{ return y < x; }
+
+/// Based on operator<
+template <typename Tp, typename Alloc>
+inline bool
+operator<=(const list<Tp, Alloc>& x, const list<Tp, Alloc>& y)
+{ return !(y < x); }
+
+/// Based on operator<
+template <typename Tp, typename Alloc>
+inline bool
+operator>=(const list<Tp, Alloc>& x, const list<Tp, Alloc>& y)
+{ return !(x < y); }
+
+/// See ft::list::swap().
+template <typename Tp, typename Alloc>
+inline void
+swap(list<Tp, Alloc>& x, list<Tp, Alloc>& y)
+{ x.swap(y); }
+
+} // ft
+
+#endif // STL_LIST_H_
@@ -38,7 +38,8 @@ namespace ft {
  *  @endif
 */
 template <typename Key, typename Tp, typename Compare = std::less<Key>,
-          typename Alloc = std::allocator<ft::pair<const Key, Tp> > >
+          typename Alloc = std::allocator<ft::pair<const Key, Tp> >,
+          typename NodeUpdate = Rb_tree_null_node_update>
 class map
 {
 public:
@@ -55,7 +56,7 @@ public:
   class value_compare
   : public std::binary_function<value_type, value_type, bool>
   {
-    friend class map<Key, Tp, Compare, Alloc>;
+    friend class map<Key, Tp, Compare, Alloc, NodeUpdate>;
     protected:
       Compare comp;
 
@@ -71,7 +72,7 @@ private:
   /// @if maint  This turns a red-black tree into a [multi]map.  @endif
   typedef typename Alloc::template rebind<value_type>::other  Pair_alloc_type;
   typedef Rb_tree<key_type, value_type, Select1st<value_type>, 
-                key_compare, Pair_alloc_type>                 Rep_type;
+                key_compare, Pair_alloc_type, NodeUpdate>     Rep_type;
 
   /// @if maint  The actual tree structure.  @endif
   Rep_type M_t;
@@ -89,6 +90,8 @@ public:
   typedef typename Rep_type::difference_type        difference_type;
   typedef typename Rep_type::reverse_iterator       reverse_iterator;
   typedef typename Rep_type::const_reverse_iterator const_reverse_iterator;
+  typedef Rb_tree_map_node_handle<Rep_type>         node_type;
+  typedef Rb_tree_insert_return<iterator, node_type> insert_return_type;
 
   // [23.3.1.1] construct/copy/destroy
   // (get_allocator() is normally listed in this section, but seems to have
@@ -117,6 +120,18 @@ public:
   map(const map& x)
   : M_t(x.M_t) { }
 
+  /**
+   *  @brief  Map copy constructor working on several threads.
+   *  @param  policy  ft::par, or ft::par(n) for n threads.
+   *  @param  x  A %map of identical element and allocator types.
+   *
+   *  As map(x), but the top levels of the tree are split among threads,
+   *  each copying a whole subtree.  The allocator must allow concurrent
+   *  use.  Programs that cannot start threads use a single thread.
+   */
+  map(const parallel_policy& policy, const map& x)
+  : M_t(x.M_t, policy) { }
+
   /**
    *  @brief  Builds a %map from a range.
    *  @param  first  An input iterator.
@@ -148,6 +163,27 @@ public:
   : M_t(comp, a)
   { M_t.M_insert_unique(first, last); }
 
+  /**
+   *  @brief  Builds a %map from a range on several threads.
+   *  @param  policy  ft::par, or ft::par(n) for n threads.
+   *  @param  first  An input iterator.
+   *  @param  last  An input iterator.
+   *  @param  comp  A comparison functor.
+   *  @param  a  An allocator object; it must allow concurrent use.
+   *
+   *  Same contents as map(first, last): of equivalent elements the first
+   *  wins.  The range is copied and sorted on several threads, and the
+   *  tree is then built straight from the sorted elements, the subtrees
+   *  near the root in parallel.  O(N log N / threads + N).  Programs
+   *  that cannot start threads use a single thread.
+   */
+  template <typename InputIterator>
+  map(const parallel_policy& policy, InputIterator first, InputIterator last,
+      const Compare& comp = Compare(),
+      const allocator_type& a = allocator_type())
+  : M_t(comp, a)
+  { M_t.M_build_unique(first, last, policy); }
+
   // FIXME There is no dtor declared, but we should have something
   // generated by Doxygen.  I don't know what tags to add to this
   // paragraph to make that happen:
@@ -171,6 +207,21 @@ public:
     return *this;
   }
 
+  /**
+   *  @brief  Assignment working on several threads.
+   *  @param  policy  ft::par, or ft::par(n) for n threads.
+   *  @param  x  A %map of identical element and allocator types.
+   *
+   *  As operator=, with the old elements freed as by clear(policy) and
+   *  the new ones copied as by the parallel copy constructor.
+   */
+  map&
+  assign(const parallel_policy& policy, const map& x)
+  {
+    M_t.M_assign(x.M_t, policy);
+    return *this;
+  }
+
   /// Get a copy of the memory allocation object.
   allocator_type
   get_allocator() const
@@ -278,17 +329,11 @@ public:
    *  subscript.  If the key does not exist, a pair with that key
    *  is created using default values, which is then returned.
    *
-   *  Lookup requires logarithmic time.
+   *  Lookup requires logarithmic time: one descent, as try_emplace().
    */
   mapped_type&
   operator[](const key_type& k)
-  {
-    iterator i = lower_bound(k);
-    // __i->first is greater than or equivalent to __k.
-    if (i == end() || key_comp()(k, (*i).first))
-      i = insert(i, value_type(k, mapped_type()));
-    return (*i).second;
-  }
+  { return (*try_emplace(k).first).second; }
 
   // _GLIBCXX_RESOLVE_LIB_DEFECTS
   // DR 464. Suggestion for new member functions in standard containers.
@@ -378,6 +423,214 @@ public:
   insert(InputIterator first, InputIterator last)
   { M_t.M_insert_unique(first, last); }
 
+  /**
+   *  @brief Inserts a batch of elements in one merged pass.
+   *  @param  first  Iterator pointing to the start of the batch.
+   *  @param  last  Iterator pointing to the end of the batch.
+   *
+   *  Same result as insert(first, last), but the batch is sorted first
+   *  and then merged into the tree, each element being placed by a
+   *  finger search from its predecessor.  Clustered batches of m
+   *  elements cost roughly O(m log(n/m)) instead of O(m log n).  A
+   *  forward range of value_type or of pairs is sorted through
+   *  iterators into it; other batches are copied once into a buffer.
+   */
+  template <typename InputIterator>
+  void
+  insert_batch(InputIterator first, InputIterator last)
+  { M_t.M_insert_unique_batch(first, last); }
+
+  /**
+   *  @brief  Inserts an element for @a k unless one is already present.
+   *  @param  k  Key of the element.
+   *  @return  A pair of an iterator to the element with key @a k and a
+   *           bool that is true if it was inserted.
+   *
+   *  The tree is searched once.  Only on a miss is a node allocated, its
+   *  mapped value being constructed in place from the remaining
+   *  arguments (here: value-initialized); when @a k is present nothing
+   *  is constructed.  Logarithmic.
+   */
+  ft::pair<iterator, bool>
+  try_emplace(const key_type& k)
+  { return M_t.M_emplace_unique_key(k, Construct_from0<mapped_type>()); }
+
+  /**
+   *  @brief  As try_emplace(k), the mapped value being built as
+   *          mapped_type(a1).
+   */
+  template <typename Arg1>
+  ft::pair<iterator, bool>
+  try_emplace(const key_type& k, const Arg1& a1)
+  {
+    return M_t.M_emplace_unique_key(k,
+        Construct_from1<mapped_type, Arg1>(a1));
+  }
+
+  /**
+   *  @brief  As try_emplace(k), the mapped value being built as
+   *          mapped_type(a1, a2).
+   */
+  template <typename Arg1, typename Arg2>
+  ft::pair<iterator, bool>
+  try_emplace(const key_type& k, const Arg1& a1, const Arg2& a2)
+  {
+    return M_t.M_emplace_unique_key(k,
+        Construct_from2<mapped_type, Arg1, Arg2>(a1, a2));
+  }
+
+  /**
+   *  @brief  As try_emplace(k), searching from a hint.
+   *  @param  position  Iterator near where the element belongs.
+   *  @return  Iterator to the element with key @a k.
+   *
+   *  The search costs O(log d), d being the distance from @a position.
+   */
+  iterator
+  try_emplace(iterator position, const key_type& k)
+  {
+    return M_t.M_emplace_unique_key(position, k,
+        Construct_from0<mapped_type>()).first;
+  }
+
+  template <typename Arg1>
+  iterator
+  try_emplace(iterator position, const key_type& k, const Arg1& a1)
+  {
+    return M_t.M_emplace_unique_key(position, k,
+        Construct_from1<mapped_type, Arg1>(a1)).first;
+  }
+
+  template <typename Arg1, typename Arg2>
+  iterator
+  try_emplace(iterator position, const key_type& k, const Arg1& a1,
+              const Arg2& a2)
+  {
+    return M_t.M_emplace_unique_key(position, k,
+        Construct_from2<mapped_type, Arg1, Arg2>(a1, a2)).first;
+  }
+
+  /**
+   *  @brief  Inserts an element, or assigns to the existing one.
+   *  @param  k  Key of the element.
+   *  @param  obj  Value for the mapped part.
+   *  @return  A pair of an iterator to the element with key @a k and a
+   *           bool that is true if it was inserted, false if assigned.
+   *
+   *  One descent either way.  On a miss the mapped value is constructed
+   *  in place from @a obj, on a hit it is assigned from @a obj; unlike
+   *  operator[], no default-constructed value is ever made.  With an
+   *  aggregating @a NodeUpdate the tree is refreshed after assignment.
+   */
+  template <typename Obj>
+  ft::pair<iterator, bool>
+  insert_or_assign(const key_type& k, const Obj& obj)
+  {
+    ft::pair<iterator, bool> r = M_t.M_emplace_unique_key(k,
+        Construct_from1<mapped_type, Obj>(obj));
+    if (!r.second)
+    {
+      (*r.first).second = obj;
+      M_t.M_refresh(r.first);
+    }
+    return r;
+  }
+
+  /**
+   *  @brief  As insert_or_assign(k, obj), searching from a hint.
+   *  @return  Iterator to the element with key @a k.
+   */
+  template <typename Obj>
+  iterator
+  insert_or_assign(iterator position, const key_type& k, const Obj& obj)
+  {
+    ft::pair<iterator, bool> r = M_t.M_emplace_unique_key(position, k,
+        Construct_from1<mapped_type, Obj>(obj));
+    if (!r.second)
+    {
+      (*r.first).second = obj;
+      M_t.M_refresh(r.first);
+    }
+    return r.first;
+  }
+
+  /**
+   *  @brief  Inserts the node owned by a node handle.
+   *  @param  nh  Handle obtained from extract() on a %map of the same type.
+   *  @return  An insert_return_type: where the element is, whether it was
+   *           inserted, and, if it was not, the handle still owning it.
+   *
+   *  The node is linked as is: nothing is copied or allocated.  An empty
+   *  handle inserts nothing and yields end().
+   */
+  insert_return_type
+  insert(node_type nh)
+  {
+    insert_return_type r;
+    r.position = end();
+    r.inserted = false;
+    if (!nh.empty())
+    {
+      ft::pair<typename Rep_type::iterator, bool> p
+        = M_t.M_insert_node_unique(nh.M_get());
+      r.position = p.first;
+      r.inserted = p.second;
+      if (p.second)
+        nh.M_release();
+      else
+        r.node.swap(nh);
+    }
+    return r;
+  }
+
+  /**
+   *  @brief  Inserts the node owned by a node handle, using a hint.
+   *  @param  position  Iterator near where the element belongs.
+   *  @param  nh  Handle obtained from extract(), taken by value.
+   *  @return  Iterator to the inserted element, or to the equal element
+   *           that prevented insertion.
+   *
+   *  The search starts from @a position and costs O(log d) where d is
+   *  its distance to the insertion point.  @a nh being taken by value, a
+   *  node that cannot be inserted is freed with it; insert(node_type)
+   *  hands such a node back instead.
+   */
+  iterator
+  insert(iterator position, node_type nh)
+  {
+    if (nh.empty())
+      return end();
+    ft::pair<typename Rep_type::iterator, bool> p
+      = M_t.M_insert_node_unique(position, nh.M_get());
+    if (p.second)
+      nh.M_release();
+    return p.first;
+  }
+
+  /**
+   *  @brief  Unlinks an element and hands over its node.
+   *  @param  position  Iterator to the element; must be dereferenceable.
+   *  @return  A node handle owning the element.
+   *
+   *  The node is neither copied nor freed, so the element can be moved
+   *  to another %map, or given a new key, and reinserted with insert().
+   *  Only iterators to the extracted element are invalidated.
+   */
+  node_type
+  extract(iterator position)
+  { return node_type(M_t.M_extract(position), M_t.M_get_Node_allocator()); }
+
+  /**
+   *  @brief  Unlinks the element with key @a x, if any.
+   *  @return  A node handle owning it, or an empty handle.
+   */
+  node_type
+  extract(const key_type& x)
+  {
+    iterator i = find(x);
+    return i == end() ? node_type() : extract(i);
+  }
+
   /**
    *  @brief Erases an element from a %map.
    *  @param  position  An iterator pointing to the element to be erased.
@@ -447,6 +700,34 @@ public:
   clear()
   { M_t.clear(); }
 
+  /**
+   *  @brief  Erases all elements on several threads.
+   *  @param  policy  ft::par, or ft::par(n) for n threads.
+   *
+   *  The top levels of the tree are split among threads, each freeing a
+   *  whole subtree.  The allocator must allow concurrent use, and the
+   *  destructors of the elements must not throw.
+   */
+  void
+  clear(const parallel_policy& policy)
+  { M_t.clear(policy); }
+
+  /**
+   *  @brief  Empties the %map at once, leaving the elements to be
+   *  destroyed by a background thread.
+   *
+   *  Constant time for the caller.  The nodes are handed, with a copy of
+   *  the allocator, to a background job on thread_pool::default_pool(),
+   *  so the allocator copy must stay usable on its own and the
+   *  destructors of the elements must be safe to run on another thread.
+   *  Call it before dropping a large %map to keep the destructor cheap.
+   *  Programs that cannot start threads destroy the elements here.  Like
+   *  the ft::par overloads, this needs parallel.hpp.
+   */
+  void
+  clear_in_background()
+  { M_t.M_clear_in_background(); }
+
   // observers
   /**
    *  Returns the key comparison object out of which the %map was
@@ -480,6 +761,13 @@ public:
   find(const key_type& x)
   { return M_t.find(x); }
 
+  /// Heterogeneous find(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         iterator>::type
+  find(const Kt& x)
+  { return M_t.M_find_tr(x); }
+
   /**
    *  @brief Tries to locate an element in a %map.
    *  @param  x  Key of (key, value) %pair to be located.
@@ -495,6 +783,13 @@ public:
   find(const key_type& x) const
   { return M_t.find(x); }
 
+  /// Heterogeneous find(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         const_iterator>::type
+  find(const Kt& x) const
+  { return M_t.M_find_tr(x); }
+
   /**
    *  @brief  Finds the number of elements with given key.
    *  @param  x  Key of (key, value) pairs to be located.
@@ -507,6 +802,13 @@ public:
   count(const key_type& x) const
   { return M_t.find(x) == M_t.end() ? 0 : 1; }
 
+  /// Heterogeneous count(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         size_type>::type
+  count(const Kt& x) const
+  { return M_t.M_count_tr(x); }
+
   /**
    *  @brief Finds the beginning of a subsequence matching given key.
    *  @param  x  Key of (key, value) pair to be located.
@@ -522,6 +824,13 @@ public:
   lower_bound(const key_type& x)
   { return M_t.lower_bound(x); }
 
+  /// Heterogeneous lower_bound(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         iterator>::type
+  lower_bound(const Kt& x)
+  { return M_t.M_lower_bound_tr(x); }
+
   /**
    *  @brief Finds the beginning of a subsequence matching given key.
    *  @param  x  Key of (key, value) pair to be located.
@@ -537,6 +846,13 @@ public:
   lower_bound(const key_type& x) const
   { return M_t.lower_bound(x); }
 
+  /// Heterogeneous lower_bound(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         const_iterator>::type
+  lower_bound(const Kt& x) const
+  { return M_t.M_lower_bound_tr(x); }
+
   /**
    *  @brief Finds the end of a subsequence matching given key.
    *  @param  x  Key of (key, value) pair to be located.
@@ -547,6 +863,13 @@ public:
   upper_bound(const key_type& x)
   { return M_t.upper_bound(x); }
 
+  /// Heterogeneous upper_bound(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         iterator>::type
+  upper_bound(const Kt& x)
+  { return M_t.M_upper_bound_tr(x); }
+
   /**
    *  @brief Finds the end of a subsequence matching given key.
    *  @param  x  Key of (key, value) pair to be located.
@@ -557,6 +880,13 @@ public:
   upper_bound(const key_type& x) const
   { return M_t.upper_bound(x); }
 
+  /// Heterogeneous upper_bound(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         const_iterator>::type
+  upper_bound(const Kt& x) const
+  { return M_t.M_upper_bound_tr(x); }
+
   /**
    *  @brief Finds a subsequence matching given key.
    *  @param  x  Key of (key, value) pairs to be located.
@@ -576,6 +906,13 @@ public:
   equal_range(const key_type& x)
   { return M_t.equal_range(x); }
 
+  /// Heterogeneous equal_range(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         ft::pair<iterator, iterator> >::type
+  equal_range(const Kt& x)
+  { return M_t.M_equal_range_tr(x); }
+
   /**
    *  @brief Finds a subsequence matching given key.
    *  @param  x  Key of (key, value) pairs to be located.
@@ -595,13 +932,260 @@ public:
   equal_range(const key_type& x) const
   { return M_t.equal_range(x); }
 
-  template <typename K1, typename T1, typename C1, typename A1>
+  /// Heterogeneous equal_range(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         ft::pair<const_iterator, const_iterator> >::type
+  equal_range(const Kt& x) const
+  { return M_t.M_equal_range_tr(x); }
+
+  /**
+   *  @brief  Looks up a sequence of keys in one pass.
+   *  @param  keys_first  Input iterator to the first key.
+   *  @param  keys_last  Input iterator past the last key.
+   *  @param  out  Output iterator receiving one iterator per key.
+   *  @return  @a out past the last iterator written.
+   *
+   *  Writes, in input order, what find() would return for each key.
+   *  The searches are run several at a time, level by level, so that
+   *  their cache misses overlap; for large maps this is substantially
+   *  faster than calling find() in a loop.
+   */
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator
+  find_many(InputIterator keys_first, InputIterator keys_last,
+            OutputIterator out)
+  {
+    return M_t.template M_lower_bound_many<iterator>(keys_first, keys_last,
+                                                     out, true);
+  }
+
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator
+  find_many(InputIterator keys_first, InputIterator keys_last,
+            OutputIterator out) const
+  {
+    return M_t.template M_lower_bound_many<const_iterator>(keys_first,
+                                                           keys_last,
+                                                           out, true);
+  }
+
+  /**
+   *  @brief  Finds the lower bounds of a sequence of keys in one pass.
+   *
+   *  As find_many(), but writes what lower_bound() would return.
+   */
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator
+  lower_bound_many(InputIterator keys_first, InputIterator keys_last,
+                   OutputIterator out)
+  {
+    return M_t.template M_lower_bound_many<iterator>(keys_first, keys_last,
+                                                     out, false);
+  }
+
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator
+  lower_bound_many(InputIterator keys_first, InputIterator keys_last,
+                   OutputIterator out) const
+  {
+    return M_t.template M_lower_bound_many<const_iterator>(keys_first,
+                                                           keys_last,
+                                                           out, false);
+  }
+
+  /**
+   *  @brief  Looks up an ascending sequence of keys in one walk.
+   *  @param  first  Input iterator to the first key.
+   *  @param  last  Input iterator past the last key.
+   *  @param  out  Output iterator receiving one iterator per key.
+   *  @return  @a out past the last iterator written.
+   *
+   *  Writes, in input order, what find() would return for each key.
+   *  Each search starts where the previous one ended and moves up only
+   *  as far as needed, so m sorted keys cost O(m log(n/m)) rather than
+   *  O(m log n).  Unsorted keys are still handled correctly.
+   */
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator
+  find_sorted(InputIterator first, InputIterator last, OutputIterator out)
+  { return M_t.template M_find_sorted<iterator>(first, last, out); }
+
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator
+  find_sorted(InputIterator first, InputIterator last,
+              OutputIterator out) const
+  { return M_t.template M_find_sorted<const_iterator>(first, last, out); }
+
+  /**
+   *  @brief  Counts how many of an ascending sequence of keys are present.
+   *
+   *  Same walk as find_sorted(); each key of the input is counted.
+   */
+  template <typename InputIterator>
+  size_type
+  count_sorted(InputIterator first, InputIterator last) const
+  { return M_t.M_count_sorted(first, last); }
+
+  /**
+   *  @brief  Accesses the element at position @a n in key order.
+   *  @param  n  Zero-based position; must be less than size().
+   *  @return  Iterator to the @a n th smallest element.
+   *
+   *  The order-statistic members nth(), rank() and distance() run in
+   *  logarithmic time and are only available when @a NodeUpdate is
+   *  Rb_tree_order_statistics_node_update.
+   */
+  iterator
+  nth(size_type n)
+  { return M_t.M_select(n); }
+
+  const_iterator
+  nth(size_type n) const
+  { return M_t.M_select(n); }
+
+  /**
+   *  @brief  Number of elements whose key is less than @a x.
+   *  @param  x  Key to be ranked; it need not be present.
+   */
+  size_type
+  rank(const key_type& x) const
+  { return M_t.M_rank(x); }
+
+  /**
+   *  @brief  Number of increments needed to go from @a first to @a last.
+   *
+   *  Equivalent to std::distance(first, last) in logarithmic time.
+   */
+  difference_type
+  distance(const_iterator first, const_iterator last) const
+  { return difference_type(M_t.M_index(last)) - M_t.M_index(first); }
+
+  /**
+   *  @brief  Folds the mapped values with keys in [@a first_key, @a last_key).
+   *  @return  The monoid combination, in key order, of those mapped values;
+   *           the identity when the range is empty.
+   *
+   *  Runs in logarithmic time.  Only available when @a NodeUpdate is
+   *  Rb_tree_aggregate_node_update<Monoid>.
+   */
+  typename Rep_type::aggregate_type
+  accumulate(const key_type& first_key, const key_type& last_key) const
+  { return M_t.M_accumulate(first_key, last_key); }
+
+  /**
+   *  @brief  Brings the aggregates up to date after a mapped value changed.
+   *  @param  position  Iterator to the element that was modified.
+   *
+   *  The tree cannot see assignments made through an iterator or
+   *  operator[], so with an aggregating @a NodeUpdate every such
+   *  assignment must be followed by a call to refresh().  Logarithmic.
+   */
+  void
+  refresh(iterator position)
+  { M_t.M_refresh(position); }
+
+  /**
+   *  @brief  Lookup cursor that remembers where the last search ended.
+   *
+   *  Each lookup made through a %cursor starts from the position found
+   *  by the previous one instead of from the root: it climbs only until
+   *  an ancestor brackets the key and then descends.  A lookup for a key
+   *  d positions away from the previous result costs O(log d), which
+   *  makes scans over nearby keys (sliding windows, merges) cheap.
+   *
+   *  A %cursor is invalidated, like an iterator, when the element it
+   *  rests on is erased; seek() repositions it.
+   */
+  class cursor
+  {
+  public:
+    cursor()
+    : M_cont(0), M_pos() { }
+
+    explicit
+    cursor(map& c)
+    : M_cont(&c), M_pos(c.end()) { }
+
+    /// The position found by the last lookup (end() initially).
+    iterator
+    position() const
+    { return M_pos; }
+
+    /// Moves the cursor to @a it, which must belong to the same %map.
+    void
+    seek(iterator it)
+    { M_pos = it; }
+
+    /// Same as map::lower_bound(), searching from the last position.
+    iterator
+    lower_bound(const key_type& k)
+    { return M_pos = M_cont->M_t.lower_bound(M_pos, k); }
+
+    /// Same as map::upper_bound(), searching from the last position.
+    iterator
+    upper_bound(const key_type& k)
+    { return M_pos = M_cont->M_t.upper_bound(M_pos, k); }
+
+    /// Same as map::find(), searching from the last position.  On a miss
+    /// the cursor still moves to lower_bound(k).
+    iterator
+    find(const key_type& k)
+    {
+      lower_bound(k);
+      if (M_pos == M_cont->end() || M_cont->key_comp()(k, (*M_pos).first))
+        return M_cont->end();
+      return M_pos;
+    }
+
+  private:
+    map*      M_cont;
+    iterator  M_pos;
+  };
+
+  friend class cursor;
+
+  template <typename K1, typename T1, typename C1, typename A1,
+            typename U1>
   friend bool
-  operator== (const map<K1, T1, C1, A1>&, const map<K1, T1, C1, A1>&);
+  operator== (const map<K1, T1, C1, A1, U1>&, const map<K1, T1, C1, A1, U1>&);
 
-  template <typename K1, typename T1, typename C1, typename A1>
+  template <typename K1, typename T1, typename C1, typename A1,
+            typename U1>
   friend bool
-  operator< (const map<K1, T1, C1, A1>&, const map<K1, T1, C1, A1>&);
+  operator< (const map<K1, T1, C1, A1, U1>&, const map<K1, T1, C1, A1, U1>&);
+
+  template <typename K1, typename T1, typename C1, typename A1,
+            typename U1, typename F1>
+  friend void
+  parallel_for_each(const parallel_policy&, map<K1, T1, C1, A1, U1>&, F1);
+
+  template <typename K1, typename T1, typename C1, typename A1,
+            typename U1, typename F1>
+  friend void
+  parallel_for_each(const parallel_policy&, const map<K1, T1, C1, A1, U1>&,
+                    F1);
+
+  template <typename K1, typename T1, typename C1, typename A1,
+            typename U1, typename R1, typename F1, typename G1>
+  friend R1
+  parallel_reduce(const parallel_policy&, const map<K1, T1, C1, A1, U1>&,
+                  R1, F1, G1);
+
+  template <typename K1, typename T1, typename C1, typename A1,
+            typename U1, typename F1>
+  friend void
+  parallel_for_each(map<K1, T1, C1, A1, U1>&, F1);
+
+  template <typename K1, typename T1, typename C1, typename A1,
+            typename U1, typename F1>
+  friend void
+  parallel_for_each(const map<K1, T1, C1, A1, U1>&, F1);
+
+  template <typename K1, typename T1, typename C1, typename A1,
+            typename U1, typename R1, typename F1, typename G1>
+  friend R1
+  parallel_reduce(const map<K1, T1, C1, A1, U1>&, R1, F1, G1);
 };
 
 /**
@@ -614,10 +1198,11 @@ public:
  *  maps.  Maps are considered equivalent if their sizes are equal,
  *  and if corresponding elements compare equal.
 */
-template <typename Key, typename Tp, typename Compare, typename Alloc>
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate>
 bool
-operator==(const map<Key, Tp, Compare, Alloc>& x,
-          const map<Key, Tp, Compare, Alloc>& y)
+operator==(const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+          const map<Key, Tp, Compare, Alloc, NodeUpdate>& y)
 { return x.M_t == y.M_t; }
 
 /**
@@ -631,48 +1216,132 @@ operator==(const map<Key, Tp, Compare, Alloc>& x,
  *
  *  See std::lexicographical_compare() for how the determination is made.
 */
-template <typename Key, typename Tp, typename Compare, typename Alloc>
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate>
 bool
-operator<(const map<Key, Tp, Compare, Alloc>& x,
-          const map<Key, Tp, Compare, Alloc>& y)
+operator<(const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+          const map<Key, Tp, Compare, Alloc, NodeUpdate>& y)
 { return x.M_t < y.M_t; }
 
 /// Based on operator==
-template <typename Key, typename Tp, typename Compare, typename Alloc>
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate>
 bool
-operator!=(const map<Key, Tp, Compare, Alloc>& x,
-          const map<Key, Tp, Compare, Alloc>& y)
+operator!=(const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+          const map<Key, Tp, Compare, Alloc, NodeUpdate>& y)
 { return !(x == y); }
 
 /// Based on operator<
-template <typename Key, typename Tp, typename Compare, typename Alloc>
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate>
 bool
-operator>(const map<Key, Tp, Compare, Alloc>& x,
-          const map<Key, Tp, Compare, Alloc>& y)
+operator>(const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+          const map<Key, Tp, Compare, Alloc, NodeUpdate>& y)
 { return y < x; }
 
 /// Based on operator<
-template <typename Key, typename Tp, typename Compare, typename Alloc>
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate>
 bool
-operator<=(const map<Key, Tp, Compare, Alloc>& x,
-          const map<Key, Tp, Compare, Alloc>& y)
+operator<=(const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+          const map<Key, Tp, Compare, Alloc, NodeUpdate>& y)
 { return !(y < x); }
 
 /// Based on operator<
-template <typename Key, typename Tp, typename Compare, typename Alloc>
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate>
 bool
-operator>=(const map<Key, Tp, Compare, Alloc>& x,
-          const map<Key, Tp, Compare, Alloc>& y)
+operator>=(const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+          const map<Key, Tp, Compare, Alloc, NodeUpdate>& y)
 { return !(x < y); }
 
 
 /// See std::map::swap().
-template <typename Key, typename Tp, typename Compare, typename Alloc>
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate>
 void
-swap(const map<Key, Tp, Compare, Alloc>& x,
-    const map<Key, Tp, Compare, Alloc>& y)
+swap(map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+    map<Key, Tp, Compare, Alloc, NodeUpdate>& y)
 { x.swap(y); }
 
+/**
+ *  @brief  Applies a function to every element of a %map, on several
+ *  threads.
+ *  @param  policy  ft::par, or ft::par(n) for n threads.
+ *  @param  x  A %map.
+ *  @param  f  Called as f(value_type&); it may change mapped values.
+ *
+ *  The tree is cut into O(threads) balanced subtrees and the nodes
+ *  above them, which the threads claim one at a time; each piece is
+ *  walked in key order by one thread, but pieces run concurrently, so
+ *  @a f is shared and must be safe to call from several threads.  If
+ *  @a f throws, the other threads finish their pieces and no element is
+ *  visited twice.  An exception thrown on the caller then propagates;
+ *  one thrown on another thread cannot, and std::bad_alloc or
+ *  ft::parallel_error is thrown in its place.  Programs that cannot
+ *  start threads use a single thread.
+ */
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate, typename Function>
+void
+parallel_for_each(const parallel_policy& policy,
+                  map<Key, Tp, Compare, Alloc, NodeUpdate>& x, Function f)
+{ x.M_t.M_parallel_for_each(f, policy); }
+
+/// As above, with f called as f(const value_type&).
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate, typename Function>
+void
+parallel_for_each(const parallel_policy& policy,
+                  const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+                  Function f)
+{ x.M_t.M_parallel_for_each(f, policy); }
+
+/// As above, with one thread per online processor.
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate, typename Function>
+void
+parallel_for_each(map<Key, Tp, Compare, Alloc, NodeUpdate>& x, Function f)
+{ x.M_t.M_parallel_for_each(f); }
+
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate, typename Function>
+void
+parallel_for_each(const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+                  Function f)
+{ x.M_t.M_parallel_for_each(f); }
+
+/**
+ *  @brief  Folds all elements of a %map on several threads.
+ *  @param  policy  ft::par, or ft::par(n) for n threads.
+ *  @param  x  A %map.
+ *  @param  identity  Identity element of @a combine.
+ *  @param  fold  Called as fold(Result, const value_type&).
+ *  @param  combine  Called as combine(Result, Result); associative.
+ *  @return  The fold of all elements in key order.
+ *
+ *  Each piece of the tree (see parallel_for_each) is folded from
+ *  @a identity by one thread, and the partial results are combined in
+ *  key order, so @a combine need not be commutative.
+ */
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate, typename Result, typename Fold,
+          typename Combine>
+Result
+parallel_reduce(const parallel_policy& policy,
+                const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+                Result identity, Fold fold, Combine combine)
+{ return x.M_t.M_parallel_reduce(identity, fold, combine, policy); }
+
+/// As above, with one thread per online processor.
+template <typename Key, typename Tp, typename Compare, typename Alloc,
+          typename NodeUpdate, typename Result, typename Fold,
+          typename Combine>
+Result
+parallel_reduce(const map<Key, Tp, Compare, Alloc, NodeUpdate>& x,
+                Result identity, Fold fold, Combine combine)
+{ return x.M_t.M_parallel_reduce(identity, fold, combine); }
+
 } // ft
 
 #endif // STL_MAP_H_
\ No newline at end of file
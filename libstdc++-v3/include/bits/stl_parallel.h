@@ -0,0 +1,324 @@
+// Parallel execution support -*- C++ -*-
+
+/** @file stl_parallel.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_PARALLEL_H_
+#define STL_PARALLEL_H_
+
+#include <cstddef>
+#include <algorithm>
+#include <new>
+#include <exception>
+#include <bits/gthr.h>
+#include <unistd.h>
+#include "stl_thread_pool.h"
+
+namespace ft {
+
+/**
+ *  @brief  Tag selecting the parallel overload of an operation, e.g.
+ *  map(ft::par, first, last).  ft::par(n) splits the work n ways; plain
+ *  ft::par one way per online processor.  The pieces all run on
+ *  thread_pool::default_pool().  Programs that cannot start threads
+ *  run everything on the calling thread.
+ *
+ *  Provided by parallel.hpp, which a program using the parallel
+ *  operations of map and set must include as well: map.hpp and set.hpp
+ *  only declare them, so that serial code never pulls in the pool.
+ */
+struct parallel_policy
+{
+  std::size_t M_threads;
+
+  explicit
+  parallel_policy(std::size_t threads = 0)
+  : M_threads(threads) { }
+
+  parallel_policy
+  operator()(std::size_t threads) const
+  { return parallel_policy(threads); }
+};
+
+const parallel_policy par = parallel_policy();
+
+enum { S_parallel_max_threads = 64 };
+
+// Whether threads can be started.  This is decided when the program
+// runs, by the same test libstdc++'s own locks make, and not by whether
+// this translation unit was built with -pthread: every translation unit
+// then sees the same definitions, and the answer is the same for all.
+inline bool
+Parallel_active()
+{ return __gthread_active_p() != 0; }
+
+// How many threads a policy stands for: at least one, at most
+// S_parallel_max_threads, and one in single-threaded programs.
+inline std::size_t
+Parallel_threads(const parallel_policy& policy)
+{
+  if (!Parallel_active())
+    return 1;
+  std::size_t n = policy.M_threads;
+  if (n == 0)
+  {
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    n = cpus > 0 ? static_cast<std::size_t>(cpus) : 1;
+  }
+  return std::min<std::size_t>(n, S_parallel_max_threads);
+}
+
+template <typename Task>
+struct Parallel_pool_task : public Pool_task
+{
+  Task* M_task;
+
+  static void
+  S_execute(Pool_task* t)
+  { static_cast<Parallel_pool_task*>(t)->M_task->M_run(); }
+};
+
+// Runs tasks[i].M_run() for every i < n: tasks[0] on the calling thread,
+// the others forked on thread_pool::default_pool(), which the caller
+// helps until all are done.  Called from within a task, this nests.
+// No task is run twice.  Once all have finished, an exception from a
+// task run on the caller propagates; one thrown by a forked task cannot
+// cross threads, and Pool_rethrow reports it instead.
+template <typename Task>
+void
+Parallel_run(Task* tasks, std::size_t n)
+{
+  if (!Parallel_active())
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      tasks[i].M_run();
+    return;
+  }
+  n = std::min<std::size_t>(n, S_parallel_max_threads);
+  if (n <= 1)
+  {
+    if (n == 1)
+      tasks[0].M_run();
+    return;
+  }
+  thread_pool* p;
+  try
+  {
+    p = &thread_pool::default_pool();
+  }
+  catch(const std::bad_alloc&)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      tasks[i].M_run();
+    return;
+  }
+  thread_pool& pool = *p;
+  Parallel_pool_task<Task> forked[S_parallel_max_threads];
+  volatile size_t pending = 0;
+  std::size_t queued = 1;
+  try
+  {
+    for (; queued < n; ++queued)
+    {
+      Parallel_pool_task<Task>& t = forked[queued];
+      t.M_execute = &Parallel_pool_task<Task>::S_execute;
+      t.M_pending = &pending;
+      t.M_failed = S_task_done;
+      t.M_task = &tasks[queued];
+      __atomic_add_fetch(&pending, size_t(1), __ATOMIC_RELAXED);
+      try
+      {
+        pool.M_push(&t);
+      }
+      catch(...)
+      {
+        __atomic_sub_fetch(&pending, size_t(1), __ATOMIC_RELAXED);
+        throw;
+      }
+    }
+  }
+  catch(const std::bad_alloc&)
+  { }
+  // Whatever could not be queued runs here too.
+  try
+  {
+    tasks[0].M_run();
+    for (std::size_t i = queued; i < n; ++i)
+      tasks[i].M_run();
+  }
+  catch(...)
+  {
+    pool.M_wait(&pending);
+    throw;
+  }
+  pool.M_wait(&pending);
+  for (std::size_t i = 1; i < queued; ++i)
+    if (forked[i].M_failed)
+      Pool_rethrow(forked[i].M_failed);
+}
+
+template <typename Tp, typename Compare>
+struct Parallel_sort_task
+{
+  Tp*      M_first;
+  Tp*      M_last;
+  Compare* M_comp;
+
+  void
+  M_run()
+  { std::stable_sort(M_first, M_last, *M_comp); }
+};
+
+template <typename Tp, typename Compare>
+struct Parallel_merge_task
+{
+  Tp*      M_first;
+  Tp*      M_middle;
+  Tp*      M_last;
+  Tp*      M_out;
+  Compare* M_comp;
+
+  void
+  M_run()
+  { std::merge(M_first, M_middle, M_middle, M_last, M_out, *M_comp); }
+};
+
+// Stable sort of [first, last) on up to `threads' threads, buffer
+// holding as many elements: a power of two of chunks is sorted at once,
+// then merged pairwise in rounds.  Meant for cheap-to-copy elements
+// such as pointers.
+template <typename Tp, typename Compare>
+void
+Parallel_stable_sort(Tp* first, Tp* last, Tp* buffer, Compare comp,
+                     std::size_t threads)
+{
+  enum { S_min_chunk = 1 << 13 };
+  const std::size_t n = last - first;
+  std::size_t chunks = 1;
+  while (chunks * 2 <= threads && n / (chunks * 2) >= S_min_chunk)
+    chunks *= 2;
+  if (chunks == 1)
+  {
+    std::stable_sort(first, last, comp);
+    return;
+  }
+
+  std::size_t bounds[S_parallel_max_threads + 1];
+  Parallel_sort_task<Tp, Compare> sorts[S_parallel_max_threads];
+  for (std::size_t i = 0; i <= chunks; ++i)
+    bounds[i] = n * i / chunks;
+  for (std::size_t i = 0; i < chunks; ++i)
+  {
+    sorts[i].M_first = first + bounds[i];
+    sorts[i].M_last = first + bounds[i + 1];
+    sorts[i].M_comp = &comp;
+  }
+  Parallel_run(sorts, chunks);
+
+  Parallel_merge_task<Tp, Compare> merges[S_parallel_max_threads / 2];
+  Tp* src = first;
+  Tp* dst = buffer;
+  for (; chunks > 1; chunks /= 2)
+  {
+    for (std::size_t i = 0; i < chunks / 2; ++i)
+    {
+      merges[i].M_first = src + bounds[2 * i];
+      merges[i].M_middle = src + bounds[2 * i + 1];
+      merges[i].M_last = src + bounds[2 * i + 2];
+      merges[i].M_out = dst + bounds[2 * i];
+      merges[i].M_comp = &comp;
+    }
+    Parallel_run(merges, chunks / 2);
+    for (std::size_t i = 0; i <= chunks / 2; ++i)
+      bounds[i] = bounds[2 * i];
+    std::swap(src, dst);
+  }
+  if (src != first)
+    std::copy(src, src + n, first);
+}
+
+/**
+ *  @if maint
+ *  Runs cleanup jobs handed over by containers in the background, on
+ *  thread_pool::default_pool(), so that freeing a large structure does
+ *  not stall the thread that drops it.  Jobs still queued at exit are
+ *  not run.  In programs that cannot start threads, or if a job cannot
+ *  be queued, it runs at once on the submitter.
+ *  @endif
+ */
+class Parallel_reclaimer
+{
+public:
+  struct Job : public Pool_task
+  {
+    void (*M_run)(Job*);   // Runs the job, then frees it.
+  };
+
+private:
+  // Jobs queued and not yet run.
+  static volatile size_t&
+  S_pending()
+  {
+    static volatile size_t pending = 0;
+    return pending;
+  }
+
+  // The job is gone once M_run returns, so nothing may be left for
+  // Pool_execute to record: an exception ends the program, as one
+  // escaping any other thread would.
+  static void
+  S_execute(Pool_task* t)
+  {
+    Job* const j = static_cast<Job*>(t);
+    try
+    {
+      j->M_run(j);
+    }
+    catch(...)
+    {
+      std::terminate();
+    }
+  }
+
+public:
+  static void
+  S_submit(Job* j)
+  {
+    if (Parallel_active())
+    {
+      j->M_execute = &S_execute;
+      j->M_pending = &S_pending();
+      j->M_failed = S_task_done;
+      __atomic_add_fetch(&S_pending(), size_t(1), __ATOMIC_RELAXED);
+      try
+      {
+        thread_pool::default_pool().M_push(j);
+        return;
+      }
+      catch(const std::bad_alloc&)
+      {
+        __atomic_sub_fetch(&S_pending(), size_t(1), __ATOMIC_RELAXED);
+      }
+    }
+    j->M_run(j);
+  }
+
+  // Waits until every job submitted so far has run, helping with them.
+  static void
+  S_wait()
+  {
+    if (Parallel_active()
+        && __atomic_load_n(&S_pending(), __ATOMIC_ACQUIRE) != 0)
+      thread_pool::default_pool().M_wait(&S_pending());
+  }
+};
+
+} // ft
+
+#ifdef STL_TREE_H_
+# include "stl_tree_parallel.h"
+#endif
+
+#endif // STL_PARALLEL_H_
@@ -0,0 +1,807 @@
+// Parallel algorithms -*- C++ -*-
+
+/** @file stl_parallel_algo.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_PARALLEL_ALGO_H_
+#define STL_PARALLEL_ALGO_H_
+
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <iterator>
+
+#include "cpp_type_traits.h"
+#include "stl_iterator_base_types.h"
+#include "stl_vector.h"
+#include "stl_parallel.h"
+
+
+namespace ft {
+
+/**
+ *  @brief  Parallel versions of common algorithms.
+ *
+ *  Each one splits a range of random-access iterators, such as those of
+ *  ft::vector, into chunks run on thread_pool::default_pool(), the
+ *  caller taking one.  Ranges shorter than S_parallel_grain elements,
+ *  other kinds of iterators, and programs that cannot start threads get
+ *  the serial algorithm.  Function objects are shared by the chunks and
+ *  so called from several threads at once.  Each algorithm takes an
+ *  optional parallel_policy first; without one ft::par is used.
+ */
+namespace parallel {
+
+enum { S_parallel_grain = 1 << 15 };
+
+// Whether Iterator is random-access according to ft::iterator_traits.
+template <typename Iterator>
+struct Random_access
+{
+  enum
+  {
+    value = are_same<typename ft::iterator_traits<Iterator>::
+                     iterator_category,
+                     std::random_access_iterator_tag>::value
+  };
+};
+
+// __true_type when every iterator given is random-access.
+template <typename Iterator1, typename Iterator2 = Iterator1,
+          typename Iterator3 = Iterator1>
+struct Random_access_tag
+{
+  typedef typename truth_type<Random_access<Iterator1>::value
+                              && Random_access<Iterator2>::value
+                              && Random_access<Iterator3>::value>::type
+    type;
+};
+
+// How many chunks n elements make: one per grain at most, about four per
+// thread so that stealing can even out unequal chunks, and at most
+// S_parallel_max_threads.  One means serial.
+inline std::size_t
+Chunks(std::size_t n, const parallel_policy& policy)
+{
+  const std::size_t threads = Parallel_threads(policy);
+  if (threads == 1)
+    return 1;
+  std::size_t chunks = std::min<std::size_t>(4 * threads,
+                                             n / S_parallel_grain);
+  chunks = std::min<std::size_t>(chunks, S_parallel_max_threads);
+  return chunks > 0 ? chunks : 1;
+}
+
+// The offset of the start of chunk i of c over n elements.
+inline std::ptrdiff_t
+Chunk_begin(std::size_t n, std::size_t c, std::size_t i)
+{ return static_cast<std::ptrdiff_t>(n / c * i + std::min(i, n % c)); }
+
+// sort
+
+// Partitions one chunk.
+template <typename RandomAccessIterator, typename Predicate>
+struct Partition_task
+{
+  RandomAccessIterator  M_first;
+  RandomAccessIterator  M_last;
+  RandomAccessIterator  M_middle;
+  Predicate*            M_pred;
+
+  void
+  M_run()
+  { M_middle = std::partition(M_first, M_last, *M_pred); }
+};
+
+// A run of positions [M_begin, M_end), as offsets from the range start.
+struct Partition_run
+{
+  std::ptrdiff_t M_begin;
+  std::ptrdiff_t M_end;
+};
+
+// Swaps the misplaced elements numbered [M_begin, M_end): the k-th
+// element failing the predicate left of the split with the k-th one
+// passing it right of the split.
+template <typename RandomAccessIterator>
+struct Partition_swap_task
+{
+  RandomAccessIterator  M_base;
+  const Partition_run*  M_left;
+  const Partition_run*  M_right;
+  std::ptrdiff_t        M_begin;
+  std::ptrdiff_t        M_end;
+
+  // The position of misplaced element k in runs.
+  static std::ptrdiff_t
+  S_position(const Partition_run*& runs, std::ptrdiff_t k)
+  {
+    while (k >= runs->M_end - runs->M_begin)
+    {
+      k -= runs->M_end - runs->M_begin;
+      ++runs;
+    }
+    return runs->M_begin + k;
+  }
+
+  void
+  M_run()
+  {
+    const Partition_run* l = M_left;
+    const Partition_run* r = M_right;
+    std::ptrdiff_t i = S_position(l, M_begin);
+    std::ptrdiff_t j = S_position(r, M_begin);
+    for (std::ptrdiff_t k = M_begin; k < M_end; ++k)
+    {
+      if (i == l->M_end)
+        i = (++l)->M_begin;
+      if (j == r->M_end)
+        j = (++r)->M_begin;
+      std::iter_swap(M_base + i++, M_base + j++);
+    }
+  }
+};
+
+// std::partition over `chunks' tasks: each chunk is partitioned on its
+// own, then the elements on the wrong side of the overall split are
+// swapped pairwise, again in chunks.  Two passes over the range at most,
+// both in parallel; the order within each side is unspecified.
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator
+Parallel_partition(RandomAccessIterator first, RandomAccessIterator last,
+                   Predicate pred, std::size_t chunks)
+{
+  const std::size_t n = last - first;
+  Partition_task<RandomAccessIterator, Predicate>
+    parts[S_parallel_max_threads];
+  for (std::size_t i = 0; i < chunks; ++i)
+  {
+    parts[i].M_first = first + Chunk_begin(n, chunks, i);
+    parts[i].M_last = first + Chunk_begin(n, chunks, i + 1);
+    parts[i].M_pred = &pred;
+  }
+  Parallel_run(parts, chunks);
+
+  std::ptrdiff_t split = 0;
+  for (std::size_t i = 0; i < chunks; ++i)
+    split += parts[i].M_middle - parts[i].M_first;
+
+  // The failing elements before split, and as many passing ones after.
+  Partition_run left[S_parallel_max_threads];
+  Partition_run right[S_parallel_max_threads];
+  std::size_t nleft = 0;
+  std::size_t nright = 0;
+  std::ptrdiff_t misplaced = 0;
+  for (std::size_t i = 0; i < chunks; ++i)
+  {
+    const std::ptrdiff_t b = parts[i].M_first - first;
+    const std::ptrdiff_t m = parts[i].M_middle - first;
+    const std::ptrdiff_t e = parts[i].M_last - first;
+    if (m < split)
+    {
+      left[nleft].M_begin = m;
+      left[nleft].M_end = std::min(e, split);
+      misplaced += left[nleft++].M_end - m;
+    }
+    if (m > split)
+    {
+      right[nright].M_begin = std::max(b, split);
+      right[nright++].M_end = m;
+    }
+  }
+  if (misplaced == 0)
+    return first + split;
+
+  const std::size_t swaps = std::min<std::size_t>(
+      chunks, misplaced / S_parallel_grain + 1);
+  Partition_swap_task<RandomAccessIterator> tasks[S_parallel_max_threads];
+  for (std::size_t i = 0; i < swaps; ++i)
+  {
+    tasks[i].M_base = first;
+    tasks[i].M_left = left;
+    tasks[i].M_right = right;
+    tasks[i].M_begin = Chunk_begin(misplaced, swaps, i);
+    tasks[i].M_end = Chunk_begin(misplaced, swaps, i + 1);
+  }
+  Parallel_run(tasks, swaps);
+  return first + split;
+}
+
+// x < pivot, and !(pivot < x).
+template <typename Tp, typename Compare>
+struct Less_than_pivot
+{
+  const Tp*  M_pivot;
+  Compare*   M_comp;
+
+  bool
+  operator()(const Tp& x) const
+  { return (*M_comp)(x, *M_pivot); }
+};
+
+template <typename Tp, typename Compare>
+struct Not_above_pivot
+{
+  const Tp*  M_pivot;
+  Compare*   M_comp;
+
+  bool
+  operator()(const Tp& x) const
+  { return !(*M_comp)(*M_pivot, x); }
+};
+
+template <typename RandomAccessIterator, typename Compare>
+void
+Quicksort(RandomAccessIterator first, RandomAccessIterator last,
+          Compare comp, std::size_t chunks);
+
+template <typename RandomAccessIterator, typename Compare>
+struct Sort_task
+{
+  RandomAccessIterator  M_first;
+  RandomAccessIterator  M_last;
+  Compare*              M_comp;
+  std::size_t           M_chunks;
+
+  void
+  M_run()
+  { Quicksort(M_first, M_last, *M_comp, M_chunks); }
+};
+
+// Partitions around the median of a sample, in parallel over `chunks'
+// tasks, then sorts both sides at once, sharing the chunks out by size.
+// A side left with one chunk is sorted serially.  Each side gets fewer
+// chunks than the whole, so the recursion ends whatever the pivots.
+template <typename RandomAccessIterator, typename Compare>
+void
+Quicksort(RandomAccessIterator first, RandomAccessIterator last,
+          Compare comp, std::size_t chunks)
+{
+  typedef typename ft::iterator_traits<RandomAccessIterator>::value_type
+    Value;
+  enum { S_sample = 127 };
+
+  const std::size_t n = last - first;
+  if (chunks < 2 || n < 2 * S_parallel_grain)
+  {
+    std::sort(first, last, comp);
+    return;
+  }
+  ft::vector<Value> sample;
+  sample.reserve(S_sample);
+  for (std::size_t i = 0; i < S_sample; ++i)
+    sample.push_back(*(first + n * (2 * i + 1) / (2 * S_sample)));
+  std::nth_element(sample.begin(), sample.begin() + S_sample / 2,
+                   sample.end(), comp);
+  const Value& pivot = sample[S_sample / 2];
+
+  Less_than_pivot<Value, Compare> less;
+  less.M_pivot = &pivot;
+  less.M_comp = &comp;
+  const RandomAccessIterator middle = Parallel_partition(first, last, less,
+                                                         chunks);
+  // Many elements equal to the pivot end up right of it: set them
+  // apart, they are in place.
+  RandomAccessIterator right = middle;
+  if (std::size_t(last - middle) > n / 2 + n / 4)
+  {
+    Not_above_pivot<Value, Compare> equal;
+    equal.M_pivot = &pivot;
+    equal.M_comp = &comp;
+    right = Parallel_partition(middle, last, equal, chunks);
+  }
+
+  const std::size_t nleft = middle - first;
+  const std::size_t nright = last - right;
+  std::size_t lchunks = chunks * nleft / (nleft + nright + 1);
+  lchunks = std::max<std::size_t>(1, std::min(lchunks, chunks - 1));
+  Sort_task<RandomAccessIterator, Compare> halves[2];
+  halves[0].M_first = first;
+  halves[0].M_last = middle;
+  halves[0].M_chunks = lchunks;
+  halves[1].M_first = right;
+  halves[1].M_last = last;
+  halves[1].M_chunks = chunks - lchunks;
+  for (int i = 0; i < 2; ++i)
+    halves[i].M_comp = &comp;
+  Parallel_run(halves, 2);
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void
+Sort(const parallel_policy& policy, RandomAccessIterator first,
+     RandomAccessIterator last, Compare comp, __true_type)
+{ Quicksort(first, last, comp, Chunks(last - first, policy)); }
+
+template <typename Iterator, typename Compare>
+void
+Sort(const parallel_policy&, Iterator first, Iterator last, Compare comp,
+     __false_type)
+{ std::sort(first, last, comp); }
+
+/**
+ *  @brief  Sorts a range, not stably.
+ *
+ *  A parallel quicksort: the range is partitioned around the median of
+ *  a sample by all its chunks at once, then both sides are sorted at
+ *  once, each with its share of the chunks, until a side has one chunk
+ *  left and is sorted serially.  Every pass over the data is parallel.
+ *  If @a comp throws, the range is left in an unspecified order.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void
+sort(const parallel_policy& policy, RandomAccessIterator first,
+     RandomAccessIterator last, Compare comp)
+{
+  Sort(policy, first, last, comp,
+       typename Random_access_tag<RandomAccessIterator>::type());
+}
+
+template <typename RandomAccessIterator>
+void
+sort(const parallel_policy& policy, RandomAccessIterator first,
+     RandomAccessIterator last)
+{
+  parallel::sort(policy, first, last,
+                 std::less<typename ft::iterator_traits<
+                     RandomAccessIterator>::value_type>());
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void
+sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{ parallel::sort(par, first, last, comp); }
+
+template <typename RandomAccessIterator>
+void
+sort(RandomAccessIterator first, RandomAccessIterator last)
+{ parallel::sort(par, first, last); }
+
+// transform
+
+template <typename InputIterator, typename OutputIterator,
+          typename UnaryOperation>
+struct Transform_task
+{
+  InputIterator    M_first;
+  InputIterator    M_last;
+  OutputIterator   M_out;
+  UnaryOperation*  M_op;
+
+  void
+  M_run()
+  { std::transform(M_first, M_last, M_out, *M_op); }
+};
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename UnaryOperation>
+RandomAccessIterator2
+Transform(const parallel_policy& policy, RandomAccessIterator1 first,
+          RandomAccessIterator1 last, RandomAccessIterator2 out,
+          UnaryOperation op, __true_type)
+{
+  const std::size_t n = last - first;
+  const std::size_t c = Chunks(n, policy);
+  if (c == 1)
+    return std::transform(first, last, out, op);
+  Transform_task<RandomAccessIterator1, RandomAccessIterator2,
+                 UnaryOperation> tasks[S_parallel_max_threads];
+  for (std::size_t i = 0; i < c; ++i)
+  {
+    tasks[i].M_first = first + Chunk_begin(n, c, i);
+    tasks[i].M_last = first + Chunk_begin(n, c, i + 1);
+    tasks[i].M_out = out + Chunk_begin(n, c, i);
+    tasks[i].M_op = &op;
+  }
+  Parallel_run(tasks, c);
+  return out + n;
+}
+
+template <typename InputIterator, typename OutputIterator,
+          typename UnaryOperation>
+OutputIterator
+Transform(const parallel_policy&, InputIterator first, InputIterator last,
+          OutputIterator out, UnaryOperation op, __false_type)
+{ return std::transform(first, last, out, op); }
+
+template <typename InputIterator1, typename InputIterator2,
+          typename OutputIterator, typename BinaryOperation>
+struct Transform2_task
+{
+  InputIterator1    M_first1;
+  InputIterator1    M_last1;
+  InputIterator2    M_first2;
+  OutputIterator    M_out;
+  BinaryOperation*  M_op;
+
+  void
+  M_run()
+  { std::transform(M_first1, M_last1, M_first2, M_out, *M_op); }
+};
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIterator3, typename BinaryOperation>
+RandomAccessIterator3
+Transform(const parallel_policy& policy, RandomAccessIterator1 first1,
+          RandomAccessIterator1 last1, RandomAccessIterator2 first2,
+          RandomAccessIterator3 out, BinaryOperation op, __true_type)
+{
+  const std::size_t n = last1 - first1;
+  const std::size_t c = Chunks(n, policy);
+  if (c == 1)
+    return std::transform(first1, last1, first2, out, op);
+  Transform2_task<RandomAccessIterator1, RandomAccessIterator2,
+                  RandomAccessIterator3, BinaryOperation>
+    tasks[S_parallel_max_threads];
+  for (std::size_t i = 0; i < c; ++i)
+  {
+    tasks[i].M_first1 = first1 + Chunk_begin(n, c, i);
+    tasks[i].M_last1 = first1 + Chunk_begin(n, c, i + 1);
+    tasks[i].M_first2 = first2 + Chunk_begin(n, c, i);
+    tasks[i].M_out = out + Chunk_begin(n, c, i);
+    tasks[i].M_op = &op;
+  }
+  Parallel_run(tasks, c);
+  return out + n;
+}
+
+template <typename InputIterator1, typename InputIterator2,
+          typename OutputIterator, typename BinaryOperation>
+OutputIterator
+Transform(const parallel_policy&, InputIterator1 first1,
+          InputIterator1 last1, InputIterator2 first2, OutputIterator out,
+          BinaryOperation op, __false_type)
+{ return std::transform(first1, last1, first2, out, op); }
+
+/**
+ *  @brief  Applies @a op to each element of [first, last), writing the
+ *  results from @a out on.  Chunks are written in any order.
+ *  @return  The end of the output.
+ */
+template <typename InputIterator, typename OutputIterator,
+          typename UnaryOperation>
+OutputIterator
+transform(const parallel_policy& policy, InputIterator first,
+          InputIterator last, OutputIterator out, UnaryOperation op)
+{
+  return Transform(policy, first, last, out, op,
+                   typename Random_access_tag<InputIterator,
+                                              OutputIterator>::type());
+}
+
+/**
+ *  @brief  Applies @a op to pairs of elements of [first1, last1) and
+ *  [first2, ...), writing the results from @a out on.
+ *  @return  The end of the output.
+ */
+template <typename InputIterator1, typename InputIterator2,
+          typename OutputIterator, typename BinaryOperation>
+OutputIterator
+transform(const parallel_policy& policy, InputIterator1 first1,
+          InputIterator1 last1, InputIterator2 first2, OutputIterator out,
+          BinaryOperation op)
+{
+  return Transform(policy, first1, last1, first2, out, op,
+                   typename Random_access_tag<InputIterator1,
+                                              InputIterator2,
+                                              OutputIterator>::type());
+}
+
+template <typename InputIterator, typename OutputIterator,
+          typename UnaryOperation>
+OutputIterator
+transform(InputIterator first, InputIterator last, OutputIterator out,
+          UnaryOperation op)
+{ return parallel::transform(par, first, last, out, op); }
+
+template <typename InputIterator1, typename InputIterator2,
+          typename OutputIterator, typename BinaryOperation>
+OutputIterator
+transform(InputIterator1 first1, InputIterator1 last1,
+          InputIterator2 first2, OutputIterator out, BinaryOperation op)
+{ return parallel::transform(par, first1, last1, first2, out, op); }
+
+// reduce
+
+template <typename InputIterator, typename Tp, typename BinaryOperation>
+struct Reduce_task
+{
+  InputIterator     M_first;
+  InputIterator     M_last;
+  Tp*               M_result;
+  BinaryOperation*  M_op;
+
+  // Folds a non-empty chunk starting from its first element.
+  void
+  M_run()
+  {
+    InputIterator i = M_first;
+    Tp acc = *i;
+    for (++i; i != M_last; ++i)
+      acc = (*M_op)(acc, *i);
+    *M_result = acc;
+  }
+};
+
+template <typename RandomAccessIterator, typename Tp,
+          typename BinaryOperation>
+Tp
+Reduce(const parallel_policy& policy, RandomAccessIterator first,
+       RandomAccessIterator last, Tp init, BinaryOperation op, __true_type)
+{
+  const std::size_t n = last - first;
+  const std::size_t c = Chunks(n, policy);
+  if (c == 1)
+    return std::accumulate(first, last, init, op);
+  ft::vector<Tp> partials(c, init);
+  Reduce_task<RandomAccessIterator, Tp, BinaryOperation>
+    tasks[S_parallel_max_threads];
+  for (std::size_t i = 0; i < c; ++i)
+  {
+    tasks[i].M_first = first + Chunk_begin(n, c, i);
+    tasks[i].M_last = first + Chunk_begin(n, c, i + 1);
+    tasks[i].M_result = &partials[i];
+    tasks[i].M_op = &op;
+  }
+  Parallel_run(tasks, c);
+  for (std::size_t i = 0; i < c; ++i)
+    init = op(init, partials[i]);
+  return init;
+}
+
+template <typename InputIterator, typename Tp, typename BinaryOperation>
+Tp
+Reduce(const parallel_policy&, InputIterator first, InputIterator last,
+       Tp init, BinaryOperation op, __false_type)
+{ return std::accumulate(first, last, init, op); }
+
+/**
+ *  @brief  Folds [first, last) into @a init with @a op.
+ *
+ *  Each chunk is folded from its own first element, then the chunk
+ *  results are folded into @a init in order; @a op must therefore be
+ *  associative, but need not be commutative.
+ */
+template <typename InputIterator, typename Tp, typename BinaryOperation>
+Tp
+reduce(const parallel_policy& policy, InputIterator first,
+       InputIterator last, Tp init, BinaryOperation op)
+{
+  return Reduce(policy, first, last, init, op,
+                typename Random_access_tag<InputIterator>::type());
+}
+
+template <typename InputIterator, typename Tp>
+Tp
+reduce(const parallel_policy& policy, InputIterator first,
+       InputIterator last, Tp init)
+{ return parallel::reduce(policy, first, last, init, std::plus<Tp>()); }
+
+template <typename InputIterator, typename Tp, typename BinaryOperation>
+Tp
+reduce(InputIterator first, InputIterator last, Tp init,
+       BinaryOperation op)
+{ return parallel::reduce(par, first, last, init, op); }
+
+template <typename InputIterator, typename Tp>
+Tp
+reduce(InputIterator first, InputIterator last, Tp init)
+{ return parallel::reduce(par, first, last, init); }
+
+// fill
+
+template <typename ForwardIterator, typename Tp>
+struct Fill_task
+{
+  ForwardIterator  M_first;
+  ForwardIterator  M_last;
+  const Tp*        M_value;
+
+  void
+  M_run()
+  { std::fill(M_first, M_last, *M_value); }
+};
+
+template <typename RandomAccessIterator, typename Tp>
+void
+Fill(const parallel_policy& policy, RandomAccessIterator first,
+     RandomAccessIterator last, const Tp& value, __true_type)
+{
+  const std::size_t n = last - first;
+  const std::size_t c = Chunks(n, policy);
+  if (c == 1)
+  {
+    std::fill(first, last, value);
+    return;
+  }
+  Fill_task<RandomAccessIterator, Tp> tasks[S_parallel_max_threads];
+  for (std::size_t i = 0; i < c; ++i)
+  {
+    tasks[i].M_first = first + Chunk_begin(n, c, i);
+    tasks[i].M_last = first + Chunk_begin(n, c, i + 1);
+    tasks[i].M_value = &value;
+  }
+  Parallel_run(tasks, c);
+}
+
+template <typename ForwardIterator, typename Tp>
+void
+Fill(const parallel_policy&, ForwardIterator first, ForwardIterator last,
+     const Tp& value, __false_type)
+{ std::fill(first, last, value); }
+
+/**
+ *  @brief  Assigns @a value to every element of [first, last).
+ */
+template <typename ForwardIterator, typename Tp>
+void
+fill(const parallel_policy& policy, ForwardIterator first,
+     ForwardIterator last, const Tp& value)
+{
+  Fill(policy, first, last, value,
+       typename Random_access_tag<ForwardIterator>::type());
+}
+
+template <typename ForwardIterator, typename Tp>
+void
+fill(ForwardIterator first, ForwardIterator last, const Tp& value)
+{ parallel::fill(par, first, last, value); }
+
+// copy
+
+template <typename InputIterator, typename OutputIterator>
+struct Copy_task
+{
+  InputIterator   M_first;
+  InputIterator   M_last;
+  OutputIterator  M_out;
+
+  void
+  M_run()
+  { std::copy(M_first, M_last, M_out); }
+};
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2>
+RandomAccessIterator2
+Copy(const parallel_policy& policy, RandomAccessIterator1 first,
+     RandomAccessIterator1 last, RandomAccessIterator2 out, __true_type)
+{
+  const std::size_t n = last - first;
+  const std::size_t c = Chunks(n, policy);
+  if (c == 1)
+    return std::copy(first, last, out);
+  Copy_task<RandomAccessIterator1, RandomAccessIterator2>
+    tasks[S_parallel_max_threads];
+  for (std::size_t i = 0; i < c; ++i)
+  {
+    tasks[i].M_first = first + Chunk_begin(n, c, i);
+    tasks[i].M_last = first + Chunk_begin(n, c, i + 1);
+    tasks[i].M_out = out + Chunk_begin(n, c, i);
+  }
+  Parallel_run(tasks, c);
+  return out + n;
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator
+Copy(const parallel_policy&, InputIterator first, InputIterator last,
+     OutputIterator out, __false_type)
+{ return std::copy(first, last, out); }
+
+/**
+ *  @brief  Copies [first, last) to a range starting at @a out, which
+ *  must not overlap it.
+ *  @return  The end of the output.
+ */
+template <typename InputIterator, typename OutputIterator>
+OutputIterator
+copy(const parallel_policy& policy, InputIterator first,
+     InputIterator last, OutputIterator out)
+{
+  return Copy(policy, first, last, out,
+              typename Random_access_tag<InputIterator,
+                                         OutputIterator>::type());
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator
+copy(InputIterator first, InputIterator last, OutputIterator out)
+{ return parallel::copy(par, first, last, out); }
+
+// find_if
+
+template <typename RandomAccessIterator, typename Predicate>
+struct Find_if_task
+{
+  enum { S_poll = 1 << 10 };
+
+  RandomAccessIterator     M_base;
+  std::ptrdiff_t           M_begin;
+  std::ptrdiff_t           M_end;
+  volatile std::ptrdiff_t* M_found;   // Least match so far.
+  Predicate*               M_pred;
+
+  // Scans in blocks, giving up once a match is known before the block.
+  void
+  M_run()
+  {
+    for (std::ptrdiff_t i = M_begin; i < M_end; )
+    {
+      if (__atomic_load_n(M_found, __ATOMIC_RELAXED) <= i)
+        return;
+      const std::ptrdiff_t block_end = std::min<std::ptrdiff_t>(
+          i + S_poll, M_end);
+      for (; i < block_end; ++i)
+        if ((*M_pred)(*(M_base + i)))
+        {
+          std::ptrdiff_t seen = __atomic_load_n(M_found, __ATOMIC_RELAXED);
+          while (i < seen
+                 && !__atomic_compare_exchange_n(M_found, &seen, i, false,
+                                                 __ATOMIC_RELAXED,
+                                                 __ATOMIC_RELAXED))
+            { }
+          return;
+        }
+    }
+  }
+};
+
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator
+Find_if(const parallel_policy& policy, RandomAccessIterator first,
+        RandomAccessIterator last, Predicate pred, __true_type)
+{
+  const std::size_t n = last - first;
+  const std::size_t c = Chunks(n, policy);
+  if (c == 1)
+    return std::find_if(first, last, pred);
+  volatile std::ptrdiff_t found = static_cast<std::ptrdiff_t>(n);
+  Find_if_task<RandomAccessIterator, Predicate>
+    tasks[S_parallel_max_threads];
+  for (std::size_t i = 0; i < c; ++i)
+  {
+    tasks[i].M_base = first;
+    tasks[i].M_begin = Chunk_begin(n, c, i);
+    tasks[i].M_end = Chunk_begin(n, c, i + 1);
+    tasks[i].M_found = &found;
+    tasks[i].M_pred = &pred;
+  }
+  Parallel_run(tasks, c);
+  return first + static_cast<std::ptrdiff_t>(found);
+}
+
+template <typename InputIterator, typename Predicate>
+InputIterator
+Find_if(const parallel_policy&, InputIterator first, InputIterator last,
+        Predicate pred, __false_type)
+{ return std::find_if(first, last, pred); }
+
+/**
+ *  @brief  Finds the first element of [first, last) satisfying @a pred.
+ *  @return  An iterator to it, or @a last.
+ *
+ *  Chunks past a match already found stop early, but @a pred may still
+ *  be called on elements after the one returned.
+ */
+template <typename InputIterator, typename Predicate>
+InputIterator
+find_if(const parallel_policy& policy, InputIterator first,
+        InputIterator last, Predicate pred)
+{
+  return Find_if(policy, first, last, pred,
+                 typename Random_access_tag<InputIterator>::type());
+}
+
+template <typename InputIterator, typename Predicate>
+InputIterator
+find_if(InputIterator first, InputIterator last, Predicate pred)
+{ return parallel::find_if(par, first, last, pred); }
+
+} // parallel
+
+} // ft
+
+#endif // STL_PARALLEL_ALGO_H_
@@ -0,0 +1,512 @@
+// Persistent map implementation -*- C++ -*-
+
+/** @file stl_persistent_map.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_PERSISTENT_MAP_H_
+#define STL_PERSISTENT_MAP_H_
+
+#include <memory>
+#include <stdexcept>
+
+#include "stl_pair.h"
+#include "stl_persistent_tree.h"
+#include "stl_function.h"
+
+
+namespace ft {
+/**
+ *  @brief A %map whose copies are snapshots: taking one is constant time
+ *  and later updates to either side leave the other unchanged.
+ *
+ *  @ingroup Containers
+ *  @ingroup Assoc_containers
+ *
+ *  Elements are kept in a path-copying red-black tree with reference
+ *  counted nodes.  A copy shares every node with the original; an
+ *  insertion or erasure then copies only the O(log n) nodes it changes
+ *  that are still shared, and is done in place on nodes the %map owns
+ *  alone.  Snapshots may be handed to other threads and destroyed there.
+ *
+ *  Iterators are read-only, since they may point into nodes shared with
+ *  other versions; operator[] and insert_or_assign() write through a
+ *  private copy of the path.  Each iterator carries its path from the
+ *  root, so it is larger than a %map iterator.  Updating a
+ *  %persistent_map invalidates its own iterators, while those of its
+ *  snapshots stay valid as long as the snapshots live.
+ *
+ *  @param  Key  Type of key objects.
+ *  @param  Tp  Type of mapped objects.
+ *  @param  Compare  Comparison function object type.
+ *  @param  Alloc  Allocator type.
+*/
+template <typename Key, typename Tp, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<ft::pair<const Key, Tp> > >
+class persistent_map
+{
+public:
+  typedef Key                         key_type;
+  typedef Tp                          mapped_type;
+  typedef ft::pair<const Key, Tp>     value_type;
+  typedef Compare                     key_compare;
+  typedef Alloc                       allocator_type;
+
+public:
+  class value_compare
+  : public std::binary_function<value_type, value_type, bool>
+  {
+    friend class persistent_map<Key, Tp, Compare, Alloc>;
+    protected:
+      Compare comp;
+
+      value_compare(Compare c)
+      : comp(c) { }
+
+    public:
+      bool operator()(const value_type& x, const value_type& y) const
+      { return comp(x.first, y.first); }
+  };
+
+private:
+  typedef typename Alloc::template rebind<value_type>::other  Pair_alloc_type;
+  typedef Persistent_tree<key_type, value_type, Select1st<value_type>,
+                          key_compare, Pair_alloc_type>       Rep_type;
+
+  Rep_type M_t;
+
+public:
+  typedef typename Pair_alloc_type::pointer         pointer;
+  typedef typename Pair_alloc_type::const_pointer   const_pointer;
+  typedef typename Pair_alloc_type::reference       reference;
+  typedef typename Pair_alloc_type::const_reference const_reference;
+  typedef typename Rep_type::iterator               iterator;
+  typedef typename Rep_type::const_iterator         const_iterator;
+  typedef typename Rep_type::size_type              size_type;
+  typedef typename Rep_type::difference_type        difference_type;
+  typedef typename Rep_type::reverse_iterator       reverse_iterator;
+  typedef typename Rep_type::const_reverse_iterator const_reverse_iterator;
+
+  /**
+   *  @brief  Default constructor creates no elements.
+   */
+  persistent_map()
+  : M_t(Compare(), allocator_type()) { }
+
+  explicit
+  persistent_map(const Compare& comp,
+                 const allocator_type& a = allocator_type())
+  : M_t(comp, a) { }
+
+  /**
+   *  @brief  Snapshot constructor.
+   *  @param  x  A %persistent_map of identical element and allocator types.
+   *
+   *  Constant time: the new %map shares all of @a x's nodes.
+   */
+  persistent_map(const persistent_map& x)
+  : M_t(x.M_t) { }
+
+  /**
+   *  @brief  Builds a %persistent_map from a range.
+   *  @param  first  An input iterator.
+   *  @param  last  An input iterator.
+   */
+  template <typename InputIterator>
+  persistent_map(InputIterator first, InputIterator last)
+  : M_t(Compare(), allocator_type())
+  { M_t.M_insert_unique(first, last); }
+
+  template <typename InputIterator>
+  persistent_map(InputIterator first, InputIterator last,
+                 const Compare& comp,
+                 const allocator_type& a = allocator_type())
+  : M_t(comp, a)
+  { M_t.M_insert_unique(first, last); }
+
+  /**
+   *  @brief  Snapshot assignment.
+   *
+   *  Constant time, plus the release of the nodes of the old contents
+   *  that no other version shares.
+   */
+  persistent_map&
+  operator=(const persistent_map& x)
+  {
+    M_t = x.M_t;
+    return *this;
+  }
+
+  /**
+   *  @brief  Takes a snapshot of the %map.
+   *  @return  A %persistent_map holding the current contents.
+   *
+   *  Same as copying: constant time, and neither side sees the updates
+   *  later made to the other.
+   */
+  persistent_map
+  snapshot() const
+  { return *this; }
+
+  /// Get a copy of the memory allocation object.
+  allocator_type
+  get_allocator() const
+  { return M_t.get_allocator(); }
+
+  // iterators
+  /**
+   *  Returns a read-only iterator that points to the first pair in the
+   *  %map.  Iteration is done in ascending order according to the keys.
+   */
+  const_iterator
+  begin() const
+  { return M_t.begin(); }
+
+  /**
+   *  Returns a read-only iterator that points one past the last pair in
+   *  the %map.
+   */
+  const_iterator
+  end() const
+  { return M_t.end(); }
+
+  /**
+   *  Returns a read-only reverse iterator that points to the last pair in
+   *  the %map.
+   */
+  const_reverse_iterator
+  rbegin() const
+  { return M_t.rbegin(); }
+
+  /**
+   *  Returns a read-only reverse iterator that points to one before the
+   *  first pair in the %map.
+   */
+  const_reverse_iterator
+  rend() const
+  { return M_t.rend(); }
+
+  // capacity
+  /** Returns true if the %map is empty.  */
+  bool
+  empty() const
+  { return M_t.empty(); }
+
+  /** Returns the size of the %map.  */
+  size_type
+  size() const
+  { return M_t.size(); }
+
+  /** Returns the maximum size of the %map.  */
+  size_type
+  max_size() const
+  { return M_t.max_size(); }
+
+  // element access
+  /**
+   *  @brief  Subscript ( @c [] ) access to %map data.
+   *  @param  k  The key for which data should be retrieved.
+   *  @return  A reference to the data of the (key,data) %pair.
+   *
+   *  If the key does not exist, a pair with that key is created using
+   *  default values.  Either way the path to the element is made private
+   *  first, so writing through the reference leaves every snapshot
+   *  unchanged.  The reference is valid until the next update.
+   */
+  mapped_type&
+  operator[](const key_type& k)
+  {
+    value_type* p = M_t.M_find_own(k);
+    if (p == 0)
+      p = const_cast<value_type*>(
+          &*M_t.M_insert_unique(value_type(k, mapped_type())).first);
+    return p->second;
+  }
+
+  /**
+   *  @brief  Access to %map data.
+   *  @param  k  The key for which data should be retrieved.
+   *  @return  A reference to the data whose key is equivalent to @a k.
+   *  @throw  std::out_of_range  If no such data is present.
+   */
+  const mapped_type&
+  at(const key_type& k) const
+  {
+    const_iterator i = find(k);
+    if (i == end())
+      throw std::out_of_range("persistent_map::at");
+    return (*i).second;
+  }
+
+  // modifiers
+  /**
+   *  @brief Attempts to insert a std::pair into the %map.
+   *  @param  x  Pair to be inserted.
+   *  @return  A pair of an iterator to the element with the key of @a x
+   *           and a bool that is true if @a x was inserted.
+   *
+   *  Allocates the new node and a private copy of each shared node on
+   *  its path and in the rebalancing.  Logarithmic.
+   */
+  ft::pair<iterator, bool>
+  insert(const value_type& x)
+  { return M_t.M_insert_unique(x); }
+
+  /**
+   *  @brief Attempts to insert a std::pair into the %map.
+   *  @param  position  Ignored; kept for the %map interface.
+   *  @param  x  Pair to be inserted.
+   *  @return  An iterator to the element with the key of @a x.
+   */
+  iterator
+  insert(iterator position, const value_type& x)
+  {
+    (void)position;
+    return M_t.M_insert_unique(x).first;
+  }
+
+  /**
+   *  @brief Template function that attemps to insert a range of elements.
+   *  @param  first  Iterator pointing to the start of the range to be
+   *                 inserted.
+   *  @param  last  Iterator pointing to the end of the range.
+   */
+  template <typename InputIterator>
+  void
+  insert(InputIterator first, InputIterator last)
+  { M_t.M_insert_unique(first, last); }
+
+  /**
+   *  @brief  Inserts an element, or assigns to the existing one.
+   *  @param  k  Key of the element.
+   *  @param  obj  Value for the mapped part.
+   *  @return  A pair of an iterator to the element with key @a k and a
+   *           bool that is true if it was inserted, false if assigned.
+   *
+   *  On a hit only the path to the element is copied, if shared, before
+   *  the assignment.
+   */
+  template <typename Obj>
+  ft::pair<iterator, bool>
+  insert_or_assign(const key_type& k, const Obj& obj)
+  {
+    value_type* p = M_t.M_find_own(k);
+    if (p != 0)
+    {
+      p->second = obj;
+      return ft::pair<iterator, bool>(M_t.find(k), false);
+    }
+    return M_t.M_insert_unique(value_type(k, obj));
+  }
+
+  /**
+   *  @brief Erases an element from a %map.
+   *  @param  position  An iterator pointing to the element to be erased.
+   */
+  void
+  erase(iterator position)
+  { M_t.M_erase_unique((*position).first); }
+
+  /**
+   *  @brief Erases elements according to the provided key.
+   *  @param  x  Key of element to be erased.
+   *  @return  The number of elements erased.
+   */
+  size_type
+  erase(const key_type& x)
+  { return M_t.M_erase_unique(x); }
+
+  /**
+   *  @brief Erases a [first,last) range of elements from a %map.
+   *
+   *  Each element is erased by key, so this costs O(m log n) for m
+   *  elements, except that erasing everything is a clear().
+   */
+  void
+  erase(iterator first, iterator last)
+  {
+    if (first == begin() && last == end())
+    {
+      clear();
+      return;
+    }
+    size_type n = 0;
+    for (iterator i = first; i != last; ++i)
+      ++n;
+    if (n == 0)
+      return;
+    const key_type k = (*first).first;
+    for (; n > 0; --n)
+      M_t.M_erase_unique((*M_t.lower_bound(k)).first);
+  }
+
+  /**
+   *  @brief  Swaps data with another %persistent_map.
+   *
+   *  Constant time; the iterators of each stay with its contents.
+   */
+  void
+  swap(persistent_map& x)
+  { M_t.swap(x.M_t); }
+
+  /**
+   *  Erases all elements in a %map; the nodes shared with snapshots are
+   *  left to them.
+   */
+  void
+  clear()
+  { M_t.clear(); }
+
+  // observers
+  /**
+   *  Returns the key comparison object out of which the %map was
+   *  constructed.
+   */
+  key_compare
+  key_comp() const
+  { return M_t.key_comp(); }
+
+  /**
+   *  Returns a value comparison object, built from the key comparison
+   *  object out of which the %map was constructed.
+   */
+  value_compare
+  value_comp() const
+  { return value_compare(M_t.key_comp()); }
+
+  // map operations
+  /**
+   *  @brief Tries to locate an element in a %map.
+   *  @param  x  Key of (key, value) %pair to be located.
+   *  @return  Iterator pointing to sought-after element, or end() if not
+   *           found.
+   */
+  const_iterator
+  find(const key_type& x) const
+  { return M_t.find(x); }
+
+  /**
+   *  @brief  Finds the number of elements with given key.
+   *  @param  x  Key of (key, value) pairs to be located.
+   *  @return  Number of elements with specified key.
+   */
+  size_type
+  count(const key_type& x) const
+  { return M_t.count(x); }
+
+  /**
+   *  @brief Finds the beginning of a subsequence matching given key.
+   *  @param  x  Key of (key, value) pair to be located.
+   *  @return  Iterator pointing to first element equal to or greater
+   *           than key, or end().
+   */
+  const_iterator
+  lower_bound(const key_type& x) const
+  { return M_t.lower_bound(x); }
+
+  /**
+   *  @brief Finds the end of a subsequence matching given key.
+   *  @param  x  Key of (key, value) pair to be located.
+   *  @return  Iterator pointing to the first element greater than key,
+   *           or end().
+   */
+  const_iterator
+  upper_bound(const key_type& x) const
+  { return M_t.upper_bound(x); }
+
+  /**
+   *  @brief Finds a subsequence matching given key.
+   *  @param  x  Key of (key, value) pairs to be located.
+   *  @return  Pair of iterators that possibly points to the subsequence
+   *           matching given key.
+   */
+  ft::pair<const_iterator, const_iterator>
+  equal_range(const key_type& x) const
+  { return M_t.equal_range(x); }
+
+  /**
+   *  @brief  Tells whether @a x is the very same version as this %map.
+   *
+   *  True for a snapshot that neither side has updated since; then the
+   *  contents are equal without being compared.  Constant time.
+   */
+  bool
+  same_version(const persistent_map& x) const
+  { return M_t.M_same_version(x.M_t); }
+
+  template <typename K1, typename T1, typename C1, typename A1>
+  friend bool
+  operator==(const persistent_map<K1, T1, C1, A1>&,
+             const persistent_map<K1, T1, C1, A1>&);
+
+  template <typename K1, typename T1, typename C1, typename A1>
+  friend bool
+  operator<(const persistent_map<K1, T1, C1, A1>&,
+            const persistent_map<K1, T1, C1, A1>&);
+};
+
+/**
+ *  @brief  Persistent map equality comparison.
+ *  @param  x  A %persistent_map.
+ *  @param  y  A %persistent_map of the same type as @a x.
+ *  @return  True iff the size and elements of the maps are equal.
+ *
+ *  Constant time for two versions that still share their root.
+*/
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator==(const persistent_map<Key, Tp, Compare, Alloc>& x,
+           const persistent_map<Key, Tp, Compare, Alloc>& y)
+{ return x.M_t == y.M_t; }
+
+/**
+ *  @brief  Persistent map ordering relation.
+ *  @param  x  A %persistent_map.
+ *  @param  y  A %persistent_map of the same type as @a x.
+ *  @return  True iff @a x is lexicographically less than @a y.
+*/
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator<(const persistent_map<Key, Tp, Compare, Alloc>& x,
+          const persistent_map<Key, Tp, Compare, Alloc>& y)
+{ return x.M_t < y.M_t; }
+
+/// Based on operator==
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator!=(const persistent_map<Key, Tp, Compare, Alloc>& x,
+           const persistent_map<Key, Tp, Compare, Alloc>& y)
+{ return !(x == y); }
+
+/// Based on operator<
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator>(const persistent_map<Key, Tp, Compare, Alloc>& x,
+          const persistent_map<Key, Tp, Compare, Alloc>& y)
+{ return y < x; }
+
+/// Based on operator<
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator<=(const persistent_map<Key, Tp, Compare, Alloc>& x,
+           const persistent_map<Key, Tp, Compare, Alloc>& y)
+{ return !(y < x); }
+
+/// Based on operator<
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+bool
+operator>=(const persistent_map<Key, Tp, Compare, Alloc>& x,
+           const persistent_map<Key, Tp, Compare, Alloc>& y)
+{ return !(x < y); }
+
+/// See persistent_map::swap().
+template <typename Key, typename Tp, typename Compare, typename Alloc>
+void
+swap(persistent_map<Key, Tp, Compare, Alloc>& x,
+     persistent_map<Key, Tp, Compare, Alloc>& y)
+{ x.swap(y); }
+
+} // ft
+
+#endif // STL_PERSISTENT_MAP_H_
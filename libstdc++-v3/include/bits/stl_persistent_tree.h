@@ -0,0 +1,854 @@
+// Persistent red-black tree implementation -*- C++ -*-
+
+/** @file stl_persistent_tree.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_PERSISTENT_TREE_H_
+#define STL_PERSISTENT_TREE_H_
+
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+
+#include "stl_pair.h"
+#include "stl_tree.h"
+#include "stl_iterator.h"
+#include "stl_algobase.h"
+
+namespace ft {
+
+// Link counting for nodes shared between tree versions.  The counts are
+// changed atomically, so versions sharing nodes may be destroyed on
+// different threads.
+inline void
+Persistent_tree_acquire(volatile std::size_t* refs)
+{
+#if defined(__GNUC__)
+  __sync_add_and_fetch(refs, 1);
+#else
+  ++*refs;
+#endif
+}
+
+// Returns true when the last link has gone.
+inline bool
+Persistent_tree_release(volatile std::size_t* refs)
+{
+#if defined(__GNUC__)
+  return __sync_sub_and_fetch(refs, 1) == 0;
+#else
+  return --*refs == 0;
+#endif
+}
+
+// True when the caller holds the only link.  The load pairs with the
+// decrements of other threads, whose reads of the node then happen before
+// the caller changes it in place.
+inline bool
+Persistent_tree_unique(const volatile std::size_t* refs)
+{
+#if defined(__GNUC__)
+  return __atomic_load_n(refs, __ATOMIC_ACQUIRE) == 1;
+#else
+  return *refs == 1;
+#endif
+}
+
+// A node has no parent pointer, since it may have a different parent in
+// every version of the tree that shares it.  M_refs counts the links to
+// it from parent nodes and from tree roots.  A node reached from a root
+// through nodes whose M_refs are all 1 belongs to that tree alone and is
+// changed in place; any other node is copied before being changed.
+template <typename Val>
+struct Persistent_tree_node
+{
+  typedef Persistent_tree_node<Val>*  Link_type;
+
+  Rb_tree_color         M_color;
+  volatile std::size_t  M_refs;
+  Link_type             M_left;
+  Link_type             M_right;
+  Val                   M_value_field;
+};
+
+// Iterators keep the path from the root, which makes increment and
+// decrement amortized constant without parent pointers.  An iterator
+// reads only the version it was taken from, so it stays valid as long as
+// some tree holds that version, whatever happens to the others.
+template <typename Tp>
+struct Persistent_tree_iterator
+{
+  typedef Tp                                value_type;
+  typedef const Tp&                         reference;
+  typedef const Tp*                         pointer;
+
+  typedef std::bidirectional_iterator_tag   iterator_category;
+  typedef ptrdiff_t                         difference_type;
+
+  typedef Persistent_tree_iterator<Tp>      Self;
+  typedef const Persistent_tree_node<Tp>*   Link_type;
+
+  // A red-black tree is at most twice as high as a perfect one.
+  enum { S_max_depth = 2 * sizeof(std::size_t) * 8 };
+
+  Persistent_tree_iterator()
+  : M_root(), M_depth(0) { }
+
+  // The past-the-end iterator of the version rooted at root.
+  explicit
+  Persistent_tree_iterator(Link_type root)
+  : M_root(root), M_depth(0) { }
+
+  Persistent_tree_iterator(const Self& x)
+  : M_root(x.M_root), M_depth(x.M_depth)
+  { std::copy(x.M_path, x.M_path + x.M_depth, M_path); }
+
+  Self&
+  operator=(const Self& x)
+  {
+    M_root = x.M_root;
+    M_depth = x.M_depth;
+    std::copy(x.M_path, x.M_path + x.M_depth, M_path);
+    return *this;
+  }
+
+  reference
+  operator*() const
+  { return M_path[M_depth - 1]->M_value_field; }
+
+  pointer
+  operator->() const
+  { return &M_path[M_depth - 1]->M_value_field; }
+
+  Self&
+  operator++()
+  {
+    if (M_path[M_depth - 1]->M_right != 0)
+      M_push_leftmost(M_path[M_depth - 1]->M_right);
+    else
+    {
+      while (M_depth > 1
+             && M_path[M_depth - 2]->M_right == M_path[M_depth - 1])
+        --M_depth;
+      --M_depth;
+    }
+    return *this;
+  }
+
+  Self
+  operator++(int)
+  {
+    Self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  Self&
+  operator--()
+  {
+    if (M_depth == 0)
+      M_push_rightmost(M_root);
+    else if (M_path[M_depth - 1]->M_left != 0)
+      M_push_rightmost(M_path[M_depth - 1]->M_left);
+    else
+    {
+      while (M_depth > 1
+             && M_path[M_depth - 2]->M_left == M_path[M_depth - 1])
+        --M_depth;
+      --M_depth;
+    }
+    return *this;
+  }
+
+  Self
+  operator--(int)
+  {
+    Self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  bool
+  operator==(const Self& x) const
+  {
+    return M_depth == x.M_depth
+      && (M_depth == 0 || M_path[M_depth - 1] == x.M_path[M_depth - 1]);
+  }
+
+  bool
+  operator!=(const Self& x) const
+  { return !(*this == x); }
+
+  void
+  M_push_leftmost(Link_type x)
+  {
+    for (; x != 0; x = x->M_left)
+      M_path[M_depth++] = x;
+  }
+
+  void
+  M_push_rightmost(Link_type x)
+  {
+    for (; x != 0; x = x->M_right)
+      M_path[M_depth++] = x;
+  }
+
+  Link_type   M_root;
+  std::size_t M_depth;
+  Link_type   M_path[S_max_depth];
+};
+
+/**
+ *  @if maint
+ *  A red-black tree whose copies share their nodes.  Copying a tree only
+ *  links its root, and an update copies the nodes it would change that
+ *  are shared with another version (the path from the root to the
+ *  element, plus the siblings a rebalance recolors or rotates), so it
+ *  allocates O(log n) nodes while the other versions are left untouched.
+ *  Once a tree owns its path again, updates are made in place.
+ *
+ *  The elements are immutable through iterators, which read shared
+ *  nodes; M_find_own gives write access to one element after making its
+ *  path private.
+ *  @endif
+ */
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc = std::allocator<Val> >
+class Persistent_tree
+{
+  typedef typename Alloc::template rebind<Persistent_tree_node<Val> >::other
+          Node_allocator;
+
+protected:
+  typedef Persistent_tree_node<Val>*        Link_type;
+  typedef const Persistent_tree_node<Val>*  Const_Link_type;
+
+public:
+  typedef Key                               key_type;
+  typedef Val                               value_type;
+  typedef value_type*                       pointer;
+  typedef const value_type*                 const_pointer;
+  typedef value_type&                       reference;
+  typedef const value_type&                 const_reference;
+  typedef size_t                            size_type;
+  typedef ptrdiff_t                         difference_type;
+  typedef Alloc                             allocator_type;
+
+  typedef Persistent_tree_iterator<value_type>  iterator;
+  typedef iterator                              const_iterator;
+  typedef ft::reverse_iterator<iterator>        reverse_iterator;
+  typedef reverse_iterator                      const_reverse_iterator;
+
+private:
+  enum { S_max_depth = iterator::S_max_depth };
+
+  struct Persistent_tree_impl : public Node_allocator
+  {
+    Compare   M_key_compare;
+    Link_type M_root;
+    size_type M_node_count;
+
+    Persistent_tree_impl(const Node_allocator& a, const Compare& comp)
+    : Node_allocator(a), M_key_compare(comp), M_root(0), M_node_count(0)
+    { }
+  };
+
+  Persistent_tree_impl M_impl;
+
+  Node_allocator&
+  M_get_Node_allocator()
+  { return *static_cast<Node_allocator*>(&this->M_impl); }
+
+  const Node_allocator&
+  M_get_Node_allocator() const
+  { return *static_cast<const Node_allocator*>(&this->M_impl); }
+
+  static const Key&
+  S_key(Const_Link_type x)
+  { return KeyOfValue()(x->M_value_field); }
+
+  static bool
+  S_is_black(Const_Link_type x)
+  { return x == 0 || x->M_color == S_black; }
+
+  Link_type
+  M_create_node(const value_type& x)
+  {
+    Link_type tmp = M_impl.Node_allocator::allocate(1);
+    try
+    {
+      get_allocator().construct(&tmp->M_value_field, x);
+    }
+    catch(...)
+    {
+      M_impl.Node_allocator::deallocate(tmp, 1);
+      throw;
+    }
+    tmp->M_color = S_red;
+    tmp->M_refs = 1;
+    tmp->M_left = 0;
+    tmp->M_right = 0;
+    return tmp;
+  }
+
+  // A private copy of x, sharing its children.
+  Link_type
+  M_clone_node(Const_Link_type x)
+  {
+    Link_type tmp = M_create_node(x->M_value_field);
+    tmp->M_color = x->M_color;
+    tmp->M_left = x->M_left;
+    tmp->M_right = x->M_right;
+    if (tmp->M_left != 0)
+      Persistent_tree_acquire(&tmp->M_left->M_refs);
+    if (tmp->M_right != 0)
+      Persistent_tree_acquire(&tmp->M_right->M_refs);
+    return tmp;
+  }
+
+  // Frees x alone; its links to children must have been handed over.
+  void
+  M_destroy_node(Link_type x)
+  {
+    get_allocator().destroy(&x->M_value_field);
+    M_impl.Node_allocator::deallocate(x, 1);
+  }
+
+  // Drops one link to x, freeing whatever no other version reaches.
+  void
+  M_release(Link_type x)
+  {
+    while (x != 0 && Persistent_tree_release(&x->M_refs))
+    {
+      M_release(x->M_left);
+      Link_type y = x->M_right;
+      M_destroy_node(x);
+      x = y;
+    }
+  }
+
+  // Makes the node linked from slot private, copying it if it is
+  // shared.  slot itself must be private.
+  Link_type
+  M_own(Link_type& slot)
+  {
+    Link_type x = slot;
+    if (Persistent_tree_unique(&x->M_refs))
+      return x;
+    slot = M_clone_node(x);
+    M_release(x);
+    return slot;
+  }
+
+  // The link to path[i]: from its parent path[i - 1], or the root.
+  Link_type&
+  M_slot(Link_type* path, size_type i)
+  {
+    if (i == 0)
+      return M_impl.M_root;
+    Link_type p = path[i - 1];
+    return p->M_left == path[i] ? p->M_left : p->M_right;
+  }
+
+  static void
+  S_rotate_left(Link_type& slot)
+  {
+    Link_type x = slot;
+    Link_type y = x->M_right;
+    x->M_right = y->M_left;
+    y->M_left = x;
+    slot = y;
+  }
+
+  static void
+  S_rotate_right(Link_type& slot)
+  {
+    Link_type x = slot;
+    Link_type y = x->M_left;
+    x->M_left = y->M_right;
+    y->M_right = x;
+    slot = y;
+  }
+
+  // Descends towards k, recording the nodes in path and the directions
+  // taken in right.  Returns the depth reached; found tells whether
+  // path[depth - 1] holds k.
+  size_type
+  M_descend(const key_type& k, Link_type* path, bool* right,
+            bool& found) const
+  {
+    size_type d = 0;
+    found = false;
+    for (Link_type x = M_impl.M_root; x != 0; ++d)
+    {
+      path[d] = x;
+      if (M_impl.M_key_compare(k, S_key(x)))
+        right[d] = false;
+      else if (M_impl.M_key_compare(S_key(x), k))
+        right[d] = true;
+      else
+      {
+        found = true;
+        return d + 1;
+      }
+      x = right[d] ? x->M_right : x->M_left;
+    }
+    return d;
+  }
+
+  // Replaces path[0..d) by private nodes, top down.
+  void
+  M_own_path(Link_type* path, const bool* right, size_type d)
+  {
+    Link_type* slot = &M_impl.M_root;
+    for (size_type i = 0; i < d; ++i)
+    {
+      path[i] = M_own(*slot);
+      slot = right[i] ? &path[i]->M_right : &path[i]->M_left;
+    }
+  }
+
+  // Links the new node z below the private path[0..d) and rebalances.
+  void
+  M_link(Link_type z, Link_type* path, const bool* right, size_type d)
+  {
+    if (d == 0)
+      M_impl.M_root = z;
+    else if (right[d - 1])
+      path[d - 1]->M_right = z;
+    else
+      path[d - 1]->M_left = z;
+
+    Link_type x = z;
+    // A red parent is never the root, so the grandparent exists.
+    while (d > 0 && path[d - 1]->M_color == S_red)
+    {
+      Link_type p = path[d - 1];
+      Link_type g = path[d - 2];
+      if (p == g->M_left)
+      {
+        if (!S_is_black(g->M_right))
+        {
+          Link_type u = M_own(g->M_right);
+          p->M_color = S_black;
+          u->M_color = S_black;
+          g->M_color = S_red;
+          x = g;
+          d -= 2;
+          continue;
+        }
+        if (x == p->M_right)
+        {
+          S_rotate_left(g->M_left);
+          p = g->M_left;
+        }
+        p->M_color = S_black;
+        g->M_color = S_red;
+        S_rotate_right(M_slot(path, d - 2));
+      }
+      else
+      {
+        if (!S_is_black(g->M_left))
+        {
+          Link_type u = M_own(g->M_left);
+          p->M_color = S_black;
+          u->M_color = S_black;
+          g->M_color = S_red;
+          x = g;
+          d -= 2;
+          continue;
+        }
+        if (x == p->M_left)
+        {
+          S_rotate_right(g->M_right);
+          p = g->M_right;
+        }
+        p->M_color = S_black;
+        g->M_color = S_red;
+        S_rotate_left(M_slot(path, d - 2));
+      }
+      break;
+    }
+    M_impl.M_root->M_color = S_black;
+  }
+
+  // Unlinks and frees path[d - 1], the path being private, and
+  // rebalances.
+  void
+  M_erase_at(Link_type* path, size_type d)
+  {
+    const size_type dz = d - 1;
+    Link_type z = path[dz];
+    Link_type x;
+    Rb_tree_color removed;
+    if (z->M_left == 0 || z->M_right == 0)
+    {
+      x = z->M_left != 0 ? z->M_left : z->M_right;
+      removed = z->M_color;
+      M_slot(path, dz) = x;
+      d = dz;
+    }
+    else
+    {
+      // z's successor y takes its place.
+      Link_type* slot = &z->M_right;
+      for (;;)
+      {
+        path[d] = M_own(*slot);
+        if (path[d]->M_left == 0)
+          break;
+        slot = &path[d++]->M_left;
+      }
+      Link_type y = path[d];
+      x = y->M_right;
+      removed = y->M_color;
+      if (d != dz + 1)
+      {
+        path[d - 1]->M_left = x;
+        y->M_right = z->M_right;
+      }
+      y->M_left = z->M_left;
+      y->M_color = z->M_color;
+      M_slot(path, dz) = y;
+      path[dz] = y;
+    }
+    M_destroy_node(z);
+    --M_impl.M_node_count;
+    if (removed == S_black)
+      M_erase_fixup(x, path, d);
+  }
+
+  // Restores the black height after a black node was removed above x,
+  // whose ancestors are path[0..d).
+  void
+  M_erase_fixup(Link_type x, Link_type* path, size_type d)
+  {
+    while (d > 0 && S_is_black(x))
+    {
+      Link_type p = path[d - 1];
+      if (x == p->M_left)
+      {
+        Link_type w = M_own(p->M_right);
+        if (w->M_color == S_red)
+        {
+          w->M_color = S_black;
+          p->M_color = S_red;
+          S_rotate_left(M_slot(path, d - 1));
+          path[d - 1] = w;
+          path[d++] = p;
+          w = M_own(p->M_right);
+        }
+        if (S_is_black(w->M_left) && S_is_black(w->M_right))
+        {
+          w->M_color = S_red;
+          x = p;
+          --d;
+          continue;
+        }
+        if (S_is_black(w->M_right))
+        {
+          M_own(w->M_left)->M_color = S_black;
+          w->M_color = S_red;
+          S_rotate_right(p->M_right);
+          w = p->M_right;
+        }
+        w->M_color = p->M_color;
+        p->M_color = S_black;
+        M_own(w->M_right)->M_color = S_black;
+        S_rotate_left(M_slot(path, d - 1));
+      }
+      else
+      {
+        Link_type w = M_own(p->M_left);
+        if (w->M_color == S_red)
+        {
+          w->M_color = S_black;
+          p->M_color = S_red;
+          S_rotate_right(M_slot(path, d - 1));
+          path[d - 1] = w;
+          path[d++] = p;
+          w = M_own(p->M_left);
+        }
+        if (S_is_black(w->M_left) && S_is_black(w->M_right))
+        {
+          w->M_color = S_red;
+          x = p;
+          --d;
+          continue;
+        }
+        if (S_is_black(w->M_left))
+        {
+          M_own(w->M_right)->M_color = S_black;
+          w->M_color = S_red;
+          S_rotate_left(p->M_left);
+          w = p->M_left;
+        }
+        w->M_color = p->M_color;
+        p->M_color = S_black;
+        M_own(w->M_left)->M_color = S_black;
+        S_rotate_right(M_slot(path, d - 1));
+      }
+      return;
+    }
+    if (x != 0 && x->M_color == S_red)
+    {
+      Link_type& slot = d == 0 ? M_impl.M_root
+                               : (path[d - 1]->M_left == x
+                                  ? path[d - 1]->M_left
+                                  : path[d - 1]->M_right);
+      M_own(slot)->M_color = S_black;
+    }
+  }
+
+  iterator
+  M_make_iterator(Link_type* path, size_type d) const
+  {
+    iterator it(M_impl.M_root);
+    std::copy(path, path + d, it.M_path);
+    it.M_depth = d;
+    return it;
+  }
+
+public:
+  Persistent_tree(const Compare& comp, const allocator_type& a)
+  : M_impl(Node_allocator(a), comp)
+  { }
+
+  // Shares every node of x: constant time.
+  Persistent_tree(const Persistent_tree& x)
+  : M_impl(x.M_get_Node_allocator(), x.M_impl.M_key_compare)
+  {
+    M_impl.M_root = x.M_impl.M_root;
+    M_impl.M_node_count = x.M_impl.M_node_count;
+    if (M_impl.M_root != 0)
+      Persistent_tree_acquire(&M_impl.M_root->M_refs);
+  }
+
+  ~Persistent_tree()
+  { M_release(M_impl.M_root); }
+
+  Persistent_tree&
+  operator=(const Persistent_tree& x)
+  {
+    if (x.M_impl.M_root != 0)
+      Persistent_tree_acquire(&x.M_impl.M_root->M_refs);
+    M_release(M_impl.M_root);
+    M_impl.M_root = x.M_impl.M_root;
+    M_impl.M_node_count = x.M_impl.M_node_count;
+    M_impl.M_key_compare = x.M_impl.M_key_compare;
+    return *this;
+  }
+
+  // Accessors.
+  Compare
+  key_comp() const
+  { return M_impl.M_key_compare; }
+
+  allocator_type
+  get_allocator() const
+  { return allocator_type(M_get_Node_allocator()); }
+
+  iterator
+  begin() const
+  {
+    iterator it(M_impl.M_root);
+    it.M_push_leftmost(M_impl.M_root);
+    return it;
+  }
+
+  iterator
+  end() const
+  { return iterator(M_impl.M_root); }
+
+  reverse_iterator
+  rbegin() const
+  { return reverse_iterator(end()); }
+
+  reverse_iterator
+  rend() const
+  { return reverse_iterator(begin()); }
+
+  bool
+  empty() const
+  { return M_impl.M_node_count == 0; }
+
+  size_type
+  size() const
+  { return M_impl.M_node_count; }
+
+  size_type
+  max_size() const
+  { return get_allocator().max_size(); }
+
+  // True if x is the very same version, i.e. shares the root.
+  bool
+  M_same_version(const Persistent_tree& x) const
+  { return M_impl.M_root == x.M_impl.M_root; }
+
+  void
+  swap(Persistent_tree& t)
+  {
+    std::swap(M_impl.M_root, t.M_impl.M_root);
+    std::swap(M_impl.M_node_count, t.M_impl.M_node_count);
+    std::swap(M_impl.M_key_compare, t.M_impl.M_key_compare);
+  }
+
+  // Insert/erase.
+  pair<iterator, bool>
+  M_insert_unique(const value_type& v)
+  {
+    Link_type path[S_max_depth];
+    bool right[S_max_depth];
+    bool found;
+    size_type d = M_descend(KeyOfValue()(v), path, right, found);
+    if (found)
+      return pair<iterator, bool>(M_make_iterator(path, d), false);
+    Link_type z = M_create_node(v);
+    M_own_path(path, right, d);
+    M_link(z, path, right, d);
+    ++M_impl.M_node_count;
+    return pair<iterator, bool>(find(S_key(z)), true);
+  }
+
+  template <typename InputIterator>
+  void
+  M_insert_unique(InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+      M_insert_unique(*first);
+  }
+
+  // Makes the path to k private and returns its element for writing,
+  // or 0 if k is absent (then nothing is copied).
+  value_type*
+  M_find_own(const key_type& k)
+  {
+    Link_type path[S_max_depth];
+    bool right[S_max_depth];
+    bool found;
+    size_type d = M_descend(k, path, right, found);
+    if (!found)
+      return 0;
+    right[d - 1] = false;
+    M_own_path(path, right, d);
+    return &path[d - 1]->M_value_field;
+  }
+
+  size_type
+  M_erase_unique(const key_type& k)
+  {
+    Link_type path[S_max_depth];
+    bool right[S_max_depth];
+    bool found;
+    size_type d = M_descend(k, path, right, found);
+    if (!found)
+      return 0;
+    right[d - 1] = false;
+    M_own_path(path, right, d);
+    M_erase_at(path, d);
+    return 1;
+  }
+
+  void
+  clear()
+  {
+    M_release(M_impl.M_root);
+    M_impl.M_root = 0;
+    M_impl.M_node_count = 0;
+  }
+
+  // Set operations.
+  iterator
+  find(const key_type& k) const
+  {
+    iterator j = lower_bound(k);
+    if (j.M_depth != 0
+        && M_impl.M_key_compare(k, S_key(j.M_path[j.M_depth - 1])))
+      j.M_depth = 0;
+    return j;
+  }
+
+  size_type
+  count(const key_type& k) const
+  {
+    for (Link_type x = M_impl.M_root; x != 0; )
+    {
+      if (M_impl.M_key_compare(k, S_key(x)))
+        x = x->M_left;
+      else if (M_impl.M_key_compare(S_key(x), k))
+        x = x->M_right;
+      else
+        return 1;
+    }
+    return 0;
+  }
+
+  iterator
+  lower_bound(const key_type& k) const
+  {
+    iterator it(M_impl.M_root);
+    size_type keep = 0;
+    for (Link_type x = M_impl.M_root; x != 0; )
+    {
+      it.M_path[it.M_depth++] = x;
+      if (!M_impl.M_key_compare(S_key(x), k))
+      {
+        keep = it.M_depth;
+        x = x->M_left;
+      }
+      else
+        x = x->M_right;
+    }
+    it.M_depth = keep;
+    return it;
+  }
+
+  iterator
+  upper_bound(const key_type& k) const
+  {
+    iterator it(M_impl.M_root);
+    size_type keep = 0;
+    for (Link_type x = M_impl.M_root; x != 0; )
+    {
+      it.M_path[it.M_depth++] = x;
+      if (M_impl.M_key_compare(k, S_key(x)))
+      {
+        keep = it.M_depth;
+        x = x->M_left;
+      }
+      else
+        x = x->M_right;
+    }
+    it.M_depth = keep;
+    return it;
+  }
+
+  pair<iterator, iterator>
+  equal_range(const key_type& k) const
+  { return pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
+};
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc>
+inline bool
+operator==(const Persistent_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
+           const Persistent_tree<Key, Val, KeyOfValue, Compare, Alloc>& y)
+{
+  return x.size() == y.size()
+    && (x.M_same_version(y) || ft::equal(x.begin(), x.end(), y.begin()));
+}
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc>
+inline bool
+operator<(const Persistent_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
+          const Persistent_tree<Key, Val, KeyOfValue, Compare, Alloc>& y)
+{
+  return ft::lexicographical_compare(x.begin(), x.end(),
+                                     y.begin(), y.end());
+}
+
+} // ft
+#endif // STL_PERSISTENT_TREE_H_
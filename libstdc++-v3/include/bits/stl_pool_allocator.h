@@ -0,0 +1,184 @@
+// Pooled node allocator -*- C++ -*-
+
+/** @file stl_pool_allocator.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_POOL_ALLOCATOR_H_
+#define STL_POOL_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <bits/gthr.h>
+
+namespace ft {
+
+/**
+ *  @if maint
+ *  One free list of @a Slot byte blocks, shared by every
+ *  pool_allocator whose value type rounds up to that size.  Blocks are
+ *  carved from 4KB chunks (or 16 blocks, if larger) and, as with
+ *  libstdc++'s __pool_alloc, the chunks are never given back; freed
+ *  blocks only go back on the list.  A mutex guards the list; as with
+ *  libstdc++'s own locks, locking it costs nothing in programs that
+ *  cannot start threads, and every translation unit sees the same
+ *  definition whether it was built with -pthread or not.
+ *  @endif
+ */
+template <std::size_t Slot>
+struct Node_pool
+{
+  struct Free_block
+  { Free_block* M_next; };
+
+  enum { S_chunk_bytes = Slot * 16 > 4096 ? Slot * 16 : 4096 };
+
+  static Free_block*       S_free;
+  static __gthread_mutex_t S_mutex;
+
+  static void*
+  S_allocate()
+  {
+    __gthread_mutex_lock(&S_mutex);
+    if (S_free == 0)
+    {
+      char* chunk;
+      try
+      {
+        chunk = static_cast<char*>(::operator new(S_chunk_bytes));
+      }
+      catch(...)
+      {
+        __gthread_mutex_unlock(&S_mutex);
+        throw;
+      }
+      // Thread the chunk onto the list front to back, so that blocks
+      // handed out in a row are adjacent in memory.
+      const std::size_t n = S_chunk_bytes / Slot;
+      for (std::size_t i = 0; i + 1 < n; ++i)
+        reinterpret_cast<Free_block*>(chunk + i * Slot)->M_next =
+          reinterpret_cast<Free_block*>(chunk + (i + 1) * Slot);
+      reinterpret_cast<Free_block*>(chunk + (n - 1) * Slot)->M_next = 0;
+      S_free = reinterpret_cast<Free_block*>(chunk);
+    }
+    Free_block* p = S_free;
+    S_free = p->M_next;
+    __gthread_mutex_unlock(&S_mutex);
+    return p;
+  }
+
+  static void
+  S_deallocate(void* p)
+  {
+    Free_block* b = static_cast<Free_block*>(p);
+    __gthread_mutex_lock(&S_mutex);
+    b->M_next = S_free;
+    S_free = b;
+    __gthread_mutex_unlock(&S_mutex);
+  }
+};
+
+template <std::size_t Slot>
+typename Node_pool<Slot>::Free_block* Node_pool<Slot>::S_free = 0;
+
+template <std::size_t Slot>
+__gthread_mutex_t Node_pool<Slot>::S_mutex = __GTHREAD_MUTEX_INIT;
+
+/**
+ *  @brief  An allocator that serves single objects from a shared pool.
+ *
+ *  Meant for node-based containers, which only ever allocate one node
+ *  at a time, e.g. ft::list<Tp, ft::pool_allocator<Tp> >: the container
+ *  rebinds it to its node type, and nodes then come from a free list
+ *  instead of operator new.  Requests for more than one object, or for
+ *  over-aligned types, go to operator new as usual.
+ *
+ *  All pool_allocators are interchangeable and compare equal.  Memory
+ *  taken for the pool stays with it until the program ends.
+ */
+template <typename Tp>
+class pool_allocator
+{
+  enum { S_word = sizeof(void*), S_align = 2 * sizeof(void*) };
+  enum { S_slot = (sizeof(Tp) + S_word - 1) / S_word * S_word };
+
+  static bool
+  S_pooled(std::size_t n)
+  { return n == 1 && __alignof__(Tp) <= std::size_t(S_align); }
+
+public:
+  typedef std::size_t     size_type;
+  typedef std::ptrdiff_t  difference_type;
+  typedef Tp*             pointer;
+  typedef const Tp*       const_pointer;
+  typedef Tp&             reference;
+  typedef const Tp&       const_reference;
+  typedef Tp              value_type;
+
+  template <typename Tp1>
+  struct rebind
+  { typedef pool_allocator<Tp1> other; };
+
+  pool_allocator() throw() { }
+
+  pool_allocator(const pool_allocator&) throw() { }
+
+  template <typename Tp1>
+  pool_allocator(const pool_allocator<Tp1>&) throw() { }
+
+  ~pool_allocator() throw() { }
+
+  pointer
+  address(reference x) const
+  { return &x; }
+
+  const_pointer
+  address(const_reference x) const
+  { return &x; }
+
+  pointer
+  allocate(size_type n, const void* = 0)
+  {
+    if (n > max_size())
+      throw std::bad_alloc();
+    if (S_pooled(n))
+      return static_cast<Tp*>(Node_pool<S_slot>::S_allocate());
+    return static_cast<Tp*>(::operator new(n * sizeof(Tp)));
+  }
+
+  void
+  deallocate(pointer p, size_type n)
+  {
+    if (S_pooled(n))
+      Node_pool<S_slot>::S_deallocate(p);
+    else
+      ::operator delete(p);
+  }
+
+  size_type
+  max_size() const throw()
+  { return size_t(-1) / sizeof(Tp); }
+
+  void
+  construct(pointer p, const Tp& val)
+  { ::new(static_cast<void*>(p)) Tp(val); }
+
+  void
+  destroy(pointer p)
+  { p->~Tp(); }
+};
+
+template <typename Tp1, typename Tp2>
+inline bool
+operator==(const pool_allocator<Tp1>&, const pool_allocator<Tp2>&)
+{ return true; }
+
+template <typename Tp1, typename Tp2>
+inline bool
+operator!=(const pool_allocator<Tp1>&, const pool_allocator<Tp2>&)
+{ return false; }
+
+} // ft
+
+#endif // STL_POOL_ALLOCATOR_H_
@@ -0,0 +1,211 @@
+// Queue implementation -*- C++ -*-
+
+/** @file stl_queue.h
+ * This is an internal header file, included by other library headers.
+ * You should not attempt to use it directly.
+ */
+
+
+#ifndef STL_QUEUE_H_
+#define STL_QUEUE_H_
+
+#include "stl_deque.h"
+
+namespace ft {
+
+/**
+ * @brief A standard container giving FIFO behavior.
+ * 
+ * @ingroup Containers
+ * @ingroup Sequences
+ * 
+ * Meets many of the requirements of a
+ * container,
+ * but does not define anything to do with iterators. Very few of the
+ * other standard container interfaces are defined.
+ * 
+ * This is not a true container, but an @e adaptor. It holds another
+ * container, and provides a wrapper interface to that container. The
+ * wrapper is what enforces strict first-in-first-out %queue behavior.
+ * 
+ * The second template parameter defines the type of the underlying
+ * sequence/container. It defaults to ft::deque, but it can be any
+ * type that supports @c front, @c back, @c push_back, and @c pop_front,
+ * such as std::list or an appropriate user-defined type.
+ * 
+ * Members not found in "normal" containers are @c container_type,
+ * which is a typedef for the second Sequence parameter, and @c push and
+ * @c pop, which are standard %queue/FIFO operations.
+ *
+ * For queues shared between threads see ft::spsc_ring and
+ * ft::mpmc_queue.
+ */
+template <typename Tp, typename Sequence = ft::deque<Tp> >
+class queue
+{
+  typedef typename Sequence::value_type Sequence_value_type;
+
+  template <typename Tp1, typename Seq1>
+  friend bool
+  operator==(const queue<Tp1, Seq1>&, const queue<Tp1, Seq1>&);
+
+  template <typename Tp1, typename Seq1>
+  friend bool
+  operator<(const queue<Tp1, Seq1>&, const queue<Tp1, Seq1>&);
+
+public:
+  typedef typename Sequence::value_type       value_type;
+  typedef typename Sequence::reference        reference;
+  typedef typename Sequence::const_reference  const_reference;
+  typedef typename Sequence::size_type        size_type;
+  typedef          Sequence                   container_type;
+
+protected:
+  /**
+   * 'c' is the underlying container, named and protected as in the
+   * standard, [23.2.3.1], like that of ft::stack.
+   */
+  Sequence c;
+
+public:
+  /**
+   * @brief Default constructor creates no elements.
+   */
+  explicit
+  queue(const Sequence& c = Sequence())
+  : c(c) {}
+
+  /**
+   * Returns true if the %queue is empty.
+   */
+  bool
+  empty() const
+  { return c.empty(); }
+
+  /** Returns the number of elements in the %queue. */
+  size_type
+  size() const
+  { return c.size(); }
+
+  /**
+   * Returns a read/write reference to the data at the first
+   * element of the %queue.
+   */
+  reference
+  front()
+  { return c.front(); }
+
+  /**
+   * Returns a read-only (constant) reference to the data at the first
+   * element of the %queue.
+   */
+  const_reference
+  front() const
+  { return c.front(); }
+
+  /**
+   * Returns a read/write reference to the data at the last
+   * element of the %queue.
+   */
+  reference
+  back()
+  { return c.back(); }
+
+  /**
+   * Returns a read-only (constant) reference to the data at the last
+   * element of the %queue.
+   */
+  const_reference
+  back() const
+  { return c.back(); }
+
+  /**
+   * @brief Add data to the end of the %queue.
+   * @param x Data to be added.
+   * 
+   * This is a typical %queue operation. The function creates an
+   * element at the end of the %queue and assigns the given data
+   * to it. The time complexity of the operation depends on the
+   * underlying sequence.
+   */
+  void
+  push(const value_type& x)
+  { c.push_back(x); }
+
+  /**
+   * @brief Removes first element.
+   * 
+   * This is a typical %queue operation. It shrinks the %queue by one.
+   * The time complexity of the operation depends on the underlying
+   * sequence.
+   * 
+   * Note that no data is returned, and if the first element's
+   * data is needed, it should be retrieved before pop() is
+   * called.
+   */
+  void
+  pop()
+  { c.pop_front(); }
+};
+
+/**
+ * @brief Queue equality comparison.
+ * @param x A %queue
+ * @param y A %queue of the same type as @a x.
+ * @return True if the size and elements of the queues are equal.
+ * 
+ * This is an equivalence relation. Complexity and semantics
+ * depend on the underlying sequence type, but the expected rules
+ * are: thie relation is linear in the size of the sequences, and
+ * queues are considered equivalent if their sequences compare
+ * equal.
+ */
+template <typename Tp, typename Seq>
+bool
+operator==(const queue<Tp, Seq>& x, const queue<Tp, Seq>& y)
+{ return x.c == y.c; }
+
+/**
+ *  @brief  Queue ordering relation.
+ *  @param  x  A %queue.
+ *  @param  y  A %queue of the same type as @a x.
+ *  @return  True iff @a x is lexicographically less than @a y.
+ *
+ *  This is an total ordering relation.  Complexity and semantics
+ *  depend on the underlying sequence type, but the expected rules
+ *  are: this relation is linear in the size of the sequences, the
+ *  elements must be comparable with @c <, and
+ *  std::lexicographical_compare() is usually used to make the
+ *  determination.
+*/
+template <typename Tp, typename Seq>
+bool
+operator<(const queue<Tp, Seq>& x, const queue<Tp, Seq>& y)
+{ return x.c < y.c; }
+
+/// Based on operator==
+template <typename Tp, typename Seq>
+bool
+operator!=(const queue<Tp, Seq>& x, const queue<Tp, Seq>& y)
+{ return !(x == y); }
+
+/// Based on operator<
+template <typename Tp, typename Seq>
+bool
+operator>(const queue<Tp, Seq>& x, const queue<Tp, Seq>& y)
+{ return y < x; }
+
+/// Based on operator<
+template <typename Tp, typename Seq>
+bool
+operator<=(const queue<Tp, Seq>& x, const queue<Tp, Seq>& y)
+{ return !(y < x); }
+
+/// Based on operator<
+template <typename Tp, typename Seq>
+bool
+operator>=(const queue<Tp, Seq>& x, const queue<Tp, Seq>& y)
+{ return !(x < y); }
+
+} // ft
+#endif // STL_QUEUE_H_
\ No newline at end of file
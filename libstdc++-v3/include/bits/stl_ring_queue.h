@@ -0,0 +1,484 @@
+// Bounded concurrent queues -*- C++ -*-
+
+/** @file stl_ring_queue.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_RING_QUEUE_H_
+#define STL_RING_QUEUE_H_
+
+#include <memory>
+#include <cstddef>
+#include <sched.h>
+
+
+namespace ft {
+
+enum { S_ring_cache_line = 64 };
+
+// Spins with a growing pause, then yields the processor.
+inline void
+Ring_backoff(unsigned& round)
+{
+  if (round < 6)
+    for (unsigned i = 0; i < (1u << round); ++i)
+      __asm__ __volatile__("" ::: "memory");
+  else
+    sched_yield();
+  ++round;
+}
+
+/**
+ *  @brief  A bounded lock-free queue for exactly one producer thread and
+ *  one consumer thread.
+ *
+ *  @tparam  Tp  Type of element.
+ *  @tparam  N  Capacity; a power of two.
+ *  @tparam  Alloc  Allocator type, defaults to allocator<Tp>.
+ *
+ *  The elements live in a ring of N slots.  The producer owns the tail
+ *  index and the consumer the head index, each alone on its cache line;
+ *  each side also keeps a private copy of the other's index and reads
+ *  the shared one only when that copy says the ring is full (or empty),
+ *  so that in steady state the two threads seldom touch the same line.
+ *  The batch operations publish a whole run of elements with one store.
+ *
+ *  push and try_push may only be called by the producer, pop and try_pop
+ *  by the consumer; empty, size and capacity by anyone.
+ */
+template <typename Tp, std::size_t N, typename Alloc = std::allocator<Tp> >
+class spsc_ring
+{
+  // N must be a nonzero power of two.
+  typedef char S_power_of_two[N != 0 && (N & (N - 1)) == 0 ? 1 : -1];
+
+public:
+  typedef Tp            value_type;
+  typedef std::size_t   size_type;
+  typedef Alloc         allocator_type;
+
+private:
+  typedef typename Alloc::pointer pointer;
+
+  enum { S_pad = S_ring_cache_line - sizeof(std::size_t) };
+
+  // Written by the producer.
+  volatile size_type  M_tail;
+  size_type           M_head_cache;
+  char                M_pad1[S_pad - sizeof(size_type)];
+  // Written by the consumer.
+  volatile size_type  M_head;
+  size_type           M_tail_cache;
+  char                M_pad2[S_pad - sizeof(size_type)];
+  Alloc               M_alloc;
+  pointer             M_slots;
+
+  spsc_ring(const spsc_ring&);
+  spsc_ring& operator=(const spsc_ring&);
+
+  // Free slots for the producer, rereading the head if none are known.
+  size_type
+  M_room(size_type tail, size_type wanted)
+  {
+    size_type room = N - (tail - M_head_cache);
+    if (room < wanted)
+    {
+      M_head_cache = __atomic_load_n(&M_head, __ATOMIC_ACQUIRE);
+      room = N - (tail - M_head_cache);
+    }
+    return room;
+  }
+
+  // Full slots for the consumer, rereading the tail if none are known.
+  size_type
+  M_ready(size_type head, size_type wanted)
+  {
+    size_type ready = M_tail_cache - head;
+    if (ready < wanted)
+    {
+      M_tail_cache = __atomic_load_n(&M_tail, __ATOMIC_ACQUIRE);
+      ready = M_tail_cache - head;
+    }
+    return ready;
+  }
+
+public:
+  explicit
+  spsc_ring(const allocator_type& a = allocator_type())
+  : M_tail(0), M_head_cache(0), M_head(0), M_tail_cache(0), M_alloc(a),
+    M_slots(M_alloc.allocate(N)) { }
+
+  ~spsc_ring()
+  {
+    for (size_type i = M_head; i != M_tail; ++i)
+      M_alloc.destroy(M_slots + (i & (N - 1)));
+    M_alloc.deallocate(M_slots, N);
+  }
+
+  allocator_type
+  get_allocator() const
+  { return M_alloc; }
+
+  size_type
+  capacity() const
+  { return N; }
+
+  /**  Returns the number of elements, exact only when both sides rest.  */
+  size_type
+  size() const
+  {
+    const size_type head = __atomic_load_n(&M_head, __ATOMIC_ACQUIRE);
+    return __atomic_load_n(&M_tail, __ATOMIC_ACQUIRE) - head;
+  }
+
+  bool
+  empty() const
+  { return size() == 0; }
+
+  /**
+   *  @brief  Appends a copy of @a x unless the ring is full.
+   *  @return  True if @a x was pushed.
+   */
+  bool
+  try_push(const value_type& x)
+  {
+    const size_type tail = M_tail;
+    if (M_room(tail, 1) == 0)
+      return false;
+    M_alloc.construct(M_slots + (tail & (N - 1)), x);
+    __atomic_store_n(&M_tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /**  Appends a copy of @a x, waiting while the ring is full.  */
+  void
+  push(const value_type& x)
+  {
+    for (unsigned round = 0; !try_push(x); )
+      Ring_backoff(round);
+  }
+
+  /**
+   *  @brief  Appends up to @a n elements read from @a first.
+   *  @return  How many were pushed: all that fit.
+   */
+  template <typename InputIterator>
+  size_type
+  try_push(InputIterator first, size_type n)
+  {
+    const size_type tail = M_tail;
+    size_type room = M_room(tail, n);
+    if (room > n)
+      room = n;
+    size_type i = 0;
+    try
+    {
+      for (; i < room; ++i, ++first)
+        M_alloc.construct(M_slots + ((tail + i) & (N - 1)), *first);
+    }
+    catch(...)
+    {
+      __atomic_store_n(&M_tail, tail + i, __ATOMIC_RELEASE);
+      throw;
+    }
+    __atomic_store_n(&M_tail, tail + room, __ATOMIC_RELEASE);
+    return room;
+  }
+
+  /**
+   *  @brief  Moves the oldest element into @a x unless the ring is empty.
+   *  @return  True if an element was popped.
+   */
+  bool
+  try_pop(value_type& x)
+  {
+    const size_type head = M_head;
+    if (M_ready(head, 1) == 0)
+      return false;
+    pointer p = M_slots + (head & (N - 1));
+    x = *p;
+    M_alloc.destroy(p);
+    __atomic_store_n(&M_head, head + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /**  Moves the oldest element into @a x, waiting while empty.  */
+  void
+  pop(value_type& x)
+  {
+    for (unsigned round = 0; !try_pop(x); )
+      Ring_backoff(round);
+  }
+
+  /**
+   *  @brief  Pops up to @a n elements, writing them from @a out on.
+   *  @return  How many were popped: all that were there.
+   */
+  template <typename OutputIterator>
+  size_type
+  try_pop(OutputIterator out, size_type n)
+  {
+    const size_type head = M_head;
+    size_type ready = M_ready(head, n);
+    if (ready > n)
+      ready = n;
+    size_type i = 0;
+    try
+    {
+      for (; i < ready; ++i, ++out)
+      {
+        pointer p = M_slots + ((head + i) & (N - 1));
+        *out = *p;
+        M_alloc.destroy(p);
+      }
+    }
+    catch(...)
+    {
+      __atomic_store_n(&M_head, head + i, __ATOMIC_RELEASE);
+      throw;
+    }
+    __atomic_store_n(&M_head, head + ready, __ATOMIC_RELEASE);
+    return ready;
+  }
+};
+
+/**
+ *  @brief  A bounded lock-free queue for any number of producer and
+ *  consumer threads.
+ *
+ *  @tparam  Tp  Type of element.
+ *  @tparam  Alloc  Allocator type, defaults to allocator<Tp>.
+ *
+ *  This is Vyukov's bounded MPMC queue.  Each slot of a ring, its size
+ *  the capacity rounded up to a power of two, carries a sequence number
+ *  telling which lap of the ring it is ready for, to be filled or to be
+ *  emptied.  A thread claims a position by advancing the enqueue (or
+ *  dequeue) index with one compare-and-swap, then fills (or empties) the
+ *  slot and publishes it by bumping its sequence number.  The two indices
+ *  sit on cache lines of their own.  The batch operations claim a run of
+ *  consecutive ready slots with a single compare-and-swap.
+ *
+ *  A thread stalled between claiming a slot and publishing it holds up
+ *  the consumers of that slot, but no one else.  For the same reason a
+ *  claimed slot must be published: copying or assigning an element must
+ *  not throw.
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp> >
+class mpmc_queue
+{
+public:
+  typedef Tp            value_type;
+  typedef std::size_t   size_type;
+  typedef Alloc         allocator_type;
+
+private:
+  struct Cell
+  {
+    volatile size_type  M_sequence;
+    value_type          M_value;
+  };
+
+  typedef typename Alloc::template rebind<Cell>::other  Cell_alloc;
+
+  enum { S_pad = S_ring_cache_line - sizeof(std::size_t) };
+
+  char                M_pad0[S_ring_cache_line];
+  volatile size_type  M_enqueue;
+  char                M_pad1[S_pad];
+  volatile size_type  M_dequeue;
+  char                M_pad2[S_pad];
+  Cell_alloc          M_alloc;
+  Cell*               M_cells;
+  size_type           M_mask;
+
+  mpmc_queue(const mpmc_queue&);
+  mpmc_queue& operator=(const mpmc_queue&);
+
+  static size_type
+  S_round_up(size_type n)
+  {
+    size_type size = 2;
+    while (size < n)
+      size *= 2;
+    return size;
+  }
+
+  size_type
+  M_sequence(size_type pos) const
+  { return __atomic_load_n(&M_cells[pos & M_mask].M_sequence,
+                           __ATOMIC_ACQUIRE); }
+
+  // Claims up to n consecutive slots from *index on, those whose sequence
+  // is their position plus lag: 0 to fill, 1 to empty.  Returns how many,
+  // their first position in pos.
+  size_type
+  M_claim(volatile size_type* index, size_type lag, size_type n,
+          size_type& pos)
+  {
+    pos = __atomic_load_n(index, __ATOMIC_RELAXED);
+    for (;;)
+    {
+      size_type got = 0;
+      while (got < n && M_sequence(pos + got) == pos + got + lag)
+        ++got;
+      if (got == 0)
+      {
+        // Empty (or full) unless the index moved on meanwhile.
+        const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(
+            M_sequence(pos) - (pos + lag));
+        if (diff < 0)
+          return 0;
+        pos = __atomic_load_n(index, __ATOMIC_RELAXED);
+        continue;
+      }
+      if (__atomic_compare_exchange_n(index, &pos, pos + got, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        return got;
+    }
+  }
+
+public:
+  /**
+   *  @brief  Creates an empty queue.
+   *  @param  capacity  Minimum capacity, rounded up to a power of two.
+   */
+  explicit
+  mpmc_queue(size_type capacity, const allocator_type& a = allocator_type())
+  : M_enqueue(0), M_dequeue(0), M_alloc(a), M_cells(0),
+    M_mask(S_round_up(capacity) - 1)
+  {
+    M_cells = M_alloc.allocate(M_mask + 1);
+    for (size_type i = 0; i <= M_mask; ++i)
+      M_cells[i].M_sequence = i;
+  }
+
+  // Must not run concurrently with anything else.
+  ~mpmc_queue()
+  {
+    for (size_type i = M_dequeue; i != M_enqueue; ++i)
+      get_allocator().destroy(&M_cells[i & M_mask].M_value);
+    M_alloc.deallocate(M_cells, M_mask + 1);
+  }
+
+  allocator_type
+  get_allocator() const
+  { return allocator_type(M_alloc); }
+
+  size_type
+  capacity() const
+  { return M_mask + 1; }
+
+  /**  Returns the number of elements, exact only when no one is busy.  */
+  size_type
+  size() const
+  {
+    // The head is read first and never passes the tail, so the
+    // difference cannot wrap; it exceeds the capacity only when pushes
+    // and pops landed between the two loads.
+    const size_type dequeue = __atomic_load_n(&M_dequeue, __ATOMIC_ACQUIRE);
+    const size_type enqueue = __atomic_load_n(&M_enqueue, __ATOMIC_ACQUIRE);
+    return enqueue - dequeue < capacity() ? enqueue - dequeue : capacity();
+  }
+
+  bool
+  empty() const
+  { return size() == 0; }
+
+  /**
+   *  @brief  Appends a copy of @a x unless the queue is full.
+   *  @return  True if @a x was pushed.
+   */
+  bool
+  try_push(const value_type& x)
+  {
+    size_type pos;
+    if (M_claim(&M_enqueue, 0, 1, pos) == 0)
+      return false;
+    Cell& c = M_cells[pos & M_mask];
+    get_allocator().construct(&c.M_value, x);
+    __atomic_store_n(&c.M_sequence, pos + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /**  Appends a copy of @a x, waiting while the queue is full.  */
+  void
+  push(const value_type& x)
+  {
+    for (unsigned round = 0; !try_push(x); )
+      Ring_backoff(round);
+  }
+
+  /**
+   *  @brief  Appends up to @a n elements read from @a first, as one run.
+   *  @return  How many were pushed; the rest of the input is untouched.
+   */
+  template <typename InputIterator>
+  size_type
+  try_push(InputIterator first, size_type n)
+  {
+    size_type pos;
+    const size_type got = M_claim(&M_enqueue, 0, n, pos);
+    allocator_type a = get_allocator();
+    for (size_type i = 0; i < got; ++i, ++first)
+    {
+      Cell& c = M_cells[(pos + i) & M_mask];
+      a.construct(&c.M_value, *first);
+      __atomic_store_n(&c.M_sequence, pos + i + 1, __ATOMIC_RELEASE);
+    }
+    return got;
+  }
+
+  /**
+   *  @brief  Moves the oldest element into @a x unless the queue is
+   *  empty.
+   *  @return  True if an element was popped.
+   */
+  bool
+  try_pop(value_type& x)
+  {
+    size_type pos;
+    if (M_claim(&M_dequeue, 1, 1, pos) == 0)
+      return false;
+    Cell& c = M_cells[pos & M_mask];
+    x = c.M_value;
+    get_allocator().destroy(&c.M_value);
+    __atomic_store_n(&c.M_sequence, pos + M_mask + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /**  Moves the oldest element into @a x, waiting while empty.  */
+  void
+  pop(value_type& x)
+  {
+    for (unsigned round = 0; !try_pop(x); )
+      Ring_backoff(round);
+  }
+
+  /**
+   *  @brief  Pops a run of up to @a n elements, writing them from @a out
+   *  on.
+   *  @return  How many were popped.
+   */
+  template <typename OutputIterator>
+  size_type
+  try_pop(OutputIterator out, size_type n)
+  {
+    size_type pos;
+    const size_type got = M_claim(&M_dequeue, 1, n, pos);
+    allocator_type a = get_allocator();
+    for (size_type i = 0; i < got; ++i, ++out)
+    {
+      Cell& c = M_cells[(pos + i) & M_mask];
+      *out = c.M_value;
+      a.destroy(&c.M_value);
+      __atomic_store_n(&c.M_sequence, pos + i + M_mask + 1,
+                       __ATOMIC_RELEASE);
+    }
+    return got;
+  }
+};
+
+} // ft
+
+#endif // STL_RING_QUEUE_H_
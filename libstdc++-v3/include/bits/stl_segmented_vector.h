@@ -0,0 +1,800 @@
+// Segmented vector implementation -*- C++ -*-
+
+/** @file stl_segmented_vector.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_SEGMENTED_VECTOR_H_
+#define STL_SEGMENTED_VECTOR_H_
+
+#include <cstddef>
+#include <memory>
+#include <iterator>
+#include <stdexcept>
+#include "cpp_type_traits.h"
+#include "stl_iterator.h"
+#include "stl_algobase.h"
+
+namespace ft {
+
+template <std::size_t N>
+struct Segment_log2
+{ enum { value = 1 + Segment_log2<N / 2>::value }; };
+
+template <>
+struct Segment_log2<1>
+{ enum { value = 0 }; };
+
+/**
+ *  @if maint
+ *  Segment geometry for a given element type: as many elements as fit
+ *  in 4096 bytes, rounded down to a power of two so that an index
+ *  splits into segment and offset with a shift and a mask, but never
+ *  fewer than 8.
+ *  @endif
+ */
+template <typename Tp>
+struct Segment_shape
+{
+  enum { S_fit = sizeof(Tp) < std::size_t(4096 / 8)
+         ? 4096 / sizeof(Tp) : std::size_t(8) };
+  enum { S_shift = Segment_log2<S_fit>::value };
+  enum { S_size = 1 << S_shift, S_mask = S_size - 1 };
+};
+
+/**
+ *  @brief A segmented_vector::iterator.
+ *
+ *  An index into the segment directory.  The directory itself may be
+ *  replaced as the container grows, so, as for ft::vector, growing the
+ *  container invalidates iterators; references never are.
+ */
+template <typename Tp, typename Ref, typename Ptr>
+struct Segmented_iterator
+{
+  typedef Segmented_iterator<Tp, Tp&, Tp*>              iterator;
+  typedef Segmented_iterator<Tp, const Tp&, const Tp*>  const_iterator;
+  typedef Segmented_iterator                            Self;
+
+  typedef std::random_access_iterator_tag  iterator_category;
+  typedef Tp                               value_type;
+  typedef Ptr                              pointer;
+  typedef Ref                              reference;
+  typedef std::ptrdiff_t                   difference_type;
+  typedef Segment_shape<Tp>                Shape;
+
+  Tp* const*      M_map;
+  difference_type M_index;
+
+  Segmented_iterator()
+  : M_map(0), M_index(0) { }
+
+  Segmented_iterator(Tp* const* map, difference_type index)
+  : M_map(map), M_index(index) { }
+
+  // iterator to const_iterator.  A template, so that it is never taken
+  // for the copy constructor and the copy operations stay implicit.
+  template <typename Ref2>
+  Segmented_iterator(const Segmented_iterator<Tp, Ref2,
+                     typename ft::enable_if<ft::are_same<Ref2, Tp&>::value,
+                                            Tp*>::type>& x)
+  : M_map(x.M_map), M_index(x.M_index) { }
+
+  reference
+  operator*() const
+  { return M_map[M_index >> Shape::S_shift][M_index & Shape::S_mask]; }
+
+  pointer
+  operator->() const
+  { return &operator*(); }
+
+  Self&
+  operator++()
+  {
+    ++M_index;
+    return *this;
+  }
+
+  Self
+  operator++(int)
+  {
+    Self tmp = *this;
+    ++M_index;
+    return tmp;
+  }
+
+  Self&
+  operator--()
+  {
+    --M_index;
+    return *this;
+  }
+
+  Self
+  operator--(int)
+  {
+    Self tmp = *this;
+    --M_index;
+    return tmp;
+  }
+
+  Self&
+  operator+=(difference_type n)
+  {
+    M_index += n;
+    return *this;
+  }
+
+  Self&
+  operator-=(difference_type n)
+  {
+    M_index -= n;
+    return *this;
+  }
+
+  Self
+  operator+(difference_type n) const
+  { return Self(M_map, M_index + n); }
+
+  Self
+  operator-(difference_type n) const
+  { return Self(M_map, M_index - n); }
+
+  reference
+  operator[](difference_type n) const
+  { return *(*this + n); }
+};
+
+// Comparisons take mixed const and non-const iterators, as
+// ft::normal_iterator's do.
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator==(const Segmented_iterator<Tp, RefL, PtrL>& x,
+           const Segmented_iterator<Tp, RefR, PtrR>& y)
+{ return x.M_index == y.M_index; }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator!=(const Segmented_iterator<Tp, RefL, PtrL>& x,
+           const Segmented_iterator<Tp, RefR, PtrR>& y)
+{ return !(x == y); }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator<(const Segmented_iterator<Tp, RefL, PtrL>& x,
+          const Segmented_iterator<Tp, RefR, PtrR>& y)
+{ return x.M_index < y.M_index; }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator>(const Segmented_iterator<Tp, RefL, PtrL>& x,
+          const Segmented_iterator<Tp, RefR, PtrR>& y)
+{ return y < x; }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator<=(const Segmented_iterator<Tp, RefL, PtrL>& x,
+           const Segmented_iterator<Tp, RefR, PtrR>& y)
+{ return !(y < x); }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline bool
+operator>=(const Segmented_iterator<Tp, RefL, PtrL>& x,
+           const Segmented_iterator<Tp, RefR, PtrR>& y)
+{ return !(x < y); }
+
+template <typename Tp, typename RefL, typename PtrL,
+          typename RefR, typename PtrR>
+inline typename Segmented_iterator<Tp, RefL, PtrL>::difference_type
+operator-(const Segmented_iterator<Tp, RefL, PtrL>& x,
+          const Segmented_iterator<Tp, RefR, PtrR>& y)
+{ return x.M_index - y.M_index; }
+
+template <typename Tp, typename Ref, typename Ptr>
+inline Segmented_iterator<Tp, Ref, Ptr>
+operator+(std::ptrdiff_t n, const Segmented_iterator<Tp, Ref, Ptr>& x)
+{ return x + n; }
+
+/**
+ *  @brief A sequence stored in fixed-size segments, growing and
+ *  shrinking at the end only.
+ *
+ *  @ingroup Containers
+ *  @ingroup Sequences
+ *
+ *  Elements live in segments of Segment_shape<Tp>::S_size elements
+ *  (about 4KB each) reached through a directory of segment pointers.
+ *  Growing never relocates an element: when the last segment fills up
+ *  a new one is added and at most the directory, a pointer per segment,
+ *  is copied.  push_back and pop_back are therefore amortised O(1) even
+ *  for large or expensive-to-copy elements, and references to elements
+ *  stay valid until those elements are popped.
+ *
+ *  Segments emptied by pop_back or clear are kept and reused by later
+ *  pushes, so a sequence that oscillates around a boundary does not
+ *  allocate; shrink_to_fit hands them back.
+ *
+ *  This is meant as the underlying container of ft::stack, e.g.
+ *  ft::stack<Tp, ft::segmented_vector<Tp> >, where ft::vector's
+ *  reallocation copies every element.
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp> >
+class segmented_vector
+{
+  typedef Segment_shape<Tp>                            Shape;
+  typedef typename Alloc::template rebind<Tp>::other   Tp_alloc_type;
+  typedef typename Alloc::template rebind<Tp*>::other  Map_alloc_type;
+
+public:
+  typedef Tp                                           value_type;
+  typedef typename Tp_alloc_type::pointer              pointer;
+  typedef typename Tp_alloc_type::const_pointer        const_pointer;
+  typedef typename Tp_alloc_type::reference            reference;
+  typedef typename Tp_alloc_type::const_reference      const_reference;
+  typedef Segmented_iterator<Tp, Tp&, Tp*>             iterator;
+  typedef Segmented_iterator<Tp, const Tp&, const Tp*> const_iterator;
+  typedef ft::reverse_iterator<const_iterator>         const_reverse_iterator;
+  typedef ft::reverse_iterator<iterator>               reverse_iterator;
+  typedef std::size_t                                  size_type;
+  typedef std::ptrdiff_t                               difference_type;
+  typedef Alloc                                        allocator_type;
+
+private:
+  Tp_alloc_type M_alloc;
+  Tp**          M_map;        // Segment directory.
+  size_type     M_map_size;   // Slots in M_map.
+  size_type     M_segments;   // Segments allocated, used or cached.
+  size_type     M_size;
+
+public:
+  /**
+   * @brief Default constructor creates no elements.
+   */
+  explicit
+  segmented_vector(const allocator_type& a = allocator_type())
+  : M_alloc(a), M_map(0), M_map_size(0), M_segments(0), M_size(0) { }
+
+  /**
+   * @brief Creates a %segmented_vector with copies of an exemplar element.
+   * @param n The number of elements to initially create.
+   * @param value An element to copy.
+   */
+  explicit
+  segmented_vector(size_type n, const value_type& value = value_type(),
+                   const allocator_type& a = allocator_type())
+  : M_alloc(a), M_map(0), M_map_size(0), M_segments(0), M_size(0)
+  { M_fill_initialize(n, value); }
+
+  /**
+   * @brief %Segmented_vector copy constructor.
+   * @param x A %segmented_vector of identical element and allocator
+   * types.
+   *
+   * Only as many segments as @a x uses are allocated; its cached
+   * segments are not copied.
+   */
+  segmented_vector(const segmented_vector& x)
+  : M_alloc(x.M_alloc), M_map(0), M_map_size(0), M_segments(0), M_size(0)
+  { M_range_initialize(x.begin(), x.end()); }
+
+  /**
+   * @brief Builds a %segmented_vector from a range.
+   * @param first An input iterator.
+   * @param last An input iterator.
+   */
+  template <typename InputIterator>
+  segmented_vector(InputIterator first, InputIterator last,
+                   const allocator_type& a = allocator_type())
+  : M_alloc(a), M_map(0), M_map_size(0), M_segments(0), M_size(0)
+  {
+    // Check whether it's an integral type. If so, it's not an iterator.
+    typedef typename ft::is_integer<InputIterator>::type Integral;
+    M_initialize_dispatch(first, last, Integral());
+  }
+
+  /**
+   * The dtor destroys the elements and frees every segment, cached ones
+   * included.
+   */
+  ~segmented_vector()
+  { M_deallocate_all(); }
+
+  /**
+   * @brief %Segmented_vector assignment operator.
+   * @param x A %segmented_vector of identical element and allocator
+   * types.
+   *
+   * The segments already held are reused for the copies.
+   */
+  segmented_vector&
+  operator=(const segmented_vector& x)
+  {
+    if (&x != this)
+    {
+      clear();
+      reserve(x.size());
+      for (const_iterator i = x.begin(); i != x.end(); ++i)
+        push_back(*i);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Assigns a given value to a %segmented_vector.
+   * @param n Number of elements to be assigned.
+   * @param val Value to be assigned.
+   */
+  void
+  assign(size_type n, const value_type& val)
+  {
+    clear();
+    M_fill_append(n, val);
+  }
+
+  /**
+   * @brief Assigns a range to a %segmented_vector.
+   * @param first An input iterator.
+   * @param last An input iterator.
+   */
+  template <typename InputIterator>
+  void
+  assign(InputIterator first, InputIterator last)
+  {
+    clear();
+    typedef typename ft::is_integer<InputIterator>::type Integral;
+    M_initialize_dispatch(first, last, Integral());
+  }
+
+  /// Get a copy of the memory allocation object.
+  allocator_type
+  get_allocator() const
+  { return allocator_type(M_alloc); }
+
+  // iterators
+  /**
+   * Returns a read/write iterator that points to the first element in
+   * the %segmented_vector. Iteration is done in ordinary element order.
+   */
+  iterator
+  begin()
+  { return iterator(M_map, 0); }
+
+  /**
+   * Returns a read-only (constant) iterator that points to the first
+   * element in the %segmented_vector.
+   */
+  const_iterator
+  begin() const
+  { return const_iterator(M_map, 0); }
+
+  /**
+   * Returns a read/write iterator that points one past the last element
+   * in the %segmented_vector.
+   */
+  iterator
+  end()
+  { return iterator(M_map, M_size); }
+
+  /**
+   * Returns a read-only (constant) iterator that points one past the last
+   * element in the %segmented_vector.
+   */
+  const_iterator
+  end() const
+  { return const_iterator(M_map, M_size); }
+
+  /**
+   * Returns a read/write reverse iterator that points to the last element
+   * in the %segmented_vector.
+   */
+  reverse_iterator
+  rbegin()
+  { return reverse_iterator(end()); }
+
+  /**
+   * Returns a read-only (constant) reverse iterator that points to the
+   * last element in the %segmented_vector.
+   */
+  const_reverse_iterator
+  rbegin() const
+  { return const_reverse_iterator(end()); }
+
+  /**
+   * Returns a read/write reverse iterator that points to one before the
+   * first element in the %segmented_vector.
+   */
+  reverse_iterator
+  rend()
+  { return reverse_iterator(begin()); }
+
+  /**
+   * Returns a read-only (constant) reverse iterator that points to one
+   * before the first element in the %segmented_vector.
+   */
+  const_reverse_iterator
+  rend() const
+  { return const_reverse_iterator(begin()); }
+
+  // capacity
+  /**  Returns the number of elements in the %segmented_vector.  */
+  size_type
+  size() const
+  { return M_size; }
+
+  /**  Returns the size() of the largest possible %segmented_vector.  */
+  size_type
+  max_size() const
+  { return M_alloc.max_size(); }
+
+  /**
+   * Returns the number of elements that fit in the segments already
+   * allocated, cached ones included.
+   */
+  size_type
+  capacity() const
+  { return M_segments << Shape::S_shift; }
+
+  /**
+   * Returns true if the %segmented_vector is empty.
+   */
+  bool
+  empty() const
+  { return M_size == 0; }
+
+  /**
+   * @brief Resizes the %segmented_vector to the specified number of
+   * elements.
+   * @param new_size Number of elements the %segmented_vector should
+   * contain.
+   * @param x Data with which new elements should be populated.
+   *
+   * Shrinking keeps the emptied segments for reuse.
+   */
+  void
+  resize(size_type new_size, value_type x = value_type())
+  {
+    while (M_size > new_size)
+      pop_back();
+    if (new_size > M_size)
+      M_fill_append(new_size - M_size, x);
+  }
+
+  /**
+   * @brief Attempt to preallocate enough segments for the specified
+   * number of elements.
+   * @param n Number of elements required.
+   * @throw std::length_error If @a n exceeds @c max_size().
+   */
+  void
+  reserve(size_type n)
+  {
+    if (n > max_size())
+      throw std::length_error("segmented_vector::reserve");
+    const size_type segments = (n + Shape::S_mask) >> Shape::S_shift;
+    if (segments > M_map_size)
+      M_reallocate_map(segments);
+    while (M_segments < segments)
+      M_add_segment();
+  }
+
+  /**
+   * Frees the cached segments beyond those holding elements.  The
+   * directory keeps its size.
+   */
+  void
+  shrink_to_fit()
+  {
+    const size_type used = (M_size + Shape::S_mask) >> Shape::S_shift;
+    while (M_segments > used)
+      M_alloc.deallocate(M_map[--M_segments], Shape::S_size);
+  }
+
+  // element access
+  /**
+   * @brief Subscript access to the data contained in the
+   * %segmented_vector.
+   * @param n The index of the element for which data should be accessed.
+   * @return Read/write reference to data.
+   *
+   * This operator allows for easy, array-style, data access.
+   * Note that data access with this operator is unchecked and
+   * out_of_range lookups are not defined. (For checked lookups
+   * see at().)
+   */
+  reference
+  operator[](size_type n)
+  { return M_map[n >> Shape::S_shift][n & Shape::S_mask]; }
+
+  /**
+   * @brief Subscript access to the data contained in the
+   * %segmented_vector.
+   * @param n The index of the element for which data should be accessed.
+   * @return Read-only (constant) reference to data.
+   */
+  const_reference
+  operator[](size_type n) const
+  { return M_map[n >> Shape::S_shift][n & Shape::S_mask]; }
+
+protected:
+  /// @if maint Safety check used only from at(). @endif
+  void
+  M_range_check(size_type n) const
+  {
+    if (n >= this->size())
+      throw std::out_of_range("segmented_vector::M_range_check");
+  }
+
+public:
+  /**
+   * @brief Provides access to the data contained in the
+   * %segmented_vector.
+   * @param n The index of the element for which data should be accessed.
+   * @return Read/write reference to data.
+   * @throw std::out_of_range If @a n is an invalid index.
+   */
+  reference
+  at(size_type n)
+  {
+    M_range_check(n);
+    return (*this)[n];
+  }
+
+  /**
+   * @brief Provides access to the data contained in the
+   * %segmented_vector.
+   * @param n The index of the element for which data should be accessed.
+   * @return Read-only (constant) reference to data.
+   * @throw std::out_of_range If @a n is an invalid index.
+   */
+  const_reference
+  at(size_type n) const
+  {
+    M_range_check(n);
+    return (*this)[n];
+  }
+
+  /**
+   * Returns a read/write reference to the data at the first
+   * element of the %segmented_vector.
+   */
+  reference
+  front()
+  { return M_map[0][0]; }
+
+  /**
+   * Returns a read-only (constant) reference to the data at the first
+   * element of the %segmented_vector.
+   */
+  const_reference
+  front() const
+  { return M_map[0][0]; }
+
+  /**
+   * Returns a read/write reference to the data at the last
+   * element of the %segmented_vector.
+   */
+  reference
+  back()
+  { return (*this)[M_size - 1]; }
+
+  /**
+   * Returns a read-only (constant) reference to the data at the last
+   * element of the %segmented_vector.
+   */
+  const_reference
+  back() const
+  { return (*this)[M_size - 1]; }
+
+  // modifiers
+  /**
+   * @brief Add data to the end of the %segmented_vector.
+   * @param x Data to be added.
+   *
+   * Amortised O(1); no existing element is moved.  A new segment is
+   * allocated only when no cached one is left.
+   */
+  void
+  push_back(const value_type& x)
+  {
+    if (M_size == capacity())
+      M_add_segment();
+    M_alloc.construct(&(*this)[M_size], x);
+    ++M_size;
+  }
+
+  /**
+   * @brief Removes last element.
+   *
+   * The segment it leaves empty, if any, is cached for reuse.
+   */
+  void
+  pop_back()
+  {
+    --M_size;
+    M_alloc.destroy(&(*this)[M_size]);
+  }
+
+  /**
+   * @brief Swaps data with another %segmented_vector.
+   * @param x A %segmented_vector of the same element and allocator
+   * types.
+   *
+   * This exchanges the elements between two segmented vectors in
+   * constant time.
+   */
+  void
+  swap(segmented_vector& x)
+  {
+    std::swap(M_map, x.M_map);
+    std::swap(M_map_size, x.M_map_size);
+    std::swap(M_segments, x.M_segments);
+    std::swap(M_size, x.M_size);
+  }
+
+  /**
+   * Erases all the elements.  The segments are kept for reuse.
+   */
+  void
+  clear()
+  {
+    while (M_size != 0)
+      pop_back();
+  }
+
+private:
+  template <typename Integer>
+  void
+  M_initialize_dispatch(Integer n, Integer value, __true_type)
+  { M_fill_initialize(static_cast<size_type>(n), value); }
+
+  template <typename InputIterator>
+  void
+  M_initialize_dispatch(InputIterator first, InputIterator last,
+                        __false_type)
+  { M_range_initialize(first, last); }
+
+  void
+  M_fill_initialize(size_type n, const value_type& value)
+  {
+    try
+    {
+      M_fill_append(n, value);
+    }
+    catch(...)
+    {
+      M_deallocate_all();
+      throw;
+    }
+  }
+
+  template <typename InputIterator>
+  void
+  M_range_initialize(InputIterator first, InputIterator last)
+  {
+    try
+    {
+      for (; first != last; ++first)
+        push_back(*first);
+    }
+    catch(...)
+    {
+      M_deallocate_all();
+      throw;
+    }
+  }
+
+  void
+  M_fill_append(size_type n, const value_type& value)
+  {
+    reserve(M_size + n);
+    for (; n != 0; --n)
+      push_back(value);
+  }
+
+  // Appends one segment to the directory, doubling the directory when
+  // it is full.  Elements never move.
+  void
+  M_add_segment()
+  {
+    if (M_segments == M_map_size)
+      M_reallocate_map(M_map_size == 0 ? 8 : M_map_size * 2);
+    M_map[M_segments] = M_alloc.allocate(Shape::S_size);
+    ++M_segments;
+  }
+
+  void
+  M_reallocate_map(size_type slots)
+  {
+    Map_alloc_type map_alloc(M_alloc);
+    Tp** map = map_alloc.allocate(slots);
+    std::copy(M_map, M_map + M_segments, map);
+    if (M_map != 0)
+      map_alloc.deallocate(M_map, M_map_size);
+    M_map = map;
+    M_map_size = slots;
+  }
+
+  void
+  M_deallocate_all()
+  {
+    clear();
+    while (M_segments != 0)
+      M_alloc.deallocate(M_map[--M_segments], Shape::S_size);
+    if (M_map != 0)
+      Map_alloc_type(M_alloc).deallocate(M_map, M_map_size);
+    M_map = 0;
+    M_map_size = 0;
+  }
+};
+
+/**
+ * @brief Segmented_vector equality comparison.
+ * @param x A %segmented_vector.
+ * @param y A %segmented_vector of the same type as @a x.
+ * @return True iff the size and elements of the vectors are equal.
+ */
+template <typename Tp, typename Alloc>
+inline bool
+operator==(const segmented_vector<Tp, Alloc>& x,
+           const segmented_vector<Tp, Alloc>& y)
+{ return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()); }
+
+/**
+ * @brief Segmented_vector ordering relation.
+ * @param x A %segmented_vector.
+ * @param y A %segmented_vector of the same type as @a x.
+ * @return True iff @a x is lexicographically less than @a y.
+ */
+template <typename Tp, typename Alloc>
+inline bool
+operator<(const segmented_vector<Tp, Alloc>& x,
+          const segmented_vector<Tp, Alloc>& y)
+{
+  return ft::lexicographical_compare(x.begin(), x.end(),
+                                     y.begin(), y.end());
+}
+
+/// Based on operator==
+template <typename Tp, typename Alloc>
+inline bool
+operator!=(const segmented_vector<Tp, Alloc>& x,
+           const segmented_vector<Tp, Alloc>& y)
+{ return !(x == y); }
+
+/// Based on operator<
+template <typename Tp, typename Alloc>
+inline bool
+operator>(const segmented_vector<Tp, Alloc>& x,
+          const segmented_vector<Tp, Alloc>& y)
+{ return y < x; }
+
+/// Based on operator<
+template <typename Tp, typename Alloc>
+inline bool
+operator<=(const segmented_vector<Tp, Alloc>& x,
+           const segmented_vector<Tp, Alloc>& y)
+{ return !(y < x); }
+
+/// Based on operator<
+template <typename Tp, typename Alloc>
+inline bool
+operator>=(const segmented_vector<Tp, Alloc>& x,
+           const segmented_vector<Tp, Alloc>& y)
+{ return !(x < y); }
+
+/// See ft::segmented_vector::swap().
+template <typename Tp, typename Alloc>
+inline void
+swap(segmented_vector<Tp, Alloc>& x, segmented_vector<Tp, Alloc>& y)
+{ x.swap(y); }
+
+} // ft
+
+#endif // STL_SEGMENTED_VECTOR_H_
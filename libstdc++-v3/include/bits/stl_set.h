@@ -32,6 +32,7 @@ namespace ft {
  *  @param  Key  Type of key objects.
  *  @param  Compare  Comparison function object type, defaults to less<Key>.
  *  @param  Alloc  Allocator type, defaults to allocator<Key>.
+ *  @param  NodeUpdate  Per-node augmentation policy, defaults to none.
  *
  *  @if maint
  *  The private tree data is declared exactly the same way for set and
@@ -40,7 +41,8 @@ namespace ft {
  *  @endif
 */
 template <class Key, class Compare = std::less<Key>, 
-          class Alloc = std::allocator<Key> >
+          class Alloc = std::allocator<Key>,
+          class NodeUpdate = Rb_tree_null_node_update>
 class set
 {
   typedef typename Alloc::value_type            Alloc_value_type;
@@ -60,7 +62,7 @@ private:
   typedef typename Alloc::template rebind<Key>::other   Key_alloc_type;
 
   typedef Rb_tree<key_type, value_type, Identity<value_type>,
-          key_compare, Key_alloc_type>                  Rep_type;
+          key_compare, Key_alloc_type, NodeUpdate>      Rep_type;
   Rep_type M_t; // red-black tree representing set
 
 public:
@@ -77,6 +79,8 @@ public:
   typedef typename Rep_type::const_iterator             const_iterator;
   typedef typename Rep_type::const_reverse_iterator     reverse_iterator;
   typedef typename Rep_type::const_reverse_iterator     const_reverse_iterator;
+  typedef Rb_tree_node_handle<Rep_type>                node_type;
+  typedef Rb_tree_insert_return<iterator, node_type>    insert_return_type;
   typedef typename Rep_type::size_type                  size_type;
   typedef typename Rep_type::difference_type            difference_type;
   //@}
@@ -127,6 +131,27 @@ public:
   : M_t(comp, a)
   { M_t.M_insert_unique(first, last); }
 
+  /**
+   *  @brief  Builds a %set from a range on several threads.
+   *  @param  policy  ft::par, or ft::par(n) for n threads.
+   *  @param  first  An input iterator.
+   *  @param  last  An input iterator.
+   *  @param  comp  A comparison functor.
+   *  @param  a  An allocator object; it must allow concurrent use.
+   *
+   *  Same contents as set(first, last): of equivalent elements the first
+   *  wins.  The range is copied and sorted on several threads, and the
+   *  tree is then built straight from the sorted elements, the subtrees
+   *  near the root in parallel.  O(N log N / threads + N).  Programs
+   *  that cannot start threads use a single thread.
+   */
+  template <typename InputIterator>
+  set(const parallel_policy& policy, InputIterator first, InputIterator last,
+      const Compare& comp = Compare(),
+      const allocator_type& a = allocator_type())
+  : M_t(comp, a)
+  { M_t.M_build_unique(first, last, policy); }
+
   /**
    *  @brief  Set copy constructor.
    *  @param  x  A %set of identical element and allocator types.
@@ -134,9 +159,22 @@ public:
    *  The newly-created %set uses a copy of the allocation object used
    *  by @a x.
    */
-  set(const set<Key, Compare, Alloc>& x)
+  set(const set<Key, Compare, Alloc, NodeUpdate>& x)
   : M_t(x.M_t) { }
 
+  /**
+   *  @brief  Set copy constructor working on several threads.
+   *  @param  policy  ft::par, or ft::par(n) for n threads.
+   *  @param  x  A %set of identical element and allocator types.
+   *
+   *  As set(x), but the top levels of the tree are split among threads,
+   *  each copying a whole subtree.  The allocator must allow concurrent
+   *  use.  Programs that cannot start threads use a single thread.
+   */
+  set(const parallel_policy& policy,
+      const set<Key, Compare, Alloc, NodeUpdate>& x)
+  : M_t(x.M_t, policy) { }
+
   /**
    *  @brief  Set assignment operator.
    *  @param  x  A %set of identical element and allocator types.
@@ -144,13 +182,29 @@ public:
    *  All the elements of @a x are copied, but unlike the copy constructor,
    *  the allocator object is not copied.
    */
-  set<Key, Compare, Alloc>&
-  operator=(const set<Key, Compare, Alloc>& x)
+  set<Key, Compare, Alloc, NodeUpdate>&
+  operator=(const set<Key, Compare, Alloc, NodeUpdate>& x)
   {
     M_t = x.M_t;
     return *this;
   }
 
+  /**
+   *  @brief  Assignment working on several threads.
+   *  @param  policy  ft::par, or ft::par(n) for n threads.
+   *  @param  x  A %set of identical element and allocator types.
+   *
+   *  As operator=, with the old elements freed as by clear(policy) and
+   *  the new ones copied as by the parallel copy constructor.
+   */
+  set<Key, Compare, Alloc, NodeUpdate>&
+  assign(const parallel_policy& policy,
+         const set<Key, Compare, Alloc, NodeUpdate>& x)
+  {
+    M_t.M_assign(x.M_t, policy);
+    return *this;
+  }
+
   // accessors:
 
   ///  Returns the comparison object with which the %set was constructed.
@@ -226,7 +280,7 @@ public:
    *  std::swap(s1,s2) will feed to this function.
    */
   void
-  swap(set<Key, Compare, Alloc>& x)
+  swap(set<Key, Compare, Alloc, NodeUpdate>& x)
   { M_t.swap(x.M_t); }
 
   // insert/erase
@@ -286,6 +340,100 @@ public:
   insert(InputIterator first, InputIterator last)
   { M_t.M_insert_unique(first, last); }
 
+  /**
+   *  @brief Inserts a batch of elements in one merged pass.
+   *  @param  first  Iterator pointing to the start of the batch.
+   *  @param  last  Iterator pointing to the end of the batch.
+   *
+   *  Same result as insert(first, last), but the batch is sorted first
+   *  and then merged into the tree, each element being placed by a
+   *  finger search from its predecessor.  Clustered batches of m
+   *  elements cost roughly O(m log(n/m)) instead of O(m log n).  A
+   *  forward range of value_type is sorted through iterators into it;
+   *  other batches are copied once into a buffer.
+   */
+  template <class InputIterator>
+  void
+  insert_batch(InputIterator first, InputIterator last)
+  { M_t.M_insert_unique_batch(first, last); }
+
+  /**
+   *  @brief  Inserts the node owned by a node handle.
+   *  @param  nh  Handle obtained from extract() on a %set of the same type.
+   *  @return  An insert_return_type: where the element is, whether it was
+   *           inserted, and, if it was not, the handle still owning it.
+   *
+   *  The node is linked as is: nothing is copied or allocated.  An empty
+   *  handle inserts nothing and yields end().
+   */
+  insert_return_type
+  insert(node_type nh)
+  {
+    insert_return_type r;
+    r.position = end();
+    r.inserted = false;
+    if (!nh.empty())
+    {
+      ft::pair<typename Rep_type::iterator, bool> p
+        = M_t.M_insert_node_unique(nh.M_get());
+      r.position = p.first;
+      r.inserted = p.second;
+      if (p.second)
+        nh.M_release();
+      else
+        r.node.swap(nh);
+    }
+    return r;
+  }
+
+  /**
+   *  @brief  Inserts the node owned by a node handle, using a hint.
+   *  @param  position  Iterator near where the element belongs.
+   *  @param  nh  Handle obtained from extract(), taken by value.
+   *  @return  Iterator to the inserted element, or to the equal element
+   *           that prevented insertion.
+   *
+   *  The search starts from @a position and costs O(log d) where d is
+   *  its distance to the insertion point.  @a nh being taken by value, a
+   *  node that cannot be inserted is freed with it; insert(node_type)
+   *  hands such a node back instead.
+   */
+  iterator
+  insert(iterator position, node_type nh)
+  {
+    if (nh.empty())
+      return end();
+    ft::pair<typename Rep_type::iterator, bool> p
+      = M_t.M_insert_node_unique(position, nh.M_get());
+    if (p.second)
+      nh.M_release();
+    return p.first;
+  }
+
+  /**
+   *  @brief  Unlinks an element and hands over its node.
+   *  @param  position  Iterator to the element; must be dereferenceable.
+   *  @return  A node handle owning the element.
+   *
+   *  The node is neither copied nor freed, so the element can be moved
+   *  to another %set, or given a new key, and reinserted with insert().
+   *  Only iterators to the extracted element are invalidated.
+   */
+  node_type
+  extract(iterator position)
+  { return node_type(M_t.M_extract(position), M_t.M_get_Node_allocator()); }
+
+  /**
+   *  @brief  Unlinks the element with key @a x, if any.
+   *  @return  A node handle owning it, or an empty handle.
+   */
+  node_type
+  extract(const key_type& x)
+  {
+    iterator i = find(x);
+    return i == end() ? node_type() : extract(i);
+  }
+
   /**
    *  @brief Erases an element from a %set.
    *  @param  position  An iterator pointing to the element to be erased.
@@ -339,6 +487,106 @@ public:
   clear()
   { M_t.clear(); }
 
+  /**
+   *  @brief  Erases all elements on several threads.
+   *  @param  policy  ft::par, or ft::par(n) for n threads.
+   *
+   *  The top levels of the tree are split among threads, each freeing a
+   *  whole subtree.  The allocator must allow concurrent use, and the
+   *  destructors of the elements must not throw.
+   */
+  void
+  clear(const parallel_policy& policy)
+  { M_t.clear(policy); }
+
+  /**
+   *  @brief  Empties the %set at once, leaving the elements to be
+   *  destroyed by a background thread.
+   *
+   *  Constant time for the caller.  The nodes are handed, with a copy of
+   *  the allocator, to a background job on thread_pool::default_pool(),
+   *  so the allocator copy must stay usable on its own and the
+   *  destructors of the elements must be safe to run on another thread.
+   *  Call it before dropping a large %set to keep the destructor cheap.
+   *  Programs that cannot start threads destroy the elements here.  Like
+   *  the ft::par overloads, this needs parallel.hpp.
+   */
+  void
+  clear_in_background()
+  { M_t.M_clear_in_background(); }
+
+  /**
+   *  @brief  Replaces the %set by its union with @a x.
+   *  @param  x  A %set of the same type, left empty.
+   *
+   *  The nodes of both sets are relinked, not copied: for sizes m <= n
+   *  the work is O(m log(n/m + 1)), so merging a small %set into a large
+   *  one costs little more than m lookups.  The allocators of both sets
+   *  must compare equal.
+   *
+   *  Strong guarantee: if the comparator throws, both sets are left
+   *  holding the elements they held.  No node is destroyed before the
+   *  last comparison.
+   */
+  void
+  set_union(set& x)
+  { M_t.M_set_union(x.M_t); }
+
+  /**
+   *  @brief  As above, splitting large inputs across threads.
+   *  @param  policy  ft::par, or ft::par(n) for n threads.
+   *  @param  x  A %set of the same type, left empty.
+   *
+   *  The top levels of the recursion run as tasks on
+   *  thread_pool::default_pool(), so the allocator must allow nodes to
+   *  be freed from several threads at once.  The strong guarantee still
+   *  holds, but an exception thrown on another thread cannot cross to
+   *  the caller, which gets std::bad_alloc or ft::parallel_error in its
+   *  place.
+   */
+  void
+  set_union(const parallel_policy& policy, set& x)
+  { M_t.M_set_union(x.M_t, policy); }
+
+  /**
+   *  @brief  Keeps only the elements also present in @a x.
+   *
+   *  @a x is left empty; see set_union() for costs and requirements.
+   */
+  void
+  set_intersection(set& x)
+  { M_t.M_set_intersection(x.M_t); }
+
+  void
+  set_intersection(const parallel_policy& policy, set& x)
+  { M_t.M_set_intersection(x.M_t, policy); }
+
+  /**
+   *  @brief  Removes the elements present in @a x.
+   *
+   *  @a x is left empty; see set_union() for costs and requirements.
+   */
+  void
+  set_difference(set& x)
+  { M_t.M_set_difference(x.M_t); }
+
+  void
+  set_difference(const parallel_policy& policy, set& x)
+  { M_t.M_set_difference(x.M_t, policy); }
+
+  /**
+   *  @brief  Keeps the elements present in exactly one of the two sets.
+   *
+   *  @a x is left empty; see set_union() for costs and requirements.
+   */
+  void
+  set_symmetric_difference(set& x)
+  { M_t.M_set_symmetric_difference(x.M_t); }
+
+  void
+  set_symmetric_difference(const parallel_policy& policy, set& x)
+  { M_t.M_set_symmetric_difference(x.M_t, policy); }
+
   // set operations:
 
   /**
@@ -353,6 +601,13 @@ public:
   count(const key_type& x) const
   { return M_t.find(x) == M_t.end() ? 0 : 1; }
 
+  /// Heterogeneous count(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         size_type>::type
+  count(const Kt& x) const
+  { return M_t.M_count_tr(x); }
+
   // _GLIBCXX_RESOLVE_LIB_DEFECTS
   // 214.  set::find() missing const overload
   //@{
@@ -374,6 +629,19 @@ public:
   const_iterator
   find(const key_type& x) const
   { return M_t.find(x); }
+
+  /// Heterogeneous find(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         iterator>::type
+  find(const Kt& x)
+  { return M_t.M_find_tr(x); }
+
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         const_iterator>::type
+  find(const Kt& x) const
+  { return M_t.M_find_tr(x); }
   //@}
 
   //@{
@@ -395,6 +663,19 @@ public:
   const_iterator
   lower_bound(const key_type& x) const
   { return M_t.lower_bound(x); }
+
+  /// Heterogeneous lower_bound(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         iterator>::type
+  lower_bound(const Kt& x)
+  { return M_t.M_lower_bound_tr(x); }
+
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         const_iterator>::type
+  lower_bound(const Kt& x) const
+  { return M_t.M_lower_bound_tr(x); }
   //@}
 
   //@{
@@ -411,6 +692,19 @@ public:
   const_iterator
   upper_bound(const key_type& x) const
   { return M_t.upper_bound(x); }
+
+  /// Heterogeneous upper_bound(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         iterator>::type
+  upper_bound(const Kt& x)
+  { return M_t.M_upper_bound_tr(x); }
+
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         const_iterator>::type
+  upper_bound(const Kt& x) const
+  { return M_t.M_upper_bound_tr(x); }
   //@}
 
   //@{
@@ -436,15 +730,212 @@ public:
   ft::pair<const_iterator, const_iterator>
   equal_range(const key_type& x) const
   { return M_t.equal_range(x); }
+
+  /// Heterogeneous equal_range(), available when @c Compare is transparent.
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         ft::pair<iterator, iterator> >::type
+  equal_range(const Kt& x)
+  { return M_t.M_equal_range_tr(x); }
+
+  template <typename Kt>
+  typename ft::enable_if<has_is_transparent<Compare, Kt>::value,
+                         ft::pair<const_iterator, const_iterator> >::type
+  equal_range(const Kt& x) const
+  { return M_t.M_equal_range_tr(x); }
   //@}
 
-  template <class K1, class C1, class A1>
+  /**
+   *  @brief  Looks up a sequence of keys in one pass.
+   *  @param  keys_first  Input iterator to the first key.
+   *  @param  keys_last  Input iterator past the last key.
+   *  @param  out  Output iterator receiving one iterator per key.
+   *  @return  @a out past the last iterator written.
+   *
+   *  Writes, in input order, what find() would return for each key.
+   *  The searches are run several at a time, level by level, so that
+   *  their cache misses overlap; for large sets this is substantially
+   *  faster than calling find() in a loop.
+   */
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator
+  find_many(InputIterator keys_first, InputIterator keys_last,
+            OutputIterator out) const
+  {
+    return M_t.template M_lower_bound_many<iterator>(keys_first, keys_last,
+                                                     out, true);
+  }
+
+  /**
+   *  @brief  Finds the lower bounds of a sequence of keys in one pass.
+   *
+   *  As find_many(), but writes what lower_bound() would return.
+   */
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator
+  lower_bound_many(InputIterator keys_first, InputIterator keys_last,
+                   OutputIterator out) const
+  {
+    return M_t.template M_lower_bound_many<iterator>(keys_first, keys_last,
+                                                     out, false);
+  }
+
+  /**
+   *  @brief  Looks up an ascending sequence of keys in one walk.
+   *  @param  first  Input iterator to the first key.
+   *  @param  last  Input iterator past the last key.
+   *  @param  out  Output iterator receiving one iterator per key.
+   *  @return  @a out past the last iterator written.
+   *
+   *  Writes, in input order, what find() would return for each key.
+   *  Each search starts where the previous one ended and moves up only
+   *  as far as needed, so m sorted keys cost O(m log(n/m)) rather than
+   *  O(m log n).  Unsorted keys are still handled correctly.
+   */
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator
+  find_sorted(InputIterator first, InputIterator last,
+              OutputIterator out) const
+  { return M_t.template M_find_sorted<iterator>(first, last, out); }
+
+  /**
+   *  @brief  Counts how many of an ascending sequence of keys are present.
+   *
+   *  Same walk as find_sorted(); each key of the input is counted.
+   */
+  template <typename InputIterator>
+  size_type
+  count_sorted(InputIterator first, InputIterator last) const
+  { return M_t.M_count_sorted(first, last); }
+
+  /**
+   *  @brief  Accesses the element at position @a n in key order.
+   *  @param  n  Zero-based position; must be less than size().
+   *  @return  Iterator to the @a n th smallest element.
+   *
+   *  The order-statistic members nth(), rank() and distance() run in
+   *  logarithmic time and are only available when @a NodeUpdate is
+   *  Rb_tree_order_statistics_node_update.
+   */
+  iterator
+  nth(size_type n) const
+  { return M_t.M_select(n); }
+
+  /**
+   *  @brief  Number of elements whose key is less than @a x.
+   *  @param  x  Key to be ranked; it need not be present.
+   */
+  size_type
+  rank(const key_type& x) const
+  { return M_t.M_rank(x); }
+
+  /**
+   *  @brief  Number of increments needed to go from @a first to @a last.
+   *
+   *  Equivalent to std::distance(first, last) in logarithmic time.
+   */
+  difference_type
+  distance(const_iterator first, const_iterator last) const
+  { return difference_type(M_t.M_index(last)) - M_t.M_index(first); }
+
+  /**
+   *  @brief  Folds the elements with keys in [@a first_key, @a last_key).
+   *  @return  The monoid combination, in key order, of those elements;
+   *           the identity when the range is empty.
+   *
+   *  Runs in logarithmic time.  Only available when @a NodeUpdate is
+   *  Rb_tree_aggregate_node_update<Monoid>.
+   */
+  typename Rep_type::aggregate_type
+  accumulate(const key_type& first_key, const key_type& last_key) const
+  { return M_t.M_accumulate(first_key, last_key); }
+
+  /**
+   *  @brief  Lookup cursor that remembers where the last search ended.
+   *
+   *  Each lookup made through a %cursor starts from the position found
+   *  by the previous one instead of from the root: it climbs only until
+   *  an ancestor brackets the key and then descends.  A lookup for a key
+   *  d positions away from the previous result costs O(log d), which
+   *  makes scans over nearby keys (sliding windows, merges) cheap.
+   *
+   *  A %cursor is invalidated, like an iterator, when the element it
+   *  rests on is erased; seek() repositions it.
+   */
+  class cursor
+  {
+  public:
+    cursor()
+    : M_cont(0), M_pos() { }
+
+    explicit
+    cursor(const set& c)
+    : M_cont(&c), M_pos(c.end()) { }
+
+    /// The position found by the last lookup (end() initially).
+    iterator
+    position() const
+    { return M_pos; }
+
+    /// Moves the cursor to @a it, which must belong to the same %set.
+    void
+    seek(iterator it)
+    { M_pos = it; }
+
+    /// Same as set::lower_bound(), searching from the last position.
+    iterator
+    lower_bound(const key_type& k)
+    { return M_pos = M_cont->M_t.lower_bound(M_pos, k); }
+
+    /// Same as set::upper_bound(), searching from the last position.
+    iterator
+    upper_bound(const key_type& k)
+    { return M_pos = M_cont->M_t.upper_bound(M_pos, k); }
+
+    /// Same as set::find(), searching from the last position.  On a miss
+    /// the cursor still moves to lower_bound(k).
+    iterator
+    find(const key_type& k)
+    {
+      lower_bound(k);
+      if (M_pos == M_cont->end() || M_cont->key_comp()(k, *M_pos))
+        return M_cont->end();
+      return M_pos;
+    }
+
+  private:
+    const set*  M_cont;
+    iterator    M_pos;
+  };
+
+  friend class cursor;
+
+  template <class K1, class C1, class A1, class U1>
   friend bool
-  operator== (const set<K1, C1, A1>&, const set<K1, C1, A1>&);
+  operator== (const set<K1, C1, A1, U1>&, const set<K1, C1, A1, U1>&);
 
-  template <class K1, class C1, class A1>
+  template <class K1, class C1, class A1, class U1>
   friend bool
-  operator< (const set<K1, C1, A1>&, const set<K1, C1, A1>&);
+  operator< (const set<K1, C1, A1, U1>&, const set<K1, C1, A1, U1>&);
+
+  template <class K1, class C1, class A1, class U1, class F1>
+  friend void
+  parallel_for_each(const parallel_policy&, const set<K1, C1, A1, U1>&, F1);
+
+  template <class K1, class C1, class A1, class U1, class R1, class F1,
+            class G1>
+  friend R1
+  parallel_reduce(const parallel_policy&, const set<K1, C1, A1, U1>&,
+                  R1, F1, G1);
+
+  template <class K1, class C1, class A1, class U1, class F1>
+  friend void
+  parallel_for_each(const set<K1, C1, A1, U1>&, F1);
+
+  template <class K1, class C1, class A1, class U1, class R1, class F1,
+            class G1>
+  friend R1
+  parallel_reduce(const set<K1, C1, A1, U1>&, R1, F1, G1);
 
 };
 
@@ -458,10 +949,10 @@ public:
  *  Sets are considered equivalent if their sizes are equal, and if
  *  corresponding elements compare equal.
 */
-template <class Key, class Compare, class Alloc>
+template <class Key, class Compare, class Alloc, class NodeUpdate>
 bool
-operator==(const set<Key, Compare, Alloc>& x,
-          const set<Key, Compare, Alloc>& y)
+operator==(const set<Key, Compare, Alloc, NodeUpdate>& x,
+          const set<Key, Compare, Alloc, NodeUpdate>& y)
 { return x.M_t == y.M_t; }
 
 /**
@@ -475,46 +966,95 @@ operator==(const set<Key, Compare, Alloc>& x,
  *
  *  See std::lexicographical_compare() for how the determination is made.
 */
-template <class Key, class Compare, class Alloc>
+template <class Key, class Compare, class Alloc, class NodeUpdate>
 bool
-operator<(const set<Key, Compare, Alloc>& x,
-          const set<Key, Compare, Alloc>& y)
+operator<(const set<Key, Compare, Alloc, NodeUpdate>& x,
+          const set<Key, Compare, Alloc, NodeUpdate>& y)
 { return x.M_t < y.M_t; }
 
 ///  Returns !(x == y).
-template <class Key, class Compare, class Alloc>
+template <class Key, class Compare, class Alloc, class NodeUpdate>
 bool
-operator!=(const set<Key, Compare, Alloc>& x,
-          const set<Key, Compare, Alloc>& y)
+operator!=(const set<Key, Compare, Alloc, NodeUpdate>& x,
+          const set<Key, Compare, Alloc, NodeUpdate>& y)
 { return !(x == y); }
 
 ///  Returns y < x.
-template <class Key, class Compare, class Alloc>
+template <class Key, class Compare, class Alloc, class NodeUpdate>
 bool
-operator>(const set<Key, Compare, Alloc>& x,
-          const set<Key, Compare, Alloc>& y)
+operator>(const set<Key, Compare, Alloc, NodeUpdate>& x,
+          const set<Key, Compare, Alloc, NodeUpdate>& y)
 { return y < x; }
 
 ///  Returns !(y < x)
-template <class Key, class Compare, class Alloc>
+template <class Key, class Compare, class Alloc, class NodeUpdate>
 bool
-operator<=(const set<Key, Compare, Alloc>& x,
-          const set<Key, Compare, Alloc>& y)
+operator<=(const set<Key, Compare, Alloc, NodeUpdate>& x,
+          const set<Key, Compare, Alloc, NodeUpdate>& y)
 { return !(y < x); }
 
 ///  Returns !(x < y)
-template<class Key, class Compare, class Alloc>
+template<class Key, class Compare, class Alloc, class NodeUpdate>
 bool
-operator>=(const set<Key, Compare, Alloc>& x,
-          const set<Key, Compare, Alloc>& y)
+operator>=(const set<Key, Compare, Alloc, NodeUpdate>& x,
+          const set<Key, Compare, Alloc, NodeUpdate>& y)
 { return !(x < y); }
 
 /// See std::set::swap().
-template <class Key, class Compare, class Alloc>
+template <class Key, class Compare, class Alloc, class NodeUpdate>
 void
-swap(set<Key, Compare, Alloc>& x, set<Key, Compare, Alloc>& y)
+swap(set<Key, Compare, Alloc, NodeUpdate>& x, set<Key, Compare, Alloc, NodeUpdate>& y)
 { x.swap(y); }
 
+/**
+ *  @brief  Applies a function to every element of a %set, on several
+ *  threads.
+ *  @param  policy  ft::par, or ft::par(n) for n threads.
+ *  @param  x  A %set.
+ *  @param  f  Called as f(const value_type&) from several threads.
+ *
+ *  See the %map overload for how the work is split and how exceptions
+ *  are handled.
+ */
+template <class Key, class Compare, class Alloc, class NodeUpdate,
+          class Function>
+void
+parallel_for_each(const parallel_policy& policy,
+                  const set<Key, Compare, Alloc, NodeUpdate>& x, Function f)
+{ x.M_t.M_parallel_for_each(f, policy); }
+
+/// As above, with one thread per online processor.
+template <class Key, class Compare, class Alloc, class NodeUpdate,
+          class Function>
+void
+parallel_for_each(const set<Key, Compare, Alloc, NodeUpdate>& x, Function f)
+{ x.M_t.M_parallel_for_each(f); }
+
+/**
+ *  @brief  Folds all elements of a %set on several threads.
+ *  @param  policy  ft::par, or ft::par(n) for n threads.
+ *  @param  x  A %set.
+ *  @param  identity  Identity element of @a combine.
+ *  @param  fold  Called as fold(Result, const value_type&).
+ *  @param  combine  Called as combine(Result, Result); associative.
+ *  @return  The fold of all elements in key order.
+ */
+template <class Key, class Compare, class Alloc, class NodeUpdate,
+          class Result, class Fold, class Combine>
+Result
+parallel_reduce(const parallel_policy& policy,
+                const set<Key, Compare, Alloc, NodeUpdate>& x,
+                Result identity, Fold fold, Combine combine)
+{ return x.M_t.M_parallel_reduce(identity, fold, combine, policy); }
+
+/// As above, with one thread per online processor.
+template <class Key, class Compare, class Alloc, class NodeUpdate,
+          class Result, class Fold, class Combine>
+Result
+parallel_reduce(const set<Key, Compare, Alloc, NodeUpdate>& x,
+                Result identity, Fold fold, Combine combine)
+{ return x.M_t.M_parallel_reduce(identity, fold, combine); }
+
 } // ft
 
 #endif // STL_SET_H_
\ No newline at end of file
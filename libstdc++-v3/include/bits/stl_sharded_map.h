@@ -0,0 +1,564 @@
+// Sharded map implementation -*- C++ -*-
+
+/** @file stl_sharded_map.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_SHARDED_MAP_H_
+#define STL_SHARDED_MAP_H_
+
+#include <memory>
+#include <cstddef>
+#include <pthread.h>
+#include <algorithm>
+
+#include "stl_pair.h"
+#include "stl_function.h"
+#include "stl_map.h"
+#include "stl_vector.h"
+#include "stl_parallel.h"
+
+
+namespace ft {
+
+/**
+ *  @brief  The default partition of a %sharded_map: a mixed hash of the
+ *  key converted to size_t.  Supply another functor for keys with no
+ *  such conversion, or to partition by key range.
+ */
+template <typename Key>
+struct Shard_hash
+{
+  std::size_t
+  operator()(const Key& k) const
+  {
+    std::size_t h = static_cast<std::size_t>(k);
+    h ^= h >> 16;
+    h *= 0x45d9f3bu;
+    h ^= h >> 16;
+    return h;
+  }
+};
+
+// Walks several sorted ranges of distinct keys as one: a binary min-heap
+// of range indices, ordered by the key at the head of each range.
+template <typename Map_iterator, typename Compare, std::size_t N>
+class Sharded_map_iterator
+{
+public:
+  typedef typename Map_iterator::value_type         value_type;
+  typedef typename Map_iterator::reference          reference;
+  typedef typename Map_iterator::pointer            pointer;
+  typedef std::forward_iterator_tag                 iterator_category;
+  typedef ptrdiff_t                                 difference_type;
+
+  typedef ft::pair<Map_iterator, Map_iterator>      Head;
+
+private:
+  typedef Sharded_map_iterator<Map_iterator, Compare, N> Self;
+
+  Head         M_heads[N];
+  std::size_t  M_heap[N];
+  std::size_t  M_count;
+  Compare      M_comp;
+
+  bool
+  M_less(std::size_t a, std::size_t b) const
+  { return M_comp((*M_heads[a].first).first, (*M_heads[b].first).first); }
+
+  void
+  M_sift_down(std::size_t i)
+  {
+    for (;;)
+    {
+      std::size_t m = i;
+      const std::size_t l = 2 * i + 1;
+      const std::size_t r = l + 1;
+      if (l < M_count && M_less(M_heap[l], M_heap[m]))
+        m = l;
+      if (r < M_count && M_less(M_heap[r], M_heap[m]))
+        m = r;
+      if (m == i)
+        return;
+      std::swap(M_heap[i], M_heap[m]);
+      i = m;
+    }
+  }
+
+public:
+  Sharded_map_iterator()
+  : M_count(0), M_comp() { }
+
+  // The end of the merge.
+  explicit
+  Sharded_map_iterator(const Compare& comp)
+  : M_count(0), M_comp(comp) { }
+
+  // Merges the N ranges [heads[i].first, heads[i].second).
+  Sharded_map_iterator(const Head* heads, const Compare& comp)
+  : M_count(0), M_comp(comp)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      M_heads[i] = heads[i];
+      if (heads[i].first != heads[i].second)
+        M_heap[M_count++] = i;
+    }
+    for (std::size_t i = M_count / 2; i-- > 0; )
+      M_sift_down(i);
+  }
+
+  Sharded_map_iterator(const Sharded_map_iterator& x)
+  : M_count(x.M_count), M_comp(x.M_comp)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      M_heads[i] = x.M_heads[i];
+    for (std::size_t i = 0; i < M_count; ++i)
+      M_heap[i] = x.M_heap[i];
+  }
+
+  Sharded_map_iterator&
+  operator=(const Sharded_map_iterator& x)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      M_heads[i] = x.M_heads[i];
+    M_count = x.M_count;
+    for (std::size_t i = 0; i < M_count; ++i)
+      M_heap[i] = x.M_heap[i];
+    M_comp = x.M_comp;
+    return *this;
+  }
+
+  reference
+  operator*() const
+  { return *M_heads[M_heap[0]].first; }
+
+  pointer
+  operator->() const
+  { return &*M_heads[M_heap[0]].first; }
+
+  /** Which shard the current element is in.  */
+  std::size_t
+  shard() const
+  { return M_heap[0]; }
+
+  // O(log N).
+  Self&
+  operator++()
+  {
+    Head& h = M_heads[M_heap[0]];
+    if (++h.first == h.second)
+      M_heap[0] = M_heap[--M_count];
+    M_sift_down(0);
+    return *this;
+  }
+
+  Self
+  operator++(int)
+  {
+    Self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  bool
+  operator==(const Self& x) const
+  {
+    if (M_count != x.M_count)
+      return false;
+    return M_count == 0
+           || M_heads[M_heap[0]].first == x.M_heads[x.M_heap[0]].first;
+  }
+
+  bool
+  operator!=(const Self& x) const
+  { return !(*this == x); }
+};
+
+/**
+ *  @brief A map that many threads may update at once, made of
+ *  independently locked %maps.
+ *
+ *  @ingroup Containers
+ *  @ingroup Assoc_containers
+ *
+ *  Each key belongs to shard Partition()(key) % Shards, a plain %map
+ *  with its own mutex and its own copy of the allocator, so a pooling
+ *  allocator gives each shard its own pool.  Threads updating different
+ *  shards never touch the same lock or node.  Single-key operations
+ *  lock one shard; size() and clear() lock each in turn.
+ *
+ *  Iteration merges the shards in key order (a k-way merge, O(log
+ *  Shards) per step) and must not overlap updates.
+ *
+ *  @param  Key  Type of key objects.
+ *  @param  Tp  Type of mapped objects.
+ *  @param  Shards  Number of shards.
+ *  @param  Compare  Comparison function object type.
+ *  @param  Partition  Function object mapping a key to a shard index.
+ *  @param  Alloc  Allocator type.
+*/
+template <typename Key, typename Tp, std::size_t Shards = 16,
+          typename Compare = std::less<Key>,
+          typename Partition = Shard_hash<Key>,
+          typename Alloc = std::allocator<ft::pair<const Key, Tp> > >
+class sharded_map
+{
+public:
+  typedef Key                                   key_type;
+  typedef Tp                                    mapped_type;
+  typedef ft::pair<const Key, Tp>               value_type;
+  typedef Compare                               key_compare;
+  typedef Partition                             partition_type;
+  typedef Alloc                                 allocator_type;
+  typedef ft::map<Key, Tp, Compare, Alloc>      shard_type;
+  typedef typename shard_type::size_type        size_type;
+  typedef Sharded_map_iterator<typename shard_type::const_iterator,
+                               Compare, Shards> const_iterator;
+
+private:
+  typedef sharded_map<Key, Tp, Shards, Compare, Partition, Alloc> Self;
+  typedef ft::pair<Key, Tp>                     Bucket_value;
+  typedef typename Alloc::template rebind<Bucket_value>::other
+                                                Bucket_alloc;
+  typedef ft::vector<Bucket_value, Bucket_alloc> Bucket;
+
+  struct Bucket_compare
+  {
+    Compare M_comp;
+
+    Bucket_compare(const Compare& comp)
+    : M_comp(comp) { }
+
+    bool
+    operator()(const Bucket_value& x, const Bucket_value& y) const
+    { return M_comp(x.first, y.first); }
+  };
+
+  enum { S_cache_line = 64 };
+
+  struct Shard
+  {
+    pthread_mutex_t M_mutex;
+    shard_type      M_map;
+    char            M_pad[S_cache_line];
+
+    Shard(const Compare& comp, const Alloc& a)
+    : M_map(comp, a)
+    { pthread_mutex_init(&M_mutex, 0); }
+
+    ~Shard()
+    { pthread_mutex_destroy(&M_mutex); }
+  };
+
+  class Shard_lock
+  {
+    pthread_mutex_t& M_mutex;
+
+    Shard_lock(const Shard_lock&);
+    Shard_lock& operator=(const Shard_lock&);
+
+  public:
+    explicit
+    Shard_lock(pthread_mutex_t& m)
+    : M_mutex(m)
+    { pthread_mutex_lock(&M_mutex); }
+
+    ~Shard_lock()
+    { pthread_mutex_unlock(&M_mutex); }
+  };
+
+  // Inserts the buckets of shards M_first, M_first + M_step, ...
+  struct Insert_task
+  {
+    Self*        M_map;
+    Bucket*      M_buckets;
+    std::size_t  M_first;
+    std::size_t  M_step;
+
+    void
+    M_run()
+    {
+      for (std::size_t s = M_first; s < Shards; s += M_step)
+        M_map->M_insert_bucket(s, M_buckets[s]);
+    }
+  };
+
+  Shard*     M_shards[Shards];
+  Partition  M_partition;
+  Compare    M_comp;
+
+  sharded_map(const sharded_map&);
+  sharded_map& operator=(const sharded_map&);
+
+  void
+  M_init(const Compare& comp, const Alloc& a)
+  {
+    std::size_t i = 0;
+    try
+    {
+      for (; i < Shards; ++i)
+        M_shards[i] = new Shard(comp, a);
+    }
+    catch(...)
+    {
+      while (i-- > 0)
+        delete M_shards[i];
+      throw;
+    }
+  }
+
+  Shard&
+  M_shard(const key_type& k) const
+  { return *M_shards[M_partition(k) % Shards]; }
+
+  // Sorts outside the lock, then inserts in order, each element hinted
+  // by the previous one: amortized constant time per element.
+  void
+  M_insert_bucket(std::size_t s, Bucket& b)
+  {
+    if (b.empty())
+      return;
+    std::stable_sort(b.begin(), b.end(), Bucket_compare(M_comp));
+    Shard_lock lock(M_shards[s]->M_mutex);
+    shard_type& m = M_shards[s]->M_map;
+    typename shard_type::iterator hint = m.end();
+    for (typename Bucket::iterator i = b.begin(); i != b.end(); ++i)
+      hint = m.insert(hint, value_type(*i));
+  }
+
+public:
+  /**
+   *  @brief  Default constructor creates no elements.
+   */
+  sharded_map()
+  : M_partition(), M_comp()
+  { M_init(Compare(), Alloc()); }
+
+  explicit
+  sharded_map(const Compare& comp, const Partition& part = Partition(),
+              const allocator_type& a = allocator_type())
+  : M_partition(part), M_comp(comp)
+  { M_init(comp, a); }
+
+  /**
+   *  No other thread may still be using the %map.
+   */
+  ~sharded_map()
+  {
+    for (std::size_t i = 0; i < Shards; ++i)
+      delete M_shards[i];
+  }
+
+  // iterators
+  /**
+   *  Returns an iterator to the first element, in ascending key order.
+   *  Iteration must not overlap updates.
+   */
+  const_iterator
+  begin() const
+  {
+    typename const_iterator::Head heads[Shards];
+    for (std::size_t i = 0; i < Shards; ++i)
+      heads[i] = typename const_iterator::Head(M_shards[i]->M_map.begin(),
+                                               M_shards[i]->M_map.end());
+    return const_iterator(heads, M_comp);
+  }
+
+  const_iterator
+  end() const
+  { return const_iterator(M_comp); }
+
+  // capacity
+  /** Returns the number of elements, summed over the shards in turn.  */
+  size_type
+  size() const
+  {
+    size_type n = 0;
+    for (std::size_t i = 0; i < Shards; ++i)
+    {
+      Shard_lock lock(M_shards[i]->M_mutex);
+      n += M_shards[i]->M_map.size();
+    }
+    return n;
+  }
+
+  bool
+  empty() const
+  { return size() == 0; }
+
+  // lookup
+  /**
+   *  @brief  Finds the number of elements with given key.
+   */
+  size_type
+  count(const key_type& x) const
+  {
+    Shard& s = M_shard(x);
+    Shard_lock lock(s.M_mutex);
+    return s.M_map.count(x);
+  }
+
+  /**
+   *  @brief  Copies out the data mapped to a key.
+   *  @param  x  Key to be located.
+   *  @param  result  Set to the mapped data if @a x is present.
+   *  @return  True if @a x was found.
+   */
+  bool
+  find(const key_type& x, mapped_type& result) const
+  {
+    Shard& s = M_shard(x);
+    Shard_lock lock(s.M_mutex);
+    typename shard_type::const_iterator i = s.M_map.find(x);
+    if (i == s.M_map.end())
+      return false;
+    result = (*i).second;
+    return true;
+  }
+
+  /**
+   *  @brief  Applies a function to the element with a given key.
+   *  @param  x  Key to be located.
+   *  @param  f  Called as f(value_type&) with the shard locked; it may
+   *             update the mapped value.
+   *  @return  True if @a x was found and @a f called.
+   */
+  template <typename Function>
+  bool
+  visit(const key_type& x, Function f)
+  {
+    Shard& s = M_shard(x);
+    Shard_lock lock(s.M_mutex);
+    typename shard_type::iterator i = s.M_map.find(x);
+    if (i == s.M_map.end())
+      return false;
+    f(*i);
+    return true;
+  }
+
+  // modifiers
+  /**
+   *  @brief  Inserts an element unless its key is present.
+   *  @return  True if @a x was inserted.
+   */
+  bool
+  insert(const value_type& x)
+  {
+    Shard& s = M_shard(x.first);
+    Shard_lock lock(s.M_mutex);
+    return s.M_map.insert(x).second;
+  }
+
+  /**
+   *  @brief  Inserts an element, or assigns to the existing one.
+   *  @return  True if the element was inserted, false if assigned.
+   */
+  template <typename Obj>
+  bool
+  insert_or_assign(const key_type& k, const Obj& obj)
+  {
+    Shard& s = M_shard(k);
+    Shard_lock lock(s.M_mutex);
+    return s.M_map.insert_or_assign(k, obj).second;
+  }
+
+  /**
+   *  @brief Inserts a range of elements on several threads.
+   *  @param  first  An input iterator.
+   *  @param  last  An input iterator.
+   *  @param  threads  Ways to split the work, the caller included; by
+   *                   default one per online processor.  At most Shards
+   *                   are used.
+   *
+   *  The range is first split into one bucket per shard on the calling
+   *  thread; then each of @a threads tasks, run on the default
+   *  thread_pool, takes every threads-th shard, sorts its bucket and
+   *  inserts it in order, holding only that shard's lock while
+   *  inserting.  Other threads may use the %map meanwhile.  Of equal
+   *  keys the first in the range wins, as with map::insert, and elements
+   *  whose key is already present are skipped.  If an insertion throws,
+   *  the elements of the other shards may have been inserted.
+   */
+  template <typename InputIterator>
+  void
+  insert(InputIterator first, InputIterator last, std::size_t threads = 0)
+  {
+    const Bucket empty_bucket = Bucket(Bucket_alloc(get_allocator()));
+    ft::vector<Bucket> buckets(Shards, empty_bucket);
+    for (; first != last; ++first)
+      buckets[M_partition((*first).first) % Shards].push_back(
+          Bucket_value((*first).first, (*first).second));
+
+    threads = Parallel_threads(parallel_policy(threads));
+    if (threads > Shards)
+      threads = Shards;
+
+    Insert_task tasks[Shards];
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+      tasks[t].M_map = this;
+      tasks[t].M_buckets = &buckets[0];
+      tasks[t].M_first = t;
+      tasks[t].M_step = threads;
+    }
+    Parallel_run(tasks, threads);
+  }
+
+  /**
+   *  @brief Erases the element with a given key.
+   *  @return  The number of elements erased.
+   */
+  size_type
+  erase(const key_type& x)
+  {
+    Shard& s = M_shard(x);
+    Shard_lock lock(s.M_mutex);
+    return s.M_map.erase(x);
+  }
+
+  /**
+   *  Erases all elements, one shard at a time.
+   */
+  void
+  clear()
+  {
+    for (std::size_t i = 0; i < Shards; ++i)
+    {
+      Shard_lock lock(M_shards[i]->M_mutex);
+      M_shards[i]->M_map.clear();
+    }
+  }
+
+  // observers
+  /**
+   *  @brief  Direct access to one shard, which is not locked.
+   *  @param  i  Shard index, less than Shards.
+   */
+  shard_type&
+  shard(std::size_t i)
+  { return M_shards[i]->M_map; }
+
+  const shard_type&
+  shard(std::size_t i) const
+  { return M_shards[i]->M_map; }
+
+  /** Which shard holds, or would hold, a key.  */
+  std::size_t
+  shard_of(const key_type& k) const
+  { return M_partition(k) % Shards; }
+
+  key_compare
+  key_comp() const
+  { return M_comp; }
+
+  /// Get a copy of the memory allocation object.
+  allocator_type
+  get_allocator() const
+  { return M_shards[0]->M_map.get_allocator(); }
+};
+
+} // ft
+
+#endif // STL_SHARDED_MAP_H_
@@ -39,6 +39,9 @@ namespace ft {
  * which is a typedef for the second Sequence parameter, and @c
  * push, @c pop, and @c top, which are standard %stack/FILO
  * operations.
+ *
+ * For stacks of large elements, ft::segmented_vector grows without
+ * copying the elements already pushed.
  */
 template <typename Tp, typename Sequence = ft::vector<Tp> >
 class stack
@@ -0,0 +1,674 @@
+// Work-stealing thread pool -*- C++ -*-
+
+/** @file stl_thread_pool.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef STL_THREAD_POOL_H_
+#define STL_THREAD_POOL_H_
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace ft {
+
+/**
+ *  @brief  Thrown on the caller of a parallel operation when a function
+ *  it forked threw anything but std::bad_alloc.  The exception itself
+ *  cannot be carried across threads, and the function is not run again.
+ */
+class parallel_error : public std::exception
+{
+public:
+  virtual const char*
+  what() const throw()
+  { return "ft::parallel_error"; }
+};
+
+// How a task ended, kept in Pool_task::M_failed.
+enum { S_task_done = 0, S_task_threw, S_task_bad_alloc };
+
+// A unit of work for a thread_pool.  Whoever submits it owns it and must
+// keep it alive until *M_pending, decremented once it has run, shows it
+// done; a task that never throws may instead free itself as it runs.
+// An exception is not carried across threads: M_failed records it
+// instead, and the owner reports it with Pool_rethrow.
+struct Pool_task
+{
+  void             (*M_execute)(Pool_task*);
+  volatile size_t* M_pending;
+  int              M_failed;
+  Pool_task*       M_next;      // For the injection queue.
+};
+
+inline void
+Pool_execute(Pool_task* t)
+{
+  volatile size_t* const pending = t->M_pending;
+  try
+  {
+    t->M_execute(t);
+  }
+  catch(const std::bad_alloc&)
+  {
+    t->M_failed = S_task_bad_alloc;
+  }
+  catch(...)
+  {
+    t->M_failed = S_task_threw;
+  }
+  __atomic_sub_fetch(pending, size_t(1), __ATOMIC_RELEASE);
+}
+
+// Throws, on the owner of a task, what its failure stands for.
+inline void
+Pool_rethrow(int failed)
+{
+  if (failed == S_task_bad_alloc)
+    throw std::bad_alloc();
+  throw parallel_error();
+}
+
+/**
+ *  @if maint
+ *  The Chase-Lev work-stealing deque (Chase and Lev, "Dynamic Circular
+ *  Work-Stealing Deque", SPAA 2005), with the memory orderings of Le,
+ *  Pop, Cohen and Zappa Nardelli (PPoPP 2013).  The owner pushes and
+ *  takes at the bottom without locking; thieves take from the top with
+ *  one compare-and-swap, which the owner joins only for the last task.
+ *  The ring doubles when full; rings outgrown stay allocated until the
+ *  deque goes, since a thief may still be reading one.
+ *  @endif
+ */
+class Pool_deque
+{
+  enum { S_cache_line = 64, S_initial_size = 64 };
+
+  struct Ring
+  {
+    long        M_mask;
+    Pool_task** M_slots;
+    Ring*       M_older;
+  };
+
+  volatile long  M_top;
+  char           M_pad1[S_cache_line - sizeof(long)];
+  volatile long  M_bottom;
+  Ring* volatile M_ring;
+  char           M_pad2[S_cache_line - sizeof(long) - sizeof(Ring*)];
+
+  Pool_deque(const Pool_deque&);
+  Pool_deque& operator=(const Pool_deque&);
+
+  static Ring*
+  S_make_ring(long size, Ring* older)
+  {
+    Ring* r = new Ring;
+    try
+    {
+      r->M_slots = new Pool_task*[size];
+    }
+    catch(...)
+    {
+      delete r;
+      throw;
+    }
+    r->M_mask = size - 1;
+    r->M_older = older;
+    return r;
+  }
+
+  static Pool_task*
+  S_get(Ring* r, long i)
+  { return __atomic_load_n(&r->M_slots[i & r->M_mask], __ATOMIC_RELAXED); }
+
+  static void
+  S_put(Ring* r, long i, Pool_task* x)
+  { __atomic_store_n(&r->M_slots[i & r->M_mask], x, __ATOMIC_RELAXED); }
+
+  // Owner only: a ring twice as large holding [t, b).
+  Ring*
+  M_grow(Ring* r, long t, long b)
+  {
+    Ring* bigger = S_make_ring(2 * (r->M_mask + 1), r);
+    for (long i = t; i < b; ++i)
+      S_put(bigger, i, S_get(r, i));
+    __atomic_store_n(&M_ring, bigger, __ATOMIC_RELEASE);
+    return bigger;
+  }
+
+public:
+  Pool_deque()
+  : M_top(0), M_bottom(0), M_ring(S_make_ring(S_initial_size, 0)) { }
+
+  ~Pool_deque()
+  {
+    Ring* r = M_ring;
+    while (r != 0)
+    {
+      Ring* older = r->M_older;
+      delete[] r->M_slots;
+      delete r;
+      r = older;
+    }
+  }
+
+  // Owner only.  May throw std::bad_alloc when the ring must grow.
+  void
+  M_push(Pool_task* x)
+  {
+    const long b = __atomic_load_n(&M_bottom, __ATOMIC_RELAXED);
+    const long t = __atomic_load_n(&M_top, __ATOMIC_ACQUIRE);
+    Ring* r = __atomic_load_n(&M_ring, __ATOMIC_RELAXED);
+    if (b - t > r->M_mask)
+      r = M_grow(r, t, b);
+    S_put(r, b, x);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&M_bottom, b + 1, __ATOMIC_RELAXED);
+  }
+
+  // Owner only: the most recently pushed task, or null.
+  Pool_task*
+  M_take()
+  {
+    const long b = __atomic_load_n(&M_bottom, __ATOMIC_RELAXED) - 1;
+    Ring* r = __atomic_load_n(&M_ring, __ATOMIC_RELAXED);
+    __atomic_store_n(&M_bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long t = __atomic_load_n(&M_top, __ATOMIC_RELAXED);
+    Pool_task* x = 0;
+    if (t <= b)
+    {
+      x = S_get(r, b);
+      if (t == b)
+      {
+        if (!__atomic_compare_exchange_n(&M_top, &t, t + 1, false,
+                                         __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+          x = 0;
+        __atomic_store_n(&M_bottom, b + 1, __ATOMIC_RELAXED);
+      }
+    }
+    else
+      __atomic_store_n(&M_bottom, b + 1, __ATOMIC_RELAXED);
+    return x;
+  }
+
+  // Any thread: the oldest task, or null if empty or lost to a race.
+  Pool_task*
+  M_steal()
+  {
+    long t = __atomic_load_n(&M_top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    const long b = __atomic_load_n(&M_bottom, __ATOMIC_ACQUIRE);
+    if (t >= b)
+      return 0;
+    Ring* r = __atomic_load_n(&M_ring, __ATOMIC_ACQUIRE);
+    Pool_task* x = S_get(r, t);
+    if (!__atomic_compare_exchange_n(&M_top, &t, t + 1, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+      return 0;
+    return x;
+  }
+};
+
+/**
+ *  @brief  A fixed set of worker threads sharing fork/join work by
+ *  stealing.
+ *
+ *  Each worker owns a Chase-Lev deque: work forked on a worker goes to
+ *  the bottom of its own deque, where that worker takes it back last in,
+ *  first out, while idle workers steal the oldest, hence largest, pieces
+ *  from the top.  Work submitted from outside the pool goes to a shared
+ *  queue.  Waiting for forked work never blocks: the waiting thread
+ *  runs queued tasks, its own first, until its join completes.  Idle
+ *  workers spin briefly, then sleep until work is pushed.
+ *
+ *  default_pool() is the one scheduler behind every parallel operation
+ *  of the library: the ft::par algorithms and tree builds, the parallel
+ *  set algebra and the background clears.  Other pools may be made for
+ *  isolation.
+ *  Only plain pthreads are used.
+ */
+class thread_pool
+{
+  enum { S_spins = 64 };
+
+  struct Worker
+  {
+    Pool_deque    M_deque;
+    pthread_t     M_thread;
+    thread_pool*  M_pool;
+    unsigned      M_seed;
+  };
+
+  Worker*          M_workers;
+  std::size_t      M_size;
+  pthread_key_t    M_self;
+  pthread_mutex_t  M_mutex;
+  pthread_cond_t   M_wake;
+  Pool_task*       M_injected_head;
+  Pool_task*       M_injected_tail;
+  volatile size_t  M_signal;
+  volatile size_t  M_sleepers;
+  volatile bool    M_stop;
+
+  thread_pool(const thread_pool&);
+  thread_pool& operator=(const thread_pool&);
+
+  static std::size_t
+  S_default_size()
+  {
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? static_cast<std::size_t>(cpus) : 1;
+  }
+
+  Worker*
+  M_current() const
+  { return static_cast<Worker*>(pthread_getspecific(M_self)); }
+
+  // The head is peeked at without the lock, to keep idle workers off it.
+  Pool_task*
+  M_take_injected()
+  {
+    if (__atomic_load_n(&M_injected_head, __ATOMIC_RELAXED) == 0)
+      return 0;
+    pthread_mutex_lock(&M_mutex);
+    Pool_task* t = M_injected_head;
+    if (t != 0)
+    {
+      __atomic_store_n(&M_injected_head, t->M_next, __ATOMIC_RELAXED);
+      if (t->M_next == 0)
+        M_injected_tail = 0;
+    }
+    pthread_mutex_unlock(&M_mutex);
+    return t;
+  }
+
+  // One sweep over the other workers from a random start.
+  Pool_task*
+  M_steal(Worker* self)
+  {
+    if (M_size == 0)
+      return 0;
+    std::size_t start;
+    if (self != 0)
+    {
+      self->M_seed ^= self->M_seed << 13;
+      self->M_seed ^= self->M_seed >> 17;
+      self->M_seed ^= self->M_seed << 5;
+      start = self->M_seed % M_size;
+    }
+    else
+      start = 0;
+    for (std::size_t i = 0; i < M_size; ++i)
+    {
+      Worker& victim = M_workers[(start + i) % M_size];
+      if (&victim == self)
+        continue;
+      if (Pool_task* t = victim.M_deque.M_steal())
+        return t;
+    }
+    return 0;
+  }
+
+  // Some task to run from the point of view of self (null outside the
+  // pool): own deque, then the shared queue, then a steal.
+  Pool_task*
+  M_find(Worker* self)
+  {
+    Pool_task* t = self != 0 ? self->M_deque.M_take() : 0;
+    if (t == 0)
+      t = M_take_injected();
+    if (t == 0)
+      t = M_steal(self);
+    return t;
+  }
+
+  void
+  M_notify()
+  {
+    __atomic_add_fetch(&M_signal, size_t(1), __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&M_sleepers, __ATOMIC_SEQ_CST) != 0)
+    {
+      pthread_mutex_lock(&M_mutex);
+      pthread_cond_signal(&M_wake);
+      pthread_mutex_unlock(&M_mutex);
+    }
+  }
+
+  static void*
+  S_work(void* p)
+  {
+    Worker* self = static_cast<Worker*>(p);
+    thread_pool& pool = *self->M_pool;
+    pthread_setspecific(pool.M_self, self);
+    for (;;)
+    {
+      const size_t seen = __atomic_load_n(&pool.M_signal, __ATOMIC_SEQ_CST);
+      Pool_task* t = 0;
+      for (int spin = 0; t == 0 && spin < S_spins; ++spin)
+      {
+        t = pool.M_find(self);
+        if (t == 0 && spin != 0)
+          sched_yield();
+      }
+      if (t != 0)
+      {
+        Pool_execute(t);
+        continue;
+      }
+      pthread_mutex_lock(&pool.M_mutex);
+      __atomic_add_fetch(&pool.M_sleepers, size_t(1), __ATOMIC_SEQ_CST);
+      while (!pool.M_stop
+             && __atomic_load_n(&pool.M_signal, __ATOMIC_SEQ_CST) == seen)
+        pthread_cond_wait(&pool.M_wake, &pool.M_mutex);
+      __atomic_sub_fetch(&pool.M_sleepers, size_t(1), __ATOMIC_SEQ_CST);
+      const bool stop = pool.M_stop;
+      pthread_mutex_unlock(&pool.M_mutex);
+      if (stop)
+        return 0;
+    }
+  }
+
+  void
+  M_shut_down(std::size_t started)
+  {
+    pthread_mutex_lock(&M_mutex);
+    M_stop = true;
+    pthread_cond_broadcast(&M_wake);
+    pthread_mutex_unlock(&M_mutex);
+    for (std::size_t i = 0; i < started; ++i)
+      pthread_join(M_workers[i].M_thread, 0);
+    for (std::size_t i = M_size; i-- > 0; )
+      M_workers[i].~Worker();
+    ::operator delete(M_workers);
+    pthread_cond_destroy(&M_wake);
+    pthread_mutex_destroy(&M_mutex);
+    pthread_key_delete(M_self);
+  }
+
+public:
+  /**
+   *  @brief  Starts the workers.
+   *  @param  workers  How many; by default one per online processor.
+   *  @throw  std::bad_alloc  If the workers cannot be created.
+   */
+  explicit
+  thread_pool(std::size_t workers = 0)
+  : M_workers(0), M_size(workers != 0 ? workers : S_default_size()),
+    M_injected_head(0), M_injected_tail(0), M_signal(0), M_sleepers(0),
+    M_stop(false)
+  {
+    if (pthread_key_create(&M_self, 0) != 0)
+      throw std::bad_alloc();
+    pthread_mutex_init(&M_mutex, 0);
+    pthread_cond_init(&M_wake, 0);
+    std::size_t made = 0;
+    std::size_t started = 0;
+    try
+    {
+      M_workers = static_cast<Worker*>(
+          ::operator new(M_size * sizeof(Worker)));
+      for (; made < M_size; ++made)
+      {
+        Worker* w = ::new(static_cast<void*>(&M_workers[made])) Worker;
+        w->M_pool = this;
+        w->M_seed = 2654435761u * unsigned(made + 1);
+      }
+      for (; started < M_size; ++started)
+        if (pthread_create(&M_workers[started].M_thread, 0, &S_work,
+                           &M_workers[started]) != 0)
+          throw std::bad_alloc();
+    }
+    catch(...)
+    {
+      M_size = made;
+      M_shut_down(started);
+      throw;
+    }
+  }
+
+  /**
+   *  Stops and joins the workers.  No task may be pending any more.
+   */
+  ~thread_pool()
+  { M_shut_down(M_size); }
+
+  /** The number of worker threads.  */
+  std::size_t
+  size() const
+  { return M_size; }
+
+  /**
+   *  @brief  The process-wide pool behind ft::par, created on first use
+   *  with one worker per online processor and never destroyed.
+   */
+  static thread_pool&
+  default_pool()
+  {
+    static thread_pool* pool = new thread_pool();
+    return *pool;
+  }
+
+  // Queues t, on the caller's own deque if it is a worker of this pool.
+  // May throw std::bad_alloc, t being then not queued.
+  void
+  M_push(Pool_task* t)
+  {
+    if (Worker* self = M_current())
+      self->M_deque.M_push(t);
+    else
+    {
+      t->M_next = 0;
+      pthread_mutex_lock(&M_mutex);
+      if (M_injected_tail != 0)
+        M_injected_tail->M_next = t;
+      else
+        __atomic_store_n(&M_injected_head, t, __ATOMIC_RELAXED);
+      M_injected_tail = t;
+      pthread_mutex_unlock(&M_mutex);
+    }
+    M_notify();
+  }
+
+  // Runs queued tasks until *pending drops to zero.
+  void
+  M_wait(volatile size_t* pending)
+  {
+    Worker* self = M_current();
+    while (__atomic_load_n(pending, __ATOMIC_ACQUIRE) != 0)
+    {
+      if (Pool_task* t = M_find(self))
+        Pool_execute(t);
+      else
+        sched_yield();
+    }
+  }
+
+  /**
+   *  @brief  Runs two functions, possibly at the same time.
+   *  @param  f  Called on the calling thread.
+   *  @param  g  Forked: any thread of the pool may run it.
+   *
+   *  Returns once both have run; while g is pending the caller runs
+   *  other queued work rather than block.  If either throws, the call
+   *  still waits for the other.  An exception from f propagates; one
+   *  from g cannot, so std::bad_alloc or parallel_error is thrown in
+   *  its place.  Neither function is ever run twice.
+   */
+  template <typename F, typename G>
+  void
+  parallel_invoke(F f, G g);
+};
+
+// A function object run as a pool task.
+template <typename Function>
+struct Pool_function_task : public Pool_task
+{
+  Function  M_f;
+
+  explicit
+  Pool_function_task(const Function& f)
+  : M_f(f)
+  {
+    this->M_execute = &S_execute;
+    this->M_failed = S_task_done;
+    this->M_next = 0;
+  }
+
+  static void
+  S_execute(Pool_task* t)
+  { static_cast<Pool_function_task*>(t)->M_f(); }
+};
+
+template <typename F, typename G>
+void
+thread_pool::parallel_invoke(F f, G g)
+{
+  volatile size_t pending = 1;
+  Pool_function_task<G> forked(g);
+  forked.M_pending = &pending;
+  M_push(&forked);
+  try
+  {
+    f();
+  }
+  catch(...)
+  {
+    M_wait(&pending);
+    throw;
+  }
+  M_wait(&pending);
+  if (forked.M_failed)
+    Pool_rethrow(forked.M_failed);
+}
+
+/**
+ *  @brief  Runs two functions, possibly at the same time, on the
+ *  default pool.  See thread_pool::parallel_invoke.
+ */
+template <typename F, typename G>
+inline void
+parallel_invoke(F f, G g)
+{ thread_pool::default_pool().parallel_invoke(f, g); }
+
+/**
+ *  @brief  A set of functions forked on a pool and joined together.
+ *
+ *  run() copies a function object and queues it; wait() returns once
+ *  all have run, the caller meanwhile running queued work.  If any
+ *  threw, wait() then throws std::bad_alloc or parallel_error in its
+ *  place, no function being run twice.  The destructor waits too, and
+ *  ignores failures.
+ */
+class task_group
+{
+  struct Node
+  {
+    Pool_task*  M_task;
+    void        (*M_destroy)(Pool_task*);
+    Node*       M_next;
+  };
+
+  template <typename Function>
+  struct Ops
+  {
+    static void
+    S_destroy(Pool_task* t)
+    { delete static_cast<Pool_function_task<Function>*>(t); }
+  };
+
+  thread_pool&     M_pool;
+  volatile size_t  M_pending;
+  Node*            M_tasks;
+
+  task_group(const task_group&);
+  task_group& operator=(const task_group&);
+
+  void
+  M_release()
+  {
+    while (M_tasks != 0)
+    {
+      Node* next = M_tasks->M_next;
+      M_tasks->M_destroy(M_tasks->M_task);
+      delete M_tasks;
+      M_tasks = next;
+    }
+  }
+
+public:
+  explicit
+  task_group(thread_pool& pool = thread_pool::default_pool())
+  : M_pool(pool), M_pending(0), M_tasks(0) { }
+
+  ~task_group()
+  {
+    M_pool.M_wait(&M_pending);
+    M_release();
+  }
+
+  /**
+   *  @brief  Forks a copy of @a f.
+   *  @throw  std::bad_alloc  If it cannot be queued; it is not run then.
+   */
+  template <typename Function>
+  void
+  run(const Function& f)
+  {
+    Pool_function_task<Function>* t = new Pool_function_task<Function>(f);
+    Node* n;
+    try
+    {
+      n = new Node;
+    }
+    catch(...)
+    {
+      delete t;
+      throw;
+    }
+    n->M_task = t;
+    n->M_destroy = &Ops<Function>::S_destroy;
+    t->M_pending = &M_pending;
+    __atomic_add_fetch(&M_pending, size_t(1), __ATOMIC_RELAXED);
+    try
+    {
+      M_pool.M_push(t);
+    }
+    catch(...)
+    {
+      __atomic_sub_fetch(&M_pending, size_t(1), __ATOMIC_RELAXED);
+      delete n;
+      delete t;
+      throw;
+    }
+    n->M_next = M_tasks;
+    M_tasks = n;
+  }
+
+  /**
+   *  @brief  Waits for every function forked so far, never blocking.
+   *  @throw  std::bad_alloc  If one of them ran out of memory.
+   *  @throw  parallel_error  If one of them threw anything else.
+   */
+  void
+  wait()
+  {
+    M_pool.M_wait(&M_pending);
+    int failed = S_task_done;
+    for (Node* n = M_tasks; n != 0 && failed == S_task_done; n = n->M_next)
+      failed = n->M_task->M_failed;
+    M_release();
+    if (failed != S_task_done)
+      Pool_rethrow(failed);
+  }
+};
+
+} // ft
+
+#endif // STL_THREAD_POOL_H_
@@ -9,12 +9,23 @@
 #define STL_TREE_H_
 
 #include <memory>
+#include <new>
+#include <limits>
+#include <algorithm>
 #include "cpp_type_traits.h"
 #include "stl_iterator.h"
 #include "stl_pair.h"
+#include "stl_function.h"
 #include "stl_algobase.h"
+#include "stl_construct.h"
+#include "stl_vector.h"
 
 namespace ft {
+// The ft::par tag of stl_parallel.h.  The members of Rb_tree taking one
+// are defined in stl_tree_parallel.h, which is included once both this
+// header and stl_parallel.h are.
+struct parallel_policy;
+
 // Red-black tree class, designed for use in implementing STL
 // associative containers (set, multiset, map, and multimap). The
 // insertion and deletion algorithms are based on those in Cormen,
@@ -79,6 +90,238 @@ struct Rb_tree_node : public Rb_tree_node_base
   Val                         M_value_field;
 };
 
+// Node carrying extra per-subtree data for a node update policy.  It
+// derives from the plain node so iterators work on it unchanged.
+template <typename Val, typename Data>
+struct Rb_tree_aug_node : public Rb_tree_node<Val>
+{
+  Data                        M_aug;
+};
+
+// Node update policies.  A policy selects the node type of a tree and
+// recomputes a node's extra data from the node and its two children;
+// Rb_tree calls it wherever the shape of the tree changes (links,
+// rotations, relinks for erase) through a functor on base pointers,
+// node<Val>::updater.  construct(), destroy() and copy() manage the
+// extra data when nodes are created, freed and cloned.  The null
+// policy keeps the plain node and uses Rb_tree_no_update, for which
+// every hook compiles away, so an unaugmented tree pays nothing.
+struct Rb_tree_no_update
+{
+  void
+  operator()(Rb_tree_node_base*) const { }
+};
+
+template <typename Policy, typename Node>
+struct Rb_tree_node_updater
+{
+  void
+  operator()(Rb_tree_node_base* x) const
+  { Policy::update(static_cast<Node*>(x)); }
+};
+
+struct Rb_tree_null_node_update
+{
+  template <typename Val>
+  struct node
+  {
+    typedef Rb_tree_node<Val>   type;
+    typedef Rb_tree_no_update   updater;
+  };
+
+  typedef void                  aggregate_type;
+
+  template <typename Node>
+  static void
+  construct(Node*) { }
+
+  template <typename Node>
+  static void
+  destroy(Node*) { }
+
+  template <typename Node>
+  static void
+  copy(Node*, const Node*) { }
+};
+
+// Keeps the size of every subtree, enabling order statistics (select,
+// rank, iterator distance) in logarithmic time.
+struct Rb_tree_order_statistics_node_update
+{
+  template <typename Val>
+  struct node
+  {
+    typedef Rb_tree_aug_node<Val, std::size_t>  type;
+    typedef Rb_tree_node_updater<Rb_tree_order_statistics_node_update,
+                                 type>          updater;
+  };
+
+  typedef void                                  aggregate_type;
+
+  template <typename Node>
+  static void
+  construct(Node*) { }
+
+  template <typename Node>
+  static void
+  destroy(Node*) { }
+
+  template <typename Node>
+  static std::size_t
+  size(const Rb_tree_node_base* x)
+  { return x ? static_cast<const Node*>(x)->M_aug : 0; }
+
+  template <typename Node>
+  static void
+  update(Node* x)
+  { x->M_aug = 1 + size<Node>(x->M_left) + size<Node>(x->M_right); }
+
+  template <typename Node>
+  static void
+  copy(Node* x, const Node* y)
+  { x->M_aug = y->M_aug; }
+};
+
+// Keeps, for every subtree, the in-order fold of its elements under a
+// monoid, so that the fold of any key range costs O(log n).  Monoid
+// provides result_type, identity(), an associative combine() and a
+// lift() from the element type; combine() need not be commutative.
+template <typename Monoid>
+struct Rb_tree_aggregate_node_update
+{
+  typedef typename Monoid::result_type  aggregate_type;
+
+  template <typename Val>
+  struct node
+  {
+    typedef Rb_tree_aug_node<Val, aggregate_type>  type;
+    typedef Rb_tree_node_updater<Rb_tree_aggregate_node_update,
+                                 type>             updater;
+  };
+
+  static aggregate_type
+  identity()
+  { return Monoid::identity(); }
+
+  static aggregate_type
+  combine(const aggregate_type& x, const aggregate_type& y)
+  { return Monoid::combine(x, y); }
+
+  template <typename Val>
+  static aggregate_type
+  lift(const Val& v)
+  { return Monoid::lift(v); }
+
+  template <typename Node>
+  static void
+  construct(Node* x)
+  { ::new(static_cast<void*>(&x->M_aug)) aggregate_type(); }
+
+  template <typename Node>
+  static void
+  destroy(Node* x)
+  { x->M_aug.~aggregate_type(); }
+
+  template <typename Node>
+  static aggregate_type
+  aggregate(const Rb_tree_node_base* x)
+  { return x ? static_cast<const Node*>(x)->M_aug : Monoid::identity(); }
+
+  template <typename Node>
+  static void
+  update(Node* x)
+  {
+    x->M_aug = Monoid::combine(Monoid::combine(aggregate<Node>(x->M_left),
+                                               Monoid::lift(x->M_value_field)),
+                               aggregate<Node>(x->M_right));
+  }
+
+  template <typename Node>
+  static void
+  copy(Node* x, const Node* y)
+  { x->M_aug = y->M_aug; }
+};
+
+/**
+ *  @brief  Monoids for Rb_tree_aggregate_node_update.
+ *
+ *  Each folds the mapped value of a map element, or the element itself
+ *  for a set, with the obvious operation.  min_monoid and max_monoid
+ *  take their identity from std::numeric_limits and so are meant for
+ *  arithmetic types.
+ */
+template <typename Tp>
+struct plus_monoid
+{
+  typedef Tp  result_type;
+
+  static Tp
+  identity()
+  { return Tp(); }
+
+  static Tp
+  combine(const Tp& x, const Tp& y)
+  { return x + y; }
+
+  template <typename Key>
+  static const Tp&
+  lift(const ft::pair<const Key, Tp>& v)
+  { return v.second; }
+
+  static const Tp&
+  lift(const Tp& v)
+  { return v; }
+};
+
+template <typename Tp>
+struct min_monoid
+{
+  typedef Tp  result_type;
+
+  static Tp
+  identity()
+  { return std::numeric_limits<Tp>::max(); }
+
+  static Tp
+  combine(const Tp& x, const Tp& y)
+  { return y < x ? y : x; }
+
+  template <typename Key>
+  static const Tp&
+  lift(const ft::pair<const Key, Tp>& v)
+  { return v.second; }
+
+  static const Tp&
+  lift(const Tp& v)
+  { return v; }
+};
+
+template <typename Tp>
+struct max_monoid
+{
+  typedef Tp  result_type;
+
+  static Tp
+  identity()
+  {
+    return std::numeric_limits<Tp>::is_integer
+      ? std::numeric_limits<Tp>::min() : -std::numeric_limits<Tp>::max();
+  }
+
+  static Tp
+  combine(const Tp& x, const Tp& y)
+  { return x < y ? y : x; }
+
+  template <typename Key>
+  static const Tp&
+  lift(const ft::pair<const Key, Tp>& v)
+  { return v.second; }
+
+  static const Tp&
+  lift(const Tp& v)
+  { return v; }
+};
+
 Rb_tree_node_base*
 Rb_tree_increment(Rb_tree_node_base* x)
 {
@@ -243,6 +486,13 @@ struct Rb_tree_const_iterator
   Rb_tree_const_iterator(const iterator& it)
   : M_node(it.M_node) { }
 
+  iterator
+  M_const_cast() const
+  {
+    return iterator(static_cast<typename iterator::Link_type>
+                    (const_cast<typename iterator::Base_ptr>(M_node)));
+  }
+
   reference
   operator*() const
   { return static_cast<Link_type>(M_node)->M_value_field; }
@@ -304,9 +554,27 @@ operator!=(const Rb_tree_iterator<Val>& x,
           const Rb_tree_const_iterator<Val>& y)
 { return x.M_node != y.M_node; }
 
+// Applies update to x and each of its ancestors below the header.
+template <typename NodeUpdater>
+void
+Rb_tree_update_to_root(Rb_tree_node_base* x,
+                       Rb_tree_node_base* header,
+                       NodeUpdater update)
+{
+  for (; x != header; x = x->M_parent)
+    update(x);
+}
+
+inline void
+Rb_tree_update_to_root(Rb_tree_node_base*, Rb_tree_node_base*,
+                       Rb_tree_no_update)
+{ }
+
+template <typename NodeUpdater>
 void
 Rb_tree_rotate_left(Rb_tree_node_base* const x,
-                    Rb_tree_node_base*& root)
+                    Rb_tree_node_base*& root,
+                    NodeUpdater update)
 {
   Rb_tree_node_base* const y = x->M_right;
 
@@ -323,11 +591,20 @@ Rb_tree_rotate_left(Rb_tree_node_base* const x,
     x->M_parent->M_right = y;
   y->M_left = x;
   x->M_parent = y;
+  update(x);
+  update(y);
 }
 
+inline void
+Rb_tree_rotate_left(Rb_tree_node_base* const x,
+                    Rb_tree_node_base*& root)
+{ Rb_tree_rotate_left(x, root, Rb_tree_no_update()); }
+
+template <typename NodeUpdater>
 void
 Rb_tree_rotate_right(Rb_tree_node_base* const x,
-                    Rb_tree_node_base*& root)
+                    Rb_tree_node_base*& root,
+                    NodeUpdater update)
 {
   Rb_tree_node_base* const y = x->M_left;
 
@@ -344,13 +621,22 @@ Rb_tree_rotate_right(Rb_tree_node_base* const x,
     x->M_parent->M_left = y;
   y->M_right = x;
   x->M_parent = y;
+  update(x);
+  update(y);
 }
 
+inline void
+Rb_tree_rotate_right(Rb_tree_node_base* const x,
+                    Rb_tree_node_base*& root)
+{ Rb_tree_rotate_right(x, root, Rb_tree_no_update()); }
+
+template <typename NodeUpdater>
 void
 Rb_tree_insert_and_rebalance(const bool insert_left,
                             Rb_tree_node_base* x,
                             Rb_tree_node_base* p,
-                            Rb_tree_node_base& header)
+                            Rb_tree_node_base& header,
+                            NodeUpdater update)
 {
   Rb_tree_node_base*& root = header.M_parent;
 
@@ -383,6 +669,10 @@ Rb_tree_insert_and_rebalance(const bool insert_left,
     if (p == header.M_right)
       header.M_right = x; // maintain rightmost pointing to max node
   }
+  // Refresh node data along the new path; rotations below preserve the
+  // data of the subtree they act on, so only they need local updates.
+  Rb_tree_update_to_root(x, &header, update);
+
   // Rebalance.
   while (x != root
     && x->M_parent->M_color == S_red)
@@ -405,11 +695,11 @@ Rb_tree_insert_and_rebalance(const bool insert_left,
         if (x == x->M_parent->M_right)
         {
           x = x->M_parent;
-          Rb_tree_rotate_left(x, root);
+          Rb_tree_rotate_left(x, root, update);
         }
         x->M_parent->M_color = S_black;
         xpp->M_color = S_red;
-        Rb_tree_rotate_right(xpp, root);
+        Rb_tree_rotate_right(xpp, root, update);
       }
     }
     else
@@ -428,20 +718,29 @@ Rb_tree_insert_and_rebalance(const bool insert_left,
         if (x == x->M_parent->M_left)
         {
           x = x->M_parent;
-          Rb_tree_rotate_right(x, root);
+          Rb_tree_rotate_right(x, root, update);
         }
         x->M_parent->M_color = S_black;
         xpp->M_color = S_red;
-        Rb_tree_rotate_left(xpp, root);
+        Rb_tree_rotate_left(xpp, root, update);
       }
     }
   }
   root->M_color = S_black;
 }
 
+inline void
+Rb_tree_insert_and_rebalance(const bool insert_left,
+                            Rb_tree_node_base* x,
+                            Rb_tree_node_base* p,
+                            Rb_tree_node_base& header)
+{ Rb_tree_insert_and_rebalance(insert_left, x, p, header, Rb_tree_no_update()); }
+
+template <typename NodeUpdater>
 Rb_tree_node_base*
 Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z,
-                            Rb_tree_node_base& header)
+                            Rb_tree_node_base& header,
+                            NodeUpdater update)
 {
   Rb_tree_node_base*& root = header.M_parent;
   Rb_tree_node_base*& leftmost = header.M_left;
@@ -527,6 +826,9 @@ Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z,
     }
   }
 
+  // z is unlinked now; refresh node data from the lowest changed node.
+  Rb_tree_update_to_root(x_parent, &header, update);
+
   if (y->M_color != S_red)
   {
     while (x != root && (x == 0 || x->M_color == S_black))
@@ -538,7 +840,7 @@ Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z,
         {
           w->M_color = S_black;
           x_parent->M_color = S_red;
-          Rb_tree_rotate_left(x_parent, root);
+          Rb_tree_rotate_left(x_parent, root, update);
           w = x_parent->M_right;
         }
 
@@ -558,14 +860,14 @@ Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z,
           {
             w->M_left->M_color = S_black;
             w->M_color = S_red;
-            Rb_tree_rotate_right(w, root);
+            Rb_tree_rotate_right(w, root, update);
             w = x_parent->M_right;
           }
           w->M_color = x_parent->M_color; // Case 4
           x_parent->M_color = S_black;
           if (w->M_right)
             w->M_right->M_color = S_black;
-          Rb_tree_rotate_left(x_parent, root);
+          Rb_tree_rotate_left(x_parent, root, update);
           break;
         }
       }
@@ -577,7 +879,7 @@ Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z,
         {
           w->M_color = S_black;
           x_parent->M_color = S_red;
-          Rb_tree_rotate_right(x_parent, root);
+          Rb_tree_rotate_right(x_parent, root, update);
           w = x_parent->M_left;
         }
 
@@ -597,14 +899,14 @@ Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z,
           {
             w->M_right->M_color = S_black;
             w->M_color = S_red;
-            Rb_tree_rotate_left(w, root);
+            Rb_tree_rotate_left(w, root, update);
             w = x_parent->M_left;
           }
           w->M_color = x_parent->M_color; // Case 4
           x_parent->M_color = S_black;
           if (w->M_left)
             w->M_left->M_color = S_black;
-          Rb_tree_rotate_right(x_parent, root);
+          Rb_tree_rotate_right(x_parent, root, update);
           break;
         }
       }
@@ -614,18 +916,98 @@ Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z,
   return y;
 }
 
+inline Rb_tree_node_base*
+Rb_tree_rebalance_for_erase(Rb_tree_node_base* const z,
+                            Rb_tree_node_base& header)
+{ return Rb_tree_rebalance_for_erase(z, header, Rb_tree_no_update()); }
+
+
+// Whether the lookups of a tree can descend without branching on the
+// comparison: arithmetic keys under std::less, a stateless (POD)
+// comparator whose result is a single flag that conditional moves can
+// consume.  Any other comparator keeps the ordinary descent.
+template <typename Key, typename Compare>
+struct Rb_tree_branchless_descent
+{ typedef __false_type type; };
+
+template <typename Key>
+struct Rb_tree_branchless_descent<Key, std::less<Key> >
+{ typedef typename is_arithmetic<Key>::type type; };
+
+// Whether the comparisons of a tree cannot throw: arithmetic keys under
+// std::less.  The set algebra then skips what undoing a throw needs.
+template <typename Key, typename Compare>
+struct Rb_tree_nothrow_compare
+{ typedef __false_type type; };
+
+template <typename Key>
+struct Rb_tree_nothrow_compare<Key, std::less<Key> >
+{ typedef typename is_arithmetic<Key>::type type; };
+
+// Whether KeyOfValue reads the key of an In in place, so that a batch of
+// In can be sorted where it lies: In is Val itself, or a pair of which
+// Select1st takes the first member.
+template <typename KeyOfValue, typename Val, typename In>
+struct Rb_tree_reads_key
+{ typedef typename are_same<Val, In>::type type; };
+
+template <typename Pair, typename Val, typename In>
+struct Rb_tree_reads_key<Select1st<Pair>, Val, In>
+{ typedef __true_type type; };
+
+// Requests the cache line holding p; a hint only, p may be null.
+inline void
+Rb_tree_prefetch(const void* p)
+{
+#if defined(__GNUC__)
+  __builtin_prefetch(p);
+#else
+  (void)p;
+#endif
+}
+
+// Prefetches the children of both children of x, two levels ahead of
+// a descent that is about to leave x.
+inline void
+Rb_tree_prefetch_grandchildren(const Rb_tree_node_base* x)
+{
+  const Rb_tree_node_base* const l = x->M_left;
+  const Rb_tree_node_base* const r = x->M_right;
+  if (l != 0)
+  {
+    Rb_tree_prefetch(l->M_left);
+    Rb_tree_prefetch(l->M_right);
+  }
+  if (r != 0)
+  {
+    Rb_tree_prefetch(r->M_left);
+    Rb_tree_prefetch(r->M_right);
+  }
+}
+
+template <typename Tree>
+class Rb_tree_node_handle;
 
 template <typename Key, typename Val, typename KeyOfValue,
-          typename Compare, typename Alloc = std::allocator<Val> >
+          typename Compare, typename Alloc = std::allocator<Val>,
+          typename NodeUpdate = Rb_tree_null_node_update>
 class Rb_tree
 {
-  typedef typename Alloc::template rebind<Rb_tree_node<Val> >::other
-          Node_allocator;
+  typedef typename NodeUpdate::template node<Val>::type     Node_type;
+  typedef typename NodeUpdate::template node<Val>::updater  Node_updater;
+  typedef typename Alloc::template rebind<Node_type>::other Node_allocator;
+  typedef typename Rb_tree_branchless_descent<Key, Compare>::type
+                                                            Branchless_descent;
+  typedef typename Rb_tree_nothrow_compare<Key, Compare>::type
+                                                            Nothrow_compare;
+
+  template <typename Tree>
+  friend class Rb_tree_node_handle;
 
   protected:
     typedef Rb_tree_node_base*                    Base_ptr;
     typedef const Rb_tree_node_base*              Const_Base_ptr;
-    typedef Rb_tree_node<Val>                     Rb_tree_node;
+    typedef Node_type                             Rb_tree_node;
 
   public:
     typedef Key                                   key_type;
@@ -639,6 +1021,7 @@ class Rb_tree
     typedef std::size_t                           size_type;
     typedef std::ptrdiff_t                        difference_type;
     typedef Alloc                                 allocator_type;
+    typedef typename NodeUpdate::aggregate_type   aggregate_type;
 
     Node_allocator&
     M_get_Node_allocator()
@@ -674,6 +1057,57 @@ class Rb_tree
         M_put_node(tmp);
         throw;
       }
+      try
+      {
+        NodeUpdate::construct(tmp);
+      }
+      catch(...)
+      {
+        get_allocator().destroy(&tmp->M_value_field);
+        M_put_node(tmp);
+        throw;
+      }
+      return tmp;
+    }
+
+    // Builds a map node (Val is pair<const Key, T>) from its key and a
+    // deferred constructor for the mapped part, so the mapped value is
+    // made once, in place, and never copied.
+    template <typename Construct>
+    Link_type
+    M_create_node_piecewise(const key_type& k, const Construct& make)
+    {
+      Link_type tmp = M_get_node();
+      key_type* key = const_cast<key_type*>(&tmp->M_value_field.first);
+      try
+      {
+        ::new(static_cast<void*>(key)) key_type(k);
+      }
+      catch(...)
+      {
+        M_put_node(tmp);
+        throw;
+      }
+      try
+      {
+        make(&tmp->M_value_field.second);
+      }
+      catch(...)
+      {
+        key->~key_type();
+        M_put_node(tmp);
+        throw;
+      }
+      try
+      {
+        NodeUpdate::construct(tmp);
+      }
+      catch(...)
+      {
+        get_allocator().destroy(&tmp->M_value_field);
+        M_put_node(tmp);
+        throw;
+      }
       return tmp;
     }
 
@@ -684,15 +1118,26 @@ class Rb_tree
       tmp->M_color = x->M_color;
       tmp->M_left = 0;
       tmp->M_right = 0;
+      NodeUpdate::copy(tmp, x);
       return tmp;
     }
 
     void
     M_destroy_node(Link_type p)
     {
+      NodeUpdate::destroy(p);
       get_allocator().destroy(&p->M_value_field);
       M_put_node(p);
     }
+
+    // Frees a node owned outside any tree, e.g. by a node handle.
+    static void
+    S_destroy_node(Node_allocator& a, Link_type p)
+    {
+      NodeUpdate::destroy(p);
+      allocator_type(a).destroy(&p->M_value_field);
+      a.deallocate(p, 1);
+    }
     
   protected:
     template <typename Key_compare,
@@ -845,7 +1290,8 @@ class Rb_tree
       Link_type z = M_create_node(v);
 
       Rb_tree_insert_and_rebalance(insert_left, z, p,
-          this->M_impl.M_header);
+          this->M_impl.M_header,
+            Node_updater());
       ++M_impl.M_node_count;
       return iterator(z);
     }
@@ -861,7 +1307,8 @@ class Rb_tree
       Link_type z = M_create_node(v);
 
       Rb_tree_insert_and_rebalance(insert_left, z, p,
-            this->M_impl.M_header);
+            this->M_impl.M_header,
+            Node_updater());
       ++M_impl.M_node_count;
       return iterator(z);
     }
@@ -877,11 +1324,262 @@ class Rb_tree
 
       Rb_tree_insert_and_rebalance(insert_left, z,
             const_cast<Base_ptr>(p),
-            this->M_impl.M_header);
+            this->M_impl.M_header,
+            Node_updater());
       ++M_impl.M_node_count;
       return const_iterator(z);
     }
 
+    // Links a new node for v immediately before pos, which must be
+    // lower_bound(key(v)).
+    iterator
+    M_insert_before(Base_ptr pos, const value_type& v)
+    {
+      if (pos == M_end())
+        return size() == 0 ? M_insert(0, M_end(), v)
+                           : M_insert(0, M_rightmost(), v);
+      if (pos->M_left == 0)
+        return M_insert(pos, pos, v);
+      return M_insert(0, Rb_tree_decrement(pos), v);
+    }
+
+    // One descent for k: (0, parent) where a node for k would be linked
+    // under parent, or (node, 0) if node already holds an equal key.
+    pair<Base_ptr, Base_ptr>
+    M_get_insert_unique_pos(const key_type& k)
+    {
+      Link_type x = M_begin();
+      Link_type y = M_end();
+      bool comp = true;
+      while (x != 0)
+      {
+        y = x;
+        comp = M_impl.M_key_compare(k, S_key(x));
+        x = comp ? S_left(x) : S_right(x);
+      }
+      iterator j = iterator(y);
+      if (comp)
+      {
+        if (j == begin())
+          return pair<Base_ptr, Base_ptr>(0, y);
+        --j;
+      }
+      if (M_impl.M_key_compare(S_key(j.M_node), k))
+        return pair<Base_ptr, Base_ptr>(0, y);
+      return pair<Base_ptr, Base_ptr>(j.M_node, 0);
+    }
+
+    // Links the detached node z under p, as found by
+    // M_get_insert_unique_pos.
+    iterator
+    M_link_at(Base_ptr p, Link_type z)
+    {
+      const bool insert_left = (p == M_end()
+                                || M_impl.M_key_compare(S_key(z), S_key(p)));
+      Rb_tree_insert_and_rebalance(insert_left, z, p, M_impl.M_header,
+                                   Node_updater());
+      ++M_impl.M_node_count;
+      return iterator(z);
+    }
+
+    // As M_insert_before, for a detached node z.
+    iterator
+    M_link_before(Base_ptr pos, Link_type z)
+    {
+      bool insert_left = true;
+      Base_ptr p = pos;
+      if (pos == M_end())
+      {
+        if (size() != 0)
+        {
+          p = M_rightmost();
+          insert_left = false;
+        }
+      }
+      else if (pos->M_left != 0)
+      {
+        p = Rb_tree_decrement(pos);
+        insert_left = false;
+      }
+      Rb_tree_insert_and_rebalance(insert_left, z, p, M_impl.M_header,
+                                   Node_updater());
+      ++M_impl.M_node_count;
+      return iterator(z);
+    }
+
+    // Descents for lower_bound and upper_bound: the first node not less
+    // than (greater than) k, or M_end().
+    Const_Base_ptr
+    M_lower_bound(const key_type& k, __false_type) const
+    {
+      Const_Base_ptr x = M_root();
+      Const_Base_ptr y = M_end();
+      while (x != 0)
+      {
+        if (!M_impl.M_key_compare(S_key(x), k))
+        {
+          y = x;
+          x = x->M_left;
+        }
+        else
+          x = x->M_right;
+      }
+      return y;
+    }
+
+    Const_Base_ptr
+    M_upper_bound(const key_type& k, __false_type) const
+    {
+      Const_Base_ptr x = M_root();
+      Const_Base_ptr y = M_end();
+      while (x != 0)
+      {
+        if (M_impl.M_key_compare(k, S_key(x)))
+        {
+          y = x;
+          x = x->M_left;
+        }
+        else
+          x = x->M_right;
+      }
+      return y;
+    }
+
+    // For arithmetic keys the comparison feeds only selects, which the
+    // compiler turns into conditional moves, so a random key costs no
+    // mispredicted branch per level.  Freed from waiting on the branch,
+    // the loads of the next levels are started early: at each node the
+    // four grandchildren are prefetched, so that whichever is reached
+    // two steps later is already on its way.
+    Const_Base_ptr
+    M_lower_bound(const key_type& k, __true_type) const
+    {
+      Const_Base_ptr x = M_root();
+      Const_Base_ptr y = M_end();
+      while (x != 0)
+      {
+        Rb_tree_prefetch_grandchildren(x);
+        const bool right = S_key(x) < k;
+        y = right ? y : x;
+        x = right ? x->M_right : x->M_left;
+      }
+      return y;
+    }
+
+    Const_Base_ptr
+    M_upper_bound(const key_type& k, __true_type) const
+    {
+      Const_Base_ptr x = M_root();
+      Const_Base_ptr y = M_end();
+      while (x != 0)
+      {
+        Rb_tree_prefetch_grandchildren(x);
+        const bool right = !(k < S_key(x));
+        y = right ? y : x;
+        x = right ? x->M_right : x->M_left;
+      }
+      return y;
+    }
+
+    // True if x sorts at or after the lower (upper) bound of k.
+    bool
+    M_at_or_after_bound(Const_Base_ptr x, const key_type& k, bool upper) const
+    {
+      return upper ? M_impl.M_key_compare(k, S_key(x))
+                   : !M_impl.M_key_compare(S_key(x), k);
+    }
+
+    // Finger search: returns lower_bound(k), or upper_bound(k) if upper,
+    // starting from an arbitrary position x instead of the root.  Climbs
+    // only until an ancestor brackets k and then descends, so the cost is
+    // O(log d) where d is the in-order distance between x and the result.
+    Const_Base_ptr
+    M_bound_from(Const_Base_ptr x, const key_type& k, bool upper) const
+    {
+      if (M_root() == 0)
+        return M_end();
+      if (x == M_end())
+      {
+        x = M_rightmost();
+        if (!M_at_or_after_bound(x, k, upper))
+          return M_end();
+      }
+
+      Const_Base_ptr bound;
+      Const_Base_ptr y;
+      if (!M_at_or_after_bound(x, k, upper))
+      {
+        // Search forward.  Climb until an ancestor reached from its left
+        // side is at or after the bound; the answer is then that ancestor
+        // or lies in x's right subtree.
+        bound = M_end();
+        while (x != M_root())
+        {
+          Const_Base_ptr p = x->M_parent;
+          if (x == p->M_left && M_at_or_after_bound(p, k, upper))
+          {
+            bound = p;
+            break;
+          }
+          x = p;
+        }
+        y = x->M_right;
+      }
+      else
+      {
+        // Search backward.  Climb until an ancestor reached from its
+        // right side is before the bound; the answer is then x or lies in
+        // x's left subtree.
+        while (x != M_root())
+        {
+          Const_Base_ptr p = x->M_parent;
+          if (x == p->M_right && !M_at_or_after_bound(p, k, upper))
+            break;
+          x = p;
+        }
+        bound = x;
+        y = x->M_left;
+      }
+
+      while (y != 0)
+      {
+        if (M_at_or_after_bound(y, k, upper))
+        {
+          bound = y;
+          y = y->M_left;
+        }
+        else
+          y = y->M_right;
+      }
+      return bound;
+    }
+
+    struct M_value_ptr_compare
+    {
+      Compare comp;
+
+      M_value_ptr_compare(const Compare& c)
+      : comp(c) { }
+
+      bool
+      operator()(const value_type* a, const value_type* b) const
+      { return comp(KeyOfValue()(*a), KeyOfValue()(*b)); }
+    };
+
+    // Orders iterators into a batch by the keys of their elements.
+    template <typename Iterator>
+    struct M_iterator_compare
+    {
+      Compare comp;
+
+      M_iterator_compare(const Compare& c)
+      : comp(c) { }
+
+      bool
+      operator()(const Iterator& a, const Iterator& b) const
+      { return comp(KeyOfValue()(*a), KeyOfValue()(*b)); }
+    };
+
     Link_type
     M_copy(Const_Link_type x, Link_type p)
     {
@@ -928,36 +1626,723 @@ class Rb_tree
       }
     }
 
-  public:
-    // allocation/deallocation
-    Rb_tree()
-    { }
-
-    Rb_tree(const Compare& comp)
-    : M_impl(allocator_type(), comp)
+    // Frees a detached subtree given only its allocator.
+    static void
+    S_erase(Node_allocator& a, Link_type x)
+    {
+      while (x != 0)
+      {
+        S_erase(a, S_right(x));
+        Link_type y = S_left(x);
+        S_destroy_node(a, x);
+        x = y;
+      }
+    }
+
+    // Parallel copy and erase, and clearing in the background; these and
+    // the other members taking a parallel_policy are defined in
+    // stl_tree_parallel.h, with everything else that needs the pool.
+    static int
+    S_parallel_forks(size_type n, std::size_t threads);
+
+    struct Copy_task;
+    struct Erase_task;
+    struct Reclaim_job;
+
+    Link_type
+    M_copy_parallel(Const_Link_type x, Link_type p, int forks);
+
+    void
+    M_erase_parallel(Link_type x, int forks);
+
+    // Copies x into this empty tree.
+    void
+    M_copy_from(const Rb_tree& x, const parallel_policy& policy);
+
+    // Join-based set algebra (Blelloch, Ferizovic and Sun, "Just Join
+    // for Parallel Ordered Sets").  Subtrees are handled as standalone
+    // red-black trees whose root may be red, carried with their black
+    // height: the number of black nodes on a path from the root down to
+    // a null link, the root included.  Every other operation is built
+    // from join(l, k, r), which links two trees around a middle node in
+    // time proportional to the difference of their black heights.
+    struct Join_tree
+    {
+      Base_ptr  M_root;
+      int       M_bh;
+    };
+
+    enum Set_operation
+    {
+      S_set_union,
+      S_set_intersection,
+      S_set_difference,
+      S_set_symmetric_difference
+    };
+
+    static Join_tree
+    S_join_tree(Base_ptr root, int bh)
+    {
+      Join_tree t;
+      t.M_root = root;
+      t.M_bh = bh;
+      return t;
+    }
+
+    static bool
+    S_is_red(Const_Base_ptr x)
+    { return x != 0 && x->M_color == S_red; }
+
+    // Black height of the children of t's root.
+    static int
+    S_child_bh(const Join_tree& t)
+    { return t.M_bh - (t.M_root->M_color == S_black); }
+
+    static Base_ptr
+    S_link(Base_ptr l, Base_ptr k, Rb_tree_color c, Base_ptr r)
+    {
+      k->M_left = l;
+      k->M_right = r;
+      k->M_color = c;
+      if (l != 0)
+        l->M_parent = k;
+      if (r != 0)
+        r->M_parent = k;
+      Node_updater()(k);
+      return k;
+    }
+
+    static Base_ptr
+    S_join_right(Base_ptr l, int lbh, Base_ptr k, Base_ptr r, int rbh)
+    {
+      if (!S_is_red(l) && lbh == rbh)
+        return S_link(l, k, S_red, r);
+      const int cbh = lbh - (l->M_color == S_black);
+      S_link(l->M_left, l, l->M_color,
+             S_join_right(l->M_right, cbh, k, r, rbh));
+      if (l->M_color == S_black && S_is_red(l->M_right)
+          && S_is_red(l->M_right->M_right))
+      {
+        Base_ptr const y = l->M_right;
+        y->M_right->M_color = S_black;
+        S_link(l->M_left, l, S_black, y->M_left);
+        return S_link(l, y, y->M_color, y->M_right);
+      }
+      return l;
+    }
+
+    static Base_ptr
+    S_join_left(Base_ptr l, int lbh, Base_ptr k, Base_ptr r, int rbh)
+    {
+      if (!S_is_red(r) && lbh == rbh)
+        return S_link(l, k, S_red, r);
+      const int cbh = rbh - (r->M_color == S_black);
+      S_link(S_join_left(l, lbh, k, r->M_left, cbh), r, r->M_color,
+             r->M_right);
+      if (r->M_color == S_black && S_is_red(r->M_left)
+          && S_is_red(r->M_left->M_left))
+      {
+        Base_ptr const y = r->M_left;
+        y->M_left->M_color = S_black;
+        S_link(y->M_right, r, S_black, r->M_right);
+        return S_link(y->M_left, y, y->M_color, r);
+      }
+      return r;
+    }
+
+    static Join_tree
+    S_join(const Join_tree& l, Base_ptr k, const Join_tree& r)
+    {
+      if (l.M_bh > r.M_bh)
+      {
+        Join_tree t = S_join_tree(S_join_right(l.M_root, l.M_bh, k,
+                                               r.M_root, r.M_bh), l.M_bh);
+        if (S_is_red(t.M_root) && S_is_red(t.M_root->M_right))
+        {
+          t.M_root->M_color = S_black;
+          ++t.M_bh;
+        }
+        return t;
+      }
+      if (r.M_bh > l.M_bh)
+      {
+        Join_tree t = S_join_tree(S_join_left(l.M_root, l.M_bh, k,
+                                              r.M_root, r.M_bh), r.M_bh);
+        if (S_is_red(t.M_root) && S_is_red(t.M_root->M_left))
+        {
+          t.M_root->M_color = S_black;
+          ++t.M_bh;
+        }
+        return t;
+      }
+      if (!S_is_red(l.M_root) && !S_is_red(r.M_root))
+        return S_join_tree(S_link(l.M_root, k, S_red, r.M_root), l.M_bh);
+      return S_join_tree(S_link(l.M_root, k, S_black, r.M_root), l.M_bh + 1);
+    }
+
+    // Detaches the greatest node of t into last.
+    static Join_tree
+    S_split_last(const Join_tree& t, Base_ptr& last)
+    {
+      Base_ptr const x = t.M_root;
+      const int cbh = S_child_bh(t);
+      if (x->M_right == 0)
+      {
+        last = x;
+        return S_join_tree(x->M_left, cbh);
+      }
+      Join_tree r = S_split_last(S_join_tree(x->M_right, cbh), last);
+      return S_join(S_join_tree(x->M_left, cbh), x, r);
+    }
+
+    // join() without a middle node.
+    static Join_tree
+    S_join2(const Join_tree& l, const Join_tree& r)
+    {
+      if (l.M_root == 0)
+        return r;
+      Base_ptr k;
+      Join_tree rest = S_split_last(l, k);
+      return S_join(rest, k, r);
+    }
+
+    // Splits t into the elements less than k, the node equal to k (or
+    // null) and the elements greater than k.
+    void
+    M_split(const Join_tree& t, const key_type& k, Join_tree& l,
+            Base_ptr& mid, Join_tree& r) const
+    {
+      if (t.M_root == 0)
+      {
+        l = r = t;
+        mid = 0;
+        return;
+      }
+      Base_ptr const x = t.M_root;
+      const int cbh = S_child_bh(t);
+      if (M_impl.M_key_compare(k, S_key(x)))
+      {
+        Join_tree gt;
+        M_split(S_join_tree(x->M_left, cbh), k, l, mid, gt);
+        r = S_join(gt, x, S_join_tree(x->M_right, cbh));
+      }
+      else if (M_impl.M_key_compare(S_key(x), k))
+      {
+        Join_tree lt;
+        M_split(S_join_tree(x->M_right, cbh), k, lt, mid, r);
+        l = S_join(S_join_tree(x->M_left, cbh), x, lt);
+      }
+      else
+      {
+        l = S_join_tree(x->M_left, cbh);
+        mid = x;
+        r = S_join_tree(x->M_right, cbh);
+      }
+    }
+
+    // The set algebra runs in two passes, so that an exception from a
+    // comparison leaves both trees holding what they held.  The first
+    // pass makes every comparison and destroys nothing: each node k of b
+    // splits the piece of a that reaches it into the elements less than
+    // k, the node equal to k (if any) and the elements greater, and these
+    // are recorded, in preorder, for k's subtrees to split further.  It
+    // only restructures a, by joins, and on a throw the pieces are joined
+    // back together; b is left alone throughout.  The second pass
+    // compares nothing and cannot throw: it combines the pieces bottom-up
+    // around the nodes of b, relinking and destroying nodes.
+    struct Set_split
+    {
+      Base_ptr   M_match;
+      Join_tree  M_left;
+      Join_tree  M_right;
+    };
+
+    typedef ft::vector<Set_split> Set_splits;
+
+    static Join_tree
+    S_set_rejoin(const Join_tree& l, Base_ptr m, const Join_tree& r)
+    { return m != 0 ? S_join(l, m, r) : S_join2(l, r); }
+
+    // First pass over a and b.  If it throws, a is a valid tree again,
+    // of the same nodes.
+    void
+    M_set_split(Join_tree& a, const Join_tree& b, Set_splits& splits) const
+    {
+      if (a.M_root == 0 || b.M_root == 0)
+        return;
+      Base_ptr const k = b.M_root;
+      const int cbh = S_child_bh(b);
+      Set_split s;
+      M_split(a, S_key(k), s.M_left, s.M_match, s.M_right);
+      Join_tree l = s.M_left;
+      Join_tree r = s.M_right;
+      const size_type first = splits.size();
+      try
+      {
+        splits.push_back(s);
+        M_set_split(l, S_join_tree(k->M_left, cbh), splits);
+      }
+      catch(...)
+      {
+        a = S_set_rejoin(l, s.M_match, r);
+        throw;
+      }
+      try
+      {
+        M_set_split(r, S_join_tree(k->M_right, cbh), splits);
+      }
+      catch(...)
+      {
+        size_type i = first + 1;
+        l = S_set_unsplit(s.M_left, S_join_tree(k->M_left, cbh), splits, i);
+        a = S_set_rejoin(l, s.M_match, r);
+        throw;
+      }
+    }
+
+    // Undoes a completed first pass over a and b whose record is
+    // splits[i], returning a as a valid tree.
+    static Join_tree
+    S_set_unsplit(const Join_tree& a, const Join_tree& b,
+                  const Set_splits& splits, size_type& i)
+    {
+      if (a.M_root == 0 || b.M_root == 0)
+        return a;
+      const Set_split& s = splits[i++];
+      Base_ptr const k = b.M_root;
+      const int cbh = S_child_bh(b);
+      const Join_tree l = S_set_unsplit(s.M_left,
+                                        S_join_tree(k->M_left, cbh),
+                                        splits, i);
+      const Join_tree r = S_set_unsplit(s.M_right,
+                                        S_join_tree(k->M_right, cbh),
+                                        splits, i);
+      return S_set_rejoin(l, s.M_match, r);
+    }
+
+    // The result where a or b is empty.
+    Join_tree
+    M_set_rest(Set_operation op, const Join_tree& a, const Join_tree& b)
+    {
+      const Join_tree& rest = a.M_root == 0 ? b : a;
+      switch (op)
+      {
+        case S_set_intersection:
+          M_erase(static_cast<Link_type>(rest.M_root));
+          return S_join_tree(0, 0);
+        case S_set_difference:
+          M_erase(static_cast<Link_type>(b.M_root));
+          return a;
+        default:
+          return rest;
+      }
+    }
+
+    // Combines the results l and r of k's subtrees around k, b's node,
+    // or m, a's equal one.  Equal elements keep a's node; nodes that drop
+    // out are destroyed, and matches counts the elements in both trees.
+    Join_tree
+    M_set_combine(Set_operation op, const Join_tree& l, Base_ptr k,
+                  Base_ptr m, const Join_tree& r, size_type& matches)
+    {
+      if (m != 0)
+        ++matches;
+      switch (op)
+      {
+        case S_set_union:
+          if (m == 0)
+            return S_join(l, k, r);
+          M_destroy_node(static_cast<Link_type>(k));
+          return S_join(l, m, r);
+        case S_set_intersection:
+          M_destroy_node(static_cast<Link_type>(k));
+          return S_set_rejoin(l, m, r);
+        case S_set_difference:
+          M_destroy_node(static_cast<Link_type>(k));
+          if (m != 0)
+            M_destroy_node(static_cast<Link_type>(m));
+          return S_join2(l, r);
+        default:
+          if (m == 0)
+            return S_join(l, k, r);
+          M_destroy_node(static_cast<Link_type>(k));
+          M_destroy_node(static_cast<Link_type>(m));
+          return S_join2(l, r);
+      }
+    }
+
+    // Second pass over a and b, from their record splits[i] on.
+    // O(m log(n/m + 1)) work over both passes, for sizes m <= n.
+    Join_tree
+    M_set_finish(Set_operation op, const Join_tree& a, const Join_tree& b,
+                 const Set_splits& splits, size_type& i,
+                 size_type& matches)
+    {
+      if (a.M_root == 0 || b.M_root == 0)
+        return M_set_rest(op, a, b);
+      const Set_split& s = splits[i++];
+      Base_ptr const k = b.M_root;
+      const int cbh = S_child_bh(b);
+      const Join_tree l2 = S_join_tree(k->M_left, cbh);
+      const Join_tree r2 = S_join_tree(k->M_right, cbh);
+      const Join_tree l = M_set_finish(op, s.M_left, l2, splits, i, matches);
+      const Join_tree r = M_set_finish(op, s.M_right, r2, splits, i,
+                                       matches);
+      return M_set_combine(op, l, k, s.M_match, r, matches);
+    }
+
+    // Both passes at once, where the comparisons cannot throw: nothing
+    // is recorded, and each split is combined while its pieces are
+    // still in cache.
+    Join_tree
+    M_set_merge(Set_operation op, const Join_tree& a, const Join_tree& b,
+                size_type& matches)
+    {
+      if (a.M_root == 0 || b.M_root == 0)
+        return M_set_rest(op, a, b);
+      Base_ptr const k = b.M_root;
+      const int cbh = S_child_bh(b);
+      Join_tree l1, r1;
+      Base_ptr m;
+      M_split(a, S_key(k), l1, m, r1);
+      const Join_tree l = M_set_merge(op, l1, S_join_tree(k->M_left, cbh),
+                                      matches);
+      const Join_tree r = M_set_merge(op, r1, S_join_tree(k->M_right, cbh),
+                                      matches);
+      return M_set_combine(op, l, k, m, r, matches);
+    }
+
+    enum { S_set_max_forks = 3 };
+
+    // A set operation on (M_a, M_b) as one of a binary tree of tasks
+    // kept in one array, task i having its halves at 2i + 1 and 2i + 2.
+    // While forks remain, b's root splits a and the halves run under
+    // M_fork, Parallel_run; otherwise the task makes both passes alone.
+    // A first pass that throws leaves M_a whole again, so that the task
+    // that forked it can rejoin its own split.
+    struct Set_operation_task
+    {
+      Rb_tree*             M_tree;
+      void                 (*M_fork)(Set_operation_task*, std::size_t);
+      Set_operation_task*  M_tasks;
+      size_type            M_index;
+      Set_operation        M_op;
+      int                  M_forks;
+      Join_tree            M_a;
+      Join_tree            M_b;
+      bool                 M_forked;
+      bool                 M_split_done;
+      bool                 M_finishing;
+      Set_split            M_top;
+      Set_splits           M_splits;
+      Join_tree            M_result;
+      size_type            M_matches;
+
+      Set_operation_task*
+      M_halves()
+      { return M_tasks + 2 * M_index + 1; }
+
+      void
+      M_run()
+      {
+        if (M_finishing)
+          M_tree->M_set_finish_task(*this);
+        else
+          M_tree->M_set_split_task(*this);
+      }
+    };
+
+    void
+    M_set_split_task(Set_operation_task& t)
+    {
+      t.M_split_done = false;
+      t.M_splits.clear();
+      t.M_forked = t.M_forks > 0 && t.M_a.M_root != 0 && t.M_b.M_root != 0;
+      if (!t.M_forked)
+      {
+        M_set_split_leaf(t, Nothrow_compare());
+        t.M_split_done = true;
+        return;
+      }
+      Base_ptr const k = t.M_b.M_root;
+      const int cbh = S_child_bh(t.M_b);
+      Set_split& s = t.M_top;
+      M_split(t.M_a, S_key(k), s.M_left, s.M_match, s.M_right);
+      Set_operation_task* const h = t.M_halves();
+      for (int i = 0; i < 2; ++i)
+      {
+        h[i].M_tree = this;
+        h[i].M_fork = t.M_fork;
+        h[i].M_tasks = t.M_tasks;
+        h[i].M_index = 2 * t.M_index + 1 + i;
+        h[i].M_op = t.M_op;
+        h[i].M_forks = t.M_forks - 1;
+        h[i].M_split_done = false;
+        h[i].M_finishing = false;
+      }
+      h[0].M_a = s.M_left;
+      h[0].M_b = S_join_tree(k->M_left, cbh);
+      h[1].M_a = s.M_right;
+      h[1].M_b = S_join_tree(k->M_right, cbh);
+      try
+      {
+        t.M_fork(h, 2);
+      }
+      catch(...)
+      {
+        for (int i = 0; i < 2; ++i)
+          if (h[i].M_split_done)
+            h[i].M_a = S_set_unsplit_task(h[i]);
+        t.M_a = S_set_rejoin(h[0].M_a, s.M_match, h[1].M_a);
+        throw;
+      }
+      t.M_split_done = true;
+    }
+
+    // A task that does not fork finishes in its first pass when there
+    // is no throw to undo.
+    void
+    M_set_split_leaf(Set_operation_task& t, __false_type)
+    { M_set_split(t.M_a, t.M_b, t.M_splits); }
+
+    void
+    M_set_split_leaf(Set_operation_task& t, __true_type)
+    {
+      t.M_matches = 0;
+      t.M_result = M_set_merge(t.M_op, t.M_a, t.M_b, t.M_matches);
+    }
+
+    void
+    M_set_finish_leaf(Set_operation_task& t, __false_type)
+    {
+      size_type i = 0;
+      t.M_matches = 0;
+      t.M_result = M_set_finish(t.M_op, t.M_a, t.M_b, t.M_splits, i,
+                                t.M_matches);
+    }
+
+    void
+    M_set_finish_leaf(Set_operation_task&, __true_type)
+    { }
+
+    static Join_tree
+    S_set_unsplit_task(Set_operation_task& t)
+    {
+      t.M_split_done = false;
+      if (!t.M_forked)
+      {
+        size_type i = 0;
+        return S_set_unsplit(t.M_a, t.M_b, t.M_splits, i);
+      }
+      Set_operation_task* const h = t.M_halves();
+      return S_set_rejoin(S_set_unsplit_task(h[0]), t.M_top.M_match,
+                          S_set_unsplit_task(h[1]));
+    }
+
+    void
+    M_set_finish_task(Set_operation_task& t)
+    {
+      if (!t.M_forked)
+      {
+        M_set_finish_leaf(t, Nothrow_compare());
+        return;
+      }
+      Set_operation_task* const h = t.M_halves();
+      h[0].M_finishing = true;
+      h[1].M_finishing = true;
+      t.M_fork(h, 2);
+      t.M_matches = h[0].M_matches + h[1].M_matches;
+      t.M_result = M_set_combine(t.M_op, h[0].M_result, t.M_b.M_root,
+                                 t.M_top.M_match, h[1].M_result,
+                                 t.M_matches);
+    }
+
+    // Against a much smaller x, union and difference relink or look up
+    // x's elements one by one: the splits would cost about as many
+    // levels each, and their joins also walk spines off the search
+    // paths.  As with the joins, a throwing comparison leaves both trees
+    // holding what they held.
+    void
+    M_set_union_small(Rb_tree& x)
+    {
+      const size_type n = x.size();
+      ft::vector<Link_type> nodes;
+      ft::vector<char> linked;
+      nodes.reserve(n);
+      linked.reserve(n);
+      for (iterator it = x.begin(); it != x.end(); ++it)
+        nodes.push_back(static_cast<Link_type>(it.M_node));
+      x.M_reset();
+      size_type i = 0;
+      try
+      {
+        for (; i < n; ++i)
+          linked.push_back(M_insert_node_unique(nodes[i]).second);
+      }
+      catch(...)
+      {
+        for (size_type j = 0; j < i; ++j)
+          if (linked[j])
+            M_extract(const_iterator(nodes[j]));
+        for (size_type j = 0; j < n; ++j)
+          x.M_link_before(x.M_end(), nodes[j]);
+        throw;
+      }
+      for (size_type j = 0; j < n; ++j)
+        if (!linked[j])
+          M_destroy_node(nodes[j]);
+    }
+
+    void
+    M_set_difference_small(Rb_tree& x)
+    {
+      ft::vector<iterator> found;
+      found.reserve(x.size());
+      for (const_iterator it = x.begin(); it != x.end(); ++it)
+      {
+        const iterator f = find(S_key(it.M_node));
+        if (f != end())
+          found.push_back(f);
+      }
+      for (size_type i = 0; i < found.size(); ++i)
+        erase(found[i]);
+      x.clear();
+    }
+
+    // Replaces this tree by (this op x), reusing the nodes of both
+    // trees; x is left empty.  The allocators must compare equal.  The
+    // top `forks' levels run their halves under fork.
+    void
+    M_set_operation(Set_operation op, Rb_tree& x, int forks,
+                    void (*fork)(Set_operation_task*, std::size_t))
+    {
+      const size_type n1 = size();
+      const size_type n2 = x.size();
+      if (n2 * S_join_cutoff < n1 && op == S_set_union)
+      {
+        M_set_union_small(x);
+        return;
+      }
+      if (n2 * S_join_cutoff < n1 && op == S_set_difference)
+      {
+        M_set_difference_small(x);
+        return;
+      }
+
+      Set_operation_task tasks[(2 << S_set_max_forks) - 1];
+      Set_operation_task& t = tasks[0];
+      t.M_tree = this;
+      t.M_fork = fork;
+      t.M_tasks = tasks;
+      t.M_index = 0;
+      t.M_op = op;
+      t.M_forks = forks;
+      t.M_a = S_join_tree(M_root(), S_black_height(M_root()));
+      t.M_b = S_join_tree(x.M_root(), S_black_height(x.M_root()));
+      t.M_finishing = false;
+      try
+      {
+        t.M_run();
+      }
+      catch(...)
+      {
+        M_set_root(t.M_a.M_root);
+        throw;
+      }
+      x.M_reset();
+      t.M_finishing = true;
+      t.M_run();
+
+      switch (op)
+      {
+        case S_set_union:
+          M_impl.M_node_count = n1 + n2 - t.M_matches;
+          break;
+        case S_set_intersection:
+          M_impl.M_node_count = t.M_matches;
+          break;
+        case S_set_difference:
+          M_impl.M_node_count = n1 - t.M_matches;
+          break;
+        default:
+          M_impl.M_node_count = n1 + n2 - 2 * t.M_matches;
+          break;
+      }
+      M_set_root(t.M_result.M_root);
+    }
+
+    // Makes root, a detached tree, this tree's, keeping the node count.
+    void
+    M_set_root(Base_ptr root)
+    {
+      M_root() = root;
+      if (root == 0)
+      {
+        M_leftmost() = M_end();
+        M_rightmost() = M_end();
+        return;
+      }
+      root->M_color = S_black;
+      root->M_parent = M_end();
+      M_leftmost() = S_minimum(root);
+      M_rightmost() = S_maximum(root);
+    }
+
+    // Empties the tree without freeing its nodes.
+    void
+    M_reset()
+    {
+      M_root() = 0;
+      M_leftmost() = M_end();
+      M_rightmost() = M_end();
+      M_impl.M_node_count = 0;
+    }
+
+    enum { S_join_cutoff = 8 };
+
+    static int
+    S_black_height(Const_Base_ptr x)
+    {
+      int bh = 0;
+      for (; x != 0; x = x->M_left)
+        bh += x->M_color == S_black;
+      return bh;
+    }
+
+  public:
+    // allocation/deallocation
+    Rb_tree()
+    { }
+
+    Rb_tree(const Compare& comp)
+    : M_impl(allocator_type(), comp)
     { }
 
     Rb_tree(const Compare& comp, const allocator_type& a)
     : M_impl(a, comp)
     { }
 
-    Rb_tree(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x)
+    Rb_tree(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& x)
     : M_impl(x.M_get_Node_allocator(), x.M_impl.M_key_compare)
     {
       if (x.M_root() != 0)
       {
         M_root() = M_copy(x.M_begin(), M_end());
         M_leftmost() = S_minimum(M_root());
-        M_rightmost() = S_minimum(M_root());
+        M_rightmost() = S_maximum(M_root());
         M_impl.M_node_count = x.M_impl.M_node_count;
       }
     }
 
+    Rb_tree(const Rb_tree& x, const parallel_policy& policy)
+    : M_impl(x.M_get_Node_allocator(), x.M_impl.M_key_compare)
+    { M_copy_from(x, policy); }
+
     ~Rb_tree()
     { M_erase(M_begin()); }
 
-    Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>&
-    operator=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x)
+    Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>&
+    operator=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& x)
     {
       if (this != &x)
       {
@@ -975,6 +2360,17 @@ class Rb_tree
       return *this;
     }
 
+    void
+    M_assign(const Rb_tree& x, const parallel_policy& policy)
+    {
+      if (this != &x)
+      {
+        clear(policy);
+        M_impl.M_key_compare = x.M_impl.M_key_compare;
+        M_copy_from(x, policy);
+      }
+    }
+
     // Accessors.
     Compare
     key_comp() const
@@ -1025,7 +2421,7 @@ class Rb_tree
     { return get_allocator().max_size(); }
 
     void
-    swap(Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& t)
+    swap(Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& t)
     {
       if (M_root() == 0)
       {
@@ -1326,24 +2722,103 @@ class Rb_tree
         M_insert_equal(end(), *first);      
     }
 
+    // Batch insertion.  The batch is sorted and then merged into the
+    // tree in key order: each element is located by M_bound_from
+    // starting at the node placed (or found) for the previous one, so a
+    // clustered batch costs O(log d) per element instead of a full
+    // descent from the root.  Among equivalent keys in the batch the
+    // first one wins, as with repeated M_insert_unique.
+    //
+    // Rebalancing is not deferred.  A run of k elements that all fall
+    // in one gap of the tree costs O(k) amortised here: each finger
+    // search is O(1) from the element before it, and insert-and-
+    // rebalance does amortised O(1) rotations.  Building the run as a
+    // subtree and joining it would still cost O(k + log n), and needs a
+    // split and join that keep the header and the NodeUpdate data
+    // right, for no better bound.
+    template<typename InputIterator>
     void
-    erase(iterator position)
+    M_insert_unique_batch(InputIterator first, InputIterator last)
     {
-      Link_type y = static_cast<Link_type>(Rb_tree_rebalance_for_erase(
-            position.M_node,
-            this->M_impl.M_header));
-      M_destroy_node(y);
-      --M_impl.M_node_count;
+      typedef typename iterator_traits<InputIterator>::value_type In;
+      M_insert_unique_batch(first, last,
+          typename Rb_tree_reads_key<KeyOfValue, value_type, In>::type(),
+          typename iterator_traits<InputIterator>::iterator_category());
     }
 
+    // A forward range is sorted where it lies, through iterators into it.
+    template<typename ForwardIterator>
     void
-    erase(const_iterator position)
+    M_insert_unique_batch(ForwardIterator first, ForwardIterator last,
+                          __true_type, std::forward_iterator_tag)
     {
-      Link_type y = static_cast<Link_type>(Rb_tree_rebalance_for_erase(
-            const_cast<Base_ptr>(position.M_node),
-            this->M_impl.M_header));
-      M_destroy_node(y);
-      --M_impl.M_node_count;
+      ft::vector<ForwardIterator> order;
+      order.reserve(std::distance(first, last));
+      for (; first != last; ++first)
+        order.push_back(first);
+      std::stable_sort(order.begin(), order.end(),
+          M_iterator_compare<ForwardIterator>(M_impl.M_key_compare));
+
+      Base_ptr finger = 0;
+      for (size_type i = 0; i < order.size(); ++i)
+      {
+        const key_type& k = KeyOfValue()(*order[i]);
+        Base_ptr pos = finger
+          ? const_cast<Base_ptr>(M_bound_from(finger, k, false))
+          : lower_bound(k).M_node;
+        if (pos != M_end() && !M_impl.M_key_compare(k, S_key(pos)))
+          finger = pos; // Equivalent key already present.
+        else
+          finger = M_insert_before(pos, *order[i]).M_node;
+      }
+    }
+
+    // An input range cannot be read twice, and elements whose key
+    // KeyOfValue cannot read in place would be converted on every
+    // comparison: such a batch is copied once.
+    template<typename InputIterator, typename ReadsKey>
+    void
+    M_insert_unique_batch(InputIterator first, InputIterator last,
+                          ReadsKey, std::input_iterator_tag)
+    {
+      ft::vector<value_type> batch(first, last);
+      M_insert_unique_batch(batch.begin(), batch.end(), __true_type(),
+                            std::forward_iterator_tag());
+    }
+
+    // Parallel bulk construction.
+    struct Build_task;
+
+    Base_ptr
+    M_build_sorted(const value_type* const* first, size_type n, int depth,
+                   int red_depth, int forks);
+
+    // Fills an empty tree.
+    template<typename InputIterator>
+    void
+    M_build_unique(InputIterator first, InputIterator last,
+                   const parallel_policy& policy);
+
+    void
+    erase(iterator position)
+    {
+      Link_type y = static_cast<Link_type>(Rb_tree_rebalance_for_erase(
+            position.M_node,
+            this->M_impl.M_header,
+            Node_updater()));
+      M_destroy_node(y);
+      --M_impl.M_node_count;
+    }
+
+    void
+    erase(const_iterator position)
+    {
+      Link_type y = static_cast<Link_type>(Rb_tree_rebalance_for_erase(
+            const_cast<Base_ptr>(position.M_node),
+            this->M_impl.M_header,
+            Node_updater()));
+      M_destroy_node(y);
+      --M_impl.M_node_count;
     }
 
     size_type
@@ -1396,78 +2871,542 @@ class Rb_tree
       M_impl.M_node_count = 0;
     }
 
+    void
+    clear(const parallel_policy& policy);
+
+    // Detaches the nodes and leaves freeing them to the reclaimer thread;
+    // frees them here if it cannot be had.
+    void
+    M_clear_in_background();
+
     // Set operations.
     iterator
     find(const key_type& k)
     {
-      Link_type x = M_begin(); // Current node.
-      Link_type y = M_end(); // Last node which is not less than k.
+      const Rb_tree* const_this = this;
+      return const_this->find(k).M_const_cast();
+    }
+    
+    const_iterator
+    find(const key_type& k) const
+    {
+      const_iterator j = lower_bound(k);
+      return j == end()
+        || M_impl.M_key_compare(k, S_key(j.M_node)) ? end() : j;
+    }
 
-      while (x != 0)
+    size_type
+    count(const key_type& k) const
+    {
+      pair<const_iterator, const_iterator> p = equal_range(k);
+      const size_type n = std::distance(p.first, p.second);
+      return n;
+    }
+
+    iterator
+    lower_bound(const key_type& k)
+    {
+      const Rb_tree* const_this = this;
+      return const_this->lower_bound(k).M_const_cast();
+    }
+
+    const_iterator
+    lower_bound(const key_type& k) const
+    {
+      return const_iterator(static_cast<Const_Link_type>(
+            M_lower_bound(k, Branchless_descent())));
+    }
+
+    iterator
+    upper_bound(const key_type& k)
+    {
+      const Rb_tree* const_this = this;
+      return const_this->upper_bound(k).M_const_cast();
+    }
+
+    const_iterator
+    upper_bound(const key_type& k) const
+    {
+      return const_iterator(static_cast<Const_Link_type>(
+            M_upper_bound(k, Branchless_descent())));
+    }
+
+    pair<iterator, iterator>
+    equal_range(const key_type& k)
+    { return pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
+
+    pair<const_iterator, const_iterator>
+    equal_range(const key_type& k) const
+    { return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k)); }
+
+    // Batched lookup.  Keys are taken S_lanes at a time and their
+    // descents advanced one level per round, so the cache misses of up
+    // to S_lanes searches are outstanding together instead of one after
+    // the other; each step prefetches the node its lane visits next.
+    // Writes, in input order, one Iterator per key: its lower bound, or
+    // with exact set, the element equal to it or end().
+    enum { S_lanes = 8 };
+
+    template <typename Iterator, typename InputIterator,
+              typename OutputIterator>
+    OutputIterator
+    M_lower_bound_many(InputIterator first, InputIterator last,
+                       OutputIterator out, bool exact) const
+    {
+      ft::vector<key_type> keys;
+      keys.reserve(S_lanes);
+      Const_Base_ptr x[S_lanes];
+      Const_Base_ptr y[S_lanes];
+      while (first != last)
       {
-        if (!M_impl.M_key_compare(S_key(x), k))
+        keys.clear();
+        for (; first != last && keys.size() < S_lanes; ++first)
+          keys.push_back(*first);
+        const size_type n = keys.size();
+        for (size_type i = 0; i < n; ++i)
         {
-          y = x;
-          x = S_left(x);
+          x[i] = M_root();
+          y[i] = M_end();
+        }
+        for (bool active = true; active; )
+        {
+          active = false;
+          for (size_type i = 0; i < n; ++i)
+          {
+            Const_Base_ptr c = x[i];
+            if (c == 0)
+              continue;
+            if (!M_impl.M_key_compare(S_key(c), keys[i]))
+            {
+              y[i] = c;
+              c = c->M_left;
+            }
+            else
+              c = c->M_right;
+            Rb_tree_prefetch(c);
+            x[i] = c;
+            active = active || c != 0;
+          }
+        }
+        for (size_type i = 0; i < n; ++i)
+        {
+          const_iterator j(static_cast<Const_Link_type>(y[i]));
+          if (exact && j != end()
+              && M_impl.M_key_compare(keys[i], S_key(j.M_node)))
+            j = end();
+          *out = Iterator(j.M_const_cast());
+          ++out;
         }
-        else
-          x = S_right(x);
       }
-      iterator j = iterator(y);
+      return out;
+    }
+
+    // Node extraction and reinsertion.  M_extract unlinks the node at
+    // pos without freeing it; the M_insert_node_unique overloads link a
+    // detached node, or return the equal element and leave z untouched.
+    // No element is ever copied or reallocated.
+    Link_type
+    M_extract(const_iterator pos)
+    {
+      Link_type z = static_cast<Link_type>(
+          Rb_tree_rebalance_for_erase(pos.M_const_cast().M_node,
+                                      M_impl.M_header, Node_updater()));
+      --M_impl.M_node_count;
+      return z;
+    }
+
+    pair<iterator, bool>
+    M_insert_node_unique(Link_type z)
+    {
+      pair<Base_ptr, Base_ptr> pos = M_get_insert_unique_pos(S_key(z));
+      if (pos.second == 0)
+        return pair<iterator, bool>(
+            iterator(static_cast<Link_type>(pos.first)), false);
+      return pair<iterator, bool>(M_link_at(pos.second, z), true);
+    }
+
+    pair<iterator, bool>
+    M_insert_node_unique(const_iterator hint, Link_type z)
+    {
+      Base_ptr pos = const_cast<Base_ptr>(
+          M_bound_from(hint.M_node, S_key(z), false));
+      if (pos != M_end() && !M_impl.M_key_compare(S_key(z), S_key(pos)))
+        return pair<iterator, bool>(iterator(static_cast<Link_type>(pos)),
+                                    false);
+      return pair<iterator, bool>(M_link_before(pos, z), true);
+    }
+
+    // Single-descent upsert for maps.  The tree is searched once for k;
+    // on a miss the node is built by M_create_node_piecewise and linked
+    // where the search ended, on a hit nothing at all is constructed.
+    // The hinted overload searches from hint with M_bound_from.
+    template <typename Construct>
+    pair<iterator, bool>
+    M_emplace_unique_key(const key_type& k, const Construct& make)
+    {
+      pair<Base_ptr, Base_ptr> pos = M_get_insert_unique_pos(k);
+      if (pos.second == 0)
+        return pair<iterator, bool>(
+            iterator(static_cast<Link_type>(pos.first)), false);
+      return pair<iterator, bool>(
+          M_link_at(pos.second, M_create_node_piecewise(k, make)), true);
+    }
+
+    template <typename Construct>
+    pair<iterator, bool>
+    M_emplace_unique_key(const_iterator hint, const key_type& k,
+                         const Construct& make)
+    {
+      Base_ptr pos = const_cast<Base_ptr>(M_bound_from(hint.M_node, k, false));
+      if (pos != M_end() && !M_impl.M_key_compare(k, S_key(pos)))
+        return pair<iterator, bool>(iterator(static_cast<Link_type>(pos)),
+                                    false);
+      return pair<iterator, bool>(
+          M_link_before(pos, M_create_node_piecewise(k, make)), true);
+    }
+
+    // Set algebra; see M_set_operation.
+    void
+    M_set_operation(Set_operation op, Rb_tree& x)
+    { M_set_operation(op, x, 0, 0); }
+
+    void
+    M_set_operation(Set_operation op, Rb_tree& x,
+                    const parallel_policy& policy);
+
+    void
+    M_set_union(Rb_tree& x)
+    { M_set_operation(S_set_union, x); }
+
+    void
+    M_set_intersection(Rb_tree& x)
+    { M_set_operation(S_set_intersection, x); }
+
+    void
+    M_set_difference(Rb_tree& x)
+    { M_set_operation(S_set_difference, x); }
+
+    void
+    M_set_symmetric_difference(Rb_tree& x)
+    { M_set_operation(S_set_symmetric_difference, x); }
+
+    void
+    M_set_union(Rb_tree& x, const parallel_policy& policy)
+    { M_set_operation(S_set_union, x, policy); }
+
+    void
+    M_set_intersection(Rb_tree& x, const parallel_policy& policy)
+    { M_set_operation(S_set_intersection, x, policy); }
+
+    void
+    M_set_difference(Rb_tree& x, const parallel_policy& policy)
+    { M_set_operation(S_set_difference, x, policy); }
+
+    void
+    M_set_symmetric_difference(Rb_tree& x, const parallel_policy& policy)
+    { M_set_operation(S_set_symmetric_difference, x, policy); }
+
+    // Sorted-batch lookup.  Each key is searched from the result of the
+    // previous one with M_bound_from, so ascending keys walk the tree
+    // once in order: m keys spread over n elements cost O(m log(n/m)).
+    // Any order gives the right answer, only the cost suffers.
+    template <typename Iterator, typename InputIterator,
+              typename OutputIterator>
+    OutputIterator
+    M_find_sorted(InputIterator first, InputIterator last,
+                  OutputIterator out) const
+    {
+      Const_Base_ptr finger = M_root() ? M_leftmost() : M_end();
+      for (; first != last; ++first)
+      {
+        const key_type& k = *first;
+        finger = M_bound_from(finger, k, false);
+        const_iterator j(static_cast<Const_Link_type>(finger));
+        if (j != end() && M_impl.M_key_compare(k, S_key(j.M_node)))
+          j = end();
+        *out = Iterator(j.M_const_cast());
+        ++out;
+      }
+      return out;
+    }
+
+    template <typename InputIterator>
+    size_type
+    M_count_sorted(InputIterator first, InputIterator last) const
+    {
+      Const_Base_ptr finger = M_root() ? M_leftmost() : M_end();
+      size_type n = 0;
+      for (; first != last; ++first)
+      {
+        const key_type& k = *first;
+        finger = M_bound_from(finger, k, false);
+        if (finger != M_end() && !M_impl.M_key_compare(k, S_key(finger)))
+          ++n;
+      }
+      return n;
+    }
+
+    // Hinted lookup.  Same results as the unhinted versions, but the
+    // search starts from hint (any valid iterator, end() included) and
+    // costs O(log d) where d is the distance between hint and the result.
+    iterator
+    lower_bound(iterator hint, const key_type& k)
+    {
+      return iterator(static_cast<Link_type>(
+            const_cast<Base_ptr>(M_bound_from(hint.M_node, k, false))));
+    }
+
+    const_iterator
+    lower_bound(const_iterator hint, const key_type& k) const
+    {
+      return const_iterator(static_cast<Const_Link_type>(
+            M_bound_from(hint.M_node, k, false)));
+    }
+
+    iterator
+    upper_bound(iterator hint, const key_type& k)
+    {
+      return iterator(static_cast<Link_type>(
+            const_cast<Base_ptr>(M_bound_from(hint.M_node, k, true))));
+    }
+
+    const_iterator
+    upper_bound(const_iterator hint, const key_type& k) const
+    {
+      return const_iterator(static_cast<Const_Link_type>(
+            M_bound_from(hint.M_node, k, true)));
+    }
+
+    iterator
+    find(iterator hint, const key_type& k)
+    {
+      iterator j = lower_bound(hint, k);
       return j == end()
         || M_impl.M_key_compare(k, S_key(j.M_node)) ? end() : j;
     }
-    
+
     const_iterator
-    find(const key_type& k) const
+    find(const_iterator hint, const key_type& k) const
     {
-      Const_Link_type x = M_begin(); // Current node.
-      Const_Link_type y = M_end(); // Last node which is not less than k.
+      const_iterator j = lower_bound(hint, k);
+      return j == end()
+        || M_impl.M_key_compare(k, S_key(j.M_node)) ? end() : j;
+    }
+
+    // Parallel traversal.
+    struct Traversal_piece;
+
+    template <typename Visitor>
+    struct Traversal_task;
+
+    template <typename Function, typename Ref>
+    struct For_each_visitor;
+
+    template <typename Tp, typename Fold>
+    struct Reduce_visitor;
+
+    static void
+    S_cut(Base_ptr x, int depth, ft::vector<Traversal_piece>& out);
+
+    std::size_t
+    M_cut(const parallel_policy& policy,
+          ft::vector<Traversal_piece>& pieces) const;
+
+    template <typename Visitor>
+    void
+    M_traverse_parallel(Visitor& v, const parallel_policy& policy,
+                        size_type& pieces_out) const;
+
+    // f(value_type&) on every element, from several threads at once;
+    // without a policy, on ft::par.
+    template <typename Function>
+    void
+    M_parallel_for_each(Function& f, const parallel_policy& policy);
+
+    template <typename Function>
+    void
+    M_parallel_for_each(Function& f, const parallel_policy& policy) const;
+
+    template <typename Function>
+    void
+    M_parallel_for_each(Function& f);
 
+    template <typename Function>
+    void
+    M_parallel_for_each(Function& f) const;
+
+    template <typename Tp, typename Fold, typename Combine>
+    Tp
+    M_parallel_reduce(const Tp& identity, Fold fold, Combine combine,
+                      const parallel_policy& policy) const;
+
+    template <typename Tp, typename Fold, typename Combine>
+    Tp
+    M_parallel_reduce(const Tp& identity, Fold fold, Combine combine) const;
+
+    // Order statistics, in O(log n).  Only usable with a NodeUpdate that
+    // keeps subtree sizes (Rb_tree_order_statistics_node_update); the
+    // members are never instantiated otherwise.
+    static size_type
+    S_subtree_size(Const_Base_ptr x)
+    { return NodeUpdate::template size<Rb_tree_node>(x); }
+
+    // The element at position k in key order, or end() if k >= size().
+    const_iterator
+    M_select(size_type k) const
+    {
+      Const_Base_ptr x = M_root();
       while (x != 0)
       {
-        if (!M_impl.M_key_compare(S_key(x), k))
+        const size_type left = S_subtree_size(x->M_left);
+        if (k < left)
+          x = x->M_left;
+        else if (k == left)
+          return const_iterator(static_cast<Const_Link_type>(x));
+        else
         {
-          y = x;
-          x = S_left(x);
+          k -= left + 1;
+          x = x->M_right;
         }
-        else
-          x = S_right(x);
       }
-      const_iterator j = const_iterator(y);
-      return j == end()
-        || M_impl.M_key_compare(k, S_key(j.M_node)) ? end() : j;
+      return end();
+    }
+
+    iterator
+    M_select(size_type k)
+    {
+      const Rb_tree* const_this = this;
+      return const_this->M_select(k).M_const_cast();
     }
 
+    // The number of elements that compare less than k.
     size_type
-    count(const key_type& k) const
+    M_rank(const key_type& k) const
     {
-      pair<const_iterator, const_iterator> p = equal_range(k);
-      const size_type n = std::distance(p.first, p.second);
-      return n;
+      Const_Base_ptr x = M_root();
+      size_type r = 0;
+      while (x != 0)
+      {
+        if (M_impl.M_key_compare(S_key(x), k))
+        {
+          r += S_subtree_size(x->M_left) + 1;
+          x = x->M_right;
+        }
+        else
+          x = x->M_left;
+      }
+      return r;
     }
 
-    iterator
-    lower_bound(const key_type& k)
+    // The position of it in key order; size() for end().
+    size_type
+    M_index(const_iterator it) const
     {
-      Link_type x = M_begin(); // Current node.
-      Link_type y = M_end(); // Last node which is not less than k.
+      Const_Base_ptr x = it.M_node;
+      if (x == M_end())
+        return size();
+      size_type r = S_subtree_size(x->M_left);
+      while (x != M_root())
+      {
+        Const_Base_ptr p = x->M_parent;
+        if (x == p->M_right)
+          r += S_subtree_size(p->M_left) + 1;
+        x = p;
+      }
+      return r;
+    }
 
+    // Range aggregates, in O(log n).  Only usable with
+    // Rb_tree_aggregate_node_update.  The fold over [lo, hi) is the
+    // combination of the left and right spines below the node where the
+    // searches for lo and hi part.
+    aggregate_type
+    M_accumulate(const key_type& lo, const key_type& hi) const
+    {
+      Const_Base_ptr x = M_root();
       while (x != 0)
       {
-        if (!M_impl.M_key_compare(S_key(x), k))
+        if (M_impl.M_key_compare(S_key(x), lo))
+          x = x->M_right;
+        else if (!M_impl.M_key_compare(S_key(x), hi))
+          x = x->M_left;
+        else
+          break;
+      }
+      if (x == 0)
+        return NodeUpdate::identity();
+
+      aggregate_type left = NodeUpdate::identity();
+      for (Const_Base_ptr y = x->M_left; y != 0; )
+      {
+        if (M_impl.M_key_compare(S_key(y), lo))
+          y = y->M_right;
+        else
         {
-          y = x;
-          x = S_left(x);
+          left = NodeUpdate::combine(
+              NodeUpdate::combine(NodeUpdate::lift(S_value(y)),
+                                  S_aggregate(y->M_right)), left);
+          y = y->M_left;
+        }
+      }
+      aggregate_type right = NodeUpdate::identity();
+      for (Const_Base_ptr y = x->M_right; y != 0; )
+      {
+        if (M_impl.M_key_compare(S_key(y), hi))
+        {
+          right = NodeUpdate::combine(right,
+              NodeUpdate::combine(S_aggregate(y->M_left),
+                                  NodeUpdate::lift(S_value(y))));
+          y = y->M_right;
         }
         else
-          x = S_right(x);
+          y = y->M_left;
       }
-      return iterator(y);
+      return NodeUpdate::combine(
+          NodeUpdate::combine(left, NodeUpdate::lift(S_value(x))), right);
     }
 
+    static aggregate_type
+    S_aggregate(Const_Base_ptr x)
+    { return NodeUpdate::template aggregate<Rb_tree_node>(x); }
+
+    // Recomputes the node data on the path from pos to the root, after
+    // the part of *pos that a policy reads has been changed in place.
+    void
+    M_refresh(iterator pos)
+    { Rb_tree_update_to_root(pos.M_node, &M_impl.M_header, Node_updater()); }
+
+    // Heterogeneous lookup.  The caller guarantees that Compare is able to
+    // order Kt against key_type, so no temporary key_type is built.
+    template <typename Kt>
     const_iterator
-    lower_bound(const key_type& k) const
+    M_find_tr(const Kt& k) const
+    {
+      const_iterator j = M_lower_bound_tr(k);
+      if (j != end() && M_impl.M_key_compare(k, S_key(j.M_node)))
+        j = end();
+      return j;
+    }
+
+    template <typename Kt>
+    iterator
+    M_find_tr(const Kt& k)
+    {
+      const Rb_tree* const_this = this;
+      return const_this->M_find_tr(k).M_const_cast();
+    }
+
+    template <typename Kt>
+    size_type
+    M_count_tr(const Kt& k) const
+    {
+      pair<const_iterator, const_iterator> p = M_equal_range_tr(k);
+      return std::distance(p.first, p.second);
+    }
+
+    template <typename Kt>
+    const_iterator
+    M_lower_bound_tr(const Kt& k) const
     {
       Const_Link_type x = M_begin(); // Current node.
       Const_Link_type y = M_end(); // Last node which is not less than k.
@@ -1485,27 +3424,17 @@ class Rb_tree
       return const_iterator(y);
     }
 
+    template <typename Kt>
     iterator
-    upper_bound(const key_type& k)
+    M_lower_bound_tr(const Kt& k)
     {
-      Link_type x = M_begin(); // Current node.
-      Link_type y = M_end(); // Last node which is greater than k.
-
-      while (x != 0)
-      {
-        if (M_impl.M_key_compare(k, S_key(x)))
-        {
-          y = x,
-          x = S_left(x);
-        }
-        else
-          x = S_right(x);
-      }
-      return iterator(y);
+      const Rb_tree* const_this = this;
+      return const_this->M_lower_bound_tr(k).M_const_cast();
     }
 
+    template <typename Kt>
     const_iterator
-    upper_bound(const key_type& k) const
+    M_upper_bound_tr(const Kt& k) const
     {
       Const_Link_type x = M_begin(); // Current node.
       Const_Link_type y = M_end(); // Last node which is greater than k.
@@ -1514,7 +3443,7 @@ class Rb_tree
       {
         if (M_impl.M_key_compare(k, S_key(x)))
         {
-          y = x,
+          y = x;
           x = S_left(x);
         }
         else
@@ -1523,77 +3452,252 @@ class Rb_tree
       return const_iterator(y);
     }
 
-    pair<iterator, iterator>
-    equal_range(const key_type& k)
-    { return pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
+    template <typename Kt>
+    iterator
+    M_upper_bound_tr(const Kt& k)
+    {
+      const Rb_tree* const_this = this;
+      return const_this->M_upper_bound_tr(k).M_const_cast();
+    }
 
+    template <typename Kt>
     pair<const_iterator, const_iterator>
-    equal_range(const key_type& k) const
-    { return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k)); }
+    M_equal_range_tr(const Kt& k) const
+    {
+      return pair<const_iterator, const_iterator>(M_lower_bound_tr(k),
+                                                  M_upper_bound_tr(k));
+    }
+
+    template <typename Kt>
+    pair<iterator, iterator>
+    M_equal_range_tr(const Kt& k)
+    {
+      const Rb_tree* const_this = this;
+      pair<const_iterator, const_iterator> r = const_this->M_equal_range_tr(k);
+      return pair<iterator, iterator>(r.first.M_const_cast(),
+                                      r.second.M_const_cast());
+    }
+};
+
+/**
+ *  @brief  Owner of a node extracted from a tree of type @a Tree.
+ *
+ *  A handle is empty or holds exactly one unlinked node, which it frees
+ *  when destroyed.  Without rvalue references a handle is transferred
+ *  the way std::auto_ptr is: copying or assigning one moves the node
+ *  and leaves the source empty.  With C++11 a handle is move-only, as
+ *  std::map's is.
+ */
+template <typename Tree>
+class Rb_tree_node_handle
+{
+public:
+  typedef typename Tree::value_type           value_type;
+  typedef typename Tree::allocator_type       allocator_type;
+
+protected:
+  typedef typename Tree::Link_type            Link_type;
+  typedef typename Tree::Node_allocator       Node_allocator;
+
+public:
+  Rb_tree_node_handle()
+  : M_node(0), M_alloc() { }
+
+  Rb_tree_node_handle(Link_type p, const Node_allocator& a)
+  : M_node(p), M_alloc(a) { }
+
+#if __cplusplus >= 201103L
+  Rb_tree_node_handle(const Rb_tree_node_handle&) = delete;
+
+  Rb_tree_node_handle&
+  operator=(const Rb_tree_node_handle&) = delete;
+
+  Rb_tree_node_handle(Rb_tree_node_handle&& x)
+  : M_node(x.M_release()), M_alloc(x.M_alloc) { }
+
+  Rb_tree_node_handle&
+  operator=(Rb_tree_node_handle&& x)
+  {
+    M_take(x);
+    return *this;
+  }
+#else
+  Rb_tree_node_handle(const Rb_tree_node_handle& x)
+  : M_node(x.M_release()), M_alloc(x.M_alloc) { }
+
+  Rb_tree_node_handle&
+  operator=(const Rb_tree_node_handle& x)
+  {
+    M_take(x);
+    return *this;
+  }
+#endif
+
+  ~Rb_tree_node_handle()
+  { M_reset(); }
+
+  /// True if the handle owns no node.
+  bool
+  empty() const
+  { return M_node == 0; }
+
+  allocator_type
+  get_allocator() const
+  { return allocator_type(M_alloc); }
+
+  /// The element held; the handle must not be empty.
+  value_type&
+  value() const
+  { return M_node->M_value_field; }
+
+  void
+  swap(Rb_tree_node_handle& x)
+  {
+    std::swap(M_node, x.M_node);
+    std::swap(M_alloc, x.M_alloc);
+  }
+
+  // The node owned, if any.
+  Link_type
+  M_get() const
+  { return M_node; }
+
+  // Gives up ownership of the node, leaving the handle empty.
+  Link_type
+  M_release() const
+  {
+    Link_type p = M_node;
+    M_node = 0;
+    return p;
+  }
+
+protected:
+  void
+  M_reset()
+  {
+    if (M_node != 0)
+      Tree::S_destroy_node(M_alloc, M_node);
+    M_node = 0;
+  }
+
+  // Frees the node owned, if any, and takes over that of x.
+  void
+  M_take(const Rb_tree_node_handle& x)
+  {
+    if (&x != this)
+    {
+      M_reset();
+      M_alloc = x.M_alloc;
+      M_node = x.M_release();
+    }
+  }
+
+  mutable Link_type       M_node;
+  mutable Node_allocator  M_alloc;
+};
+
+/// Node handle of a map: the key may be changed before reinsertion.
+template <typename Tree>
+class Rb_tree_map_node_handle : public Rb_tree_node_handle<Tree>
+{
+  typedef Rb_tree_node_handle<Tree>                       Base;
+  typedef typename Base::Link_type                        Link_type;
+  typedef typename Base::Node_allocator                   Node_allocator;
+
+public:
+  typedef typename Tree::key_type                         key_type;
+  typedef typename Base::value_type::second_type          mapped_type;
+
+  Rb_tree_map_node_handle()
+  : Base() { }
+
+  Rb_tree_map_node_handle(Link_type p, const Node_allocator& a)
+  : Base(p, a) { }
+
+  key_type&
+  key() const
+  { return const_cast<key_type&>(this->M_node->M_value_field.first); }
+
+  mapped_type&
+  mapped() const
+  { return this->M_node->M_value_field.second; }
+};
+
+/// Result of inserting a node handle into a unique-key container.
+template <typename Iterator, typename NodeHandle>
+struct Rb_tree_insert_return
+{
+  Iterator    position;
+  bool        inserted;
+  NodeHandle  node;
 };
 
 template <typename Key, typename Val, typename KeyOfValue,
-          typename Compare, typename Alloc>
+          typename Compare, typename Alloc, typename NodeUpdate>
 bool
-operator==(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y)
+operator==(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& x,
+          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& y)
 {
   return x.size() == y.size()
       && ft::equal(x.begin(), x.end(), y.begin());
 }
 
 template <typename Key, typename Val, typename KeyOfValue,
-          typename Compare, typename Alloc>
+          typename Compare, typename Alloc, typename NodeUpdate>
 bool
-operator<(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y)
+operator<(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& x,
+          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& y)
 {
   return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 
 template <typename Key, typename Val, typename KeyOfValue,
-          typename Compare, typename Alloc>
+          typename Compare, typename Alloc, typename NodeUpdate>
 bool
-operator!=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y)
+operator!=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& x,
+          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& y)
 {
   return !(x == y);
 }
 
 template <typename Key, typename Val, typename KeyOfValue,
-          typename Compare, typename Alloc>
+          typename Compare, typename Alloc, typename NodeUpdate>
 bool
-operator>(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y)
+operator>(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& x,
+          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& y)
 {
   return y < x;
 }
 
 template <typename Key, typename Val, typename KeyOfValue,
-          typename Compare, typename Alloc>
+          typename Compare, typename Alloc, typename NodeUpdate>
 bool
-operator<=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y)
+operator<=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& x,
+          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& y)
 {
   return !(y < x);
 }
 
 template <typename Key, typename Val, typename KeyOfValue,
-          typename Compare, typename Alloc>
+          typename Compare, typename Alloc, typename NodeUpdate>
 bool
-operator>=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y)
+operator>=(const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& x,
+          const Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& y)
 {
   return !(x < y);
 }
 
 template <typename Key, typename Val, typename KeyOfValue,
-          typename Compare, typename Alloc>
+          typename Compare, typename Alloc, typename NodeUpdate>
 void
-swap(Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& x,
-    Rb_tree<Key, Val, KeyOfValue, Compare, Alloc>& y)
+swap(Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& x,
+    Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>& y)
 { x.swap(y); }
 
 
 } // ft
-#endif // STL_TREE_H_
\ No newline at end of file
+#ifdef STL_PARALLEL_H_
+# include "stl_tree_parallel.h"
+#endif
+
+#endif // STL_TREE_H_
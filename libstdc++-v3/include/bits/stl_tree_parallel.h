@@ -0,0 +1,579 @@
+// RB tree parallel operations -*- C++ -*-
+
+/** @file stl_tree_parallel.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+// The members of Rb_tree that run on the thread pool: the ft::par
+// overloads, the parallel set algebra and M_clear_in_background.
+// stl_tree.h only declares them, so that the serial uses of map and set
+// do not pull in the pool.  Whichever of stl_tree.h and stl_parallel.h
+// is included second includes this header too.
+
+#ifndef STL_TREE_PARALLEL_H_
+#define STL_TREE_PARALLEL_H_
+
+#include "stl_tree.h"
+#include "stl_vector.h"
+#include "stl_parallel.h"
+
+namespace ft {
+
+// Parallel copy and erase.  Down to depth `forks' each node hands its
+// two subtrees to Parallel_run; the tree being balanced, a subtree at
+// depth d holds about n / 2^d nodes.  Below, M_copy and M_erase run as
+// usual.  Nodes are allocated and freed from several threads at once,
+// which the allocator must support.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+int
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+S_parallel_forks(size_type n, std::size_t threads)
+{
+  // Some 16K nodes a task at least.
+  int forks = 0;
+  while ((std::size_t(1) << forks) < threads && (n >> (forks + 14)) > 0)
+    ++forks;
+  return forks;
+}
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+struct Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::Copy_task
+{
+  Rb_tree*         M_tree;
+  Const_Link_type  M_src;
+  Link_type        M_parent;
+  int              M_forks;
+  Link_type        M_result;
+
+  void
+  M_run()
+  {
+    M_result = 0;
+    if (M_src != 0)
+      M_result = M_tree->M_copy_parallel(M_src, M_parent, M_forks);
+  }
+};
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+typename Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::Link_type
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_copy_parallel(Const_Link_type x, Link_type p, int forks)
+{
+  if (forks <= 0)
+    return M_copy(x, p);
+  Link_type top = M_clone_node(x);
+  top->M_parent = p;
+  Copy_task halves[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    halves[i].M_tree = this;
+    halves[i].M_parent = top;
+    halves[i].M_forks = forks - 1;
+    halves[i].M_result = 0;
+  }
+  halves[0].M_src = S_left(x);
+  halves[1].M_src = S_right(x);
+  try
+  {
+    Parallel_run(halves, 2);
+  }
+  catch(...)
+  {
+    M_erase(halves[0].M_result);
+    M_erase(halves[1].M_result);
+    M_destroy_node(top);
+    throw;
+  }
+  top->M_left = halves[0].M_result;
+  top->M_right = halves[1].M_result;
+  return top;
+}
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+struct Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::Erase_task
+{
+  Rb_tree*   M_tree;
+  Link_type  M_root;
+  int        M_forks;
+
+  void
+  M_run()
+  { M_tree->M_erase_parallel(M_root, M_forks); }
+};
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_erase_parallel(Link_type x, int forks)
+{
+  if (forks <= 0 || x == 0)
+  {
+    M_erase(x);
+    return;
+  }
+  Erase_task halves[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    halves[i].M_tree = this;
+    halves[i].M_forks = forks - 1;
+  }
+  halves[0].M_root = S_left(x);
+  halves[1].M_root = S_right(x);
+  Parallel_run(halves, 2);
+  M_destroy_node(x);
+}
+
+// Copies x into this empty tree.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_copy_from(const Rb_tree& x, const parallel_policy& policy)
+{
+  if (x.M_root() != 0)
+  {
+    const int forks = S_parallel_forks(x.size(), Parallel_threads(policy));
+    M_root() = M_copy_parallel(x.M_begin(), M_end(), forks);
+    M_leftmost() = S_minimum(M_root());
+    M_rightmost() = S_maximum(M_root());
+    M_impl.M_node_count = x.M_impl.M_node_count;
+  }
+}
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+clear(const parallel_policy& policy)
+{
+  const int forks = S_parallel_forks(size(), Parallel_threads(policy));
+  M_erase_parallel(M_begin(), forks);
+  M_leftmost() = M_end();
+  M_root() = 0;
+  M_rightmost() = M_end();
+  M_impl.M_node_count = 0;
+}
+
+// A detached tree waiting for the reclaimer thread.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+struct Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::Reclaim_job
+: public Parallel_reclaimer::Job
+{
+  Node_allocator  M_alloc;
+  Link_type       M_root;
+
+  Reclaim_job(const Node_allocator& a, Link_type root)
+  : M_alloc(a), M_root(root)
+  { this->M_run = &S_run; }
+
+  static void
+  S_run(Parallel_reclaimer::Job* j)
+  {
+    Reclaim_job* r = static_cast<Reclaim_job*>(j);
+    S_erase(r->M_alloc, r->M_root);
+    delete r;
+  }
+};
+
+// Detaches the nodes and leaves freeing them to the reclaimer thread;
+// frees them here if it cannot be had.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_clear_in_background()
+{
+  if (M_root() == 0)
+    return;
+  Reclaim_job* job = new(std::nothrow) Reclaim_job(M_get_Node_allocator(),
+                                                   M_begin());
+  if (job == 0)
+  {
+    clear();
+    return;
+  }
+  M_leftmost() = M_end();
+  M_root() = 0;
+  M_rightmost() = M_end();
+  M_impl.M_node_count = 0;
+  Parallel_reclaimer::S_submit(job);
+}
+
+// The set algebra of M_set_operation with its top levels forked, when
+// there is enough work to share.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_set_operation(Set_operation op, Rb_tree& x, const parallel_policy& policy)
+{
+  const std::size_t threads = Parallel_threads(policy);
+  int forks = 0;
+  for (size_type w = (size() + x.size()) >> 14;
+       w > 1 && forks < S_set_max_forks
+       && (std::size_t(1) << forks) < threads; w >>= 2)
+    ++forks;
+  M_set_operation(op, x, forks, &Parallel_run<Set_operation_task>);
+}
+
+// Parallel bulk construction.  The range is copied, sorted (stably, on
+// several threads) through an array of pointers and deduplicated, the
+// first of equivalent elements winning; the tree is then built directly
+// from the sorted array, each node being the median of its range.
+// Sibling subtrees near the root are built on separate threads and
+// linked once both are done.  The median split leaves every null link
+// within one level of the deepest one, so colouring the deepest level
+// red and all others black balances the tree with no rotation.  Nodes
+// are allocated from several threads at once, which the allocator must
+// support.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+struct Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::Build_task
+{
+  Rb_tree*                  M_tree;
+  const value_type* const*  M_first;
+  size_type                 M_n;
+  int                       M_depth;
+  int                       M_red_depth;
+  int                       M_forks;
+  Base_ptr                  M_result;
+
+  void
+  M_run()
+  {
+    M_result = 0;
+    M_result = M_tree->M_build_sorted(M_first, M_n, M_depth,
+                                      M_red_depth, M_forks);
+  }
+};
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+typename Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::Base_ptr
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_build_sorted(const value_type* const* first, size_type n, int depth,
+               int red_depth, int forks)
+{
+  if (n == 0)
+    return 0;
+  const size_type mid = n / 2;
+  Link_type k = M_create_node(*first[mid]);
+  Build_task halves[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    halves[i].M_tree = this;
+    halves[i].M_depth = depth + 1;
+    halves[i].M_red_depth = red_depth;
+    halves[i].M_forks = forks - 1;
+    halves[i].M_result = 0;
+  }
+  halves[0].M_first = first;
+  halves[0].M_n = mid;
+  halves[1].M_first = first + mid + 1;
+  halves[1].M_n = n - mid - 1;
+  try
+  {
+    if (forks > 0)
+      Parallel_run(halves, 2);
+    else
+    {
+      halves[0].M_run();
+      halves[1].M_run();
+    }
+  }
+  catch(...)
+  {
+    M_erase(static_cast<Link_type>(halves[0].M_result));
+    M_erase(static_cast<Link_type>(halves[1].M_result));
+    M_destroy_node(k);
+    throw;
+  }
+  return S_link(halves[0].M_result, k,
+                depth == red_depth ? S_red : S_black,
+                halves[1].M_result);
+}
+
+// Fills an empty tree.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename InputIterator>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_build_unique(InputIterator first, InputIterator last,
+               const parallel_policy& policy)
+{
+  ft::vector<value_type> values(first, last);
+  if (values.empty())
+    return;
+  const std::size_t threads = Parallel_threads(policy);
+
+  ft::vector<const value_type*> order;
+  order.reserve(values.size());
+  for (size_type i = 0; i < values.size(); ++i)
+    order.push_back(&values[i]);
+  ft::vector<const value_type*> buffer(order.size());
+  Parallel_stable_sort(&order[0], &order[0] + order.size(), &buffer[0],
+                       M_value_ptr_compare(M_impl.M_key_compare),
+                       threads);
+
+  size_type n = 1;
+  for (size_type i = 1; i < order.size(); ++i)
+    if (M_impl.M_key_compare(KeyOfValue()(*order[n - 1]),
+                             KeyOfValue()(*order[i])))
+      order[n++] = order[i];
+
+  const int forks = S_parallel_forks(n, threads);
+  int red_depth = 0;
+  for (size_type m = n; m > 1; m >>= 1)
+    ++red_depth;
+
+  Base_ptr root = M_build_sorted(&order[0], n, 0, red_depth, forks);
+  root->M_color = S_black;
+  root->M_parent = M_end();
+  M_root() = root;
+  M_leftmost() = S_minimum(root);
+  M_rightmost() = S_maximum(root);
+  M_impl.M_node_count = n;
+}
+
+// Parallel traversal.  The tree is cut top-down, to a depth chosen from
+// the thread count and the size, into the subtrees hanging at that
+// depth and the single nodes above them, listed in key order; no
+// iterator range is built.  Workers claim pieces one at a time and walk
+// each from its minimum to its maximum, and the visitor is told which
+// piece each element belongs to.  No element is visited twice, even
+// when the visitor throws.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+struct Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+Traversal_piece
+{
+  Base_ptr  M_node;
+  bool      M_subtree;
+};
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+S_cut(Base_ptr x, int depth, ft::vector<Traversal_piece>& out)
+{
+  if (x == 0)
+    return;
+  Traversal_piece p;
+  p.M_node = x;
+  p.M_subtree = depth == 0;
+  if (p.M_subtree)
+  {
+    out.push_back(p);
+    return;
+  }
+  S_cut(x->M_left, depth - 1, out);
+  out.push_back(p);
+  S_cut(x->M_right, depth - 1, out);
+}
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Visitor>
+struct Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+Traversal_task
+{
+  const ft::vector<Traversal_piece>*  M_pieces;
+  volatile size_type*                 M_next;
+  Visitor*                            M_visitor;
+  size_type                           M_piece;
+  Base_ptr                            M_at;
+  Base_ptr                            M_last;
+
+  void
+  M_run()
+  {
+    for (;;)
+    {
+      if (M_at == 0)
+      {
+        M_piece = __sync_fetch_and_add(M_next, size_type(1));
+        if (M_piece >= M_pieces->size())
+          return;
+        const Traversal_piece& p = (*M_pieces)[M_piece];
+        M_at = p.M_subtree ? S_minimum(p.M_node) : p.M_node;
+        M_last = p.M_subtree ? S_maximum(p.M_node) : p.M_node;
+      }
+      for (;;)
+      {
+        (*M_visitor)(M_piece, static_cast<Link_type>(M_at)->M_value_field);
+        if (M_at == M_last)
+          break;
+        M_at = Rb_tree_increment(M_at);
+      }
+      M_at = 0;
+    }
+  }
+};
+
+// Cuts the tree for traversal; returns the number of workers.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+std::size_t
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_cut(const parallel_policy& policy,
+      ft::vector<Traversal_piece>& pieces) const
+{
+  const std::size_t threads = Parallel_threads(policy);
+  // Some four pieces a worker, of 4K nodes at least.
+  int depth = 0;
+  while ((std::size_t(1) << depth) < 4 * threads
+         && (size() >> (depth + 12)) > 0)
+    ++depth;
+  S_cut(const_cast<Base_ptr>(M_impl.M_header.M_parent), depth, pieces);
+  return std::min<std::size_t>(threads, pieces.size());
+}
+
+// Calls v(piece, value) for every element.  v is shared by the workers;
+// elements of a piece are visited in order by one worker.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Visitor>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_traverse_parallel(Visitor& v, const parallel_policy& policy,
+                    size_type& pieces_out) const
+{
+  ft::vector<Traversal_piece> pieces;
+  const std::size_t workers = M_cut(policy, pieces);
+  pieces_out = pieces.size();
+  v.M_start(pieces.size());
+  if (workers == 0)
+    return;
+  volatile size_type next = 0;
+  Traversal_task<Visitor> tasks[S_parallel_max_threads];
+  for (std::size_t i = 0; i < workers; ++i)
+  {
+    tasks[i].M_pieces = &pieces;
+    tasks[i].M_next = &next;
+    tasks[i].M_visitor = &v;
+    tasks[i].M_at = 0;
+  }
+  Parallel_run(tasks, workers);
+}
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Function, typename Ref>
+struct Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+For_each_visitor
+{
+  Function* M_f;
+
+  void
+  M_start(size_type) { }
+
+  void
+  operator()(size_type, Ref v)
+  { (*M_f)(v); }
+};
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Tp, typename Fold>
+struct Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+Reduce_visitor
+{
+  ft::vector<Tp>*  M_results;
+  const Tp*        M_identity;
+  Fold*            M_fold;
+
+  void
+  M_start(size_type n)
+  { M_results->assign(n, *M_identity); }
+
+  void
+  operator()(size_type piece, const value_type& v)
+  { (*M_results)[piece] = (*M_fold)((*M_results)[piece], v); }
+};
+
+// f(value_type&) on every element, from several threads at once.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Function>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_parallel_for_each(Function& f, const parallel_policy& policy)
+{
+  For_each_visitor<Function, value_type&> v;
+  v.M_f = &f;
+  size_type pieces;
+  M_traverse_parallel(v, policy, pieces);
+}
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Function>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_parallel_for_each(Function& f, const parallel_policy& policy) const
+{
+  For_each_visitor<Function, const value_type&> v;
+  v.M_f = &f;
+  size_type pieces;
+  M_traverse_parallel(v, policy, pieces);
+}
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Function>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_parallel_for_each(Function& f)
+{ M_parallel_for_each(f, par); }
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Function>
+void
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_parallel_for_each(Function& f) const
+{ M_parallel_for_each(f, par); }
+
+// Folds each piece from identity, then combines the pieces in key
+// order; combine must be associative with identity as its identity.
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Tp, typename Fold, typename Combine>
+Tp
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_parallel_reduce(const Tp& identity, Fold fold, Combine combine,
+                  const parallel_policy& policy) const
+{
+  ft::vector<Tp> results;
+  Reduce_visitor<Tp, Fold> v;
+  v.M_results = &results;
+  v.M_identity = &identity;
+  v.M_fold = &fold;
+  size_type pieces;
+  M_traverse_parallel(v, policy, pieces);
+  Tp result = identity;
+  for (size_type i = 0; i < pieces; ++i)
+    result = combine(result, results[i]);
+  return result;
+}
+
+template <typename Key, typename Val, typename KeyOfValue,
+          typename Compare, typename Alloc, typename NodeUpdate>
+template <typename Tp, typename Fold, typename Combine>
+Tp
+Rb_tree<Key, Val, KeyOfValue, Compare, Alloc, NodeUpdate>::
+M_parallel_reduce(const Tp& identity, Fold fold, Combine combine) const
+{ return M_parallel_reduce(identity, fold, combine, par); }
+
+} // ft
+
+#endif // STL_TREE_PARALLEL_H_
@@ -49,6 +49,7 @@ template <>
 struct is_integral<wchar_t>
 : public integral_constant<wchar_t, true> { };
 
+#if __cplusplus >= 201103L
 template <>
 struct is_integral<char16_t>
 : public integral_constant<char16_t, true> { };
@@ -56,6 +57,7 @@ struct is_integral<char16_t>
 template <>
 struct is_integral<char32_t>
 : public integral_constant<char32_t, true> { };
+#endif
 
 template <>
 struct is_integral<short>
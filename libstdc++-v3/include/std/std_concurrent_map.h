@@ -0,0 +1,7 @@
+#ifndef STD_CONCURRENT_MAP_H_
+#define STD_CONCURRENT_MAP_H_
+
+
+#include "../bits/stl_concurrent_map.h"
+
+#endif // STD_CONCURRENT_MAP_H_
\ No newline at end of file
@@ -0,0 +1,7 @@
+#ifndef STD_CONCURRENT_SKIPLIST_MAP_H_
+#define STD_CONCURRENT_SKIPLIST_MAP_H_
+
+
+#include "../bits/stl_concurrent_skiplist_map.h"
+
+#endif // STD_CONCURRENT_SKIPLIST_MAP_H_
\ No newline at end of file
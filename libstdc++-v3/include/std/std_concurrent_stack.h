@@ -0,0 +1,7 @@
+#ifndef STD_CONCURRENT_STACK_H_
+#define STD_CONCURRENT_STACK_H_
+
+
+#include "../bits/stl_concurrent_stack.h"
+
+#endif // STD_CONCURRENT_STACK_H_
\ No newline at end of file
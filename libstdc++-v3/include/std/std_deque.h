@@ -0,0 +1,7 @@
+#ifndef STD_DEQUE_H_
+#define STD_DEQUE_H_
+
+
+#include "../bits/stl_deque.h"
+
+#endif // STD_DEQUE_H_
\ No newline at end of file
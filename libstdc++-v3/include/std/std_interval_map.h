@@ -0,0 +1,7 @@
+#ifndef STD_INTERVAL_MAP_H_
+#define STD_INTERVAL_MAP_H_
+
+
+#include "../bits/stl_interval_map.h"
+
+#endif // STD_INTERVAL_MAP_H_
\ No newline at end of file
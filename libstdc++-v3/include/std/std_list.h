@@ -0,0 +1,7 @@
+#ifndef STD_LIST_H_
+#define STD_LIST_H_
+
+
+#include "../bits/stl_list.h"
+
+#endif // STD_LIST_H_
\ No newline at end of file
@@ -0,0 +1,7 @@
+#ifndef STD_PARALLEL_H_
+#define STD_PARALLEL_H_
+
+
+#include "../bits/stl_parallel.h"
+
+#endif // STD_PARALLEL_H_
\ No newline at end of file
@@ -0,0 +1,7 @@
+#ifndef STD_PARALLEL_ALGORITHM_H_
+#define STD_PARALLEL_ALGORITHM_H_
+
+
+#include "../bits/stl_parallel_algo.h"
+
+#endif // STD_PARALLEL_ALGORITHM_H_
\ No newline at end of file
@@ -0,0 +1,7 @@
+#ifndef STD_PERSISTENT_MAP_H_
+#define STD_PERSISTENT_MAP_H_
+
+
+#include "../bits/stl_persistent_map.h"
+
+#endif // STD_PERSISTENT_MAP_H_
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef STD_QUEUE_H_
+#define STD_QUEUE_H_
+
+#include "../bits/stl_queue.h"
+
+#endif // STD_QUEUE_H_
\ No newline at end of file
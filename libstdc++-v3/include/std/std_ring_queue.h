@@ -0,0 +1,7 @@
+#ifndef STD_RING_QUEUE_H_
+#define STD_RING_QUEUE_H_
+
+
+#include "../bits/stl_ring_queue.h"
+
+#endif // STD_RING_QUEUE_H_
\ No newline at end of file
@@ -0,0 +1,7 @@
+#ifndef STD_SEGMENTED_VECTOR_H_
+#define STD_SEGMENTED_VECTOR_H_
+
+
+#include "../bits/stl_segmented_vector.h"
+
+#endif // STD_SEGMENTED_VECTOR_H_
\ No newline at end of file
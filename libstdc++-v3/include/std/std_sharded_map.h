@@ -0,0 +1,7 @@
+#ifndef STD_SHARDED_MAP_H_
+#define STD_SHARDED_MAP_H_
+
+
+#include "../bits/stl_sharded_map.h"
+
+#endif // STD_SHARDED_MAP_H_
\ No newline at end of file
@@ -0,0 +1,7 @@
+#ifndef STD_THREAD_POOL_H_
+#define STD_THREAD_POOL_H_
+
+
+#include "../bits/stl_thread_pool.h"
+
+#endif // STD_THREAD_POOL_H_
\ No newline at end of file
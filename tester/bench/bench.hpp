@@ -0,0 +1,31 @@
+#ifndef BENCH_HPP
+# define BENCH_HPP
+
+# include <cstdio>
+# include <cstdlib>
+# include <sys/time.h>
+
+// Wall-clock seconds: the threaded benchmarks need elapsed time, not the
+// CPU time summed over threads that clock() reports.
+inline double	bench_now(void)
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, 0);
+	return (tv.tv_sec + tv.tv_usec * 1e-6);
+}
+
+// The i-th command line argument as a number, or dflt if it is absent.
+inline long	bench_arg(int argc, char **argv, int i, long dflt)
+{
+	return (i < argc ? std::strtol(argv[i], 0, 10) : dflt);
+}
+
+// A small LCG, so that every run, on every revision, sees the same keys.
+inline int	bench_rand(unsigned &seed)
+{
+	seed = seed * 1103515245u + 12345u;
+	return (static_cast<int>(seed >> 1));
+}
+
+#endif /* BENCH_HPP */
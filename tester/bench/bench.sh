@@ -0,0 +1,35 @@
+#!/usr/bin/env bash
+
+# Builds and runs the benchmarks of srcs/, every one by default.
+# Usage: ./bench.sh [benchmark_name] [...]
+# Set include_path to another checkout's headers to time that revision.
+
+include_path="${include_path:-../../libstdc++-v3/include/backward/}"
+srcs="srcs"
+
+CC="${CC:-c++}"
+CFLAGS="-O2 -std=c++98 -pthread -Wall -Wextra"
+
+cd "$(dirname "$0")" || exit 1
+
+benches=$(find "${srcs}" -type f -name '*.cpp' | sort)
+if [ $# -ne 0 ]; then
+	benches=""
+	for name in $@; do
+		benches+=" ${srcs}/${name%.cpp}.cpp"
+	done
+fi
+
+status=0
+for file in ${benches[@]}; do
+	name=$(basename "${file}" .cpp)
+	bin="bench.${name}.out"
+	printf "%s\n" "--- ${name}"
+	if ! $CC $CFLAGS -I./$include_path -I. -o "${bin}" "${file}"; then
+		status=1
+		continue
+	fi
+	./"${bin}" || status=1
+	rm -f "${bin}"
+done
+exit $status
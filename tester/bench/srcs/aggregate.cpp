@@ -0,0 +1,78 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include "interval_map.hpp"
+#include <vector>
+#include <iterator>
+
+// Range sums with a plus_monoid aggregate against summing the range with
+// an iterator loop, and interval_map::find_overlaps() against a scan of
+// every interval.
+
+typedef ft::map<int, long, std::less<int>, std::allocator<ft::pair<const int, long> >,
+	ft::Rb_tree_aggregate_node_update<ft::plus_monoid<long> > >	t_sum_map;
+typedef ft::interval_map<int, int>	t_imap;
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	q = bench_arg(argc, argv, 2, 200);
+	const int	span = 1 << 30;
+	unsigned	seed = 1;
+
+	t_sum_map	sums;
+	for (long i = 0; i < n; ++i)
+		sums.insert(ft::make_pair(bench_rand(seed) % span, static_cast<long>(i % 1000)));
+
+	// Windows of about a tenth of the keys.
+	std::vector<int>	lows(q);
+	for (long i = 0; i < q; ++i)
+		lows[i] = bench_rand(seed) % (span - span / 10);
+
+	long	sum1 = 0, sum2 = 0;
+	double	t = bench_now();
+	for (long i = 0; i < q; ++i)
+	{
+		const int	hi = lows[i] + span / 10;
+		for (t_sum_map::const_iterator it = sums.lower_bound(lows[i]);
+			it != sums.end() && it->first < hi; ++it)
+			sum1 += it->second;
+	}
+	const double	t1 = bench_now() - t;
+	t = bench_now();
+	for (long i = 0; i < q; ++i)
+		sum2 += sums.accumulate(lows[i], lows[i] + span / 10);
+	const double	t2 = bench_now() - t;
+	std::printf("n=%ld range sum over n/10 keys: loop %.0f us  accumulate %.2f us%s\n",
+		n, t1 / q * 1e6, t2 / q * 1e6, sum1 == sum2 ? "" : "  MISMATCH");
+
+	// Short intervals, short queries: a few matches each.
+	t_imap	intervals;
+	for (long i = 0; i < n; ++i)
+	{
+		const int	lo = bench_rand(seed) % span;
+		intervals.insert(ft::make_pair(ft::make_pair(lo, lo + span / n * 4), 0));
+	}
+	long	found1 = 0, found2 = 0;
+	const long	qi = q / 10 + 1;
+	t = bench_now();
+	for (long i = 0; i < qi; ++i)
+	{
+		const int	hi = lows[i] + span / n * 4;
+		for (t_imap::const_iterator it = intervals.begin(); it != intervals.end(); ++it)
+			found1 += it->first.first < hi && lows[i] < it->first.second;
+	}
+	const double	t3 = bench_now() - t;
+	std::vector<t_imap::const_iterator>	out;
+	t = bench_now();
+	for (long i = 0; i < q; ++i)
+	{
+		out.clear();
+		intervals.find_overlaps(lows[i], lows[i] + span / n * 4, std::back_inserter(out));
+		if (i < qi)
+			found2 += out.size();
+	}
+	const double	t4 = bench_now() - t;
+	std::printf("n=%ld find_overlaps (~8 matches): scan %.0f us  find_overlaps %.2f us%s\n",
+		n, t3 / qi * 1e6, t4 / q * 1e6, found1 == found2 ? "" : "  MISMATCH");
+	return (0);
+}
@@ -0,0 +1,85 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include "concurrent_map.hpp"
+#include <pthread.h>
+
+// Threads making random finds and insert_or_assign()s on a map of 100K
+// keys, a given percentage of them writes: ft::concurrent_map against an
+// ft::map behind one mutex.
+
+static const long	keys = 100000;
+static long			ops_per_thread = 400000;
+static long			write_pct = 10;
+
+static ft::concurrent_map<int, long>	cmap;
+static ft::map<int, long>				lmap;
+static pthread_mutex_t					lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void	*run_concurrent(void *arg)
+{
+	unsigned	seed = static_cast<unsigned>(reinterpret_cast<size_t>(arg));
+	long		found = 0, v;
+
+	for (long i = 0; i < ops_per_thread; ++i)
+	{
+		const int	k = bench_rand(seed) % keys;
+		if (bench_rand(seed) % 100 < write_pct)
+			cmap.insert_or_assign(k, i);
+		else
+			found += cmap.find(k, v);
+	}
+	return (reinterpret_cast<void *>(found));
+}
+
+static void	*run_locked(void *arg)
+{
+	unsigned	seed = static_cast<unsigned>(reinterpret_cast<size_t>(arg));
+	long		found = 0;
+
+	for (long i = 0; i < ops_per_thread; ++i)
+	{
+		const int	k = bench_rand(seed) % keys;
+		const bool	write = bench_rand(seed) % 100 < write_pct;
+		pthread_mutex_lock(&lock);
+		if (write)
+			lmap[k] = i;
+		else
+			found += lmap.find(k) != lmap.end();
+		pthread_mutex_unlock(&lock);
+	}
+	return (reinterpret_cast<void *>(found));
+}
+
+static double	time_threads(void *(*fn)(void *), long threads)
+{
+	pthread_t	th[64];
+	double		t = bench_now();
+
+	for (long i = 0; i < threads; ++i)
+		pthread_create(&th[i], 0, fn, reinterpret_cast<void *>(i + 1));
+	for (long i = 0; i < threads; ++i)
+		pthread_join(th[i], 0);
+	return (bench_now() - t);
+}
+
+int		main(int argc, char **argv)
+{
+	const long	max_threads = bench_arg(argc, argv, 1, 8);
+	write_pct = bench_arg(argc, argv, 2, 10);
+
+	for (long i = 0; i < keys; i += 2)
+	{
+		cmap.insert(ft::make_pair(static_cast<int>(i), i));
+		lmap[i] = i;
+	}
+	for (long threads = 1; threads <= max_threads && threads <= 64; threads *= 2)
+	{
+		ops_per_thread = 1600000 / threads;
+		const double	t1 = time_threads(&run_concurrent, threads);
+		const double	t2 = time_threads(&run_locked, threads);
+		std::printf("threads=%-2ld writes=%ld%%  concurrent_map %5.2f Mops/s  map+mutex %5.2f Mops/s\n",
+			threads, write_pct, ops_per_thread * threads / t1 / 1e6,
+			ops_per_thread * threads / t2 / 1e6);
+	}
+	return (0);
+}
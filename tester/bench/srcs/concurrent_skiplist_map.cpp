@@ -0,0 +1,78 @@
+#include "bench.hpp"
+#include "concurrent_map.hpp"
+#include "concurrent_skiplist_map.hpp"
+#include <pthread.h>
+
+// A write-heavy mix over 100K keys, half of them present: 50% inserts,
+// 30% erases and 20% counts, split over 1 to 64 threads.  The lock-free
+// ft::concurrent_skiplist_map against ft::concurrent_map, whose writers
+// take turns.
+
+typedef ft::concurrent_skiplist_map<int, int>	t_skiplist;
+typedef ft::concurrent_map<int, int>			t_cmap;
+
+static const long	keys = 100000;
+static long			ops_per_thread;
+
+template <typename Map>
+struct Worker
+{
+	Map		*map;
+	unsigned	seed;
+
+	static void	*run(void *arg)
+	{
+		Worker		*w = static_cast<Worker *>(arg);
+		unsigned	seed = w->seed;
+
+		for (long i = 0; i < ops_per_thread; ++i)
+		{
+			const int	k = bench_rand(seed) % keys;
+			const int	op = bench_rand(seed) % 10;
+			if (op < 5)
+				w->map->insert(ft::make_pair(k, static_cast<int>(i)));
+			else if (op < 8)
+				w->map->erase(k);
+			else
+				w->map->count(k);
+		}
+		return (0);
+	}
+};
+
+template <typename Map>
+static double	time_mix(long threads)
+{
+	Map				map;
+	Worker<Map>		workers[64];
+	pthread_t		th[64];
+
+	for (int k = 0; k < keys; k += 2)
+		map.insert(ft::make_pair(k, k));
+	ops_per_thread = 800000 / threads;
+	const double	t = bench_now();
+	for (long i = 0; i < threads; ++i)
+	{
+		workers[i].map = &map;
+		workers[i].seed = i + 1;
+		pthread_create(&th[i], 0, &Worker<Map>::run, &workers[i]);
+	}
+	for (long i = 0; i < threads; ++i)
+		pthread_join(th[i], 0);
+	return (bench_now() - t);
+}
+
+int		main(int argc, char **argv)
+{
+	const long	max_threads = bench_arg(argc, argv, 1, 64);
+
+	for (long threads = 1; threads <= max_threads && threads <= 64; threads *= 2)
+	{
+		const double	t1 = time_mix<t_skiplist>(threads);
+		const double	t2 = time_mix<t_cmap>(threads);
+		std::printf("threads=%-2ld skiplist_map %5.2f Mops/s  concurrent_map %5.2f Mops/s\n",
+			threads, ops_per_thread * threads / t1 / 1e6,
+			ops_per_thread * threads / t2 / 1e6);
+	}
+	return (0);
+}
@@ -0,0 +1,90 @@
+#include "bench.hpp"
+#include "stack.hpp"
+#include "concurrent_stack.hpp"
+#include <pthread.h>
+
+// Threads each pushing and popping in pairs, on 1 to 8 threads:
+// ft::concurrent_stack, without and with an elimination array, against
+// an ft::stack behind one mutex.
+
+static long	pairs_per_thread;
+
+static ft::concurrent_stack<long>	*cstack;
+static ft::stack<long>				lstack;
+static pthread_mutex_t				lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void	*run_concurrent(void *)
+{
+	long	sum = 0, x;
+
+	for (long i = 0; i < pairs_per_thread; ++i)
+	{
+		cstack->push(i);
+		cstack->pop(x);
+		sum += x;
+	}
+	return (reinterpret_cast<void *>(sum));
+}
+
+static void	*run_locked(void *)
+{
+	long	sum = 0;
+
+	for (long i = 0; i < pairs_per_thread; ++i)
+	{
+		pthread_mutex_lock(&lock);
+		lstack.push(i);
+		pthread_mutex_unlock(&lock);
+		pthread_mutex_lock(&lock);
+		sum += lstack.top();
+		lstack.pop();
+		pthread_mutex_unlock(&lock);
+	}
+	return (reinterpret_cast<void *>(sum));
+}
+
+// Returns the time taken, and whether the popped values add up to the
+// pushed ones.
+static double	time_threads(void *(*fn)(void *), long threads, bool &ok)
+{
+	pthread_t	th[64];
+	long		sum = 0;
+	double		t = bench_now();
+
+	for (long i = 0; i < threads; ++i)
+		pthread_create(&th[i], 0, fn, 0);
+	for (long i = 0; i < threads; ++i)
+	{
+		void	*res;
+		pthread_join(th[i], &res);
+		sum += reinterpret_cast<long>(res);
+	}
+	t = bench_now() - t;
+	ok = sum == threads * (pairs_per_thread * (pairs_per_thread - 1) / 2);
+	return (t);
+}
+
+int		main(int argc, char **argv)
+{
+	const long	total = bench_arg(argc, argv, 1, 2000000);
+	const long	max_threads = bench_arg(argc, argv, 2, 8);
+	const long	slots = bench_arg(argc, argv, 3, 8);
+
+	for (long threads = 1; threads <= max_threads && threads <= 64; threads *= 2)
+	{
+		bool	ok1, ok2, ok3;
+
+		pairs_per_thread = total / threads;
+		ft::concurrent_stack<long>	plain;
+		cstack = &plain;
+		const double	t1 = time_threads(&run_concurrent, threads, ok1);
+		ft::concurrent_stack<long>	elim(slots);
+		cstack = &elim;
+		const double	t2 = time_threads(&run_concurrent, threads, ok2);
+		const double	t3 = time_threads(&run_locked, threads, ok3);
+		std::printf("threads=%-2ld concurrent_stack %5.2f  elimination(%ld) %5.2f  stack+mutex %5.2f Mpairs/s%s\n",
+			threads, total / t1 / 1e6, slots, total / t2 / 1e6, total / t3 / 1e6,
+			ok1 && ok2 && ok3 && plain.empty() && elim.empty() && lstack.empty() ? "" : "  MISMATCH");
+	}
+	return (0);
+}
@@ -0,0 +1,65 @@
+#include "bench.hpp"
+#include "set.hpp"
+#include <vector>
+#include <string>
+#include <algorithm>
+
+// A join-like probe: m ascending keys, half of them present, counted in a
+// set of n with a loop of count() and with one count_sorted() walk, for
+// int keys and for 16-character string keys.
+
+template <typename Key>
+static void	run(const char *label, const std::vector<Key> &pool, long n, long m)
+{
+	unsigned		seed = 2;
+	ft::set<Key>	st;
+	for (long i = 0; i < n; ++i)
+		st.insert(pool[i]);
+	std::vector<Key>	probes(m);
+	for (long i = 0; i < m; ++i)
+		probes[i] = pool[(i & 1) ? bench_rand(seed) % n : n + bench_rand(seed) % n];
+	std::sort(probes.begin(), probes.end());
+
+	// Repeat small batches so that every cell times about 5M probes.
+	long	reps = 5000000 / m;
+	if (reps < 1)
+		reps = 1;
+	size_t	count1 = 0, count2 = 0;
+	double	t = bench_now();
+	for (long r = 0; r < reps; ++r)
+		for (long i = 0; i < m; ++i)
+			count1 += st.count(probes[i]);
+	const double	t1 = bench_now() - t;
+	t = bench_now();
+	for (long r = 0; r < reps; ++r)
+		count2 += st.count_sorted(probes.begin(), probes.end());
+	const double	t2 = bench_now() - t;
+	std::printf("%-6s n=%ld m=%-8ld count loop %5.0f ns/key  count_sorted %5.0f ns/key%s\n",
+		label, n, m, t1 / m / reps * 1e9, t2 / m / reps * 1e9,
+		count1 == count2 ? "" : "  MISMATCH");
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	unsigned	seed = 1;
+	char		buf[32];
+
+	// The first n keys go in the set, the others are misses.
+	std::vector<int>			ints;
+	std::vector<std::string>	strings;
+	for (long i = 0; i < 2 * n; ++i)
+	{
+		const int	k = bench_rand(seed);
+		ints.push_back(k);
+		std::sprintf(buf, "key-%012d", k);
+		strings.push_back(buf);
+	}
+	const long	batches[] = { 1000, 100000, n };
+	for (unsigned i = 0; i < sizeof(batches) / sizeof(*batches); ++i)
+	{
+		run("int", ints, n, batches[i]);
+		run("string", strings, n, batches[i]);
+	}
+	return (0);
+}
@@ -0,0 +1,90 @@
+#include "bench.hpp"
+#include "deque.hpp"
+#include <deque>
+#include <new>
+
+// Pushing and popping n ints at both ends of a deque: filling at the
+// back and draining from the front, the reverse, and a queue of 1000
+// that slides n times, counting the allocations each makes.  std::deque
+// against ft::deque with its default block (4096 bytes) and blocks of 16
+// to 4096 elements.
+
+static unsigned long	allocations;
+
+void	*operator new(std::size_t n) throw(std::bad_alloc)
+{
+	++allocations;
+	void	*p = std::malloc(n);
+	if (p == 0)
+		throw std::bad_alloc();
+	return (p);
+}
+
+void	operator delete(void *p) throw()
+{
+	std::free(p);
+}
+
+template <typename Deque>
+static void	run(const char *name, long n)
+{
+	long			sum = 0;
+	double			t[3];
+	unsigned long	allocs;
+
+	{
+		Deque	d;
+		t[0] = bench_now();
+		for (long i = 0; i < n; ++i)
+			d.push_back(static_cast<int>(i));
+		for (long i = 0; i < n; ++i)
+		{
+			sum += d.front();
+			d.pop_front();
+		}
+		t[0] = bench_now() - t[0];
+	}
+	{
+		Deque	d;
+		t[1] = bench_now();
+		for (long i = 0; i < n; ++i)
+			d.push_front(static_cast<int>(i));
+		for (long i = 0; i < n; ++i)
+		{
+			sum += d.back();
+			d.pop_back();
+		}
+		t[1] = bench_now() - t[1];
+	}
+	{
+		Deque	d;
+		for (int i = 0; i < 1000; ++i)
+			d.push_back(0);
+		allocs = allocations;
+		t[2] = bench_now();
+		for (long i = 0; i < n; ++i)
+		{
+			d.push_back(static_cast<int>(i));
+			sum += d.front();
+			d.pop_front();
+		}
+		t[2] = bench_now() - t[2];
+		allocs = allocations - allocs;
+	}
+	const long	expected = 2 * (n * (n - 1) / 2) + (n - 1000) * (n - 1001) / 2;
+	std::printf("%-15s back/front %.3f s  front/back %.3f s  sliding %.3f s (%lu allocations)%s\n",
+		name, t[0], t[1], t[2], allocs, sum == expected ? "" : "  MISMATCH");
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 10000000);
+
+	run<std::deque<int> >("std::deque", n);
+	run<ft::deque<int> >("ft::deque", n);
+	run<ft::deque<int, std::allocator<int>, 16> >("ft::deque<16>", n);
+	run<ft::deque<int, std::allocator<int>, 64> >("ft::deque<64>", n);
+	run<ft::deque<int, std::allocator<int>, 512> >("ft::deque<512>", n);
+	run<ft::deque<int, std::allocator<int>, 4096> >("ft::deque<4096>", n);
+	return (0);
+}
@@ -0,0 +1,50 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include <map>
+#include <vector>
+
+// find() on map<int, int>, half hits and half misses, with std::map as a
+// reference.  Run it with include_path pointing at an older checkout to
+// compare descents.
+
+template <typename Map>
+static double	time_find(const Map &m, const std::vector<int> &queries, long &sum)
+{
+	double	t = bench_now();
+
+	for (size_t i = 0; i < queries.size(); ++i)
+	{
+		typename Map::const_iterator	it = m.find(queries[i]);
+		if (it != m.end())
+			sum += it->second;
+	}
+	return ((bench_now() - t) / queries.size());
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	q = bench_arg(argc, argv, 2, 2000000);
+	unsigned	seed = 1;
+	ft::map<int, int>	ftm;
+	std::map<int, int>	stdm;
+	std::vector<int>	keys;
+
+	for (long i = 0; i < n; ++i)
+	{
+		const int	k = bench_rand(seed);
+		ftm.insert(ft::make_pair(k, static_cast<int>(i)));
+		stdm.insert(std::make_pair(k, static_cast<int>(i)));
+		keys.push_back(k);
+	}
+	std::vector<int>	queries(q);
+	for (long i = 0; i < q; ++i)
+		queries[i] = (i & 1) ? keys[bench_rand(seed) % n] : bench_rand(seed);
+
+	long	sum1 = 0, sum2 = 0;
+	const double	t1 = time_find(stdm, queries, sum1);
+	const double	t2 = time_find(ftm, queries, sum2);
+	std::printf("n=%ld find: std::map %.0f ns  ft::map %.0f ns%s\n",
+		n, t1 * 1e9, t2 * 1e9, sum1 == sum2 ? "" : "  MISMATCH");
+	return (0);
+}
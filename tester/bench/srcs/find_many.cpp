@@ -0,0 +1,47 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include <vector>
+
+// Looking up a batch of unsorted keys, half hits and half misses: a loop
+// of find() against one find_many() call.
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	q = bench_arg(argc, argv, 2, 2000000);
+	unsigned	seed = 1;
+	ft::map<int, int>	m;
+	std::vector<int>	keys;
+
+	for (long i = 0; i < n; ++i)
+	{
+		const int	k = bench_rand(seed);
+		m.insert(ft::make_pair(k, static_cast<int>(i)));
+		keys.push_back(k);
+	}
+	std::vector<int>	queries(q);
+	for (long i = 0; i < q; ++i)
+		queries[i] = (i & 1) ? keys[bench_rand(seed) % n] : bench_rand(seed);
+
+	long	sum1 = 0, sum2 = 0;
+	double	t = bench_now();
+	for (long i = 0; i < q; ++i)
+	{
+		ft::map<int, int>::iterator	it = m.find(queries[i]);
+		if (it != m.end())
+			sum1 += it->second;
+	}
+	const double	t1 = bench_now() - t;
+
+	std::vector<ft::map<int, int>::iterator>	res(q);
+	t = bench_now();
+	m.find_many(queries.begin(), queries.end(), res.begin());
+	for (long i = 0; i < q; ++i)
+		if (res[i] != m.end())
+			sum2 += res[i]->second;
+	const double	t2 = bench_now() - t;
+
+	std::printf("n=%ld find loop %.0f ns/key  find_many %.0f ns/key%s\n",
+		n, t1 / q * 1e9, t2 / q * 1e9, sum1 == sum2 ? "" : "  MISMATCH");
+	return (0);
+}
@@ -0,0 +1,44 @@
+#include "bench.hpp"
+#include "set.hpp"
+#include <vector>
+#include <algorithm>
+
+// A merge-style scan: looking up an ascending sequence of m keys in a set
+// of n, with find() from the root against a set::cursor that starts each
+// search where the previous one ended.
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	m = bench_arg(argc, argv, 2, 1000000);
+	unsigned	seed = 1;
+	ft::set<int>	st;
+	std::vector<int>	keys;
+
+	for (long i = 0; i < n; ++i)
+	{
+		const int	k = bench_rand(seed);
+		st.insert(k);
+		keys.push_back(k);
+	}
+	std::vector<int>	queries(m);
+	for (long i = 0; i < m; ++i)
+		queries[i] = (i & 1) ? keys[bench_rand(seed) % n] : bench_rand(seed);
+	std::sort(queries.begin(), queries.end());
+
+	long	hits1 = 0, hits2 = 0;
+	double	t = bench_now();
+	for (long i = 0; i < m; ++i)
+		hits1 += st.find(queries[i]) != st.end();
+	const double	t1 = bench_now() - t;
+
+	ft::set<int>::cursor	cur(st);
+	t = bench_now();
+	for (long i = 0; i < m; ++i)
+		hits2 += cur.find(queries[i]) != st.end();
+	const double	t2 = bench_now() - t;
+
+	std::printf("n=%ld m=%ld sorted keys: find %.0f ns/key  cursor %.0f ns/key%s\n",
+		n, m, t1 / m * 1e9, t2 / m * 1e9, hits1 == hits2 ? "" : "  MISMATCH");
+	return (0);
+}
@@ -0,0 +1,47 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include <vector>
+
+// Inserting a batch of m keys into a map of n: insert(first, last)
+// against insert_batch(), for a batch spread over the whole key range
+// and for one clustered in a narrow window.
+
+typedef ft::map<int, int>				t_map;
+typedef std::vector<ft::pair<int, int> >	t_batch;
+
+static double	time_insert(const t_map &base, const t_batch &batch, bool merged)
+{
+	t_map	m(base);
+	double	t = bench_now();
+
+	if (merged)
+		m.insert_batch(batch.begin(), batch.end());
+	else
+		m.insert(batch.begin(), batch.end());
+	return (bench_now() - t);
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	m = bench_arg(argc, argv, 2, 100000);
+	unsigned	seed = 1;
+	t_map		base;
+
+	for (long i = 0; i < n; ++i)
+		base.insert(ft::make_pair(bench_rand(seed), 0));
+
+	t_batch	spread, clustered;
+	const int	window_start = bench_rand(seed);
+	for (long i = 0; i < m; ++i)
+	{
+		spread.push_back(ft::make_pair(bench_rand(seed), 1));
+		clustered.push_back(ft::make_pair(window_start + bench_rand(seed) % (m * 4), 1));
+	}
+
+	std::printf("n=%ld m=%ld spread:    insert %.3fs  insert_batch %.3fs\n",
+		n, m, time_insert(base, spread, false), time_insert(base, spread, true));
+	std::printf("n=%ld m=%ld clustered: insert %.3fs  insert_batch %.3fs\n",
+		n, m, time_insert(base, clustered, false), time_insert(base, clustered, true));
+	return (0);
+}
@@ -0,0 +1,108 @@
+#include "bench.hpp"
+#include "list.hpp"
+#include <list>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Building and draining lists of n ints, then sort() on lists of random
+// ints, then the churn again once a sorted list has been destroyed:
+// ft::list with its default allocator and with ft::pool_allocator, and
+// std::list for reference.
+//
+// Each measurement runs in a process of its own.  Destroying a sorted
+// list frees its nodes in an order unrelated to their addresses, and
+// both the pool and malloc's small-chunk bins hand them back in that
+// order, so whatever ran after a sort would find its nodes scattered.
+
+// Ten rounds of push_back n, pop_front half, clear.
+template <typename List>
+static double	time_churn(long n, bool &ok)
+{
+	List	l;
+	long	sum = 0;
+
+	const double	t = bench_now();
+	for (int round = 0; round < 10; ++round)
+	{
+		for (long i = 0; i < n; ++i)
+			l.push_back(static_cast<int>(i));
+		for (long i = 0; i < n / 2; ++i)
+		{
+			sum += l.front();
+			l.pop_front();
+		}
+		l.clear();
+	}
+	const double	dt = bench_now() - t;
+	ok = ok && sum == 10 * ((n / 2) * (n / 2 - 1) / 2);
+	return (dt);
+}
+
+template <typename List>
+static double	time_sort(long n, bool &ok)
+{
+	List		l;
+	unsigned	seed = 42;
+
+	for (long i = 0; i < n; ++i)
+		l.push_back(bench_rand(seed));
+	const double	t = bench_now();
+	l.sort();
+	const double	dt = bench_now() - t;
+	int			prev = -1;
+	for (typename List::iterator it = l.begin(); it != l.end(); ++it)
+	{
+		ok = ok && *it >= prev;
+		prev = *it;
+	}
+	ok = ok && static_cast<long>(l.size()) == n;
+	return (dt);
+}
+
+template <typename List>
+static double	time_churn_after_sort(long n, bool &ok)
+{
+	time_sort<List>(n, ok);
+	return (time_churn<List>(n, ok));
+}
+
+static void	run(const char *what, double (*fn)(long, bool &), const char *name, long n)
+{
+	std::fflush(stdout);
+	const pid_t	pid = fork();
+	if (pid == 0)
+	{
+		bool			ok = true;
+		const double	t = fn(n, ok);
+		std::printf("n=%-8ld %-16s %-14s %.3f s%s\n", n, what, name, t, ok ? "" : "  MISMATCH");
+		std::fflush(stdout);
+		_exit(0);
+	}
+	waitpid(pid, 0, 0);
+}
+
+typedef std::list<int>								t_std_list;
+typedef ft::list<int>								t_ft_list;
+typedef ft::list<int, ft::pool_allocator<int> >	t_pool_list;
+
+int		main(int argc, char **argv)
+{
+	const long	sizes[] = { 10000, 1000000, bench_arg(argc, argv, 1, 4000000) };
+
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+	{
+		run("churn", &time_churn<t_std_list>, "std::list", sizes[i]);
+		run("churn", &time_churn<t_ft_list>, "ft::list", sizes[i]);
+		run("churn", &time_churn<t_pool_list>, "ft::list<pool>", sizes[i]);
+	}
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+	{
+		run("sort", &time_sort<t_std_list>, "std::list", sizes[i]);
+		run("sort", &time_sort<t_ft_list>, "ft::list", sizes[i]);
+		run("sort", &time_sort<t_pool_list>, "ft::list<pool>", sizes[i]);
+	}
+	run("churn after sort", &time_churn_after_sort<t_std_list>, "std::list", sizes[1]);
+	run("churn after sort", &time_churn_after_sort<t_ft_list>, "ft::list", sizes[1]);
+	run("churn after sort", &time_churn_after_sort<t_pool_list>, "ft::list<pool>", sizes[1]);
+	return (0);
+}
@@ -0,0 +1,56 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include <string>
+#include <vector>
+
+// Changing the key of q elements of a map of n, whose values are 64-byte
+// strings: erase() then insert() of a copy, against extract() then
+// insert() of the same node.
+
+typedef ft::map<int, std::string>	t_map;
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	q = bench_arg(argc, argv, 2, 1000000);
+	unsigned	seed = 1;
+	t_map		m1;
+
+	for (long i = 0; i < n; ++i)
+		m1.insert(ft::make_pair(static_cast<int>(2 * i), std::string(64, 'a' + i % 26)));
+	t_map		m2(m1);
+	std::vector<int>	keys(q);
+	for (long i = 0; i < q; ++i)
+		keys[i] = 2 * (bench_rand(seed) % n);
+
+	// Every key moves to the odd neighbour above it, and back on its
+	// second draw, so the map keeps its size and never collides.
+	double	t = bench_now();
+	for (long i = 0; i < q; ++i)
+	{
+		t_map::iterator	it = m1.find(keys[i]);
+		if (it == m1.end())
+			it = m1.find(keys[i] + 1);
+		const int			k = it->first ^ 1;
+		const std::string	v = it->second;
+		m1.erase(it);
+		m1.insert(ft::make_pair(k, v));
+	}
+	const double	t1 = bench_now() - t;
+
+	t = bench_now();
+	for (long i = 0; i < q; ++i)
+	{
+		t_map::iterator	it = m2.find(keys[i]);
+		if (it == m2.end())
+			it = m2.find(keys[i] + 1);
+		t_map::node_type	nh = m2.extract(it);
+		nh.key() ^= 1;
+		m2.insert(nh);
+	}
+	const double	t2 = bench_now() - t;
+
+	std::printf("n=%ld erase+insert %.0f ns/key  extract+insert %.0f ns/key%s\n",
+		n, t1 / q * 1e9, t2 / q * 1e9, m1 == m2 ? "" : "  MISMATCH");
+	return (0);
+}
@@ -0,0 +1,59 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include <iterator>
+
+// What the order-statistics node update costs and buys: inserting into a
+// plain map and into one keeping subtree sizes, then nth() and rank()
+// against walking with std::advance and std::distance.
+
+typedef ft::map<int, int>	t_plain;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+	ft::Rb_tree_order_statistics_node_update>	t_ranked;
+
+template <typename Map>
+static double	time_build(Map &m, long n)
+{
+	unsigned	seed = 1;
+	double		t = bench_now();
+
+	for (long i = 0; i < n; ++i)
+		m.insert(ft::make_pair(bench_rand(seed), 0));
+	return (bench_now() - t);
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	q = bench_arg(argc, argv, 2, 1000);
+	t_plain		plain;
+	t_ranked	ranked;
+
+	const double	b1 = time_build(plain, n);
+	const double	b2 = time_build(ranked, n);
+	std::printf("n=%ld insert: plain %.0f ns  with sizes %.0f ns\n",
+		n, b1 / n * 1e9, b2 / n * 1e9);
+
+	unsigned	seed = 2;
+	long		sum1 = 0, sum2 = 0;
+	double		t = bench_now();
+	for (long i = 0; i < q; ++i)
+	{
+		t_plain::iterator	it = plain.begin();
+		std::advance(it, bench_rand(seed) % n);
+		sum1 += it->first;
+		sum1 += std::distance(plain.begin(), plain.lower_bound(it->first));
+	}
+	const double	t1 = bench_now() - t;
+	seed = 2;
+	t = bench_now();
+	for (long i = 0; i < q; ++i)
+	{
+		t_ranked::iterator	it = ranked.nth(bench_rand(seed) % n);
+		sum2 += it->first;
+		sum2 += ranked.rank(it->first);
+	}
+	const double	t2 = bench_now() - t;
+	std::printf("n=%ld nth+rank: walking %.0f us  nth/rank %.2f us%s\n",
+		n, t1 / q * 1e6, t2 / q * 1e6, sum1 == sum2 ? "" : "  MISMATCH");
+	return (0);
+}
@@ -0,0 +1,96 @@
+#include "bench.hpp"
+#include "vector.hpp"
+#include "parallel_algorithm.hpp"
+#include <algorithm>
+#include <numeric>
+
+// The ft::parallel algorithms on a vector of n ints, on 1 to 8 threads,
+// against their serial <algorithm> counterparts: fill, copy, transform,
+// reduce, find_if (with the only match at the end) and sort.
+
+typedef ft::vector<int>	t_vec;
+
+struct Triple
+{
+	int		operator()(int x) const { return (x * 3 + 1); }
+};
+
+struct IsNegative
+{
+	bool	operator()(int x) const { return (x < 0); }
+};
+
+static void	report(const char *label, size_t threads, double t, bool ok)
+{
+	if (threads == 0)
+		std::printf("%-10s serial  %.3f s\n", label, t);
+	else
+		std::printf("%-10s par(%lu) %.3f s%s\n", label,
+			static_cast<unsigned long>(threads), t, ok ? "" : "  MISMATCH");
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 4000000);
+	unsigned	seed = 1;
+	t_vec		v(n), w(n), s;
+
+	for (long i = 0; i < n; ++i)
+		v[i] = static_cast<int>(bench_rand(seed) & 0x3fffffff);
+	v[n - 1] = -1;
+
+	double	t = bench_now();
+	std::fill(w.begin(), w.end(), 1);
+	report("fill", 0, bench_now() - t, true);
+	t = bench_now();
+	std::copy(v.begin(), v.end(), w.begin());
+	report("copy", 0, bench_now() - t, true);
+	t = bench_now();
+	std::transform(v.begin(), v.end(), w.begin(), Triple());
+	report("transform", 0, bench_now() - t, true);
+	const t_vec	transformed(w);
+	t = bench_now();
+	const long long	sum = std::accumulate(v.begin(), v.end(), 0LL);
+	report("reduce", 0, bench_now() - t, true);
+	t = bench_now();
+	const t_vec::iterator	found = std::find_if(v.begin(), v.end(), IsNegative());
+	report("find_if", 0, bench_now() - t, true);
+	s = v;
+	t = bench_now();
+	std::sort(s.begin(), s.end());
+	report("sort", 0, bench_now() - t, true);
+
+	// The clock is read before the result is checked, which may take as
+	// long as the algorithm itself.
+	double	dt;
+	for (size_t threads = 1; threads <= 8; threads *= 2)
+	{
+		t = bench_now();
+		ft::parallel::fill(ft::par(threads), w.begin(), w.end(), 2);
+		dt = bench_now() - t;
+		report("fill", threads, dt, w[n / 2] == 2);
+		t = bench_now();
+		ft::parallel::copy(ft::par(threads), v.begin(), v.end(), w.begin());
+		dt = bench_now() - t;
+		report("copy", threads, dt, w == v);
+		t = bench_now();
+		ft::parallel::transform(ft::par(threads), v.begin(), v.end(), w.begin(), Triple());
+		dt = bench_now() - t;
+		report("transform", threads, dt, w == transformed);
+		t = bench_now();
+		const long long	psum = ft::parallel::reduce(ft::par(threads), v.begin(), v.end(), 0LL);
+		dt = bench_now() - t;
+		report("reduce", threads, dt, psum == sum);
+		t = bench_now();
+		const t_vec::iterator	pfound = ft::parallel::find_if(ft::par(threads),
+			v.begin(), v.end(), IsNegative());
+		dt = bench_now() - t;
+		report("find_if", threads, dt, pfound == found);
+		w = v;
+		t = bench_now();
+		ft::parallel::sort(ft::par(threads), w.begin(), w.end());
+		dt = bench_now() - t;
+		report("sort", threads, dt, w == s);
+	}
+	return (0);
+}
@@ -0,0 +1,37 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include "parallel.hpp"
+#include <vector>
+
+// Building a map from n random pairs: the range constructor, against
+// map(ft::par(t), first, last) for 1 to 16 threads.
+
+typedef ft::map<int, int>	t_map;
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 2000000);
+	unsigned	seed = 1;
+	std::vector<ft::pair<int, int> >	in;
+
+	for (long i = 0; i < n; ++i)
+		in.push_back(ft::make_pair(bench_rand(seed), static_cast<int>(i)));
+
+	double	t = bench_now();
+	size_t	size;
+	{
+		t_map	m(in.begin(), in.end());
+		t = bench_now() - t;
+		size = m.size();
+	}
+	std::printf("n=%ld map(first, last)          %.3f s\n", n, t);
+	for (size_t threads = 1; threads <= 16; threads *= 2)
+	{
+		t = bench_now();
+		t_map	m(ft::par(threads), in.begin(), in.end());
+		t = bench_now() - t;
+		std::printf("n=%ld map(par(%2lu), first, last) %.3f s%s\n", n,
+			static_cast<unsigned long>(threads), t, m.size() == size ? "" : "  MISMATCH");
+	}
+	return (0);
+}
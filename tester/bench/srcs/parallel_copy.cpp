@@ -0,0 +1,58 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include "parallel.hpp"
+#include <ctime>
+
+// Copying and clearing a map of n: the serial copy constructor and
+// clear(), against map(ft::par(t), x) and clear(ft::par(t)), and the
+// caller's share of clear_in_background().
+
+typedef ft::map<int, int>	t_map;
+
+// CPU seconds of the calling thread: on a machine with fewer cores than
+// threads, the worker that frees the nodes may preempt the caller, whose
+// wall-clock time then includes the worker's.
+static double	thread_cpu(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 2000000);
+	unsigned	seed = 1;
+	t_map		m;
+
+	for (long i = 0; i < n; ++i)
+		m.insert(ft::make_pair(bench_rand(seed), static_cast<int>(i)));
+
+	double	t = bench_now();
+	t_map	c(m);
+	double	t1 = bench_now();
+	c.clear();
+	std::printf("n=%ld serial   copy %.3f s  clear %.3f s\n", n, t1 - t, bench_now() - t1);
+	for (size_t threads = 2; threads <= 8; threads *= 2)
+	{
+		t = bench_now();
+		t_map	p(ft::par(threads), m);
+		t1 = bench_now();
+		p.clear(ft::par(threads));
+		std::printf("n=%ld par(%lu)   copy %.3f s  clear %.3f s%s\n", n,
+			static_cast<unsigned long>(threads), t1 - t, bench_now() - t1,
+			c.size() == 0 && p.size() == 0 ? "" : "  MISMATCH");
+	}
+
+	t_map	b(m);
+	const double	cpu = thread_cpu();
+	t = bench_now();
+	b.clear_in_background();
+	t1 = bench_now();
+	const double	cpu1 = thread_cpu();
+	ft::Parallel_reclaimer::S_wait();
+	std::printf("n=%ld clear_in_background: caller %.1f us (%.1f us CPU), all freed after %.3f s\n",
+		n, (t1 - t) * 1e6, (cpu1 - cpu) * 1e6, bench_now() - t);
+	return (0);
+}
@@ -0,0 +1,39 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include "parallel.hpp"
+
+// Summing the mapped values of a map of n: an iterator loop, against
+// ft::parallel_reduce() on 1 to 32 threads.
+
+typedef ft::map<int, int>	t_map;
+
+struct Sum
+{
+	long	operator()(long a, const t_map::value_type &x) const { return (a + x.second); }
+	long	operator()(long a, long b) const { return (a + b); }
+};
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 4000000);
+	unsigned	seed = 1;
+	t_map		m;
+
+	for (long i = 0; i < n; ++i)
+		m.insert(ft::make_pair(bench_rand(seed), static_cast<int>(i & 1023)));
+
+	double	t = bench_now();
+	long	expected = 0;
+	for (t_map::const_iterator it = m.begin(); it != m.end(); ++it)
+		expected += it->second;
+	std::printf("n=%ld iterator loop      %.3f s\n", n, bench_now() - t);
+	for (size_t threads = 1; threads <= 32; threads *= 2)
+	{
+		t = bench_now();
+		const long	sum = ft::parallel_reduce(ft::par(threads), m, 0L, Sum(), Sum());
+		std::printf("n=%ld parallel_reduce(%2lu) %.3f s%s\n", n,
+			static_cast<unsigned long>(threads), bench_now() - t,
+			sum == expected ? "" : "  MISMATCH");
+	}
+	return (0);
+}
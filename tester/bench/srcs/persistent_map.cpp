@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include "persistent_map.hpp"
+#include <vector>
+
+// Publishing a snapshot of a map of n after every `upd' updates: copying
+// an ft::map, against taking a snapshot of an ft::persistent_map, the
+// last four of which are kept alive.  Then the price of persistence on
+// reads: lookups and a full scan of both.
+
+typedef ft::map<int, long>				t_map;
+typedef ft::persistent_map<int, long>	t_pmap;
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 100000);
+	const long	rounds = bench_arg(argc, argv, 2, 1000);
+	const long	upd = bench_arg(argc, argv, 3, 10);
+	const long	q = 1000000;
+	unsigned	seed = 1;
+	long		sink1 = 0, sink2 = 0;
+
+	t_map	m;
+	for (long i = 0; i < n; ++i)
+		m[i] = i;
+	double	t = bench_now();
+	for (long r = 0; r < rounds; ++r)
+	{
+		for (long u = 0; u < upd; ++u)
+			m[bench_rand(seed) % n] = r;
+		t_map	snap(m);
+		sink1 += snap.size();
+	}
+	const double	t1 = bench_now() - t;
+
+	seed = 1;
+	t_pmap	pm;
+	for (long i = 0; i < n; ++i)
+		pm[i] = i;
+	std::vector<t_pmap>	keep;
+	t = bench_now();
+	for (long r = 0; r < rounds; ++r)
+	{
+		for (long u = 0; u < upd; ++u)
+			pm[bench_rand(seed) % n] = r;
+		t_pmap	snap = pm.snapshot();
+		sink2 += snap.size();
+		keep.push_back(snap);
+		if (keep.size() > 4)
+			keep.erase(keep.begin());
+	}
+	const double	t2 = bench_now() - t;
+	std::printf("n=%ld upd=%ld publish: map copy %.1f us  persistent snapshot %.1f us%s\n",
+		n, upd, t1 / rounds * 1e6, t2 / rounds * 1e6, sink1 == sink2 ? "" : "  MISMATCH");
+
+	std::vector<int>	keys(q);
+	for (long i = 0; i < q; ++i)
+		keys[i] = bench_rand(seed) % n;
+	sink1 = 0;
+	sink2 = 0;
+	t = bench_now();
+	for (long i = 0; i < q; ++i)
+		sink1 += m.find(keys[i])->second;
+	const double	f1 = bench_now() - t;
+	t = bench_now();
+	for (long i = 0; i < q; ++i)
+		sink2 += pm.find(keys[i])->second;
+	const double	f2 = bench_now() - t;
+	t = bench_now();
+	for (t_map::const_iterator it = m.begin(); it != m.end(); ++it)
+		sink1 += it->second;
+	const double	s1 = bench_now() - t;
+	t = bench_now();
+	for (t_pmap::const_iterator it = pm.begin(); it != pm.end(); ++it)
+		sink2 += it->second;
+	const double	s2 = bench_now() - t;
+	std::printf("find: map %.0f ns  persistent %.0f ns  scan: map %.2f ms  persistent %.2f ms%s\n",
+		f1 / q * 1e9, f2 / q * 1e9, s1 * 1e3, s2 * 1e3, sink1 == sink2 ? "" : "  MISMATCH");
+	return (0);
+}
@@ -0,0 +1,248 @@
+#include "bench.hpp"
+#include "queue.hpp"
+#include "ring_queue.hpp"
+#include <queue>
+#include <pthread.h>
+#include <sched.h>
+
+// Throughput of ft::spsc_ring and ft::mpmc_queue under contention, one
+// element or 32 at a time, against an ft::queue behind one mutex and
+// bounded to the same 1024 elements; then the round-trip latency of a
+// ping-pong between two threads, and ft::queue against std::queue on
+// one thread.
+
+static long			total = 4000000;
+static const long	bound = 1024;
+
+// ft::queue behind a mutex, with the interface of the ring queues.
+class Locked_queue
+{
+	public:
+		Locked_queue(void) { pthread_mutex_init(&this->_mutex, 0); }
+		~Locked_queue(void) { pthread_mutex_destroy(&this->_mutex); }
+
+		long	try_push(const long *first, long n)
+		{
+			pthread_mutex_lock(&this->_mutex);
+			long	i = 0;
+			for (; i < n && static_cast<long>(this->_queue.size()) < bound; ++i)
+				this->_queue.push(first[i]);
+			pthread_mutex_unlock(&this->_mutex);
+			return (i);
+		}
+
+		long	try_pop(long *out, long n)
+		{
+			pthread_mutex_lock(&this->_mutex);
+			long	i = 0;
+			for (; i < n && !this->_queue.empty(); ++i)
+			{
+				out[i] = this->_queue.front();
+				this->_queue.pop();
+			}
+			pthread_mutex_unlock(&this->_mutex);
+			return (i);
+		}
+
+	private:
+		ft::queue<long>	_queue;
+		pthread_mutex_t	_mutex;
+};
+
+typedef ft::spsc_ring<long, bound>	t_ring;
+typedef ft::mpmc_queue<long>		t_mpmc;
+
+// The single-element operations, through the batch interface.
+static long	push_some(Locked_queue &q, const long *b, long n, bool) { return (q.try_push(b, n)); }
+static long	pop_some(Locked_queue &q, long *b, long n, bool) { return (q.try_pop(b, n)); }
+
+template <typename Queue>
+static long	push_some(Queue &q, const long *b, long n, bool batch)
+{
+	return (batch ? q.try_push(b, n) : q.try_push(*b));
+}
+
+template <typename Queue>
+static long	pop_some(Queue &q, long *b, long n, bool batch)
+{
+	return (batch ? q.try_pop(b, n) : q.try_pop(*b));
+}
+
+template <typename Queue>
+struct Run
+{
+	static Queue	*q;
+	static long		batch;
+	static long		per_producer;
+	static long		consumed;
+	static long		sum;
+
+	static void	*produce(void *)
+	{
+		long	buf[32];
+
+		for (long i = 0; i < per_producer; )
+		{
+			long	n = batch < per_producer - i ? batch : per_producer - i;
+			for (long k = 0; k < n; ++k)
+				buf[k] = i + k;
+			for (long done = 0; done < n; )
+			{
+				const long	got = push_some(*q, buf + done, n - done, batch > 1);
+				if (got == 0)
+					sched_yield();
+				done += got;
+			}
+			i += n;
+		}
+		return (0);
+	}
+
+	static void	*consume(void *)
+	{
+		long	buf[32], local = 0;
+
+		while (__atomic_load_n(&consumed, __ATOMIC_RELAXED) < total)
+		{
+			const long	got = pop_some(*q, buf, batch, batch > 1);
+			if (got == 0)
+			{
+				sched_yield();
+				continue;
+			}
+			for (long k = 0; k < got; ++k)
+				local += buf[k];
+			__atomic_add_fetch(&consumed, got, __ATOMIC_RELAXED);
+		}
+		__atomic_add_fetch(&sum, local, __ATOMIC_RELAXED);
+		return (0);
+	}
+
+	static void	time(const char *name, Queue &queue, long producers, long consumers, long b)
+	{
+		pthread_t	th[16];
+
+		q = &queue;
+		batch = b;
+		per_producer = total / producers;
+		consumed = 0;
+		sum = 0;
+		const double	t = bench_now();
+		for (long i = 0; i < producers; ++i)
+			pthread_create(&th[i], 0, &produce, 0);
+		for (long i = 0; i < consumers; ++i)
+			pthread_create(&th[producers + i], 0, &consume, 0);
+		for (long i = 0; i < producers + consumers; ++i)
+			pthread_join(th[i], 0);
+		const double	dt = bench_now() - t;
+		const long		expected = producers * (per_producer * (per_producer - 1) / 2);
+		std::printf("%-18s %ldP/%ldC batch %-2ld %6.2f Mops/s%s\n", name, producers, consumers, b,
+			producers * per_producer / dt / 1e6, sum == expected ? "" : "  MISMATCH");
+	}
+};
+
+template <typename Queue> Queue	*Run<Queue>::q;
+template <typename Queue> long	Run<Queue>::batch;
+template <typename Queue> long	Run<Queue>::per_producer;
+template <typename Queue> long	Run<Queue>::consumed;
+template <typename Queue> long	Run<Queue>::sum;
+
+// Ping-pong: the echo thread sends back every number it receives.
+template <typename Queue>
+struct Echo
+{
+	Queue	*ping;
+	Queue	*pong;
+	long	rounds;
+
+	static void	*run(void *arg)
+	{
+		Echo	*e = static_cast<Echo *>(arg);
+		long	x;
+
+		for (long i = 0; i < e->rounds; ++i)
+		{
+			e->ping->pop(x);
+			e->pong->push(x);
+		}
+		return (0);
+	}
+};
+
+template <typename Queue>
+static void	round_trip(const char *name, Queue &ping, Queue &pong, long rounds)
+{
+	Echo<Queue>	e = { &ping, &pong, rounds };
+	pthread_t	th;
+	long		x, bad = 0;
+
+	pthread_create(&th, 0, &Echo<Queue>::run, &e);
+	const double	t = bench_now();
+	for (long i = 0; i < rounds; ++i)
+	{
+		ping.push(i);
+		pong.pop(x);
+		bad += x != i;
+	}
+	const double	dt = bench_now() - t;
+	pthread_join(th, 0);
+	std::printf("%-18s round trip %.0f ns%s\n", name, dt / rounds * 1e9, bad ? "  MISMATCH" : "");
+}
+
+template <typename Queue>
+static void	serial(const char *name, long n)
+{
+	Queue	q;
+	long	sum = 0;
+
+	const double	t = bench_now();
+	for (long i = 0; i < n; ++i)
+	{
+		q.push(i);
+		if (i % 4 == 3)
+			for (int k = 0; k < 3; ++k)
+			{
+				sum += q.front();
+				q.pop();
+			}
+	}
+	while (!q.empty())
+	{
+		sum += q.front();
+		q.pop();
+	}
+	std::printf("%-18s serial push/pop %.3f s%s\n", name, bench_now() - t,
+		sum == n * (n - 1) / 2 ? "" : "  MISMATCH");
+}
+
+int		main(int argc, char **argv)
+{
+	total = bench_arg(argc, argv, 1, 4000000);
+	const long	max_threads = bench_arg(argc, argv, 2, 4);
+
+	{
+		Locked_queue	l;
+		t_ring			r;
+		Run<Locked_queue>::time("ft::queue+mutex", l, 1, 1, 1);
+		Run<t_ring>::time("spsc_ring", r, 1, 1, 1);
+		Run<t_ring>::time("spsc_ring", r, 1, 1, 32);
+	}
+	for (long pc = 1; pc <= max_threads && pc <= 8; pc *= 2)
+	{
+		Locked_queue	l;
+		t_mpmc			m(bound);
+		Run<Locked_queue>::time("ft::queue+mutex", l, pc, pc, 1);
+		Run<t_mpmc>::time("mpmc_queue", m, pc, pc, 1);
+		Run<t_mpmc>::time("mpmc_queue", m, pc, pc, 32);
+	}
+
+	const long	rounds = bench_arg(argc, argv, 3, 100000);
+	t_ring		ping, pong;
+	t_mpmc		mping(bound), mpong(bound);
+	round_trip("spsc_ring", ping, pong, rounds);
+	round_trip("mpmc_queue", mping, mpong, rounds);
+
+	serial<std::queue<long> >("std::queue", total);
+	serial<ft::queue<long> >("ft::queue", total);
+	return (0);
+}
@@ -0,0 +1,72 @@
+#include "bench.hpp"
+#include "stack.hpp"
+#include "vector.hpp"
+#include "segmented_vector.hpp"
+#include <deque>
+#include <ctime>
+
+// Pushing n elements of 4KB on an ft::stack and popping them, twice,
+// over ft::vector, std::deque and ft::segmented_vector: the total time,
+// and the slowest single push, which for ft::vector is a reallocation
+// copying everything pushed so far.
+
+struct Buffer
+{
+	int		index;
+	char	payload[4096];
+};
+
+static double	now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+template <typename Stack>
+static void	run(const char *name, long n)
+{
+	double	best = 1e30, worst = 0;
+	long	sum = 0;
+	Buffer	b;
+
+	b.payload[0] = 0;
+	for (int rep = 0; rep < 3; ++rep)
+	{
+		Stack			s;
+		const double	t = now_ns();
+		for (int round = 0; round < 2; ++round)
+		{
+			for (long i = 0; i < n; ++i)
+			{
+				b.index = static_cast<int>(i);
+				const double	t1 = now_ns();
+				s.push(b);
+				const double	dt = now_ns() - t1;
+				if (dt > worst)
+					worst = dt;
+			}
+			for (long i = 0; i < n; ++i)
+			{
+				sum += s.top().index;
+				s.pop();
+			}
+		}
+		const double	total = now_ns() - t;
+		if (total < best)
+			best = total;
+	}
+	std::printf("%-18s total %.3f s  slowest push %9.1f us%s\n", name, best * 1e-9, worst * 1e-3,
+		sum == 6 * (n * (n - 1) / 2) ? "" : "  MISMATCH");
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 50000);
+
+	run<ft::stack<Buffer, ft::vector<Buffer> > >("ft::vector", n);
+	run<ft::stack<Buffer, std::deque<Buffer> > >("std::deque", n);
+	run<ft::stack<Buffer, ft::segmented_vector<Buffer> > >("segmented_vector", n);
+	return (0);
+}
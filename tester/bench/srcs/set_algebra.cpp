@@ -0,0 +1,75 @@
+#include "bench.hpp"
+#include "set.hpp"
+#include "parallel.hpp"
+
+// In-place union and difference of a set of n with one of m, against
+// inserting or erasing the m elements one by one.  Both operands are
+// copied before each timing, so only the operation is timed.
+
+typedef ft::set<int>	t_set;
+
+static double	time_loop(const t_set &big, const t_set &small, bool unite, size_t &size)
+{
+	t_set	a(big), b(small);
+	double	t = bench_now();
+
+	for (t_set::iterator it = b.begin(); it != b.end(); ++it)
+	{
+		if (unite)
+			a.insert(*it);
+		else
+			a.erase(*it);
+	}
+	t = bench_now() - t;
+	size = a.size();
+	return (t);
+}
+
+static double	time_join(const t_set &big, const t_set &small, bool unite,
+					bool parallel, size_t &size)
+{
+	t_set	a(big), b(small);
+	double	t = bench_now();
+
+	if (unite && parallel)
+		a.set_union(ft::par, b);
+	else if (unite)
+		a.set_union(b);
+	else if (parallel)
+		a.set_difference(ft::par, b);
+	else
+		a.set_difference(b);
+	t = bench_now() - t;
+	size = a.size();
+	return (t);
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	sizes[] = { 100, 10000, 250000, n };
+
+	std::printf("%-8s %-32s %s\n", "m", "union (loop / join / parallel)",
+		"difference (loop / join / parallel)");
+	for (unsigned i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+	{
+		unsigned	seed = 1;
+		t_set		big, small;
+		for (long k = 0; k < n; ++k)
+			big.insert(bench_rand(seed));
+		for (long k = 0; k < sizes[i]; ++k)
+			small.insert(bench_rand(seed));
+
+		size_t	s1, s2, s3, s4, s5, s6;
+		const double	u1 = time_loop(big, small, true, s1);
+		const double	u2 = time_join(big, small, true, false, s2);
+		const double	u3 = time_join(big, small, true, true, s3);
+		const double	d1 = time_loop(big, small, false, s4);
+		const double	d2 = time_join(big, small, false, false, s5);
+		const double	d3 = time_join(big, small, false, true, s6);
+		std::printf("%-8ld %7.2f / %7.2f / %7.2f ms     %7.2f / %7.2f / %7.2f ms%s\n",
+			sizes[i], u1 * 1e3, u2 * 1e3, u3 * 1e3, d1 * 1e3, d2 * 1e3, d3 * 1e3,
+			s1 == s2 && s2 == s3 && s4 == s5 && s5 == s6 ? "" : "  MISMATCH");
+	}
+	return (0);
+}
@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include "sharded_map.hpp"
+#include <vector>
+#include <pthread.h>
+
+// Threads inserting n random keys, each every threads-th one: an ft::map
+// behind one mutex against an ft::sharded_map of 16 shards.  Then the
+// bulk insert(first, last, threads) of the same keys, and a serial
+// ft::map range insert for reference.
+
+typedef ft::sharded_map<int, int, 16>	t_smap;
+typedef ft::map<int, int>				t_map;
+
+static std::vector<ft::pair<int, int> >	in;
+static long								threads;
+static t_smap							*smap;
+static t_map							*lmap;
+static pthread_mutex_t					lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void	*run_sharded(void *arg)
+{
+	for (size_t i = reinterpret_cast<size_t>(arg); i < in.size(); i += threads)
+		smap->insert(in[i]);
+	return (0);
+}
+
+static void	*run_locked(void *arg)
+{
+	for (size_t i = reinterpret_cast<size_t>(arg); i < in.size(); i += threads)
+	{
+		pthread_mutex_lock(&lock);
+		lmap->insert(in[i]);
+		pthread_mutex_unlock(&lock);
+	}
+	return (0);
+}
+
+static double	time_threads(void *(*fn)(void *))
+{
+	pthread_t	th[64];
+	double		t = bench_now();
+
+	for (long i = 0; i < threads; ++i)
+		pthread_create(&th[i], 0, fn, reinterpret_cast<void *>(i));
+	for (long i = 0; i < threads; ++i)
+		pthread_join(th[i], 0);
+	return (bench_now() - t);
+}
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	max_threads = bench_arg(argc, argv, 2, 8);
+	unsigned	seed = 1;
+
+	for (long i = 0; i < n; ++i)
+		in.push_back(ft::make_pair(bench_rand(seed), static_cast<int>(i)));
+	for (threads = 1; threads <= max_threads && threads <= 64; threads *= 2)
+	{
+		t_smap	s2;
+		double	t = bench_now();
+		s2.insert(in.begin(), in.end(), threads);
+		const double	t3 = bench_now() - t;
+		t_map	m;
+		lmap = &m;
+		const double	t1 = time_threads(&run_locked);
+		t_smap	s1;
+		smap = &s1;
+		const double	t2 = time_threads(&run_sharded);
+		std::printf("threads=%-2ld map+mutex %5.2f Mops/s  sharded %5.2f Mops/s  bulk %5.2f Mops/s%s\n",
+			threads, n / t1 / 1e6, n / t2 / 1e6, n / t3 / 1e6,
+			m.size() == s1.size() && s1.size() == s2.size() ? "" : "  MISMATCH");
+	}
+	t_map	m;
+	double	t = bench_now();
+	m.insert(in.begin(), in.end());
+	std::printf("map range insert, 1 thread %5.2f Mops/s\n", n / (bench_now() - t) / 1e6);
+	return (0);
+}
@@ -0,0 +1,71 @@
+#include "bench.hpp"
+#include "thread_pool.hpp"
+
+// The cost of forking on an ft::thread_pool of 1 to 4 workers: a
+// recursive fib() split with parallel_invoke() down to a serial cutoff,
+// against the serial recursion, then parallel_invoke() and
+// task_group::run() of empty functions.
+
+static long	serial_fib(long n)
+{
+	return (n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2));
+}
+
+struct Fib
+{
+	ft::thread_pool	*pool;
+	long			n;
+	long			*out;
+
+	void	operator()() const
+	{
+		if (n < 20)
+		{
+			*out = serial_fib(n);
+			return ;
+		}
+		long	a, b;
+		Fib		f1 = { pool, n - 1, &a };
+		Fib		f2 = { pool, n - 2, &b };
+		pool->parallel_invoke(f1, f2);
+		*out = a + b;
+	}
+};
+
+struct Nop
+{
+	void	operator()() const { }
+};
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 38);
+	const long	forks = bench_arg(argc, argv, 2, 1000000);
+	long		expected, res;
+
+	double	t = bench_now();
+	expected = serial_fib(n);
+	std::printf("serial   fib(%ld) %.3f s\n", n, bench_now() - t);
+	for (size_t workers = 1; workers <= 4; workers *= 2)
+	{
+		ft::thread_pool	pool(workers);
+		Fib				f = { &pool, n, &res };
+		t = bench_now();
+		f();
+		std::printf("%lu worker(s): fib(%ld) %.3f s%s\n", static_cast<unsigned long>(workers),
+			n, bench_now() - t, res == expected ? "" : "  MISMATCH");
+		t = bench_now();
+		for (long i = 0; i < forks; ++i)
+			pool.parallel_invoke(Nop(), Nop());
+		std::printf("  parallel_invoke %.0f ns", (bench_now() - t) / forks * 1e9);
+		t = bench_now();
+		{
+			ft::task_group	group(pool);
+			for (long i = 0; i < forks; ++i)
+				group.run(Nop());
+			group.wait();
+		}
+		std::printf("  task_group::run %.0f ns/task\n", (bench_now() - t) / forks * 1e9);
+	}
+	return (0);
+}
@@ -0,0 +1,58 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include <string>
+#include <vector>
+#include <cstring>
+
+// Looking up a map<std::string, ...> with a const char*: a plain
+// comparator needs a temporary std::string per lookup, a transparent
+// one compares the char* directly.
+
+struct StrLess
+{
+	typedef void	is_transparent;
+
+	bool	operator()(const std::string &a, const std::string &b) const
+	{ return (a < b); }
+	bool	operator()(const std::string &a, const char *b) const
+	{ return (a.compare(b) < 0); }
+	bool	operator()(const char *a, const std::string &b) const
+	{ return (b.compare(a) > 0); }
+};
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 100000);
+	const long	q = bench_arg(argc, argv, 2, 2000000);
+	unsigned	seed = 1;
+	char		buf[64];
+
+	ft::map<std::string, int>				plain;
+	ft::map<std::string, int, StrLess>		transparent;
+	std::vector<std::string>				keys;
+	for (long i = 0; i < n; ++i)
+	{
+		// Long enough to defeat the small string optimisation.
+		std::sprintf(buf, "some/fairly/long/path/%012d", bench_rand(seed));
+		plain[buf] = i;
+		transparent[buf] = i;
+		keys.push_back(buf);
+	}
+	std::vector<const char *>	queries(q);
+	for (long i = 0; i < q; ++i)
+		queries[i] = keys[bench_rand(seed) % n].c_str();
+
+	long	sum1 = 0, sum2 = 0;
+	double	t = bench_now();
+	for (long i = 0; i < q; ++i)
+		sum1 += plain.find(queries[i])->second;
+	const double	t1 = bench_now() - t;
+	t = bench_now();
+	for (long i = 0; i < q; ++i)
+		sum2 += transparent.find(queries[i])->second;
+	const double	t2 = bench_now() - t;
+
+	std::printf("n=%ld find(const char*): std::less %.0f ns  transparent %.0f ns%s\n",
+		n, t1 / q * 1e9, t2 / q * 1e9, sum1 == sum2 ? "" : "  MISMATCH");
+	return (0);
+}
@@ -0,0 +1,41 @@
+#include "bench.hpp"
+#include "map.hpp"
+#include <string>
+#include <vector>
+
+// q writes of a 48-byte string to random keys of a map of up to n:
+// operator[] then assignment, against insert_or_assign(), and, when the
+// value is only wanted for new keys, try_emplace().
+
+typedef ft::map<int, std::string>	t_map;
+
+int		main(int argc, char **argv)
+{
+	const long	n = bench_arg(argc, argv, 1, 1000000);
+	const long	q = bench_arg(argc, argv, 2, 2000000);
+	unsigned	seed = 1;
+	const std::string	payload(48, 'x');
+	std::vector<int>	keys(q);
+
+	for (long i = 0; i < q; ++i)
+		keys[i] = bench_rand(seed) % n;
+
+	t_map	m1, m2, m3;
+	double	t = bench_now();
+	for (long i = 0; i < q; ++i)
+		m1[keys[i]] = payload;
+	const double	t1 = bench_now() - t;
+	t = bench_now();
+	for (long i = 0; i < q; ++i)
+		m2.insert_or_assign(keys[i], payload);
+	const double	t2 = bench_now() - t;
+	t = bench_now();
+	for (long i = 0; i < q; ++i)
+		m3.try_emplace(keys[i], payload);
+	const double	t3 = bench_now() - t;
+
+	std::printf("n=%ld operator[]= %.0f ns/op  insert_or_assign %.0f ns/op  try_emplace %.0f ns/op%s\n",
+		n, t1 / q * 1e9, t2 / q * 1e9, t3 / q * 1e9,
+		m1 == m2 && m2 == m3 ? "" : "  MISMATCH");
+	return (0);
+}
@@ -149,8 +149,8 @@ do_test () {
 
 function main () {
 	pheader
-	containers=(vector map stack set)
-	# containers=(vector list map stack queue deque multimap set multiset)
+	containers=(vector list map stack queue deque set interval_map persistent_map sharded_map concurrent_map ring_queue concurrent_stack segmented_vector concurrent_skiplist_map)
+	# containers=(vector list map stack queue deque multimap set multiset interval_map persistent_map sharded_map concurrent_map ring_queue concurrent_stack segmented_vector concurrent_skiplist_map)
 	if [ $# -ne 0 ]; then
 		containers=($@);
 	fi
@@ -0,0 +1,103 @@
+#include "common.hpp"
+#include <stdexcept>
+
+#define T1 int
+#define T2 std::string
+
+typedef t_concurrent_map<T1, T2>	t_cmap;
+typedef t_cmap::snapshot_type		t_snap;
+
+struct Print
+{
+	void	operator()(const t_cmap::value_type &x) const { std::cout << "visited " << x.first << " = " << x.second << std::endl; };
+};
+
+// Several changes published together; throws half-way when asked to.
+struct Batch
+{
+	bool	fail;
+
+	Batch(bool f) : fail(f) { };
+	void	operator()(t_snap &mp) const
+	{
+		mp.insert(t_snap::value_type(100, "batch"));
+		mp.erase(2);
+		if (this->fail)
+			throw std::runtime_error("batch");
+		mp.insert(t_snap::value_type(101, "batch"));
+	};
+};
+
+static void	printFind(const t_cmap &mp, const T1 &k)
+{
+	T2	res = "untouched";
+
+	std::cout << "find(" << k << "): " << mp.find(k, res);
+	std::cout << " -> " << res << std::endl;
+}
+
+static void	printBounds(const t_cmap &mp, const T1 &k)
+{
+	_pair<T1, T2>	res(-1, "none");
+
+	std::cout << "lower_bound(" << k << "): " << mp.lower_bound(k, res);
+	std::cout << " -> " << res.first << " " << res.second << std::endl;
+	res = _pair<T1, T2>(-1, "none");
+	std::cout << "upper_bound(" << k << "): " << mp.upper_bound(k, res);
+	std::cout << " -> " << res.first << " " << res.second << std::endl;
+}
+
+int		main(void)
+{
+	t_cmap	mp;
+
+	std::cout << "\t-- insert and insert_or_assign --" << std::endl;
+	std::cout << "empty: " << mp.empty() << std::endl;
+	for (int i = 0; i < 10; ++i)
+	{
+		const bool	res = mp.insert(t_cmap::value_type((i * 7) % 10, std::string(1, 'a' + i)));
+		std::cout << "insert " << (i * 7) % 10 << ": " << res << std::endl;
+	}
+	std::cout << "duplicate: " << mp.insert(t_cmap::value_type(7, "dup")) << std::endl;
+	std::cout << "assign 7: " << mp.insert_or_assign(7, "assigned") << std::endl;
+	std::cout << "assign 20: " << mp.insert_or_assign(20, "new") << std::endl;
+
+	std::cout << "\t-- snapshots are unaffected by later writes --" << std::endl;
+	const t_snap	before = mp.snapshot();
+	std::cout << "erase(3): " << mp.erase(3) << std::endl;
+	std::cout << "erase(3) again: " << mp.erase(3) << std::endl;
+	printSize(before);
+	printSize(mp.snapshot());
+
+	std::cout << "\t-- lookups --" << std::endl;
+	printFind(mp, 7);
+	printFind(mp, 3);
+	std::cout << "count(20): " << mp.count(20) << std::endl;
+	std::cout << "count(21): " << mp.count(21) << std::endl;
+	std::cout << "visit(20): " << mp.visit(20, Print()) << std::endl;
+	std::cout << "visit(21): " << mp.visit(21, Print()) << std::endl;
+	printBounds(mp, 3);
+	printBounds(mp, 9);
+	printBounds(mp, 20);
+	std::cout << "key_comp()(1, 2): " << mp.key_comp()(1, 2) << std::endl;
+
+	std::cout << "\t-- update --" << std::endl;
+	mp.update(Batch(false));
+	printSize(mp.snapshot());
+	try
+	{
+		mp.update(Batch(true));
+	}
+	catch (std::exception &e)
+	{
+		std::cout << "caught: " << e.what() << std::endl;
+	}
+	std::cout << "unchanged size: " << mp.size() << std::endl;
+
+	std::cout << "\t-- clear --" << std::endl;
+	mp.clear();
+	std::cout << "empty: " << mp.empty() << " before.size(): " << before.size() << std::endl;
+	mp.insert(t_cmap::value_type(1, "after clear"));
+	printSize(mp.snapshot());
+	return (0);
+}
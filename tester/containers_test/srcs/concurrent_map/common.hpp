@@ -0,0 +1,180 @@
+#include "../base.hpp"
+#include <pthread.h>
+#if !defined(USING_STD)
+# include "concurrent_map.hpp"
+#else
+# include <map>
+#endif /* !defined(STD) */
+
+#define _pair TESTED_NAMESPACE::pair
+
+#if defined(USING_STD)
+// The STL has no concurrent map: a std::map behind one mutex, whose
+// snapshots are full copies.
+template <typename Key, typename Tp>
+class t_concurrent_map
+{
+	public:
+		typedef std::map<Key, Tp>					snapshot_type;
+		typedef typename snapshot_type::value_type	value_type;
+		typedef typename snapshot_type::size_type	size_type;
+		typedef typename snapshot_type::key_compare	key_compare;
+
+		t_concurrent_map(void) { pthread_mutex_init(&this->_mutex, 0); };
+		~t_concurrent_map(void) { pthread_mutex_destroy(&this->_mutex); };
+
+		snapshot_type	snapshot(void) const
+		{
+			Lock	lock(this->_mutex);
+			return (this->_map);
+		};
+		size_type	size(void) const
+		{
+			Lock	lock(this->_mutex);
+			return (this->_map.size());
+		};
+		bool		empty(void) const { return (this->size() == 0); };
+		size_type	count(const Key &k) const
+		{
+			Lock	lock(this->_mutex);
+			return (this->_map.count(k));
+		};
+
+		bool	find(const Key &k, Tp &result) const
+		{
+			Lock										lock(this->_mutex);
+			typename snapshot_type::const_iterator		it = this->_map.find(k);
+
+			if (it == this->_map.end())
+				return (false);
+			result = it->second;
+			return (true);
+		};
+
+		template <typename Function>
+		bool	visit(const Key &k, Function f) const
+		{
+			Lock										lock(this->_mutex);
+			typename snapshot_type::const_iterator		it = this->_map.find(k);
+
+			if (it == this->_map.end())
+				return (false);
+			f(*it);
+			return (true);
+		};
+
+		bool	lower_bound(const Key &k, std::pair<Key, Tp> &result) const
+		{
+			Lock										lock(this->_mutex);
+			typename snapshot_type::const_iterator		it = this->_map.lower_bound(k);
+
+			if (it == this->_map.end())
+				return (false);
+			result = std::pair<Key, Tp>(it->first, it->second);
+			return (true);
+		};
+
+		bool	upper_bound(const Key &k, std::pair<Key, Tp> &result) const
+		{
+			Lock										lock(this->_mutex);
+			typename snapshot_type::const_iterator		it = this->_map.upper_bound(k);
+
+			if (it == this->_map.end())
+				return (false);
+			result = std::pair<Key, Tp>(it->first, it->second);
+			return (true);
+		};
+
+		bool	insert(const value_type &x)
+		{
+			Lock	lock(this->_mutex);
+			return (this->_map.insert(x).second);
+		};
+
+		template <typename Obj>
+		bool	insert_or_assign(const Key &k, const Obj &obj)
+		{
+			Lock								lock(this->_mutex);
+			typename snapshot_type::iterator	it = this->_map.find(k);
+
+			if (it != this->_map.end())
+			{
+				it->second = obj;
+				return (false);
+			}
+			this->_map.insert(value_type(k, obj));
+			return (true);
+		};
+
+		size_type	erase(const Key &k)
+		{
+			Lock	lock(this->_mutex);
+			return (this->_map.erase(k));
+		};
+
+		// Applied to a copy, so that nothing is published if f throws.
+		template <typename Function>
+		void	update(Function f)
+		{
+			Lock			lock(this->_mutex);
+			snapshot_type	next(this->_map);
+
+			f(next);
+			this->_map.swap(next);
+		};
+
+		void	clear(void)
+		{
+			Lock	lock(this->_mutex);
+			this->_map.clear();
+		};
+
+		key_compare	key_comp(void) const { return (this->_map.key_comp()); };
+
+	private:
+		struct Lock
+		{
+			pthread_mutex_t	&m;
+
+			Lock(pthread_mutex_t &mutex) : m(mutex) { pthread_mutex_lock(&m); };
+			~Lock(void) { pthread_mutex_unlock(&m); };
+		};
+
+		t_concurrent_map(const t_concurrent_map &);
+		t_concurrent_map	&operator=(const t_concurrent_map &);
+
+		snapshot_type			_map;
+		mutable pthread_mutex_t	_mutex;
+};
+#else
+template <typename Key, typename Tp>
+class t_concurrent_map : public ft::concurrent_map<Key, Tp>
+{
+};
+#endif
+
+template <typename T>
+std::string	printPair(const T &iterator, bool nl = true, std::ostream &o = std::cout)
+{
+	o << "key: " << iterator->first << " | value: " << iterator->second;
+	if (nl)
+		o << std::endl;
+	return ("");
+}
+
+template <typename T_MAP>
+void	printSize(T_MAP const &mp, bool print_content = 1)
+{
+	std::cout << "size: " << mp.size() << std::endl;
+	if (print_content)
+	{
+		typename T_MAP::const_iterator it = mp.begin(), ite = mp.end();
+		std::cout << std::endl << "Content is:" << std::endl;
+		for (; it != ite; ++it)
+		{
+			std::cout << "- ";
+			printPair(it);
+		}
+	}
+	std::cout << "###############################################" << std::endl;
+}
@@ -0,0 +1,147 @@
+#include "common.hpp"
+
+#define T1 int
+#define T2 long
+
+typedef t_concurrent_map<T1, T2>	t_cmap;
+typedef t_cmap::snapshot_type		t_snap;
+
+// Writers publish every key k < PARTNER together with k + PARTNER, each
+// mapped to twice its key, and erase some pairs again; readers check
+// that they never see half of a pair or a wrong value.
+static const int	PARTNER = 1000000;
+static const int	WRITERS = 2;
+static const int	READERS = 3;
+static const int	PER_WRITER = 1500;
+
+struct Shared
+{
+	t_cmap	mp;
+	int		writers_left;
+	long	errors;
+	long	reads;
+};
+
+struct Args
+{
+	Shared	*shared;
+	int		id;
+};
+
+struct AddPair
+{
+	int		k;
+
+	AddPair(int key) : k(key) { };
+	void	operator()(t_snap &mp) const
+	{
+		mp.insert(t_snap::value_type(this->k, 2L * this->k));
+		mp.insert(t_snap::value_type(this->k + PARTNER, 2L * (this->k + PARTNER)));
+	};
+};
+
+struct ErasePair
+{
+	int		k;
+
+	ErasePair(int key) : k(key) { };
+	void	operator()(t_snap &mp) const
+	{
+		mp.erase(this->k);
+		mp.erase(this->k + PARTNER);
+	};
+};
+
+static void	*writer(void *p)
+{
+	Args	*args = static_cast<Args *>(p);
+	t_cmap	&mp = args->shared->mp;
+
+	for (int i = 0; i < PER_WRITER; ++i)
+	{
+		const int	k = args->id * PER_WRITER + i;
+		if (i % 3 == 0)
+			mp.insert(t_cmap::value_type(-1 - k, 2L * (-1 - k)));
+		else
+			mp.update(AddPair(k));
+		if (i % 4 == 0)
+			mp.update(ErasePair(k));
+	}
+	__sync_fetch_and_sub(&args->shared->writers_left, 1);
+	return (0);
+}
+
+static long	check_snapshot(const t_snap &snap)
+{
+	long	errors = 0;
+	size_t	pairs = 0, singles = 0;
+
+	for (t_snap::const_iterator it = snap.begin(); it != snap.end(); ++it)
+	{
+		errors += it->second != 2L * it->first;
+		if (it->first < 0)
+			++singles;
+		else if (it->first < PARTNER)
+		{
+			++pairs;
+			errors += snap.count(it->first + PARTNER) != 1;
+		}
+	}
+	errors += snap.size() != singles + 2 * pairs;
+	return (errors);
+}
+
+static void	*reader(void *p)
+{
+	Args		*args = static_cast<Args *>(p);
+	t_cmap		&mp = args->shared->mp;
+	long		errors = 0, reads = 0;
+	unsigned	seed = args->id + 1;
+
+	do
+	{
+		errors += check_snapshot(mp.snapshot());
+		errors += !mp.key_comp()(1, 2);
+		for (int i = 0; i < 200; ++i, ++reads)
+		{
+			seed = seed * 1103515245u + 12345u;
+			const int	k = static_cast<int>((seed >> 8) % (WRITERS * PER_WRITER));
+			T2			v = -1;
+			if (mp.find(k, v))
+				errors += v != 2L * k;
+		}
+	} while (__sync_fetch_and_add(&args->shared->writers_left, 0) > 0);
+	__sync_fetch_and_add(&args->shared->errors, errors);
+	__sync_fetch_and_add(&args->shared->reads, reads);
+	return (0);
+}
+
+int		main(void)
+{
+	Shared		shared;
+	pthread_t	threads[WRITERS + READERS];
+	Args		args[WRITERS + READERS];
+
+	shared.writers_left = WRITERS;
+	shared.errors = 0;
+	shared.reads = 0;
+	for (int i = 0; i < WRITERS + READERS; ++i)
+	{
+		args[i].shared = &shared;
+		args[i].id = i < WRITERS ? i : i - WRITERS;
+		pthread_create(&threads[i], 0, i < WRITERS ? &writer : &reader, &args[i]);
+	}
+	for (int i = 0; i < WRITERS + READERS; ++i)
+		pthread_join(threads[i], 0);
+
+	const t_snap	snap = shared.mp.snapshot();
+	long			sum = 0;
+	for (t_snap::const_iterator it = snap.begin(); it != snap.end(); ++it)
+		sum += it->first;
+	std::cout << "size: " << shared.mp.size() << std::endl;
+	std::cout << "key sum: " << sum << std::endl;
+	std::cout << "final errors: " << check_snapshot(snap) << std::endl;
+	std::cout << "reader errors: " << shared.errors << std::endl;
+	std::cout << "readers ran: " << (shared.reads > 0) << std::endl;
+	return (0);
+}
@@ -0,0 +1,98 @@
+#include "common.hpp"
+#include <list>
+
+#define T1 int
+#define T2 std::string
+
+typedef t_skiplist_map<T1, T2>	t_map;
+typedef _pair<const T1, T2>		T3;
+
+static void	printBounds(t_map &mp, const T1 &k)
+{
+	t_map::iterator		lo = mp.lower_bound(k), hi = mp.upper_bound(k);
+	_pair<t_map::iterator, t_map::iterator>	range = mp.equal_range(k);
+
+	std::cout << "bounds(" << k << "): ";
+	if (lo == mp.end())
+		std::cout << "end";
+	else
+		std::cout << lo->first;
+	std::cout << " ";
+	if (hi == mp.end())
+		std::cout << "end";
+	else
+		std::cout << hi->first;
+	std::cout << " equal_range ok: " << (range.first == lo && range.second == hi) << std::endl;
+}
+
+int		main(void)
+{
+	std::list<T3>	lst;
+	for (int i = 0; i < 12; ++i)
+		lst.push_back(T3((i * 7) % 12 * 5, std::string(1, 'a' + i)));
+
+	std::cout << "\t-- construction and insert --" << std::endl;
+	t_map	mp(lst.begin(), lst.end());
+	printSize(mp);
+	_pair<t_map::iterator, bool>	res = mp.insert(T3(15, "dup"));
+	std::cout << "insert 15: " << res.second << " -> ";
+	printPair(res.first);
+	res = mp.insert(T3(17, "new"));
+	std::cout << "insert 17: " << res.second << " -> ";
+	printPair(res.first);
+	t_map::iterator		hint = mp.insert(mp.begin(), T3(3, "hinted"));
+	printPair(hint);
+	mp[100] = "subscript";
+	mp[15] = "assigned";
+	std::cout << "at(100): " << mp.at(100) << std::endl;
+	try
+	{
+		mp.at(101);
+	}
+	catch (std::out_of_range &)
+	{
+		std::cout << "at(101): out_of_range" << std::endl;
+	}
+	printSize(mp);
+	printReverse(mp);
+
+	std::cout << "\t-- lookups --" << std::endl;
+	std::cout << "count(17): " << mp.count(17) << " count(18): " << mp.count(18) << std::endl;
+	std::cout << "find(18) == end: " << (mp.find(18) == mp.end()) << std::endl;
+	printPair(mp.find(40));
+	printBounds(mp, 17);
+	printBounds(mp, 18);
+	printBounds(mp, 100);
+	printBounds(mp, -5);
+
+	std::cout << "\t-- erase --" << std::endl;
+	std::cout << "erase(17): " << mp.erase(17) << std::endl;
+	std::cout << "erase(17) again: " << mp.erase(17) << std::endl;
+	mp.erase(mp.find(3));
+	{
+		t_map::pin		p(mp);
+		t_map::iterator	first = mp.lower_bound(20), last = mp.lower_bound(45);
+		mp.erase(first, last);
+	}
+	mp.quiesce();
+	printSize(mp);
+	printReverse(mp);
+
+	std::cout << "\t-- copies, comparison and swap --" << std::endl;
+	t_map	copy(mp);
+	std::cout << "== " << (copy == mp) << " < " << (copy < mp) << std::endl;
+	copy[1] = "one";
+	std::cout << "== " << (copy == mp) << " < " << (copy < mp) << " > " << (copy > mp) << std::endl;
+	t_map	other;
+	other[-1] = "minus";
+	other = copy;
+	printSize(other);
+	other.clear();
+	other[-2] = "alone";
+	other.swap(mp);
+	printSize(mp);
+	printSize(other);
+	mp.clear();
+	std::cout << "empty: " << mp.empty() << " begin == end: " << (mp.begin() == mp.end()) << std::endl;
+	return (0);
+}
@@ -0,0 +1,102 @@
+#include "../base.hpp"
+#include <pthread.h>
+#if !defined(USING_STD)
+# include "concurrent_skiplist_map.hpp"
+#else
+# include <map>
+#endif /* !defined(STD) */
+
+#define _pair TESTED_NAMESPACE::pair
+
+#if defined(USING_STD)
+// The STL has no concurrent map: single-threaded tests run against a
+// plain std::map, for which pins and quiesce() do nothing.
+template <typename Key, typename Tp>
+class t_skiplist_map : public std::map<Key, Tp>
+{
+	public:
+		typedef std::map<Key, Tp>	base;
+
+		class pin
+		{
+			public:
+				explicit pin(const t_skiplist_map &) { };
+		};
+
+		t_skiplist_map(void) : base() { };
+		template <typename InputIterator>
+		t_skiplist_map(InputIterator first, InputIterator last) : base(first, last) { };
+
+		void	quiesce(void) { };
+};
+#else
+template <typename Key, typename Tp>
+class t_skiplist_map : public ft::concurrent_skiplist_map<Key, Tp>
+{
+	public:
+		typedef ft::concurrent_skiplist_map<Key, Tp>	base;
+
+		t_skiplist_map(void) : base() { };
+		template <typename InputIterator>
+		t_skiplist_map(InputIterator first, InputIterator last) : base(first, last) { };
+};
+#endif
+
+// Starts a thread.  std::map is not thread-safe, so under std each thread
+// runs to completion before the next one starts.
+inline void	startThread(pthread_t *th, void *(*fn)(void *), void *arg)
+{
+	pthread_create(th, 0, fn, arg);
+#if defined(USING_STD)
+	pthread_join(*th, 0);
+#endif
+}
+
+inline void	joinThread(pthread_t th)
+{
+#if defined(USING_STD)
+	(void)th;
+#else
+	pthread_join(th, 0);
+#endif
+}
+
+template <typename T>
+std::string	printPair(const T &iterator, bool nl = true, std::ostream &o = std::cout)
+{
+	o << "key: " << iterator->first << " | value: " << iterator->second;
+	if (nl)
+		o << std::endl;
+	return ("");
+}
+
+template <typename T_MAP>
+void	printSize(T_MAP const &mp, bool print_content = 1)
+{
+	std::cout << "size: " << mp.size() << std::endl;
+	if (print_content)
+	{
+		typename T_MAP::const_iterator it = mp.begin(), ite = mp.end();
+		std::cout << std::endl << "Content is:" << std::endl;
+		for (; it != ite; ++it)
+		{
+			std::cout << "- ";
+			printPair(it);
+		}
+	}
+	std::cout << "###############################################" << std::endl;
+}
+
+template <typename T_MAP>
+void	printReverse(T_MAP &mp)
+{
+	typename T_MAP::reverse_iterator	it = mp.rbegin(), ite = mp.rend();
+
+	std::cout << "printReverse:" << std::endl;
+	for (; it != ite; ++it)
+	{
+		std::cout << "-> ";
+		printPair(it);
+	}
+	std::cout << "_______________________________________________" << std::endl;
+}
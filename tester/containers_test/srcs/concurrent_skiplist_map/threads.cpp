@@ -0,0 +1,143 @@
+#include "common.hpp"
+
+#define T1 int
+#define T2 long
+
+typedef t_skiplist_map<T1, T2>	t_map;
+
+// Writers insert keys of their own, each mapped to twice itself, and
+// erase every third one again; all of them also race to erase the same
+// SHARED keys, of which each must go exactly once.  Readers, pinned,
+// walk the map meanwhile and check that it stays ordered and that every
+// value matches its key.
+static const int	WRITERS = 4;
+static const int	READERS = 2;
+static const int	PER_WRITER = 3000;
+static const int	SHARED = 1000;
+static const int	SHARED_BASE = 1000000;
+
+struct Shared
+{
+	t_map	mp;
+	int		writers_left;
+	long	erased_shared;
+	long	errors;
+	long	walks;
+};
+
+struct Args
+{
+	Shared	*shared;
+	int		id;
+};
+
+static void	*writer(void *p)
+{
+	Args	*args = static_cast<Args *>(p);
+	t_map	&mp = args->shared->mp;
+	long	erased = 0;
+
+	for (int i = 0; i < PER_WRITER; ++i)
+	{
+		const int	k = args->id * PER_WRITER + i;
+		mp.insert(t_map::value_type(k, 2L * k));
+		if (i % 2 == 0)
+			erased += mp.erase(SHARED_BASE + (i / 2 + args->id * 97) % SHARED);
+	}
+	for (int i = 0; i < PER_WRITER; i += 3)
+		mp.erase(args->id * PER_WRITER + i);
+	for (int i = 0; i < SHARED; ++i)
+		erased += mp.erase(SHARED_BASE + i);
+	__sync_fetch_and_add(&args->shared->erased_shared, erased);
+	__sync_fetch_and_sub(&args->shared->writers_left, 1);
+	return (0);
+}
+
+static long	check_walk(const t_map &mp)
+{
+	long	errors = 0;
+	T1		prev = -1;
+
+	for (t_map::const_iterator it = mp.begin(); it != mp.end(); ++it)
+	{
+		errors += it->first <= prev;
+		errors += it->second != 2L * it->first;
+		prev = it->first;
+	}
+	return (errors);
+}
+
+static void	*reader(void *p)
+{
+	Args		*args = static_cast<Args *>(p);
+	t_map		&mp = args->shared->mp;
+	long		errors = 0, walks = 0;
+	unsigned	seed = args->id + 1;
+
+	do
+	{
+		{
+			t_map::pin	pin(mp);
+			errors += check_walk(mp);
+			// A step back searches from the head: only a few.
+			int		steps = 0;
+			T1		prev = SHARED_BASE + SHARED;
+			for (t_map::reverse_iterator it = mp.rbegin(); it != mp.rend() && steps < 20; ++it, ++steps)
+			{
+				errors += it->first >= prev;
+				prev = it->first;
+			}
+		}
+		for (int i = 0; i < 100; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			const T1				k = static_cast<T1>((seed >> 8) % (WRITERS * PER_WRITER));
+			t_map::const_iterator	it = mp.find(k);
+			if (it != mp.end())
+				errors += it->second != 2L * k;
+		}
+		++walks;
+	} while (__sync_fetch_and_add(&args->shared->writers_left, 0) > 0);
+	__sync_fetch_and_add(&args->shared->errors, errors);
+	__sync_fetch_and_add(&args->shared->walks, walks);
+	return (0);
+}
+
+int		main(void)
+{
+	Shared		shared;
+	pthread_t	threads[WRITERS + READERS];
+	Args		args[WRITERS + READERS];
+
+	for (int i = 0; i < SHARED; ++i)
+		shared.mp.insert(t_map::value_type(SHARED_BASE + i, 2L * (SHARED_BASE + i)));
+	shared.writers_left = WRITERS;
+	shared.erased_shared = 0;
+	shared.errors = 0;
+	shared.walks = 0;
+	for (int i = 0; i < WRITERS + READERS; ++i)
+	{
+		args[i].shared = &shared;
+		args[i].id = i < WRITERS ? i : i - WRITERS;
+		startThread(&threads[i], i < WRITERS ? &writer : &reader, &args[i]);
+	}
+	for (int i = 0; i < WRITERS + READERS; ++i)
+		joinThread(threads[i]);
+
+	t_map	&mp = shared.mp;
+	long	sum = 0;
+	for (t_map::iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->first;
+	long	reverse_sum = 0;
+	for (t_map::reverse_iterator it = mp.rbegin(); it != mp.rend(); ++it)
+		reverse_sum += it->first;
+	std::cout << "size: " << mp.size() << " key sum: " << sum << " reverse sum: " << reverse_sum << std::endl;
+	std::cout << "shared keys erased: " << shared.erased_shared << " of " << SHARED << std::endl;
+	std::cout << "walk errors: " << check_walk(mp) << " reader errors: " << shared.errors << std::endl;
+	std::cout << "readers ran: " << (shared.walks >= READERS) << std::endl;
+	mp.quiesce();
+	std::cout << "after quiesce: " << mp.size() << " " << check_walk(mp) << std::endl;
+	mp.clear();
+	std::cout << "cleared: " << mp.size() << " " << mp.empty() << std::endl;
+	return (0);
+}
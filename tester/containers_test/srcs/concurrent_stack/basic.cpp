@@ -0,0 +1,44 @@
+#include "common.hpp"
+#include <list>
+
+#define TESTED_TYPE std::string
+
+typedef t_concurrent_stack<TESTED_TYPE>	t_stack;
+
+static void	exercise(t_stack &st)
+{
+	TESTED_TYPE		x = "untouched";
+
+	std::cout << "empty: " << st.empty() << std::endl;
+	std::cout << "try_pop on empty: " << st.try_pop(x) << " -> " << x << std::endl;
+	st.push("one");
+	st.push("two");
+	std::cout << "empty: " << st.empty() << std::endl;
+	st.pop(x);
+	std::cout << "pop: " << x << std::endl;
+	st.push("three");
+	printDrain(st);
+
+	// The last element of a batch ends on top, as if pushed one by one.
+	std::list<TESTED_TYPE>	lst;
+	for (int i = 0; i < 6; ++i)
+		lst.push_back(std::string(i + 1, 'a' + i));
+	st.push("below");
+	st.push(lst.begin(), lst.end());
+	st.push(lst.end(), lst.end());
+	std::cout << "try_pop: " << st.try_pop(x) << " -> " << x << std::endl;
+	st.push("above");
+	printDrain(st);
+}
+
+int		main(void)
+{
+	std::cout << "\t-- no elimination --" << std::endl;
+	t_stack	st;
+	exercise(st);
+
+	std::cout << "\t-- elimination(4) --" << std::endl;
+	t_stack	elim(4);
+	exercise(elim);
+	return (0);
+}
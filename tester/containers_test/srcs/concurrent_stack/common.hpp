@@ -0,0 +1,94 @@
+#include "../base.hpp"
+#include <pthread.h>
+#include <sched.h>
+#if !defined(USING_STD)
+# include "concurrent_stack.hpp"
+#else
+# include <stack>
+#endif /* !defined(STD) */
+
+#if defined(USING_STD)
+// The STL has no concurrent stack: a std::stack behind one mutex, which
+// ignores the elimination array.
+template <typename T>
+class t_concurrent_stack
+{
+	public:
+		typedef T			value_type;
+		typedef size_t		size_type;
+
+		explicit t_concurrent_stack(size_type = 0) { pthread_mutex_init(&this->_mutex, 0); };
+		~t_concurrent_stack(void) { pthread_mutex_destroy(&this->_mutex); };
+
+		bool	empty(void) const
+		{
+			Lock	lock(this->_mutex);
+			return (this->_stack.empty());
+		};
+
+		void	push(const value_type &x)
+		{
+			Lock	lock(this->_mutex);
+			this->_stack.push(x);
+		};
+
+		template <typename InputIterator>
+		void	push(InputIterator first, InputIterator last)
+		{
+			Lock	lock(this->_mutex);
+			for (; first != last; ++first)
+				this->_stack.push(*first);
+		};
+
+		bool	try_pop(value_type &x)
+		{
+			Lock	lock(this->_mutex);
+			if (this->_stack.empty())
+				return (false);
+			x = this->_stack.top();
+			this->_stack.pop();
+			return (true);
+		};
+
+		void	pop(value_type &x)
+		{
+			while (!this->try_pop(x))
+				sched_yield();
+		};
+
+	private:
+		struct Lock
+		{
+			pthread_mutex_t	&m;
+
+			Lock(pthread_mutex_t &mutex) : m(mutex) { pthread_mutex_lock(&m); };
+			~Lock(void) { pthread_mutex_unlock(&m); };
+		};
+
+		t_concurrent_stack(const t_concurrent_stack &);
+		t_concurrent_stack	&operator=(const t_concurrent_stack &);
+
+		std::stack<T>			_stack;
+		mutable pthread_mutex_t	_mutex;
+};
+#else
+template <typename T>
+class t_concurrent_stack : public ft::concurrent_stack<T>
+{
+	public:
+		explicit t_concurrent_stack(size_t elimination = 0) : ft::concurrent_stack<T>(elimination) { };
+};
+#endif
+
+// Pops everything, printing it top first.
+template <typename T_STACK>
+void	printDrain(T_STACK &st)
+{
+	typename T_STACK::value_type	x;
+
+	std::cout << "Content was:";
+	while (st.try_pop(x))
+		std::cout << " " << x;
+	std::cout << std::endl << "empty: " << st.empty() << std::endl;
+	std::cout << "###############################################" << std::endl;
+}
@@ -0,0 +1,99 @@
+#include "common.hpp"
+
+// Every thread alternates pushes, single or in batches of 8, with as many
+// pops, so that all of them contend on the head (and, given slots, meet
+// in the elimination array).  Each pop waits, and never for long: a
+// thread about to pop has pushed more than it popped.  In the end the
+// stack must be empty, and the popped numbers must be the pushed ones.
+static const long	ROUNDS = 4000;
+
+struct Shared
+{
+	t_concurrent_stack<long>	*st;
+	long						popped;
+	long						sum;
+	long						xor_sum;
+};
+
+struct Args
+{
+	Shared	*shared;
+	long	id;
+};
+
+static void	*worker(void *p)
+{
+	Args	*args = static_cast<Args *>(p);
+	Shared	&shared = *args->shared;
+	long	batch[8], x, popped = 0, sum = 0, xor_sum = 0;
+
+	for (long r = 0; r < ROUNDS; ++r)
+	{
+		const long	base = (args->id * ROUNDS + r) * 8;
+		long		n = 1;
+		if (r % 4 == 0)
+		{
+			for (n = 0; n < 8; ++n)
+				batch[n] = base + n;
+			shared.st->push(batch, batch + 8);
+		}
+		else
+			shared.st->push(base);
+		for (long i = 0; i < n; ++i)
+		{
+			if (i % 2 == 0)
+				shared.st->pop(x);
+			else if (!shared.st->try_pop(x))
+				shared.st->pop(x);
+			++popped;
+			sum += x;
+			xor_sum ^= x;
+		}
+	}
+	__sync_fetch_and_add(&shared.popped, popped);
+	__sync_fetch_and_add(&shared.sum, sum);
+	__sync_fetch_and_xor(&shared.xor_sum, xor_sum);
+	return (0);
+}
+
+static void	run(size_t elimination, long threads)
+{
+	t_concurrent_stack<long>	st(elimination);
+	Shared						shared = { &st, 0, 0, 0 };
+	pthread_t					th[16];
+	Args						args[16];
+	long						pushed = 0, sum = 0, xor_sum = 0;
+
+	for (long t = 0; t < threads; ++t)
+	{
+		args[t].shared = &shared;
+		args[t].id = t;
+		pthread_create(&th[t], 0, &worker, &args[t]);
+	}
+	for (long t = 0; t < threads; ++t)
+		pthread_join(th[t], 0);
+	for (long t = 0; t < threads; ++t)
+		for (long r = 0; r < ROUNDS; ++r)
+			for (long n = 0; n < (r % 4 == 0 ? 8 : 1); ++n)
+			{
+				const long	x = (t * ROUNDS + r) * 8 + n;
+				++pushed;
+				sum += x;
+				xor_sum ^= x;
+			}
+	std::cout << "elimination " << elimination << ", " << threads << " thread(s): popped " << shared.popped
+		<< " of " << pushed << " sum ok " << (shared.sum == sum) << " xor ok " << (shared.xor_sum == xor_sum)
+		<< " empty " << st.empty() << std::endl;
+}
+
+int		main(void)
+{
+	const long	threads[] = { 1, 2, 4, 8 };
+
+	for (size_t i = 0; i < sizeof(threads) / sizeof(*threads); ++i)
+	{
+		run(0, threads[i]);
+		run(4, threads[i]);
+	}
+	return (0);
+}
@@ -0,0 +1,83 @@
+#include "../base.hpp"
+#if !defined(USING_STD)
+# include "interval_map.hpp"
+#else
+# include <map>
+#endif /* !defined(STD) */
+
+#define _pair TESTED_NAMESPACE::pair
+
+#if defined(USING_STD)
+// The STL has no interval map: a map ordered by lower then upper end, as
+// ft::interval_map is, with the overlap queries done by linear scans.
+template <typename Key, typename Tp>
+class t_interval_map : public std::map<std::pair<Key, Key>, Tp>
+{
+	public:
+		typedef std::map<std::pair<Key, Key>, Tp>	base;
+		typedef typename base::iterator				iterator;
+		typedef typename base::const_iterator		const_iterator;
+
+		const_iterator	find_overlap(const Key &lo, const Key &hi) const
+		{
+			const_iterator	it = this->begin();
+			while (it != this->end() && !(it->first.first < hi && lo < it->first.second))
+				++it;
+			return (it);
+		};
+
+		iterator	find_overlap(const Key &lo, const Key &hi)
+		{
+			iterator	it = this->begin();
+			while (it != this->end() && !(it->first.first < hi && lo < it->first.second))
+				++it;
+			return (it);
+		};
+
+		template <typename OutputIterator>
+		OutputIterator	find_overlaps(const Key &lo, const Key &hi, OutputIterator out) const
+		{
+			for (const_iterator it = this->begin(); it != this->end(); ++it)
+				if (it->first.first < hi && lo < it->first.second)
+					*out++ = it;
+			return (out);
+		};
+
+		bool	overlaps(const Key &lo, const Key &hi) const
+		{
+			return (this->find_overlap(lo, hi) != this->end());
+		};
+};
+#else
+template <typename Key, typename Tp>
+class t_interval_map : public ft::interval_map<Key, Tp>
+{
+};
+#endif
+
+template <typename T>
+std::string	printInterval(const T &iterator, bool nl = true, std::ostream &o = std::cout)
+{
+	o << "[" << iterator->first.first << ", " << iterator->first.second
+		<< "): " << iterator->second;
+	if (nl)
+		o << std::endl;
+	return ("");
+}
+
+template <typename T_MAP>
+void	printSize(T_MAP const &mp, bool print_content = 1)
+{
+	std::cout << "size: " << mp.size() << std::endl;
+	if (print_content)
+	{
+		typename T_MAP::const_iterator it = mp.begin(), ite = mp.end();
+		std::cout << std::endl << "Content is:" << std::endl;
+		for (; it != ite; ++it)
+		{
+			std::cout << "- ";
+			printInterval(it);
+		}
+	}
+	std::cout << "###############################################" << std::endl;
+}
@@ -0,0 +1,83 @@
+#include "common.hpp"
+#include <vector>
+#include <iterator>
+
+#define T1 int
+#define T2 std::string
+
+typedef t_interval_map<T1, T2>	t_imap;
+
+static t_imap	mp;
+
+static void	query(const T1 &lo, const T1 &hi)
+{
+	std::vector<t_imap::const_iterator>	found;
+	const t_imap						&cmp = mp;
+
+	cmp.find_overlaps(lo, hi, std::back_inserter(found));
+	std::cout << "[" << lo << ", " << hi << "): overlaps " << mp.overlaps(lo, hi)
+		<< ", " << found.size() << " found" << std::endl;
+	for (size_t i = 0; i < found.size(); ++i)
+	{
+		std::cout << "  - ";
+		printInterval(found[i]);
+	}
+	t_imap::iterator	first = mp.find_overlap(lo, hi);
+	std::cout << "  first: ";
+	if (first == mp.end())
+		std::cout << "end()" << std::endl;
+	else
+		printInterval(first);
+	if (found.empty() ? first != mp.end() : t_imap::const_iterator(first) != found[0])
+		std::cout << "  find_overlap disagrees with find_overlaps" << std::endl;
+}
+
+int		main(void)
+{
+	query(0, 100);
+
+	mp[_pair<T1, T1>(0, 10)] = "a";
+	mp[_pair<T1, T1>(5, 15)] = "b";
+	mp[_pair<T1, T1>(5, 7)] = "c";
+	mp[_pair<T1, T1>(20, 30)] = "d";
+	mp[_pair<T1, T1>(25, 26)] = "e";
+	mp[_pair<T1, T1>(-10, 100)] = "f";
+	mp[_pair<T1, T1>(40, 41)] = "g";
+	mp[_pair<T1, T1>(41, 42)] = "h";
+	mp[_pair<T1, T1>(60, 90)] = "i";
+	mp[_pair<T1, T1>(70, 71)] = "j";
+	printSize(mp);
+
+	std::cout << "\t-- windows --" << std::endl;
+	query(-20, -10);
+	query(-20, -9);
+	query(0, 1);
+	query(6, 7);
+	query(10, 20);
+	query(15, 20);
+	query(26, 40);
+	query(41, 41);
+	query(40, 42);
+	query(100, 200);
+	query(99, 100);
+	query(-1000, 1000);
+
+	std::cout << "\t-- without the long interval --" << std::endl;
+	mp.erase(_pair<T1, T1>(-10, 100));
+	query(-20, -9);
+	query(15, 20);
+	query(30, 40);
+	query(42, 60);
+	query(65, 75);
+	query(89, 95);
+	query(90, 95);
+
+	std::cout << "\t-- exact lookups still work --" << std::endl;
+	std::cout << "count([5, 7)): " << mp.count(_pair<T1, T1>(5, 7))
+		<< " count([5, 8)): " << mp.count(_pair<T1, T1>(5, 8)) << std::endl;
+	t_imap::iterator	it = mp.find(_pair<T1, T1>(20, 30));
+	printInterval(it);
+	it = mp.lower_bound(_pair<T1, T1>(5, 8));
+	printInterval(it);
+	return (0);
+}
@@ -0,0 +1,94 @@
+#include "common.hpp"
+#include <vector>
+#include <iterator>
+
+#define T1 int
+#define T2 int
+
+typedef t_interval_map<T1, T2>	t_imap;
+
+static unsigned	seed = 11;
+
+static unsigned	next(void)
+{
+	seed = seed * 1103515245u + 12345u;
+	return (seed >> 8);
+}
+
+// Overlap queries over the whole key range, compared against a scan.
+static void	checkQueries(const t_imap &mp)
+{
+	long	total = 0;
+	int		bad = 0;
+
+	for (T1 lo = -20; lo < 1050; lo += 13)
+	{
+		const T1	hi = lo + static_cast<T1>(next() % 60);
+		std::vector<t_imap::const_iterator>	found, expected;
+
+		mp.find_overlaps(lo, hi, std::back_inserter(found));
+		for (t_imap::const_iterator it = mp.begin(); it != mp.end(); ++it)
+			if (it->first.first < hi && lo < it->first.second)
+				expected.push_back(it);
+		if (found != expected || mp.overlaps(lo, hi) != !expected.empty())
+			++bad;
+		if (mp.find_overlap(lo, hi) != (expected.empty() ? mp.end() : expected[0]))
+			++bad;
+		total += found.size();
+	}
+	std::cout << "size: " << mp.size() << " matches: " << total << " bad: " << bad << std::endl;
+}
+
+int		main(void)
+{
+	t_imap	mp;
+
+	for (int i = 0; i < 400; ++i)
+	{
+		const T1	lo = next() % 1000;
+		mp.insert(_pair<const _pair<T1, T1>, T2>(_pair<T1, T1>(lo, lo + 1 + next() % 50), i));
+	}
+	checkQueries(mp);
+
+	std::cout << "\t-- erase by iterator, key and range --" << std::endl;
+	for (int i = 0; i < 50; ++i)
+	{
+		t_imap::iterator	it = mp.lower_bound(_pair<T1, T1>(next() % 1000, 0));
+		if (it != mp.end())
+			mp.erase(it);
+	}
+	std::cout << "erase(key): " << mp.erase(mp.begin()->first) << std::endl;
+	std::cout << "erase(missing key): " << mp.erase(_pair<T1, T1>(5000, 5001)) << std::endl;
+	mp.erase(mp.lower_bound(_pair<T1, T1>(300, 0)), mp.lower_bound(_pair<T1, T1>(400, 0)));
+	checkQueries(mp);
+
+	std::cout << "\t-- interleaved --" << std::endl;
+	for (int i = 0; i < 3000; ++i)
+	{
+		const T1	lo = next() % 1000;
+		const T1	hi = lo + 1 + next() % 80;
+		if (next() % 3)
+			mp[_pair<T1, T1>(lo, hi)] += i;
+		else
+			mp.erase(mp.lower_bound(_pair<T1, T1>(lo, 0)), mp.lower_bound(_pair<T1, T1>(lo + 5, 0)));
+	}
+	checkQueries(mp);
+
+	std::cout << "\t-- copy, assignment, swap, clear --" << std::endl;
+	t_imap	cpy(mp);
+	t_imap	asg;
+	asg = mp;
+	cpy.erase(cpy.begin(), cpy.lower_bound(_pair<T1, T1>(500, 0)));
+	asg.insert(_pair<const _pair<T1, T1>, T2>(_pair<T1, T1>(-100, 2000), -1));
+	checkQueries(cpy);
+	checkQueries(asg);
+	checkQueries(mp);
+	cpy.swap(asg);
+	checkQueries(cpy);
+	checkQueries(asg);
+	mp.clear();
+	checkQueries(mp);
+	mp[_pair<T1, T1>(1, 2)] = 3;
+	printSize(mp);
+	return (0);
+}
@@ -0,0 +1,72 @@
+#include "common.hpp"
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#define TESTED_TYPE int
+
+typedef TESTED_NAMESPACE::list<TESTED_TYPE> t_list;
+
+// Throws on its n-th call.
+struct throwing_less {
+	long	*left;
+
+	throwing_less(long *n) : left(n) { }
+	bool	operator()(const TESTED_TYPE &a, const TESTED_TYPE &b) const
+	{
+		if ((*left)-- == 0)
+			throw std::runtime_error("comparison");
+		return (a < b);
+	}
+};
+
+// The elements must all still be there, and the links agree both ways,
+// wherever the sort was interrupted; their order is unspecified.
+static bool	intact(const t_list &lst, const std::vector<TESTED_TYPE> &sorted)
+{
+	std::vector<TESTED_TYPE>	fwd(lst.begin(), lst.end());
+	std::vector<TESTED_TYPE>	bwd(lst.rbegin(), lst.rend());
+
+	std::reverse(bwd.begin(), bwd.end());
+	if (fwd != bwd || fwd.size() != lst.size())
+		return (false);
+	std::sort(fwd.begin(), fwd.end());
+	return (fwd == sorted);
+}
+
+int		main(void)
+{
+	std::vector<TESTED_TYPE>	values;
+	unsigned					seed = 7;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		values.push_back(static_cast<TESTED_TYPE>((seed >> 8) % 500));
+	}
+	std::vector<TESTED_TYPE>	sorted(values);
+	std::sort(sorted.begin(), sorted.end());
+
+	int		broken = 0, runs = 0;
+	for (long calls = 0; calls < 12000; calls += 97, ++runs)
+	{
+		t_list	lst(values.begin(), values.end());
+		long	left = calls;
+		try
+		{
+			lst.sort(throwing_less(&left));
+		}
+		catch (std::runtime_error &)
+		{
+		}
+		broken += !intact(lst, sorted);
+	}
+	std::cout << "runs: " << runs << " broken: " << broken << std::endl;
+
+	t_list	lst(values.begin(), values.end());
+	long	left = -1;
+	lst.sort(throwing_less(&left));
+	std::cout << "sorted: " << (std::vector<TESTED_TYPE>(lst.begin(), lst.end()) == sorted) << std::endl;
+	std::cout << "intact: " << intact(lst, sorted) << std::endl;
+	return (0);
+}
@@ -0,0 +1,159 @@
+#include "common.hpp"
+#include <limits>
+#include <algorithm>
+
+#define T1 int
+
+// Concatenation: associative but not commutative, so it also checks that
+// the pieces are combined in key order.
+struct Concat
+{
+	typedef std::string	result_type;
+
+	static std::string	identity(void) { return (""); }
+	static std::string	combine(const std::string &a, const std::string &b) { return (a + b); }
+	static const std::string	&lift(const _pair<const T1, std::string> &v) { return (v.second); }
+};
+
+#if defined(USING_STD)
+typedef std::map<T1, long>			t_sum_map;
+typedef std::map<T1, int>			t_min_map;
+typedef std::map<T1, std::string>	t_cat_map;
+
+// std::map keeps no aggregates: fold the range instead.
+static long	sum(const t_sum_map &mp, const T1 &lo, const T1 &hi)
+{
+	long	res = 0;
+	for (t_sum_map::const_iterator it = mp.lower_bound(lo); it != mp.end() && it->first < hi; ++it)
+		res += it->second;
+	return (res);
+}
+
+static int	minimum(const t_min_map &mp, const T1 &lo, const T1 &hi)
+{
+	int		res = std::numeric_limits<int>::max();
+	for (t_min_map::const_iterator it = mp.lower_bound(lo); it != mp.end() && it->first < hi; ++it)
+		res = std::min(res, it->second);
+	return (res);
+}
+
+static std::string	concat(const t_cat_map &mp, const T1 &lo, const T1 &hi)
+{
+	std::string	res;
+	for (t_cat_map::const_iterator it = mp.lower_bound(lo); it != mp.end() && it->first < hi; ++it)
+		res += it->second;
+	return (res);
+}
+
+template <typename T_MAP>
+static void	refresh(T_MAP &, typename T_MAP::iterator) { }
+#else
+typedef ft::map<T1, long, std::less<T1>, std::allocator<ft::pair<const T1, long> >,
+	ft::Rb_tree_aggregate_node_update<ft::plus_monoid<long> > >	t_sum_map;
+typedef ft::map<T1, int, std::less<T1>, std::allocator<ft::pair<const T1, int> >,
+	ft::Rb_tree_aggregate_node_update<ft::min_monoid<int> > >	t_min_map;
+typedef ft::map<T1, std::string, std::less<T1>, std::allocator<ft::pair<const T1, std::string> >,
+	ft::Rb_tree_aggregate_node_update<Concat> >				t_cat_map;
+
+static long	sum(const t_sum_map &mp, const T1 &lo, const T1 &hi)
+{
+	return (mp.accumulate(lo, hi));
+}
+
+static int	minimum(const t_min_map &mp, const T1 &lo, const T1 &hi)
+{
+	return (mp.accumulate(lo, hi));
+}
+
+static std::string	concat(const t_cat_map &mp, const T1 &lo, const T1 &hi)
+{
+	return (mp.accumulate(lo, hi));
+}
+
+template <typename T_MAP>
+static void	refresh(T_MAP &mp, typename T_MAP::iterator it)
+{
+	mp.refresh(it);
+}
+#endif
+
+static void	printRanges(const t_sum_map &s, const t_min_map &m, const t_cat_map &c)
+{
+	const T1	ranges[][2] = { { 0, 100 }, { -50, 0 }, { 10, 11 }, { 10, 10 },
+		{ 20, 10 }, { 13, 77 }, { 99, 200 }, { -1000, 1000 } };
+
+	for (unsigned i = 0; i < sizeof(ranges) / sizeof(*ranges); ++i)
+	{
+		const T1	lo = ranges[i][0], hi = ranges[i][1];
+		std::cout << "[" << lo << ", " << hi << "): sum " << sum(s, lo, hi)
+			<< " min " << minimum(m, lo, hi) << " concat \"" << concat(c, lo, hi)
+			<< "\"" << std::endl;
+	}
+}
+
+int		main(void)
+{
+	t_sum_map	s;
+	t_min_map	m;
+	t_cat_map	c;
+
+	printRanges(s, m, c);
+	for (int i = 0; i < 100; i += 3)
+	{
+		s.insert(_pair<const T1, long>(i, i * 7 - 300));
+		m.insert(_pair<const T1, int>(i, (i * 37) % 101));
+		c.insert(_pair<const T1, std::string>(i, std::string(1, 'a' + i % 26)));
+	}
+	printRanges(s, m, c);
+
+	std::cout << "\t-- erase --" << std::endl;
+	s.erase(30);
+	m.erase(m.begin());
+	c.erase(c.lower_bound(40), c.lower_bound(60));
+	printRanges(s, m, c);
+
+	std::cout << "\t-- update then refresh --" << std::endl;
+	t_sum_map::iterator	sit = s.find(45);
+	sit->second = 100000;
+	refresh(s, sit);
+	t_min_map::iterator	mit = m.find(51);
+	mit->second = -7;
+	refresh(m, mit);
+	t_cat_map::iterator	cit = c.find(15);
+	cit->second = "XYZ";
+	refresh(c, cit);
+	printRanges(s, m, c);
+
+	std::cout << "\t-- random updates --" << std::endl;
+	unsigned	seed = 7;
+	int			bad = 0;
+	for (int i = 0; i < 4000; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		const int	k = (seed >> 8) % 300;
+		const long	v = static_cast<long>((seed >> 4) % 1000) - 500;
+		if (seed & 2)
+		{
+			s.insert(_pair<const T1, long>(k, v));
+			t_sum_map::iterator	it = s.find(k);
+			it->second = v;
+			refresh(s, it);
+		}
+		else
+			s.erase(k);
+		const int	lo = (seed >> 12) % 320 - 10;
+		long		expected = 0;
+		for (t_sum_map::iterator it = s.lower_bound(lo); it != s.end() && it->first < lo + 40; ++it)
+			expected += it->second;
+		if (sum(s, lo, lo + 40) != expected)
+			++bad;
+	}
+	std::cout << "size: " << s.size() << " total: " << sum(s, -1, 1000)
+		<< " bad: " << bad << std::endl;
+
+	t_sum_map	cpy(s);
+	cpy.erase(cpy.begin());
+	std::cout << "copy total: " << sum(cpy, -1, 1000) << " original total: "
+		<< sum(s, -1, 1000) << std::endl;
+	return (0);
+}
@@ -0,0 +1,112 @@
+#include "common.hpp"
+
+#define T1 int
+#define T2 std::string
+
+typedef TESTED_NAMESPACE::map<T1, T2> t_map;
+
+#if defined(USING_STD)
+// std::map has no cursor: the same lookups, made from the root.
+class t_cursor
+{
+	public:
+		t_cursor(t_map &c) : _cont(&c), _pos(c.end()) { };
+
+		t_map::iterator	position(void) const { return this->_pos; };
+		void			seek(t_map::iterator it) { this->_pos = it; };
+		t_map::iterator	lower_bound(const T1 &k) { return this->_pos = this->_cont->lower_bound(k); };
+		t_map::iterator	upper_bound(const T1 &k) { return this->_pos = this->_cont->upper_bound(k); };
+		t_map::iterator	find(const T1 &k)
+		{
+			this->lower_bound(k);
+			if (this->_pos == this->_cont->end() || k < this->_pos->first)
+				return (this->_cont->end());
+			return (this->_pos);
+		};
+
+	private:
+		t_map			*_cont;
+		t_map::iterator	_pos;
+};
+#else
+typedef t_map::cursor t_cursor;
+#endif
+
+static t_map	mp;
+
+static void	printIt(const char *what, const T1 &k, t_map::iterator it)
+{
+	std::cout << what << "(" << k << "): ";
+	if (it == mp.end())
+		std::cout << "end()" << std::endl;
+	else
+		printPair(it);
+}
+
+int		main(void)
+{
+	for (int i = 0; i < 200; i += 4)
+		mp[i] = std::string(1, 'a' + i % 26);
+
+	t_cursor	cur(mp);
+	std::cout << "initially at end: " << (cur.position() == mp.end()) << std::endl;
+
+	std::cout << "\t-- sliding forward --" << std::endl;
+	for (int k = -3; k < 30; k += 5)
+	{
+		printIt("lower_bound", k, cur.lower_bound(k));
+		printIt("find", k, cur.find(k));
+	}
+
+	std::cout << "\t-- sliding backward --" << std::endl;
+	for (int k = 210; k > 150; k -= 7)
+	{
+		printIt("upper_bound", k, cur.upper_bound(k));
+		printIt("find", k, cur.find(k));
+	}
+
+	std::cout << "\t-- jumps --" << std::endl;
+	const int	jumps[] = { 196, 0, 100, -50, 400, 52, 53, 199, 4 };
+	for (unsigned i = 0; i < sizeof(jumps) / sizeof(*jumps); ++i)
+	{
+		printIt("find", jumps[i], cur.find(jumps[i]));
+		printIt("lower_bound", jumps[i], cur.lower_bound(jumps[i]));
+		printIt("upper_bound", jumps[i], cur.upper_bound(jumps[i]));
+	}
+
+	std::cout << "\t-- seek after erase --" << std::endl;
+	cur.find(100);
+	mp.erase(100);
+	cur.seek(mp.begin());
+	printIt("find", 100, cur.find(100));
+	printIt("lower_bound", 100, cur.lower_bound(100));
+	cur.seek(mp.end());
+	printIt("find", 8, cur.find(8));
+	std::cout << "position: ";
+	printPair(cur.position());
+
+	std::cout << "\t-- every key from every start --" << std::endl;
+	int	mismatches = 0;
+	for (t_map::iterator start = mp.begin(); ; ++start)
+	{
+		for (int k = -2; k < 203; ++k)
+		{
+			cur.seek(start);
+			if (cur.lower_bound(k) != mp.lower_bound(k))
+				++mismatches;
+			cur.seek(start);
+			if (cur.upper_bound(k) != mp.upper_bound(k))
+				++mismatches;
+		}
+		if (start == mp.end())
+			break ;
+	}
+	std::cout << "mismatches: " << mismatches << std::endl;
+
+	std::cout << "\t-- empty map --" << std::endl;
+	t_map		empty;
+	t_cursor	ecur(empty);
+	std::cout << (ecur.find(1) == empty.end()) << (ecur.lower_bound(1) == empty.end())
+		<< (ecur.upper_bound(1) == empty.end()) << std::endl;
+	return (0);
+}
@@ -0,0 +1,204 @@
+#include "common.hpp"
+
+#define T1 int
+#define T2 std::string
+
+typedef TESTED_NAMESPACE::map<T1, T2> t_map;
+
+#if defined(USING_STD)
+// std::map has no node handles: a handle is emulated by a copy of the
+// element, erased from the map on extract and inserted again on insert.
+// Copying a handle empties the source, as moving a real one does.
+class t_node
+{
+	public:
+		t_node(void) : _full(false), _key(), _mapped() { };
+		t_node(const t_map::value_type &val) : _full(true), _key(val.first), _mapped(val.second) { };
+		t_node(const t_node &x) : _full(x._full), _key(x._key), _mapped(x._mapped) { x._full = false; };
+
+		t_node	&operator=(const t_node &x)
+		{
+			if (&x != this)
+			{
+				this->_full = x._full;
+				this->_key = x._key;
+				this->_mapped = x._mapped;
+				x._full = false;
+			}
+			return (*this);
+		};
+
+		bool				empty(void) const { return !this->_full; };
+		T1					&key(void) { return this->_key; };
+		T2					&mapped(void) { return this->_mapped; };
+		t_map::value_type	value(void) const { return t_map::value_type(this->_key, this->_mapped); };
+
+	private:
+		mutable bool	_full;
+		T1				_key;
+		T2				_mapped;
+};
+
+struct t_insert_return
+{
+	t_map::iterator	position;
+	bool			inserted;
+	t_node			node;
+};
+
+static t_node	extract(t_map &mp, t_map::iterator it)
+{
+	t_node	nh(*it);
+
+	mp.erase(it);
+	return (nh);
+}
+
+static t_node	extract(t_map &mp, const T1 &k)
+{
+	t_map::iterator	it = mp.find(k);
+
+	return (it == mp.end() ? t_node() : extract(mp, it));
+}
+
+// Like the real insert(node_type), which takes the handle by value.
+static t_insert_return	insert(t_map &mp, t_node &nh)
+{
+	t_insert_return	r;
+
+	r.position = mp.end();
+	r.inserted = false;
+	if (!nh.empty())
+	{
+		std::pair<t_map::iterator, bool>	p = mp.insert(nh.value());
+		r.position = p.first;
+		r.inserted = p.second;
+		if (!p.second)
+			r.node = nh;
+	}
+	nh = t_node();
+	return (r);
+}
+
+// The hinted insert takes the handle by value too, and frees a node it
+// cannot insert.
+static t_map::iterator	insert(t_map &mp, t_map::iterator hint, t_node nh)
+{
+	if (nh.empty())
+		return (mp.end());
+	return (mp.insert(hint, nh.value()));
+}
+#else
+typedef t_map::node_type			t_node;
+typedef t_map::insert_return_type	t_insert_return;
+
+static t_node	extract(t_map &mp, t_map::iterator it)
+{
+	return (mp.extract(it));
+}
+
+static t_node	extract(t_map &mp, const T1 &k)
+{
+	return (mp.extract(k));
+}
+
+static t_insert_return	insert(t_map &mp, t_node &nh)
+{
+	return (mp.insert(nh));
+}
+
+static t_map::iterator	insert(t_map &mp, t_map::iterator hint, t_node nh)
+{
+	return (mp.insert(hint, nh));
+}
+#endif
+
+static void	printNode(const char *what, t_node &nh)
+{
+	std::cout << what << ": ";
+	if (nh.empty())
+		std::cout << "empty" << std::endl;
+	else
+		std::cout << "key: " << nh.key() << " | mapped: " << nh.mapped()
+			<< " | value: " << nh.value().first << std::endl;
+}
+
+static void	printReturn(const t_map &mp, t_insert_return &r)
+{
+	std::cout << "inserted: " << r.inserted << " at end: " << (r.position == mp.end()) << std::endl;
+	if (r.position != mp.end())
+		printPair(r.position);
+	printNode("node", r.node);
+}
+
+int		main(void)
+{
+	t_map	mp, other;
+
+	for (int i = 0; i < 10; ++i)
+		mp[i * 3] = std::string(i + 1, 'a' + i);
+
+	std::cout << "\t-- extract by iterator and key --" << std::endl;
+	t_map::iterator	it = mp.find(9);
+	t_node			nh = extract(mp, it);
+	printNode("by iterator", nh);
+	t_node			nh2 = extract(mp, 21);
+	printNode("by key", nh2);
+	t_node			missing = extract(mp, 4);
+	printNode("missing key", missing);
+	printSize(mp);
+
+	std::cout << "\t-- rekey and reinsert --" << std::endl;
+	nh.key() = 10;
+	nh.mapped() += "!";
+	t_insert_return	r = insert(mp, nh);
+	printReturn(mp, r);
+	printNode("source", nh);
+
+	std::cout << "\t-- insert into another map --" << std::endl;
+	r = insert(other, nh2);
+	printReturn(other, r);
+	printNode("source", nh2);
+
+	std::cout << "\t-- failed insert keeps the node --" << std::endl;
+	t_node	dup = extract(mp, 0);
+	dup.key() = 3;
+	r = insert(mp, dup);
+	printReturn(mp, r);
+	printNode("source", dup);
+	r.node.key() = 1;
+	t_insert_return	r2 = insert(mp, r.node);
+	printReturn(mp, r2);
+
+	std::cout << "\t-- empty handle --" << std::endl;
+	r = insert(mp, missing);
+	printReturn(mp, r);
+	std::cout << "hinted at end: " << (insert(mp, mp.begin(), missing) == mp.end()) << std::endl;
+
+	std::cout << "\t-- hinted insert --" << std::endl;
+	t_node	hinted = extract(mp, mp.begin());
+	hinted.key() = 100;
+	it = insert(mp, mp.end(), hinted);
+	printPair(it);
+	printNode("source", hinted);
+	hinted = extract(mp, 3);
+	hinted.key() = 100;
+	it = insert(mp, mp.begin(), hinted);
+	printPair(it);
+	printNode("freed", hinted);
+	printSize(mp);
+	it = insert(mp, mp.find(100), extract(other, 21));
+	printPair(it);
+	printSize(other);
+
+	std::cout << "\t-- moving every element --" << std::endl;
+	while (!mp.empty())
+	{
+		t_node	n = extract(mp, mp.begin());
+		n.key() *= -1;
+		insert(other, n);
+	}
+	printSize(mp);
+	printSize(other);
+	return (0);
+}
@@ -0,0 +1,123 @@
+#include "common.hpp"
+#include <vector>
+#include <list>
+#include <iterator>
+#include <algorithm>
+
+#define T1 int
+#define T2 std::string
+
+typedef TESTED_NAMESPACE::map<T1, T2> t_map;
+
+#if defined(USING_STD)
+// std::map has no batched lookups: one find() or lower_bound() per key.
+template <typename T_MAP, typename InputIterator, typename OutputIterator>
+OutputIterator	find_many(T_MAP &mp, InputIterator first, InputIterator last, OutputIterator out)
+{
+	for (; first != last; ++first)
+		*out++ = mp.find(*first);
+	return (out);
+}
+
+template <typename T_MAP, typename InputIterator, typename OutputIterator>
+OutputIterator	lower_bound_many(T_MAP &mp, InputIterator first, InputIterator last, OutputIterator out)
+{
+	for (; first != last; ++first)
+		*out++ = mp.lower_bound(*first);
+	return (out);
+}
+#else
+template <typename T_MAP, typename InputIterator, typename OutputIterator>
+OutputIterator	find_many(T_MAP &mp, InputIterator first, InputIterator last, OutputIterator out)
+{
+	return (mp.find_many(first, last, out));
+}
+
+template <typename T_MAP, typename InputIterator, typename OutputIterator>
+OutputIterator	lower_bound_many(T_MAP &mp, InputIterator first, InputIterator last, OutputIterator out)
+{
+	return (mp.lower_bound_many(first, last, out));
+}
+#endif
+
+template <typename Iterator>
+static void	printResults(const t_map &mp, const T1 *keys, const std::vector<Iterator> &res)
+{
+	for (size_t i = 0; i < res.size(); ++i)
+	{
+		std::cout << keys[i] << " -> ";
+		if (res[i] == mp.end())
+			std::cout << "end()" << std::endl;
+		else
+			printPair(res[i]);
+	}
+}
+
+int		main(void)
+{
+	t_map		mp;
+	const T1	keys[] = { 42, 3, 90, 25, 25, 100, -1, 12, 80, 41, 43, 27 };
+	const size_t	n = sizeof(keys) / sizeof(*keys);
+
+	mp[42] = "fgzgxfn";
+	mp[25] = "funny";
+	mp[80] = "hey";
+	mp[12] = "no";
+	mp[27] = "bee";
+	mp[90] = "8";
+
+	std::cout << "\t-- find_many --" << std::endl;
+	std::vector<t_map::iterator>	found;
+	find_many(mp, keys, keys + n, std::back_inserter(found));
+	printResults(mp, keys, found);
+
+	std::cout << "\t-- lower_bound_many, const, into an array --" << std::endl;
+	const t_map						&cmp = mp;
+	std::vector<t_map::const_iterator>	bounds(n);
+	std::vector<t_map::const_iterator>::iterator	end
+		= lower_bound_many(cmp, keys, keys + n, bounds.begin());
+	std::cout << "written: " << (end - bounds.begin()) << std::endl;
+	printResults(mp, keys, bounds);
+
+	std::cout << "\t-- keys from a list, results modified --" << std::endl;
+	std::list<T1>	lst(keys, keys + n);
+	found.clear();
+	find_many(mp, lst.begin(), lst.end(), std::back_inserter(found));
+	for (size_t i = 0; i < found.size(); ++i)
+		if (found[i] != mp.end())
+			found[i]->second += "!";
+	printSize(mp);
+
+	std::cout << "\t-- no keys, empty map --" << std::endl;
+	found.clear();
+	find_many(mp, keys, keys, std::back_inserter(found));
+	std::cout << "results: " << found.size() << std::endl;
+	t_map	empty;
+	found.clear();
+	find_many(empty, keys, keys + n, std::back_inserter(found));
+	std::cout << "results: " << found.size() << " all end(): "
+		<< (std::count(found.begin(), found.end(), empty.end()) == static_cast<long>(n)) << std::endl;
+
+	std::cout << "\t-- large batch --" << std::endl;
+	t_map				big;
+	std::vector<T1>		many;
+	unsigned			seed = 3;
+	for (int i = 0; i < 20000; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		big[(seed >> 8) % 50000] = "v";
+		many.push_back((seed >> 4) % 50100 - 50);
+	}
+	std::vector<t_map::iterator>	f, lb;
+	find_many(big, many.begin(), many.end(), std::back_inserter(f));
+	lower_bound_many(big, many.begin(), many.end(), std::back_inserter(lb));
+	int		bad = 0, hits = 0;
+	for (size_t i = 0; i < many.size(); ++i)
+	{
+		if (f[i] != big.find(many[i]) || lb[i] != big.lower_bound(many[i]))
+			++bad;
+		hits += f[i] != big.end();
+	}
+	std::cout << "keys: " << many.size() << " hits: " << hits << " bad: " << bad << std::endl;
+	return (0);
+}
@@ -0,0 +1,76 @@
+#include "common.hpp"
+#include <list>
+#include <vector>
+
+#define T1 int
+#define T2 std::string
+
+typedef TESTED_NAMESPACE::map<T1, T2>	t_map;
+typedef _pair<T1, T2>					t_pair;
+
+#if defined(USING_STD)
+// insert_batch has the result of insert(first, last).
+template <typename InputIterator>
+static void	insertBatch(t_map &mp, InputIterator first, InputIterator last)
+{
+	mp.insert(first, last);
+}
+#else
+template <typename InputIterator>
+static void	insertBatch(t_map &mp, InputIterator first, InputIterator last)
+{
+	mp.insert_batch(first, last);
+}
+#endif
+
+int		main(void)
+{
+	t_map					mp, other;
+	std::vector<t_pair>		batch;
+
+	std::cout << "\t-- empty batch --" << std::endl;
+	insertBatch(mp, batch.begin(), batch.end());
+	printSize(mp);
+
+	// Unsorted, with a key repeated in the batch: the first one wins.
+	std::cout << "\t-- pairs of another type --" << std::endl;
+	const int	keys[] = { 42, 7, 19, 7, 3, 88, 42, 50, 1 };
+	for (size_t i = 0; i < sizeof(keys) / sizeof(*keys); ++i)
+		batch.push_back(t_pair(keys[i], std::string(i + 1, 'a' + i)));
+	insertBatch(mp, batch.begin(), batch.end());
+	printSize(mp);
+
+	std::cout << "\t-- keys already present are kept --" << std::endl;
+	std::list<t_pair>	lst;
+	for (int i = 0; i < 10; ++i)
+		lst.push_front(t_pair(i * 10, "new"));
+	insertBatch(mp, lst.begin(), lst.end());
+	printSize(mp);
+
+	std::cout << "\t-- range of another map --" << std::endl;
+	for (int i = 0; i < 1000; ++i)
+		other[(i * 7919) % 1000 - 500] = "other";
+	insertBatch(mp, other.begin(), other.end());
+	printSize(mp, false);
+	t_map::iterator	it = mp.begin();
+	for (int i = 0; i < 5; ++i)
+		printPair(it++);
+	it = mp.find(42);
+	printPair(it);
+	printPair(--mp.end());
+
+	std::cout << "\t-- clustered batch --" << std::endl;
+	batch.clear();
+	for (int i = 0; i < 5000; ++i)
+		batch.push_back(t_pair(2000 + (i * 37) % 5000, "c"));
+	insertBatch(mp, batch.begin(), batch.end());
+	printSize(mp, false);
+	int		sorted = 1;
+	for (it = mp.begin(); it != --mp.end(); )
+	{
+		t_map::iterator	prev = it++;
+		sorted &= prev->first < it->first;
+	}
+	std::cout << "sorted: " << sorted << std::endl;
+	return (0);
+}
@@ -0,0 +1,132 @@
+#include "common.hpp"
+#include <iterator>
+
+#define T1 int
+#define T2 int
+
+#if defined(USING_STD)
+typedef std::map<T1, T2> t_map;
+
+// std::map has no order statistics: walk instead.
+static t_map::iterator	nth(t_map &mp, size_t n)
+{
+	t_map::iterator	it = mp.begin();
+	std::advance(it, n);
+	return (it);
+}
+
+static size_t	rank(const t_map &mp, const T1 &k)
+{
+	return (std::distance(mp.begin(), mp.lower_bound(k)));
+}
+
+static long	distance(const t_map &, t_map::const_iterator first, t_map::const_iterator last)
+{
+	return (std::distance(first, last));
+}
+#else
+typedef ft::map<T1, T2, std::less<T1>, std::allocator<ft::pair<const T1, T2> >,
+	ft::Rb_tree_order_statistics_node_update> t_map;
+
+static t_map::iterator	nth(t_map &mp, size_t n)
+{
+	return (mp.nth(n));
+}
+
+static size_t	rank(const t_map &mp, const T1 &k)
+{
+	return (mp.rank(k));
+}
+
+static long	distance(const t_map &mp, t_map::const_iterator first, t_map::const_iterator last)
+{
+	return (mp.distance(first, last));
+}
+#endif
+
+static void	printStats(t_map &mp)
+{
+	std::cout << "size: " << mp.size() << std::endl;
+	for (size_t i = 0; i < mp.size(); i += 1 + mp.size() / 8)
+	{
+		std::cout << "nth(" << i << "): ";
+		printPair(nth(mp, i));
+	}
+	if (!mp.empty())
+	{
+		std::cout << "last: ";
+		printPair(nth(mp, mp.size() - 1));
+	}
+	const T1	probes[] = { -1, 0, 7, 50, 51, 99, 1000 };
+	for (unsigned i = 0; i < sizeof(probes) / sizeof(*probes); ++i)
+		std::cout << "rank(" << probes[i] << "): " << rank(mp, probes[i]) << std::endl;
+	std::cout << "distance(begin, end): " << distance(mp, mp.begin(), mp.end())
+		<< " distance(lower_bound(20), lower_bound(70)): "
+		<< distance(mp, mp.lower_bound(20), mp.lower_bound(70))
+		<< " distance(end, end): " << distance(mp, mp.end(), mp.end()) << std::endl;
+}
+
+// Every position and rank, checked against a walk.
+static void	checkAll(t_map &mp)
+{
+	int		bad = 0;
+	size_t	i = 0;
+
+	for (t_map::iterator it = mp.begin(); it != mp.end(); ++it, ++i)
+	{
+		if (nth(mp, i) != it || rank(mp, it->first) != i
+			|| distance(mp, mp.begin(), it) != static_cast<long>(i))
+			++bad;
+		if (rank(mp, it->first + 1) != i + 1)
+			++bad;
+	}
+	std::cout << "checked " << i << " positions, " << bad << " bad" << std::endl;
+}
+
+int		main(void)
+{
+	t_map	mp;
+
+	printStats(mp);
+	for (int i = 0; i < 100; i += 2)
+		mp.insert(_pair<const T1, T2>(i, i * 10));
+	printStats(mp);
+
+	std::cout << "\t-- after erasing --" << std::endl;
+	mp.erase(0);
+	mp.erase(50);
+	mp.erase(mp.lower_bound(60), mp.lower_bound(80));
+	printStats(mp);
+	checkAll(mp);
+
+	std::cout << "\t-- mixed updates --" << std::endl;
+	unsigned	seed = 42;
+	for (int i = 0; i < 3000; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		const int	k = (seed >> 8) % 500;
+		if (seed & 1)
+			mp[k] = i;
+		else
+			mp.erase(k);
+	}
+	printStats(mp);
+	checkAll(mp);
+
+	std::cout << "\t-- copies --" << std::endl;
+	t_map	cpy(mp);
+	t_map	asg;
+	asg = mp;
+	cpy.erase(cpy.begin());
+	asg.insert(_pair<const T1, T2>(-5, 0));
+	printStats(cpy);
+	checkAll(cpy);
+	printStats(asg);
+	checkAll(asg);
+	cpy.swap(asg);
+	checkAll(cpy);
+	checkAll(asg);
+	mp.clear();
+	printStats(mp);
+	return (0);
+}
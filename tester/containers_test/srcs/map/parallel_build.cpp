@@ -0,0 +1,105 @@
+#include "common.hpp"
+#include <vector>
+#include <list>
+#if !defined(USING_STD)
+# include "parallel.hpp"
+#endif
+
+#define T1 int
+#define T2 int
+
+typedef TESTED_NAMESPACE::map<T1, T2> t_map;
+typedef std::vector<_pair<T1, T2> > t_input;
+
+#if defined(USING_STD)
+// std::map has no parallel constructor: the serial one, whose result the
+// parallel build must match.
+template <typename InputIterator>
+static t_map	build(size_t, InputIterator first, InputIterator last)
+{
+	return (t_map(first, last));
+}
+#else
+// 0 stands for ft::par, one thread per processor.
+template <typename InputIterator>
+static t_map	build(size_t threads, InputIterator first, InputIterator last)
+{
+	return (t_map(ft::par(threads), first, last));
+}
+#endif
+
+// Walks the map both ways and looks every element up again.
+static void	check(const char *what, size_t threads, t_map &mp)
+{
+	int		bad = 0;
+	size_t	walked = 0;
+
+	for (t_map::iterator it = mp.begin(); it != mp.end(); ++it, ++walked)
+	{
+		t_map::iterator	next = it;
+		if (++next != mp.end() && !(it->first < next->first))
+			++bad;
+		if (mp.find(it->first) != it)
+			++bad;
+	}
+	for (t_map::reverse_iterator it = mp.rbegin(); it != mp.rend(); ++it)
+		--walked;
+	std::cout << what << " threads " << threads << ": size " << mp.size()
+		<< " bad " << bad + (walked != 0) << " sum ";
+	long	sum = 0;
+	for (t_map::iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->first * 3 + it->second;
+	std::cout << sum << std::endl;
+}
+
+int		main(void)
+{
+	const size_t	threads[] = { 0, 1, 2, 3, 4, 8, 64 };
+	const size_t	sizes[] = { 0, 1, 2, 7, 100, 5000, 60000 };
+	unsigned		seed = 21;
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+	{
+		// Random keys with repeats: of equal keys the first one wins.
+		t_input	in;
+		for (size_t i = 0; i < sizes[s]; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			in.push_back(_pair<T1, T2>((seed >> 8) % (sizes[s] + 1), static_cast<T2>(i)));
+		}
+		std::cout << "\t-- " << sizes[s] << " elements --" << std::endl;
+		for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); ++t)
+		{
+			t_map	mp = build(threads[t], in.begin(), in.end());
+			check("random", threads[t], mp);
+		}
+	}
+
+	std::cout << "\t-- sorted and reversed input, from a list --" << std::endl;
+	std::list<_pair<T1, T2> >	lst;
+	for (int i = 0; i < 20000; ++i)
+		lst.push_back(_pair<T1, T2>(i / 2, i));
+	for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); ++t)
+	{
+		t_map	mp = build(threads[t], lst.begin(), lst.end());
+		check("sorted", threads[t], mp);
+		t_map	rev = build(threads[t], lst.rbegin(), lst.rend());
+		check("reversed", threads[t], rev);
+	}
+
+	std::cout << "\t-- the result is an ordinary map --" << std::endl;
+	t_input	in;
+	for (int i = 0; i < 3000; ++i)
+		in.push_back(_pair<T1, T2>((i * 7919) % 3001, i));
+	t_map	mp = build(4, in.begin(), in.end());
+	for (int i = 0; i < 3001; i += 3)
+		mp.erase(i);
+	for (int i = -10; i < 0; ++i)
+		mp[i] = i;
+	mp.insert(_pair<T1, T2>(5000, 5000));
+	check("updated", 4, mp);
+	printPair(mp.begin());
+	printPair(mp.lower_bound(1500));
+	printPair(--mp.end());
+	return (0);
+}
@@ -0,0 +1,116 @@
+#include "common.hpp"
+#if !defined(USING_STD)
+# include "parallel.hpp"
+#endif
+
+#define T1 int
+
+// Counts the live values; the counter is atomic, since the background
+// clear destroys values on another thread.
+class Val
+{
+	public:
+		static volatile long	live;
+
+		Val(void) : _n(0) { __sync_fetch_and_add(&live, 1); };
+		Val(int n) : _n(n) { __sync_fetch_and_add(&live, 1); };
+		Val(const Val &src) : _n(src._n) { __sync_fetch_and_add(&live, 1); };
+		~Val(void) { __sync_fetch_and_sub(&live, 1); };
+		Val		&operator=(const Val &src) { this->_n = src._n; return (*this); };
+		int		get(void) const { return (this->_n); };
+
+		friend std::ostream	&operator<<(std::ostream &o, const Val &v) { return (o << v._n); };
+
+	private:
+		int		_n;
+};
+
+volatile long	Val::live = 0;
+
+typedef TESTED_NAMESPACE::map<T1, Val> t_map;
+
+#if defined(USING_STD)
+// std::map has none of these: the serial copy, assignment and clear.
+static t_map	*copy(size_t, const t_map &x) { return (new t_map(x)); }
+static void		assign(size_t, t_map &mp, const t_map &x) { mp = x; }
+static void		clear(size_t, t_map &mp) { mp.clear(); }
+static void		clear_in_background(t_map &mp) { mp.clear(); }
+static void		wait_reclaimed(void) { }
+#else
+// 0 stands for ft::par, one thread per processor.
+static t_map	*copy(size_t threads, const t_map &x) { return (new t_map(ft::par(threads), x)); }
+static void		assign(size_t threads, t_map &mp, const t_map &x) { mp.assign(ft::par(threads), x); }
+static void		clear(size_t threads, t_map &mp) { mp.clear(ft::par(threads)); }
+static void		clear_in_background(t_map &mp) { mp.clear_in_background(); }
+static void		wait_reclaimed(void) { ft::Parallel_reclaimer::S_wait(); }
+#endif
+
+// Compares two maps element by element and walks a backwards.
+static void	check(const char *what, size_t threads, const t_map &a, const t_map &b)
+{
+	int		bad = a.size() != b.size();
+	size_t	walked = 0;
+
+	for (t_map::const_iterator i = a.begin(), j = b.begin(); i != a.end() && j != b.end(); ++i, ++j)
+		bad += i->first != j->first || i->second.get() != j->second.get();
+	for (t_map::const_reverse_iterator it = a.rbegin(); it != a.rend(); ++it)
+		++walked;
+	std::cout << what << " threads " << threads << ": size " << a.size()
+		<< " walked " << walked << " bad " << bad << std::endl;
+}
+
+int		main(void)
+{
+	const size_t	threads[] = { 0, 1, 2, 3, 8, 64 };
+	const size_t	sizes[] = { 0, 1, 5, 1000, 70000 };
+	unsigned		seed = 17;
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+	{
+		t_map	src;
+		while (src.size() < sizes[s])
+		{
+			seed = seed * 1103515245u + 12345u;
+			src.insert(t_map::value_type(seed >> 4, Val(src.size())));
+		}
+		std::cout << "\t-- " << sizes[s] << " elements --" << std::endl;
+		for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); ++t)
+		{
+			t_map	*cp = copy(threads[t], src);
+			check("copy", threads[t], *cp, src);
+
+			// Over a map of other contents, then over an empty one.
+			t_map	dst;
+			for (int i = 0; i < 100; ++i)
+				dst[i] = Val(-i);
+			assign(threads[t], dst, src);
+			check("assign", threads[t], dst, src);
+			t_map	empty;
+			assign(threads[t], dst, empty);
+			check("assign empty", threads[t], dst, empty);
+
+			clear(threads[t], *cp);
+			check("clear", threads[t], *cp, empty);
+			cp->insert(t_map::value_type(1, Val(1)));
+			std::cout << "usable: " << cp->size() << std::endl;
+			delete cp;
+		}
+		std::cout << "live: " << Val::live - static_cast<long>(src.size()) << std::endl;
+	}
+
+	std::cout << "\t-- clear_in_background --" << std::endl;
+	t_map	big;
+	for (int i = 0; i < 100000; ++i)
+		big[i * 3] = Val(i);
+	t_map	*cp = copy(2, big);
+	clear_in_background(*cp);
+	std::cout << "empty at once: " << cp->empty() << " begin == end: " << (cp->begin() == cp->end()) << std::endl;
+	(*cp)[7] = Val(7);
+	printPair(cp->begin());
+	delete cp;
+	clear_in_background(big);
+	clear_in_background(big);
+	wait_reclaimed();
+	std::cout << "live: " << Val::live << std::endl;
+	return (0);
+}
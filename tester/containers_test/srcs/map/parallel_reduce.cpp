@@ -0,0 +1,90 @@
+#include "common.hpp"
+#if !defined(USING_STD)
+# include "parallel.hpp"
+#endif
+
+#define T1 int
+#define T2 int
+
+typedef TESTED_NAMESPACE::map<T1, T2> t_map;
+
+// Sums the mapped values, and folds the keys into a string: string
+// concatenation is not commutative, so the pieces must combine in order.
+struct Sum
+{
+	long	operator()(long a, const t_map::value_type &x) const { return (a + x.second); };
+	long	operator()(long a, long b) const { return (a + b); };
+};
+
+struct Concat
+{
+	std::string	operator()(const std::string &a, const t_map::value_type &x) const
+	{
+		return (a + static_cast<char>('a' + x.first % 26));
+	};
+	std::string	operator()(const std::string &a, const std::string &b) const { return (a + b); };
+};
+
+struct Double
+{
+	void	operator()(t_map::value_type &x) const { x.second *= 2; };
+};
+
+#if defined(USING_STD)
+// std::map has neither: serial loops in key order.
+template <typename Result, typename Fold, typename Combine>
+static Result	reduce(size_t, const t_map &mp, Result identity, Fold fold, Combine)
+{
+	for (t_map::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		identity = fold(identity, *it);
+	return (identity);
+}
+
+template <typename Function>
+static void	for_each(size_t, t_map &mp, Function f)
+{
+	for (t_map::iterator it = mp.begin(); it != mp.end(); ++it)
+		f(*it);
+}
+#else
+// 0 stands for ft::par, one thread per processor.
+template <typename Result, typename Fold, typename Combine>
+static Result	reduce(size_t threads, const t_map &mp, Result identity, Fold fold, Combine combine)
+{
+	return (ft::parallel_reduce(ft::par(threads), mp, identity, fold, combine));
+}
+
+template <typename Function>
+static void	for_each(size_t threads, t_map &mp, Function f)
+{
+	ft::parallel_for_each(ft::par(threads), mp, f);
+}
+#endif
+
+int		main(void)
+{
+	const size_t	threads[] = { 0, 1, 2, 3, 8, 64 };
+	const size_t	sizes[] = { 0, 1, 3, 100, 50000 };
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+	{
+		t_map	mp;
+		for (size_t i = 0; i < sizes[s]; ++i)
+			mp[static_cast<T1>((i * 7919) % 100003)] = static_cast<T2>(i % 1000);
+		std::string	expected;
+		for (t_map::iterator it = mp.begin(); it != mp.end(); ++it)
+			expected = Concat()(expected, *it);
+		std::cout << "\t-- " << sizes[s] << " elements --" << std::endl;
+		for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); ++t)
+		{
+			const long			sum = reduce(threads[t], mp, 0L, Sum(), Sum());
+			const std::string	keys = reduce(threads[t], mp, std::string(), Concat(), Concat());
+			for_each(threads[t], mp, Double());
+			const long			doubled = reduce(threads[t], mp, 0L, Sum(), Sum());
+			std::cout << "threads " << threads[t] << ": sum " << sum << " doubled " << doubled
+				<< " keys " << keys.size() << " in order " << (keys == expected)
+				<< " " << keys.substr(0, 40) << std::endl;
+		}
+	}
+	return (0);
+}
@@ -0,0 +1,169 @@
+#include "common.hpp"
+#include <stdexcept>
+#if !defined(USING_STD)
+# include "parallel.hpp"
+# include "thread_pool.hpp"
+#endif
+
+#define T1 int
+#define T2 int
+
+typedef TESTED_NAMESPACE::map<T1, T2> t_map;
+
+// A function that throws is never called again: every element is
+// visited at most once, and the caller catches whatever is thrown.
+// Only std::exception is caught, since an exception thrown on a worker
+// reaches the caller as ft::parallel_error.
+static const T1	N = 50000;
+static int		visits[N];
+static int		calls[2];
+
+struct Visit
+{
+	T1		M_throw_at;
+
+	void	operator()(t_map::value_type &x) const
+	{
+		__sync_fetch_and_add(&visits[x.first], 1);
+		if (x.first == M_throw_at)
+			throw std::runtime_error("visit");
+	};
+};
+
+struct Call
+{
+	int		M_id;
+	bool	M_throw;
+
+	void	operator()() const
+	{
+		__sync_fetch_and_add(&calls[M_id], 1);
+		if (M_throw)
+			throw std::runtime_error("call");
+	};
+};
+
+#if defined(USING_STD)
+// Serial stand-ins for the ft-only functions.
+template <typename Function>
+static void	for_each(size_t, t_map &mp, Function f)
+{
+	for (t_map::iterator it = mp.begin(); it != mp.end(); ++it)
+		f(*it);
+}
+
+template <typename F, typename G>
+static void	invoke(F f, G g)
+{
+	f();
+	g();
+}
+
+class group
+{
+public:
+	template <typename Function>
+	void	run(const Function &f) { f(); };
+	void	wait() { };
+};
+#else
+template <typename Function>
+static void	for_each(size_t threads, t_map &mp, Function f)
+{
+	ft::parallel_for_each(ft::par(threads), mp, f);
+}
+
+template <typename F, typename G>
+static void	invoke(F f, G g)
+{
+	ft::parallel_invoke(f, g);
+}
+
+typedef ft::task_group	group;
+#endif
+
+static void	reset_calls(void)
+{
+	calls[0] = 0;
+	calls[1] = 0;
+}
+
+int		main(void)
+{
+	const size_t	threads[] = { 0, 1, 2, 8, 64 };
+	const T1		throw_at[] = { 0, N / 3, N - 1, N };
+	t_map			mp;
+
+	for (T1 k = 0; k < N; ++k)
+		mp[k] = k;
+	for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); ++t)
+		for (size_t a = 0; a < sizeof(throw_at) / sizeof(*throw_at); ++a)
+		{
+			for (T1 k = 0; k < N; ++k)
+				visits[k] = 0;
+			Visit	v;
+			v.M_throw_at = throw_at[a];
+			bool	caught = false;
+			try
+			{
+				for_each(threads[t], mp, v);
+			}
+			catch (std::exception &)
+			{
+				caught = true;
+			}
+			int		twice = 0;
+			for (T1 k = 0; k < N; ++k)
+				twice += visits[k] > 1;
+			std::cout << "threads " << threads[t] << " throw at " << throw_at[a]
+				<< ": caught " << caught << " twice " << twice
+				<< " thrower visited " << (throw_at[a] < N ? visits[throw_at[a]] : 0) << std::endl;
+		}
+	std::cout << "size after: " << mp.size() << std::endl;
+
+	for (int mask = 0; mask < 4; ++mask)
+	{
+		Call	f, g;
+		f.M_id = 0;
+		f.M_throw = mask & 1;
+		g.M_id = 1;
+		g.M_throw = mask & 2;
+		reset_calls();
+		bool	caught = false;
+		try
+		{
+			invoke(f, g);
+		}
+		catch (std::exception &)
+		{
+			caught = true;
+		}
+		// Under std a throwing f keeps g from running at all.
+		std::cout << "invoke f throws " << f.M_throw << " g throws " << g.M_throw
+			<< ": caught " << caught << " f calls " << calls[0]
+			<< " g calls " << (calls[1] <= 1) << std::endl;
+	}
+
+	reset_calls();
+	bool	caught = false;
+	{
+		group	tg;
+		Call	c;
+		c.M_id = 1;
+		c.M_throw = false;
+		for (int i = 0; i < 10; ++i)
+			tg.run(c);
+		c.M_throw = true;
+		try
+		{
+			tg.run(c);
+			tg.wait();
+		}
+		catch (std::exception &)
+		{
+			caught = true;
+		}
+	}
+	std::cout << "task_group: caught " << caught << " calls " << calls[1] << std::endl;
+	return (0);
+}
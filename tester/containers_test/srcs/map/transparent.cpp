@@ -0,0 +1,123 @@
+#include "common.hpp"
+#include <string>
+
+// Orders strings as usual, and against an Initial by their first letter
+// only, so that a single Initial is equivalent to a whole run of keys.
+struct Initial
+{
+	Initial(char c) : c(c) { };
+
+	char	c;
+};
+
+struct ByInitial
+{
+	typedef void	is_transparent;
+
+	bool	operator()(const std::string &a, const std::string &b) const { return (a < b); };
+	bool	operator()(const std::string &a, const Initial &b) const { return (a[0] < b.c); };
+	bool	operator()(const Initial &a, const std::string &b) const { return (a.c < b[0]); };
+};
+
+typedef TESTED_NAMESPACE::map<std::string, int, ByInitial> t_map;
+typedef std::pair<t_map::iterator, t_map::iterator> t_range;
+
+#if defined(USING_STD)
+// std::map only has transparent lookups from C++14: they are emulated by
+// a scan of the map with the same comparator.
+static t_map::iterator	lowerBound(t_map &mp, const Initial &k)
+{
+	t_map::iterator	it = mp.begin();
+
+	while (it != mp.end() && ByInitial()(it->first, k))
+		++it;
+	return (it);
+}
+
+static t_map::iterator	upperBound(t_map &mp, const Initial &k)
+{
+	t_map::iterator	it = lowerBound(mp, k);
+
+	while (it != mp.end() && !ByInitial()(k, it->first))
+		++it;
+	return (it);
+}
+
+static t_range	equalRange(t_map &mp, const Initial &k)
+{
+	return (t_range(lowerBound(mp, k), upperBound(mp, k)));
+}
+
+static size_t	count(t_map &mp, const Initial &k)
+{
+	t_range	r = equalRange(mp, k);
+
+	return (std::distance(r.first, r.second));
+}
+#else
+static t_map::iterator	lowerBound(t_map &mp, const Initial &k)
+{
+	return (mp.lower_bound(k));
+}
+
+static t_map::iterator	upperBound(t_map &mp, const Initial &k)
+{
+	return (mp.upper_bound(k));
+}
+
+static t_range	equalRange(t_map &mp, const Initial &k)
+{
+	ft::pair<t_map::iterator, t_map::iterator>	r = mp.equal_range(k);
+
+	return (t_range(r.first, r.second));
+}
+
+static size_t	count(t_map &mp, const Initial &k)
+{
+	return (mp.count(k));
+}
+#endif
+
+static void	printRange(t_map &mp, char c)
+{
+	t_range	r = equalRange(mp, Initial(c));
+
+	std::cout << "'" << c << "': count " << count(mp, Initial(c))
+		<< " | lower at end: " << (lowerBound(mp, Initial(c)) == mp.end())
+		<< " | upper at end: " << (upperBound(mp, Initial(c)) == mp.end()) << std::endl;
+	std::cout << "range:";
+	for (; r.first != r.second; ++r.first)
+		std::cout << " " << r.first->first;
+	std::cout << std::endl;
+}
+
+int		main(void)
+{
+	const char	*words[] = { "apple", "avocado", "banana", "blackberry", "blueberry",
+		"boysenberry", "cherry", "date", "damson", "durian", "elderberry", "fig", "nectarine" };
+	t_map		mp;
+
+	for (size_t i = 0; i < sizeof(words) / sizeof(*words); ++i)
+		mp[words[i]] = i;
+
+	const char	probes[] = "0abcdefgz";
+	for (size_t i = 0; probes[i]; ++i)
+		printRange(mp, probes[i]);
+
+	// A run spanning many levels of the tree.
+	for (int i = 0; i < 500; ++i)
+	{
+		std::string	s(1, 'm');
+		s += static_cast<char>('a' + i % 26);
+		s += static_cast<char>('a' + i / 26);
+		mp[s] = i;
+	}
+	std::cout << "'m': count " << count(mp, Initial('m')) << std::endl;
+	t_range	r = equalRange(mp, Initial('m'));
+	printPair(r.first);
+	std::cout << "after: " << r.second->first << std::endl;
+	printRange(mp, 'e');
+	printRange(mp, 'f');
+	printSize(mp, false);
+	return (0);
+}
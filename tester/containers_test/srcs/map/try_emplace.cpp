@@ -0,0 +1,180 @@
+#include "common.hpp"
+
+#define T1 int
+
+// Counts the values built from arguments; copies are not counted, so
+// that the emulation below prints the same as the real thing.
+class Val
+{
+	public:
+		static int	built;
+
+		Val(void) : _s("default"), _n(0) { ++built; };
+		Val(const std::string &s) : _s(s), _n(1) { ++built; };
+		Val(const std::string &s, int n) : _s(s), _n(n) { ++built; };
+
+		friend std::ostream	&operator<<(std::ostream &o, const Val &v)
+		{
+			return (o << v._s << "*" << v._n);
+		};
+
+	private:
+		std::string	_s;
+		int			_n;
+};
+
+int	Val::built = 0;
+
+typedef TESTED_NAMESPACE::map<T1, Val> t_map;
+typedef _pair<t_map::iterator, bool> t_ret;
+
+#if defined(USING_STD)
+// std::map has neither: one find(), then an insert() on a miss.
+static t_ret	try_emplace(t_map &mp, const T1 &k)
+{
+	t_map::iterator	it = mp.find(k);
+	if (it != mp.end())
+		return (t_ret(it, false));
+	return (mp.insert(t_map::value_type(k, Val())));
+}
+
+static t_ret	try_emplace(t_map &mp, const T1 &k, const std::string &a1)
+{
+	t_map::iterator	it = mp.find(k);
+	if (it != mp.end())
+		return (t_ret(it, false));
+	return (mp.insert(t_map::value_type(k, Val(a1))));
+}
+
+static t_ret	try_emplace(t_map &mp, const T1 &k, const std::string &a1, int a2)
+{
+	t_map::iterator	it = mp.find(k);
+	if (it != mp.end())
+		return (t_ret(it, false));
+	return (mp.insert(t_map::value_type(k, Val(a1, a2))));
+}
+
+static t_map::iterator	try_emplace(t_map &mp, t_map::iterator hint, const T1 &k, const std::string &a1)
+{
+	t_map::iterator	it = mp.find(k);
+	if (it != mp.end())
+		return (it);
+	return (mp.insert(hint, t_map::value_type(k, Val(a1))));
+}
+
+static t_ret	insert_or_assign(t_map &mp, const T1 &k, const Val &v)
+{
+	t_map::iterator	it = mp.find(k);
+	if (it != mp.end())
+	{
+		it->second = v;
+		return (t_ret(it, false));
+	}
+	return (mp.insert(t_map::value_type(k, v)));
+}
+
+static t_map::iterator	insert_or_assign(t_map &mp, t_map::iterator hint, const T1 &k, const Val &v)
+{
+	t_map::iterator	it = mp.find(k);
+	if (it != mp.end())
+	{
+		it->second = v;
+		return (it);
+	}
+	return (mp.insert(hint, t_map::value_type(k, v)));
+}
+#else
+static t_ret	try_emplace(t_map &mp, const T1 &k)
+{
+	return (mp.try_emplace(k));
+}
+
+static t_ret	try_emplace(t_map &mp, const T1 &k, const std::string &a1)
+{
+	return (mp.try_emplace(k, a1));
+}
+
+static t_ret	try_emplace(t_map &mp, const T1 &k, const std::string &a1, int a2)
+{
+	return (mp.try_emplace(k, a1, a2));
+}
+
+static t_map::iterator	try_emplace(t_map &mp, t_map::iterator hint, const T1 &k, const std::string &a1)
+{
+	return (mp.try_emplace(hint, k, a1));
+}
+
+static t_ret	insert_or_assign(t_map &mp, const T1 &k, const Val &v)
+{
+	return (mp.insert_or_assign(k, v));
+}
+
+static t_map::iterator	insert_or_assign(t_map &mp, t_map::iterator hint, const T1 &k, const Val &v)
+{
+	return (mp.insert_or_assign(hint, k, v));
+}
+#endif
+
+static void	printRet(const char *what, const t_ret &r)
+{
+	std::cout << what << ": inserted " << r.second << " built " << Val::built << " | ";
+	printPair(r.first);
+}
+
+int		main(void)
+{
+	t_map	mp;
+
+	std::cout << "\t-- try_emplace --" << std::endl;
+	printRet("no argument", try_emplace(mp, 10));
+	printRet("one argument", try_emplace(mp, 20, "one"));
+	printRet("two arguments", try_emplace(mp, 30, "two", 2));
+	printRet("present, no argument", try_emplace(mp, 20));
+	printRet("present, one argument", try_emplace(mp, 30, "lost"));
+	printRet("present, two arguments", try_emplace(mp, 10, "lost", 9));
+	printSize(mp);
+
+	std::cout << "\t-- try_emplace with a hint --" << std::endl;
+	Val::built = 0;
+	t_map::iterator	it = try_emplace(mp, mp.end(), 40, "end");
+	printPair(it);
+	it = try_emplace(mp, mp.begin(), 5, "begin");
+	printPair(it);
+	it = try_emplace(mp, mp.find(30), 25, "near");
+	printPair(it);
+	it = try_emplace(mp, mp.begin(), 40, "lost");
+	printPair(it);
+	std::cout << "built: " << Val::built << std::endl;
+	printSize(mp);
+
+	std::cout << "\t-- insert_or_assign --" << std::endl;
+	const Val	v1("assigned", 7), v2("new", 8);
+	Val::built = 0;
+	printRet("present", insert_or_assign(mp, 20, v1));
+	printRet("absent", insert_or_assign(mp, 35, v2));
+	it = insert_or_assign(mp, mp.find(35), 36, v1);
+	printPair(it);
+	it = insert_or_assign(mp, mp.begin(), 5, v2);
+	printPair(it);
+	it = insert_or_assign(mp, mp.end(), 100, v1);
+	printPair(it);
+	std::cout << "built: " << Val::built << std::endl;
+	printSize(mp);
+
+	std::cout << "\t-- many keys --" << std::endl;
+	t_map		big;
+	unsigned	seed = 7;
+	int			inserted = 0;
+	Val::built = 0;
+	for (int i = 0; i < 20000; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		const T1	k = (seed >> 8) % 5000;
+		if (i % 3)
+			inserted += try_emplace(big, k, "x", i).second;
+		else
+			inserted += insert_or_assign(big, k, Val("y", i)).second;
+	}
+	std::cout << "size: " << big.size() << " inserted: " << inserted << " built: " << Val::built << std::endl;
+	return (0);
+}
@@ -0,0 +1,132 @@
+#include "../base.hpp"
+#if !defined(USING_STD)
+# include "persistent_map.hpp"
+#else
+# include <map>
+#endif /* !defined(STD) */
+
+#define _pair TESTED_NAMESPACE::pair
+
+#if defined(USING_STD)
+// The STL has no persistent map: snapshots are full copies, and a
+// version number, kept by copies and renewed by every update, stands
+// for the root that ft::persistent_map versions share.
+template <typename Key, typename Tp>
+class t_persistent_map : public std::map<Key, Tp>
+{
+	public:
+		typedef std::map<Key, Tp>					base;
+		typedef typename base::iterator				iterator;
+		typedef typename base::const_iterator		const_iterator;
+		typedef typename base::value_type			value_type;
+		typedef typename base::size_type			size_type;
+
+		t_persistent_map(void) : base(), _version(next_version()) { };
+		template <typename InputIterator>
+		t_persistent_map(InputIterator first, InputIterator last) : base(first, last), _version(next_version()) { };
+
+		t_persistent_map	snapshot(void) const { return (*this); };
+		bool				same_version(const t_persistent_map &x) const
+		{
+			return (this->_version == x._version || (this->empty() && x.empty()));
+		};
+
+		Tp	&operator[](const Key &k)
+		{
+			this->_version = next_version();
+			return (base::operator[](k));
+		};
+
+		std::pair<iterator, bool>	insert(const value_type &x)
+		{
+			std::pair<iterator, bool>	res = base::insert(x);
+
+			if (res.second)
+				this->_version = next_version();
+			return (res);
+		};
+
+		template <typename Obj>
+		std::pair<iterator, bool>	insert_or_assign(const Key &k, const Obj &obj)
+		{
+			this->_version = next_version();
+			iterator	it = this->find(k);
+			if (it != this->end())
+			{
+				it->second = obj;
+				return (std::make_pair(it, false));
+			}
+			return (base::insert(value_type(k, obj)));
+		};
+
+		size_type	erase(const Key &k)
+		{
+			const size_type	res = base::erase(k);
+
+			if (res)
+				this->_version = next_version();
+			return (res);
+		};
+
+		void	erase(iterator first, iterator last)
+		{
+			if (first != last)
+				this->_version = next_version();
+			base::erase(first, last);
+		};
+
+		void	clear(void)
+		{
+			this->_version = next_version();
+			base::clear();
+		};
+
+	private:
+		static unsigned long	next_version(void)
+		{
+			static unsigned long	last = 0;
+
+			return (++last);
+		};
+
+		unsigned long	_version;
+};
+#else
+template <typename Key, typename Tp>
+class t_persistent_map : public ft::persistent_map<Key, Tp>
+{
+	public:
+		typedef ft::persistent_map<Key, Tp>	base;
+
+		t_persistent_map(void) : base() { };
+		t_persistent_map(const base &x) : base(x) { };
+		template <typename InputIterator>
+		t_persistent_map(InputIterator first, InputIterator last) : base(first, last) { };
+};
+#endif
+
+template <typename T>
+std::string	printPair(const T &iterator, bool nl = true, std::ostream &o = std::cout)
+{
+	o << "key: " << iterator->first << " | value: " << iterator->second;
+	if (nl)
+		o << std::endl;
+	return ("");
+}
+
+template <typename T_MAP>
+void	printSize(T_MAP const &mp, bool print_content = 1)
+{
+	std::cout << "size: " << mp.size() << std::endl;
+	if (print_content)
+	{
+		typename T_MAP::const_iterator it = mp.begin(), ite = mp.end();
+		std::cout << std::endl << "Content is:" << std::endl;
+		for (; it != ite; ++it)
+		{
+			std::cout << "- ";
+			printPair(it);
+		}
+	}
+	std::cout << "###############################################" << std::endl;
+}
@@ -0,0 +1,78 @@
+#include "common.hpp"
+#include <vector>
+
+#define T1 int
+#define T2 std::string
+
+typedef t_persistent_map<T1, T2>	t_pmap;
+
+static void	printVersions(const char *what, const t_pmap &a, const t_pmap &b)
+{
+	std::cout << what << ": same_version " << a.same_version(b)
+		<< " equal " << (a == b) << std::endl;
+}
+
+int		main(void)
+{
+	t_pmap	mp;
+
+	for (int i = 0; i < 8; ++i)
+		mp[i * 10] = std::string(i + 1, 'a' + i);
+
+	std::cout << "\t-- snapshots share a version until updated --" << std::endl;
+	t_pmap	snap = mp.snapshot();
+	t_pmap	copy(mp);
+	t_pmap	assigned;
+	assigned = mp;
+	printVersions("snapshot", mp, snap);
+	printVersions("copy", mp, copy);
+	printVersions("assigned", mp, assigned);
+	printVersions("empty maps", t_pmap(), t_pmap());
+
+	std::cout << "\t-- updates leave the snapshot alone --" << std::endl;
+	mp[10] = "changed";
+	mp[15] = "new";
+	mp.erase(70);
+	mp.insert_or_assign(0, "assigned");
+	printVersions("after updates", mp, snap);
+	printSize(mp);
+	printSize(snap);
+
+	std::cout << "\t-- updating the snapshot leaves the original alone --" << std::endl;
+	snap.erase(0);
+	snap.insert(_pair<const T1, T2>(5, "snap"));
+	printSize(mp);
+	printSize(snap);
+	printVersions("copy", copy, assigned);
+	printSize(copy);
+
+	std::cout << "\t-- a chain of versions --" << std::endl;
+	std::vector<t_pmap>	versions;
+	t_pmap				cur;
+	for (int v = 0; v < 6; ++v)
+	{
+		versions.push_back(cur.snapshot());
+		for (int k = 0; k < 4; ++k)
+			cur[v * 4 + k] = std::string(1, 'A' + v);
+		if (v % 2)
+			cur.erase(v * 2);
+	}
+	for (size_t v = 0; v < versions.size(); ++v)
+	{
+		std::cout << "version " << v << ": size " << versions[v].size() << " first ";
+		if (versions[v].empty())
+			std::cout << "none" << std::endl;
+		else
+			printPair(versions[v].begin());
+	}
+	printSize(cur);
+
+	std::cout << "\t-- clear and swap --" << std::endl;
+	t_pmap	kept = cur.snapshot();
+	cur.clear();
+	printVersions("cleared", cur, kept);
+	std::cout << "sizes: " << cur.size() << " " << kept.size() << std::endl;
+	cur.swap(kept);
+	std::cout << "swapped sizes: " << cur.size() << " " << kept.size() << std::endl;
+	return (0);
+}
@@ -0,0 +1,101 @@
+#include "common.hpp"
+#include <stdexcept>
+#include <map>
+
+#define T1 int
+#define T2 int
+
+typedef t_persistent_map<T1, T2>	t_pmap;
+
+static unsigned	seed = 3;
+
+static unsigned	next(void)
+{
+	seed = seed * 1103515245u + 12345u;
+	return (seed >> 8);
+}
+
+// Compares a version with the std::map kept alongside it.
+static int	check(const t_pmap &mp, const std::map<T1, T2> &ref)
+{
+	int		bad = mp.size() != ref.size();
+	std::map<T1, T2>::const_iterator	r = ref.begin();
+
+	for (t_pmap::const_iterator it = mp.begin(); it != mp.end() && r != ref.end(); ++it, ++r)
+		bad += it->first != r->first || it->second != r->second;
+	return (bad);
+}
+
+int		main(void)
+{
+	t_pmap	mp;
+
+	std::cout << "\t-- insert, at and operator[] --" << std::endl;
+	for (int i = 0; i < 10; ++i)
+		std::cout << "insert " << i * 7 % 10 << ": "
+			<< mp.insert(_pair<const T1, T2>(i * 7 % 10, i)).second << std::endl;
+	std::cout << "duplicate: " << mp.insert(_pair<const T1, T2>(3, 100)).second << std::endl;
+	std::cout << "at(3): " << mp.at(3) << std::endl;
+	mp[3] += 50;
+	std::cout << "at(3): " << mp.at(3) << " [42]: " << mp[42] << std::endl;
+	try
+	{
+		std::cout << mp.at(-1) << std::endl;
+	}
+	catch (std::out_of_range &)
+	{
+		std::cout << "at(-1): out_of_range" << std::endl;
+	}
+	printSize(mp);
+
+	std::cout << "\t-- insert_or_assign, erase, lookups --" << std::endl;
+	std::cout << "assign 4: " << mp.insert_or_assign(4, 400).second << std::endl;
+	std::cout << "insert 11: " << mp.insert_or_assign(11, 11).second << std::endl;
+	std::cout << "erase 5: " << mp.erase(5) << std::endl;
+	std::cout << "erase 5 again: " << mp.erase(5) << std::endl;
+	std::cout << "count 11: " << mp.count(11) << " count 5: " << mp.count(5) << std::endl;
+	printPair(mp.lower_bound(5));
+	printPair(mp.upper_bound(6));
+	printPair(mp.find(42));
+	mp.erase(mp.find(2), mp.find(9));
+	printSize(mp);
+
+	std::cout << "\t-- random updates against std::map --" << std::endl;
+	std::map<T1, T2>	ref;
+	t_pmap				cur;
+	t_pmap				snaps[4];
+	std::map<T1, T2>	refs[4];
+	int					bad = 0;
+	for (int round = 0; round < 4; ++round)
+	{
+		for (int i = 0; i < 3000; ++i)
+		{
+			const T1	k = next() % 2000;
+			switch (next() % 4)
+			{
+				case 0:
+					cur.insert(_pair<const T1, T2>(k, i));
+					ref.insert(std::make_pair(k, i));
+					break;
+				case 1:
+					cur.erase(k);
+					ref.erase(k);
+					break;
+				case 2:
+					cur.insert_or_assign(k, i);
+					ref[k] = i;
+					break;
+				default:
+					cur[k] += 1;
+					ref[k] += 1;
+			}
+		}
+		snaps[round] = cur.snapshot();
+		refs[round] = ref;
+	}
+	for (int round = 0; round < 4; ++round)
+		bad += check(snaps[round], refs[round]);
+	bad += check(cur, ref);
+	std::cout << "size: " << cur.size() << " bad: " << bad << std::endl;
+	return (0);
+}
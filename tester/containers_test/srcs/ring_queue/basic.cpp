@@ -0,0 +1,65 @@
+#include "common.hpp"
+
+#define TESTED_TYPE std::string
+
+// Fills the queue one element at a time, empties it halfway, refills it
+// with a batch that wraps around the ring and only partly fits, and
+// drains it.
+template <typename T_QUEUE>
+void	exercise(T_QUEUE &q)
+{
+	TESTED_TYPE		x;
+	TESTED_TYPE		batch[6] = { "u", "v", "w", "x", "y", "z" };
+	TESTED_TYPE		out[16];
+	size_t			pushed = 0;
+
+	printState(q);
+	std::cout << "try_pop on empty: " << q.try_pop(x) << std::endl;
+	while (q.try_push(std::string(1, 'a' + pushed)))
+		++pushed;
+	std::cout << "pushed until full: " << pushed << std::endl;
+	printState(q);
+	for (size_t i = 0; i < pushed / 2 + 1; ++i)
+	{
+		q.pop(x);
+		std::cout << x;
+	}
+	std::cout << std::endl;
+	printState(q);
+
+	const size_t	n = q.try_push(batch, 6);
+	std::cout << "batch pushed: " << n << std::endl;
+	std::cout << "batch pushed when full: " << q.try_push(batch, 6) << std::endl;
+	printState(q);
+
+	size_t	got;
+	while ((got = q.try_pop(out, 3)) != 0)
+	{
+		std::cout << "popped " << got << ":";
+		for (size_t i = 0; i < got; ++i)
+			std::cout << " " << out[i];
+		std::cout << std::endl;
+	}
+	printState(q);
+
+	q.push("again");
+	q.pop(x);
+	std::cout << "push then pop: " << x << std::endl;
+	printState(q);
+}
+
+int		main(void)
+{
+	std::cout << "\t-- spsc_ring<8> --" << std::endl;
+	t_spsc_ring<TESTED_TYPE, 8>	ring;
+	exercise(ring);
+
+	std::cout << "\t-- mpmc_queue(5) --" << std::endl;
+	t_mpmc_queue<TESTED_TYPE>	mq(5);
+	exercise(mq);
+
+	std::cout << "\t-- mpmc_queue(16) --" << std::endl;
+	t_mpmc_queue<TESTED_TYPE>	mq16(16);
+	exercise(mq16);
+	return (0);
+}
@@ -0,0 +1,124 @@
+#include "../base.hpp"
+#include <pthread.h>
+#include <sched.h>
+#if !defined(USING_STD)
+# include "ring_queue.hpp"
+#else
+# include <deque>
+#endif /* !defined(STD) */
+
+#if defined(USING_STD)
+// The STL has no bounded concurrent queue: a std::deque behind one
+// mutex, refusing pushes past the capacity, which is rounded up as
+// ft::mpmc_queue rounds it.
+template <typename T>
+class t_bounded_queue
+{
+	public:
+		typedef T			value_type;
+		typedef size_t		size_type;
+
+		explicit t_bounded_queue(size_type capacity) : _capacity(2)
+		{
+			while (this->_capacity < capacity)
+				this->_capacity *= 2;
+			pthread_mutex_init(&this->_mutex, 0);
+		};
+		~t_bounded_queue(void) { pthread_mutex_destroy(&this->_mutex); };
+
+		size_type	capacity(void) const { return (this->_capacity); };
+		size_type	size(void) const
+		{
+			Lock	lock(this->_mutex);
+			return (this->_deque.size());
+		};
+		bool		empty(void) const { return (this->size() == 0); };
+
+		bool	try_push(const value_type &x) { return (this->try_push(&x, 1) == 1); };
+		void	push(const value_type &x)
+		{
+			while (!this->try_push(x))
+				sched_yield();
+		};
+
+		template <typename InputIterator>
+		size_type	try_push(InputIterator first, size_type n)
+		{
+			Lock		lock(this->_mutex);
+			size_type	i = 0;
+
+			for (; i < n && this->_deque.size() < this->_capacity; ++i, ++first)
+				this->_deque.push_back(*first);
+			return (i);
+		};
+
+		bool	try_pop(value_type &x) { return (this->try_pop(&x, 1) == 1); };
+		void	pop(value_type &x)
+		{
+			while (!this->try_pop(x))
+				sched_yield();
+		};
+
+		template <typename OutputIterator>
+		size_type	try_pop(OutputIterator out, size_type n)
+		{
+			Lock		lock(this->_mutex);
+			size_type	i = 0;
+
+			for (; i < n && !this->_deque.empty(); ++i, ++out)
+			{
+				*out = this->_deque.front();
+				this->_deque.pop_front();
+			}
+			return (i);
+		};
+
+	private:
+		struct Lock
+		{
+			pthread_mutex_t	&m;
+
+			Lock(pthread_mutex_t &mutex) : m(mutex) { pthread_mutex_lock(&m); };
+			~Lock(void) { pthread_mutex_unlock(&m); };
+		};
+
+		t_bounded_queue(const t_bounded_queue &);
+		t_bounded_queue	&operator=(const t_bounded_queue &);
+
+		std::deque<T>			_deque;
+		size_type				_capacity;
+		mutable pthread_mutex_t	_mutex;
+};
+
+template <typename T, size_t N>
+class t_spsc_ring : public t_bounded_queue<T>
+{
+	public:
+		t_spsc_ring(void) : t_bounded_queue<T>(N) { };
+};
+
+template <typename T>
+class t_mpmc_queue : public t_bounded_queue<T>
+{
+	public:
+		explicit t_mpmc_queue(size_t capacity) : t_bounded_queue<T>(capacity) { };
+};
+#else
+template <typename T, size_t N>
+class t_spsc_ring : public ft::spsc_ring<T, N>
+{
+};
+
+template <typename T>
+class t_mpmc_queue : public ft::mpmc_queue<T>
+{
+	public:
+		explicit t_mpmc_queue(size_t capacity) : ft::mpmc_queue<T>(capacity) { };
+};
+#endif
+
+template <typename T_QUEUE>
+void	printState(const T_QUEUE &q)
+{
+	std::cout << "size: " << q.size() << " empty: " << q.empty() << " capacity: " << q.capacity() << std::endl;
+}
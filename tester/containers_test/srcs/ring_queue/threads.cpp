@@ -0,0 +1,130 @@
+#include "common.hpp"
+
+// Producers push, in order, ITEMS numbers tagged with their id; the
+// consumers pop them, some one at a time, some in batches, until every
+// number has been seen.  Each consumer checks that the numbers of any
+// one producer reach it in increasing order, and the sums are compared
+// at the end.
+static const long	ITEMS = 20000;
+static const long	TAG = 1000000;
+
+template <typename T_QUEUE>
+struct Shared
+{
+	T_QUEUE	*q;
+	long	left;
+	long	sum;
+	long	errors;
+};
+
+template <typename T_QUEUE>
+struct Args
+{
+	Shared<T_QUEUE>	*shared;
+	long			id;
+	bool			batch;
+};
+
+template <typename T_QUEUE>
+void	*producer(void *p)
+{
+	Args<T_QUEUE>	*args = static_cast<Args<T_QUEUE> *>(p);
+	T_QUEUE			&q = *args->shared->q;
+	long			buf[16];
+
+	for (long i = 0; i < ITEMS; )
+	{
+		if (!args->batch)
+		{
+			q.push(args->id * TAG + i);
+			++i;
+			continue;
+		}
+		long	n = 0;
+		for (; n < 16 && i + n < ITEMS; ++n)
+			buf[n] = args->id * TAG + i + n;
+		for (long done = 0; done < n; )
+		{
+			const long	got = q.try_push(buf + done, n - done);
+			if (got == 0)
+				sched_yield();
+			done += got;
+		}
+		i += n;
+	}
+	return (0);
+}
+
+template <typename T_QUEUE>
+void	*consumer(void *p)
+{
+	Args<T_QUEUE>	*args = static_cast<Args<T_QUEUE> *>(p);
+	Shared<T_QUEUE>	&shared = *args->shared;
+	long			last[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+	long			buf[16], sum = 0, errors = 0;
+
+	while (__sync_fetch_and_add(&shared.left, 0) > 0)
+	{
+		long	got = args->batch ? shared.q->try_pop(buf, 16) : shared.q->try_pop(buf[0]);
+		if (got == 0)
+		{
+			sched_yield();
+			continue;
+		}
+		for (long i = 0; i < got; ++i)
+		{
+			const long	from = buf[i] / TAG, seq = buf[i] % TAG;
+			errors += seq <= last[from];
+			last[from] = seq;
+			sum += buf[i];
+		}
+		__sync_fetch_and_sub(&shared.left, got);
+	}
+	__sync_fetch_and_add(&shared.sum, sum);
+	__sync_fetch_and_add(&shared.errors, errors);
+	return (0);
+}
+
+template <typename T_QUEUE>
+void	run(T_QUEUE &q, int producers, int consumers, bool batch_first)
+{
+	Shared<T_QUEUE>	shared;
+	pthread_t		threads[16];
+	Args<T_QUEUE>	args[16];
+
+	shared.q = &q;
+	shared.left = producers * ITEMS;
+	shared.sum = 0;
+	shared.errors = 0;
+	for (int i = 0; i < producers + consumers; ++i)
+	{
+		args[i].shared = &shared;
+		args[i].id = i < producers ? i : i - producers;
+		args[i].batch = (args[i].id % 2 == 0) == batch_first;
+		pthread_create(&threads[i], 0, i < producers ? &producer<T_QUEUE> : &consumer<T_QUEUE>, &args[i]);
+	}
+	for (int i = 0; i < producers + consumers; ++i)
+		pthread_join(threads[i], 0);
+
+	long	expected = 0;
+	for (long p = 0; p < producers; ++p)
+		expected += p * TAG * ITEMS + ITEMS * (ITEMS - 1) / 2;
+	std::cout << producers << " producer(s), " << consumers << " consumer(s): sum ok " << (shared.sum == expected)
+		<< " order errors " << shared.errors << " left " << shared.left << std::endl;
+	printState(q);
+}
+
+int		main(void)
+{
+	std::cout << "\t-- spsc_ring<64> --" << std::endl;
+	t_spsc_ring<long, 64>	ring;
+	run(ring, 1, 1, false);
+	run(ring, 1, 1, true);
+
+	std::cout << "\t-- mpmc_queue(64) --" << std::endl;
+	t_mpmc_queue<long>		mq(64);
+	run(mq, 1, 1, true);
+	run(mq, 2, 2, false);
+	run(mq, 4, 3, true);
+	return (0);
+}
@@ -0,0 +1,73 @@
+#include "common.hpp"
+
+#define TESTED_TYPE int
+
+typedef t_segmented_vector<TESTED_TYPE>	t_vec;
+
+int		main(void)
+{
+	t_vec	vct;
+
+	std::cout << "\t-- push_back and access --" << std::endl;
+	std::cout << "empty: " << vct.empty() << std::endl;
+	for (int i = 0; i < 10; ++i)
+		vct.push_back(i * 3);
+	printSize(vct);
+	std::cout << "front: " << vct.front() << " back: " << vct.back() << std::endl;
+	std::cout << "[4]: " << vct[4] << " at(9): " << vct.at(9) << std::endl;
+	try
+	{
+		vct.at(10);
+	}
+	catch (std::out_of_range &)
+	{
+		std::cout << "at(10): out_of_range" << std::endl;
+	}
+	std::cout << "reversed:";
+	for (t_vec::reverse_iterator it = vct.rbegin(); it != vct.rend(); ++it)
+		std::cout << " " << *it;
+	std::cout << std::endl;
+	t_vec::iterator	it = vct.begin() + 7;
+	*it = -1;
+	std::cout << "end - begin: " << (vct.end() - vct.begin()) << " it[1]: " << it[1] << " *(it - 2): " << *(it - 2) << std::endl;
+
+	std::cout << "\t-- across segments --" << std::endl;
+	for (int i = 0; i < 5000; ++i)
+		vct.push_back(i);
+	long	sum = 0;
+	for (t_vec::const_iterator cit = vct.begin(); cit != vct.end(); ++cit)
+		sum += *cit;
+	std::cout << "size: " << vct.size() << " sum: " << sum << " [1034]: " << vct[1034] << std::endl;
+	printSize(vct, false);
+
+	std::cout << "\t-- resize, assign and copies --" << std::endl;
+	vct.resize(4);
+	printSize(vct);
+	vct.resize(6, 42);
+	printSize(vct);
+	t_vec	copy(vct);
+	printSize(copy);
+	std::cout << "== " << (copy == vct) << " < " << (copy < vct) << std::endl;
+	copy.push_back(1);
+	std::cout << "== " << (copy == vct) << " < " << (copy < vct) << " > " << (copy > vct) << std::endl;
+	vct.assign(3, 7);
+	printSize(vct);
+	int		range[] = { 5, 4, 3 };
+	t_vec	from_range(range, range + 3);
+	from_range = copy;
+	printSize(from_range);
+	t_vec	filled(2000, 9);
+	printSize(filled, false);
+
+	std::cout << "\t-- swap, clear and shrink_to_fit --" << std::endl;
+	vct.swap(filled);
+	printSize(vct, false);
+	printSize(filled);
+	vct.clear();
+	printSize(vct);
+	vct.shrink_to_fit();
+	printSize(vct);
+	vct.reserve(3000);
+	printSize(vct);
+	return (0);
+}
@@ -0,0 +1,108 @@
+#include "../base.hpp"
+#if !defined(USING_STD)
+# include "segmented_vector.hpp"
+#else
+# include <deque>
+#endif /* !defined(STD) */
+
+#if defined(USING_STD)
+// The STL has no segmented vector: std::deque keeps references across
+// push_back too, and the segments ft::segmented_vector would hold, cached
+// ones included, are counted alongside to stand for its capacity().
+template <typename T>
+class t_segmented_vector : public std::deque<T>
+{
+	public:
+		typedef std::deque<T>					base;
+		typedef typename base::size_type		size_type;
+		typedef typename base::value_type		value_type;
+
+		enum { S_fit = sizeof(T) < 4096 / 8 ? 4096 / sizeof(T) : 8 };
+
+		t_segmented_vector(void) : base(), _segments(0) { };
+		explicit t_segmented_vector(size_type n, const value_type &val = value_type()) : base(n, val), _segments(used(n)) { };
+		template <typename InputIterator>
+		t_segmented_vector(InputIterator first, InputIterator last) : base(first, last), _segments(used(this->size())) { };
+		t_segmented_vector(const t_segmented_vector &x) : base(x), _segments(used(x.size())) { };
+
+		t_segmented_vector	&operator=(const t_segmented_vector &x)
+		{
+			base::operator=(x);
+			this->reserve(x.size());
+			return (*this);
+		};
+
+		size_type	capacity(void) const { return (this->_segments * segment_size()); };
+		void		reserve(size_type n)
+		{
+			if (used(n) > this->_segments)
+				this->_segments = used(n);
+		};
+		void		shrink_to_fit(void) { this->_segments = used(this->size()); };
+
+		void	push_back(const value_type &x)
+		{
+			base::push_back(x);
+			this->reserve(this->size());
+		};
+		void	resize(size_type n, value_type x = value_type())
+		{
+			this->reserve(n);
+			base::resize(n, x);
+		};
+		void	assign(size_type n, const value_type &val)
+		{
+			this->reserve(n);
+			base::assign(n, val);
+		};
+		void	swap(t_segmented_vector &x)
+		{
+			base::swap(x);
+			std::swap(this->_segments, x._segments);
+		};
+
+	private:
+		// As many elements as fit in 4096 bytes, down to a power of two.
+		static size_type	segment_size(void)
+		{
+			size_type	size = 1;
+
+			while (size * 2 <= static_cast<size_type>(S_fit))
+				size *= 2;
+			return (size);
+		};
+		static size_type	used(size_type n) { return ((n + segment_size() - 1) / segment_size()); };
+
+		size_type	_segments;
+};
+#else
+template <typename T>
+class t_segmented_vector : public ft::segmented_vector<T>
+{
+	public:
+		typedef ft::segmented_vector<T>			base;
+		typedef typename base::size_type		size_type;
+		typedef typename base::value_type		value_type;
+
+		t_segmented_vector(void) : base() { };
+		explicit t_segmented_vector(size_type n, const value_type &val = value_type()) : base(n, val) { };
+		template <typename InputIterator>
+		t_segmented_vector(InputIterator first, InputIterator last) : base(first, last) { };
+};
+#endif
+
+template <typename T_VEC>
+void	printSize(T_VEC const &vct, bool print_content = true)
+{
+	std::cout << "size: " << vct.size() << std::endl;
+	std::cout << "capacity: " << vct.capacity() << std::endl;
+	if (print_content)
+	{
+		typename T_VEC::const_iterator it = vct.begin();
+		typename T_VEC::const_iterator ite = vct.end();
+		std::cout << std::endl << "Content is:" << std::endl;
+		for (; it != ite; ++it)
+			std::cout << "- " << *it << std::endl;
+	}
+	std::cout << "###############################################" << std::endl;
+}
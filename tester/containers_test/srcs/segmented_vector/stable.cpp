@@ -0,0 +1,61 @@
+#include "common.hpp"
+#include <vector>
+
+// A segment fills up at 4096 bytes: a handful of these.
+struct Big
+{
+	int		value;
+	char	pad[1000];
+
+	Big(int v = 0) : value(v) { pad[0] = 0; }
+};
+
+std::ostream	&operator<<(std::ostream &o, const Big &b)
+{
+	return (o << b.value);
+}
+
+typedef t_segmented_vector<Big>	t_vec;
+
+int		main(void)
+{
+	t_vec				vct;
+	std::vector<Big *>	refs;
+
+	std::cout << "\t-- references survive growth --" << std::endl;
+	for (int i = 0; i < 20000; ++i)
+	{
+		vct.push_back(Big(i));
+		if (i % 7 == 0)
+			refs.push_back(&vct.back());
+	}
+	int		moved = 0, changed = 0;
+	for (size_t i = 0; i < refs.size(); ++i)
+	{
+		moved += refs[i] != &vct[i * 7];
+		changed += refs[i]->value != static_cast<int>(i * 7);
+	}
+	std::cout << "refs: " << refs.size() << " moved: " << moved << " changed: " << changed << std::endl;
+	printSize(vct, false);
+
+	std::cout << "\t-- emptied segments are reused --" << std::endl;
+	const size_t	capacity = vct.capacity();
+	int				grew = 0;
+	for (int round = 0; round < 50; ++round)
+	{
+		while (vct.size() > static_cast<size_t>(round * 13))
+			vct.pop_back();
+		for (int i = vct.size(); i < 20000; ++i)
+			vct.push_back(Big(i));
+		grew += vct.capacity() != capacity;
+	}
+	std::cout << "grew: " << grew << std::endl;
+	vct.clear();
+	std::cout << "cleared, capacity kept: " << (vct.capacity() == capacity) << std::endl;
+	for (int i = 0; i < 100; ++i)
+		vct.push_back(Big(i));
+	std::cout << "capacity kept: " << (vct.capacity() == capacity) << std::endl;
+	vct.shrink_to_fit();
+	printSize(vct, false);
+	return (0);
+}
@@ -0,0 +1,93 @@
+#include "common.hpp"
+
+#define T1 int
+
+typedef TESTED_NAMESPACE::set<T1> t_set;
+
+#if defined(USING_STD)
+// std::set has no cursor: the same lookups, made from the root.
+class t_cursor
+{
+	public:
+		t_cursor(const t_set &c) : _cont(&c), _pos(c.end()) { };
+
+		t_set::iterator	position(void) const { return this->_pos; };
+		void			seek(t_set::iterator it) { this->_pos = it; };
+		t_set::iterator	lower_bound(const T1 &k) { return this->_pos = this->_cont->lower_bound(k); };
+		t_set::iterator	upper_bound(const T1 &k) { return this->_pos = this->_cont->upper_bound(k); };
+		t_set::iterator	find(const T1 &k)
+		{
+			this->lower_bound(k);
+			if (this->_pos == this->_cont->end() || k < *this->_pos)
+				return (this->_cont->end());
+			return (this->_pos);
+		};
+
+	private:
+		const t_set		*_cont;
+		t_set::iterator	_pos;
+};
+#else
+typedef t_set::cursor t_cursor;
+#endif
+
+static t_set	st;
+
+static void	printIt(const char *what, const T1 &k, t_set::iterator it)
+{
+	std::cout << what << "(" << k << "): ";
+	if (it == st.end())
+		std::cout << "end()" << std::endl;
+	else
+		printPair(it);
+}
+
+int		main(void)
+{
+	for (int i = 0; i < 300; i += 3)
+		st.insert(i);
+
+	t_cursor	cur(st);
+	std::cout << "initially at end: " << (cur.position() == st.end()) << std::endl;
+
+	// A merge-style scan: the sorted keys of another sequence, in order.
+	std::cout << "\t-- merge scan --" << std::endl;
+	int		hits = 0;
+	for (int k = -10; k < 320; k += 7)
+	{
+		t_set::iterator	it = cur.find(k);
+		if (it != st.end())
+		{
+			++hits;
+			printIt("find", k, it);
+		}
+	}
+	std::cout << "hits: " << hits << std::endl;
+
+	std::cout << "\t-- backward and jumps --" << std::endl;
+	const int	keys[] = { 299, 297, 150, 151, 0, -1, 1000, 3, 298, 42 };
+	for (unsigned i = 0; i < sizeof(keys) / sizeof(*keys); ++i)
+	{
+		printIt("lower_bound", keys[i], cur.lower_bound(keys[i]));
+		printIt("upper_bound", keys[i], cur.upper_bound(keys[i]));
+	}
+
+	std::cout << "\t-- every key from every start --" << std::endl;
+	int	mismatches = 0;
+	for (t_set::iterator start = st.begin(); ; ++start)
+	{
+		for (int k = -2; k < 302; ++k)
+		{
+			cur.seek(start);
+			if (cur.lower_bound(k) != st.lower_bound(k))
+				++mismatches;
+			cur.seek(start);
+			if (cur.find(k) != st.find(k))
+				++mismatches;
+		}
+		if (start == st.end())
+			break ;
+	}
+	std::cout << "mismatches: " << mismatches << std::endl;
+	return (0);
+}
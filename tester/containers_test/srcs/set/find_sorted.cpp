@@ -0,0 +1,102 @@
+#include "common.hpp"
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#define T1 int
+
+typedef TESTED_NAMESPACE::set<T1> t_set;
+
+#if defined(USING_STD)
+// std::set has no merged lookups: one find() or count() per key.
+template <typename InputIterator, typename OutputIterator>
+OutputIterator	find_sorted(const t_set &st, InputIterator first, InputIterator last, OutputIterator out)
+{
+	for (; first != last; ++first)
+		*out++ = st.find(*first);
+	return (out);
+}
+
+template <typename InputIterator>
+size_t	count_sorted(const t_set &st, InputIterator first, InputIterator last)
+{
+	size_t	res = 0;
+	for (; first != last; ++first)
+		res += st.count(*first);
+	return (res);
+}
+#else
+template <typename InputIterator, typename OutputIterator>
+OutputIterator	find_sorted(const t_set &st, InputIterator first, InputIterator last, OutputIterator out)
+{
+	return (st.find_sorted(first, last, out));
+}
+
+template <typename InputIterator>
+size_t	count_sorted(const t_set &st, InputIterator first, InputIterator last)
+{
+	return (st.count_sorted(first, last));
+}
+#endif
+
+static void	lookup(const t_set &st, const std::vector<T1> &keys)
+{
+	std::vector<t_set::const_iterator>	res;
+
+	find_sorted(st, keys.begin(), keys.end(), std::back_inserter(res));
+	std::cout << "count_sorted: " << count_sorted(st, keys.begin(), keys.end()) << std::endl;
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		std::cout << keys[i] << " -> ";
+		if (res[i] == st.end())
+			std::cout << "end()" << std::endl;
+		else
+			printPair(res[i]);
+	}
+}
+
+int		main(void)
+{
+	t_set	st;
+
+	for (int i = 0; i < 60; i += 3)
+		st.insert(i * i);
+
+	const T1	sorted[] = { -5, 0, 0, 9, 10, 81, 81, 82, 400, 1000, 3249, 3250, 9999 };
+	std::vector<T1>	keys(sorted, sorted + sizeof(sorted) / sizeof(*sorted));
+	std::cout << "\t-- ascending keys, with repeats --" << std::endl;
+	lookup(st, keys);
+
+	std::cout << "\t-- unsorted keys --" << std::endl;
+	std::reverse(keys.begin(), keys.end());
+	std::swap(keys[2], keys[7]);
+	lookup(st, keys);
+
+	std::cout << "\t-- no keys, empty set --" << std::endl;
+	lookup(st, std::vector<T1>());
+	lookup(t_set(), keys);
+
+	std::cout << "\t-- large batches --" << std::endl;
+	t_set			big;
+	std::vector<T1>	many;
+	unsigned		seed = 5;
+	for (int i = 0; i < 30000; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		big.insert((seed >> 8) % 100000);
+		many.push_back((seed >> 3) % 100100 - 50);
+	}
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		std::vector<t_set::const_iterator>	res;
+		find_sorted(big, many.begin(), many.end(), std::back_inserter(res));
+		int		bad = 0;
+		for (size_t i = 0; i < many.size(); ++i)
+			if (res[i] != big.find(many[i]))
+				++bad;
+		std::cout << (pass ? "sorted" : "random") << ": count_sorted "
+			<< count_sorted(big, many.begin(), many.end()) << " bad " << bad << std::endl;
+		std::sort(many.begin(), many.end());
+	}
+	return (0);
+}
@@ -0,0 +1,58 @@
+#include "common.hpp"
+#include <sstream>
+#include <iterator>
+#include <vector>
+
+#define T1 int
+
+typedef TESTED_NAMESPACE::set<T1>			t_set;
+typedef TESTED_NAMESPACE::set<std::string>	t_str_set;
+
+#if defined(USING_STD)
+// insert_batch has the result of insert(first, last).
+template <typename Set, typename InputIterator>
+static void	insertBatch(Set &st, InputIterator first, InputIterator last)
+{
+	st.insert(first, last);
+}
+#else
+template <typename Set, typename InputIterator>
+static void	insertBatch(Set &st, InputIterator first, InputIterator last)
+{
+	st.insert_batch(first, last);
+}
+#endif
+
+int		main(void)
+{
+	t_set	st;
+
+	std::cout << "\t-- array --" << std::endl;
+	const T1	values[] = { 5, -3, 12, 5, 0, 99, -3, 7 };
+	insertBatch(st, values, values + sizeof(values) / sizeof(*values));
+	printSize(st);
+
+	std::cout << "\t-- input iterators --" << std::endl;
+	std::istringstream	in("8 1 12 -40 3 8 100");
+	insertBatch(st, std::istream_iterator<T1>(in), std::istream_iterator<T1>());
+	printSize(st);
+
+	std::cout << "\t-- elements converted to the key type --" << std::endl;
+	t_str_set					words;
+	std::vector<const char *>	batch;
+	batch.push_back("pear");
+	batch.push_back("apple");
+	batch.push_back("fig");
+	batch.push_back("apple");
+	insertBatch(words, batch.begin(), batch.end());
+	printSize(words);
+
+	std::cout << "\t-- large batch --" << std::endl;
+	std::vector<T1>	large;
+	for (int i = 0; i < 20000; ++i)
+		large.push_back((i * 7919) % 10007);
+	insertBatch(st, large.begin(), large.end());
+	printSize(st, false);
+	std::cout << "first: " << *st.begin() << " last: " << *--st.end() << std::endl;
+	return (0);
+}
@@ -0,0 +1,79 @@
+#include "common.hpp"
+#include <iterator>
+
+#define T1 std::string
+
+#if defined(USING_STD)
+typedef std::set<T1> t_set;
+
+// std::set has no order statistics: walk instead.
+static t_set::const_iterator	nth(const t_set &st, size_t n)
+{
+	t_set::const_iterator	it = st.begin();
+	std::advance(it, n);
+	return (it);
+}
+
+static size_t	rank(const t_set &st, const T1 &k)
+{
+	return (std::distance(st.begin(), st.lower_bound(k)));
+}
+#else
+typedef ft::set<T1, std::less<T1>, std::allocator<T1>,
+	ft::Rb_tree_order_statistics_node_update> t_set;
+
+static t_set::const_iterator	nth(const t_set &st, size_t n)
+{
+	return (st.nth(n));
+}
+
+static size_t	rank(const t_set &st, const T1 &k)
+{
+	return (st.rank(k));
+}
+#endif
+
+static void	checkAll(const t_set &st)
+{
+	int		bad = 0;
+	size_t	i = 0;
+
+	for (t_set::const_iterator it = st.begin(); it != st.end(); ++it, ++i)
+		if (nth(st, i) != it || rank(st, *it) != i || rank(st, *it + '\1') != i + 1)
+			++bad;
+	std::cout << "checked " << i << " positions, " << bad << " bad" << std::endl;
+}
+
+int		main(void)
+{
+	t_set		st;
+	const char	*words[] = { "lorem", "ipsum", "dolor", "sit", "amet",
+		"consectetur", "adipiscing", "elit", "sed", "do", "eiusmod",
+		"tempor", "incididunt", "ut", "labore", "et", "dolore", "magna" };
+
+	for (unsigned i = 0; i < sizeof(words) / sizeof(*words); ++i)
+		st.insert(words[i]);
+	for (size_t i = 0; i < st.size(); ++i)
+	{
+		std::cout << "nth(" << i << "): ";
+		printPair(nth(st, i));
+	}
+	const char	*probes[] = { "", "a", "dolor", "dolorz", "m", "zzz" };
+	for (unsigned i = 0; i < sizeof(probes) / sizeof(*probes); ++i)
+		std::cout << "rank(\"" << probes[i] << "\"): " << rank(st, probes[i]) << std::endl;
+	checkAll(st);
+
+	st.erase("lorem");
+	st.erase(st.begin());
+	st.insert("aaa");
+	checkAll(st);
+	std::cout << "nth(0): ";
+	printPair(nth(st, 0));
+	std::cout << "rank(\"lorem\"): " << rank(st, "lorem") << std::endl;
+
+	t_set	cpy(st);
+	cpy.erase(cpy.lower_bound("e"), cpy.lower_bound("s"));
+	checkAll(cpy);
+	printSize(cpy);
+	return (0);
+}
@@ -0,0 +1,54 @@
+#include "common.hpp"
+#include <vector>
+#include <cstdio>
+#if !defined(USING_STD)
+# include "parallel.hpp"
+#endif
+
+#define T1 std::string
+
+typedef TESTED_NAMESPACE::set<T1> t_set;
+
+#if defined(USING_STD)
+// std::set has no parallel constructor: the serial one.
+template <typename InputIterator>
+static t_set	build(size_t, InputIterator first, InputIterator last)
+{
+	return (t_set(first, last));
+}
+#else
+template <typename InputIterator>
+static t_set	build(size_t threads, InputIterator first, InputIterator last)
+{
+	return (t_set(ft::par(threads), first, last));
+}
+#endif
+
+int		main(void)
+{
+	const size_t	threads[] = { 0, 1, 2, 5, 16 };
+	std::vector<T1>	in;
+	unsigned		seed = 4;
+	char			buf[16];
+
+	for (int i = 0; i < 30000; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		std::sprintf(buf, "k%05u", (seed >> 8) % 20000);
+		in.push_back(buf);
+	}
+	for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); ++t)
+	{
+		t_set	st = build(threads[t], in.begin(), in.end());
+		int		bad = 0;
+		for (size_t i = 0; i < in.size(); ++i)
+			bad += st.count(in[i]) != 1;
+		t_set::iterator	prev = st.begin();
+		for (t_set::iterator it = st.begin(); it != st.end(); prev = it++)
+			bad += it != st.begin() && !(*prev < *it);
+		std::cout << "threads " << threads[t] << ": size " << st.size() << " bad " << bad
+			<< " front " << *st.begin() << " back " << *st.rbegin() << std::endl;
+	}
+	std::cout << "empty: " << build(3, in.begin(), in.begin()).size() << std::endl;
+	return (0);
+}
@@ -0,0 +1,185 @@
+#include "common.hpp"
+#include <algorithm>
+#include <iterator>
+#if !defined(USING_STD)
+# include "parallel.hpp"
+#endif
+
+#define T1 int
+
+// Throws on any comparison with the poisoned key while armed.
+static bool	armed = false;
+static const T1	poison = 777;
+
+struct Cmp
+{
+	bool	operator()(const T1 &a, const T1 &b) const
+	{
+		if (armed && (a == poison || b == poison))
+			throw std::string("poisoned comparison");
+		return (a < b);
+	}
+};
+
+typedef TESTED_NAMESPACE::set<T1, Cmp> t_set;
+// Comparisons that cannot throw take a single-pass path.
+typedef TESTED_NAMESPACE::set<T1> t_plain_set;
+
+enum e_op { UNION, INTERSECTION, DIFFERENCE, SYMMETRIC_DIFFERENCE };
+
+static const char	*op_names[] = {
+	"set_union", "set_intersection", "set_difference",
+	"set_symmetric_difference"
+};
+
+#if defined(USING_STD)
+// std::set has no in-place set algebra: build the result with the
+// <algorithm> functions, which leave both inputs alone if they throw.
+template <typename T_SET>
+static void	run_op(e_op op, T_SET &a, T_SET &b, bool)
+{
+	T_SET res;
+	std::insert_iterator<T_SET> out(res, res.end());
+
+	if (op == UNION)
+		std::set_union(a.begin(), a.end(), b.begin(), b.end(), out, a.value_comp());
+	else if (op == INTERSECTION)
+		std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out, a.value_comp());
+	else if (op == DIFFERENCE)
+		std::set_difference(a.begin(), a.end(), b.begin(), b.end(), out, a.value_comp());
+	else
+		std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), out, a.value_comp());
+	a.swap(res);
+	b.clear();
+}
+#else
+template <typename T_SET>
+static void	run_op(e_op op, T_SET &a, T_SET &b, bool parallel)
+{
+	if (parallel && op == UNION)
+		a.set_union(ft::par, b);
+	else if (parallel && op == INTERSECTION)
+		a.set_intersection(ft::par, b);
+	else if (parallel && op == DIFFERENCE)
+		a.set_difference(ft::par, b);
+	else if (parallel)
+		a.set_symmetric_difference(ft::par, b);
+	else if (op == UNION)
+		a.set_union(b);
+	else if (op == INTERSECTION)
+		a.set_intersection(b);
+	else if (op == DIFFERENCE)
+		a.set_difference(b);
+	else
+		a.set_symmetric_difference(b);
+}
+#endif
+
+template <typename T_SET>
+static void	fill(T_SET &st, int n, int step, int offset)
+{
+	for (int i = 0; i < n; ++i)
+		st.insert(i * step + offset);
+}
+
+// Large sets print as a size, a checksum and their ends.
+template <typename T_SET>
+static void	printSummary(const T_SET &st)
+{
+	unsigned long	sum = 0;
+	int				walked = 0;
+
+	for (typename T_SET::const_iterator it = st.begin(); it != st.end(); ++it, ++walked)
+		sum = sum * 31 + *it;
+	std::cout << "size: " << st.size() << " walked: " << walked
+		<< " checksum: " << sum;
+	if (!st.empty())
+		std::cout << " front: " << *st.begin() << " back: " << *st.rbegin();
+	std::cout << std::endl;
+}
+
+static void	test_op(e_op op, int n1, int step1, int n2, int step2,
+					bool parallel, bool throwing)
+{
+	t_set	a, b;
+
+	fill(a, n1, step1, 0);
+	fill(b, n2, step2, 1);
+	if (throwing)
+	{
+		a.insert(poison);
+		b.insert(poison);
+	}
+	std::cout << "\t-- " << op_names[op] << (parallel ? " (parallel)" : "")
+		<< (throwing ? " (throwing)" : "") << " --" << std::endl;
+	armed = throwing;
+	try
+	{
+		run_op(op, a, b, parallel);
+	}
+	catch (std::string &e)
+	{
+		std::cout << "caught: " << e << std::endl;
+	}
+	armed = false;
+	printSummary(a);
+	printSummary(b);
+	// Both sets must still be usable.
+	a.insert(-1);
+	a.erase(-1);
+	b.insert(-1);
+	std::cout << "after: " << a.size() << " " << b.size() << std::endl;
+}
+
+static void	test_plain(e_op op, int n1, int step1, int n2, int step2, bool parallel)
+{
+	t_plain_set	a, b;
+
+	fill(a, n1, step1, 0);
+	fill(b, n2, step2, 1);
+	std::cout << "\t-- " << op_names[op] << (parallel ? " (parallel)" : "")
+		<< " (std::less) --" << std::endl;
+	run_op(op, a, b, parallel);
+	printSummary(a);
+	printSummary(b);
+}
+
+int		main(void)
+{
+	for (int op = UNION; op <= SYMMETRIC_DIFFERENCE; ++op)
+	{
+		// Small sets, printed in full.
+		t_set	a, b;
+		fill(a, 10, 2, 0);
+		fill(b, 7, 3, 0);
+		run_op(static_cast<e_op>(op), a, b, false);
+		std::cout << op_names[op] << ":" << std::endl;
+		for (t_set::iterator it = a.begin(); it != a.end(); ++it)
+			std::cout << "- " << *it << std::endl;
+		std::cout << "other empty: " << b.empty() << std::endl;
+
+		// Empty on either side.
+		t_set	e;
+		run_op(static_cast<e_op>(op), a, e, false);
+		printSummary(a);
+		run_op(static_cast<e_op>(op), e, a, false);
+		printSummary(e);
+		printSummary(a);
+
+		for (int p = 0; p < 2; ++p)
+		{
+			// Balanced sizes, overlapping keys.
+			test_op(static_cast<e_op>(op), 3000, 2, 2000, 3, p, false);
+			// Much smaller right-hand side.
+			test_op(static_cast<e_op>(op), 20000, 1, 100, 97, p, false);
+			// Large enough for the top levels to fork.
+			test_op(static_cast<e_op>(op), 40000, 2, 30000, 3, p, false);
+			test_op(static_cast<e_op>(op), 3000, 2, 2000, 3, p, true);
+			test_op(static_cast<e_op>(op), 20000, 1, 100, 97, p, true);
+			test_op(static_cast<e_op>(op), 40000, 2, 30000, 3, p, true);
+			test_plain(static_cast<e_op>(op), 3000, 2, 2000, 3, p);
+			test_plain(static_cast<e_op>(op), 40000, 2, 30000, 3, p);
+		}
+	}
+	return (0);
+}
@@ -0,0 +1,63 @@
+#include "common.hpp"
+
+#define T1 int
+#define T2 std::string
+
+typedef t_sharded_map<T1, T2>	t_smap;
+
+struct Append
+{
+	std::string	suffix;
+
+	Append(const std::string &s) : suffix(s) { };
+	void	operator()(t_smap::value_type &x) const { x.second += this->suffix; };
+};
+
+static void	printFind(const t_smap &mp, const T1 &k)
+{
+	T2	res = "untouched";
+
+	std::cout << "find(" << k << "): " << mp.find(k, res);
+	std::cout << " -> " << res << std::endl;
+}
+
+int		main(void)
+{
+	t_smap	mp;
+
+	std::cout << "\t-- insert and insert_or_assign --" << std::endl;
+	for (int i = 0; i < 12; ++i)
+	{
+		const bool	res = mp.insert(t_smap::value_type((i * 37) % 50, std::string(1, 'a' + i)));
+		std::cout << "insert " << (i * 37) % 50 << ": " << res << std::endl;
+	}
+	std::cout << "duplicate: " << mp.insert(t_smap::value_type(37, "dup")) << std::endl;
+	std::cout << "assign 37: " << mp.insert_or_assign(37, "assigned") << std::endl;
+	std::cout << "assign 100: " << mp.insert_or_assign(100, "new") << std::endl;
+	printSize(mp);
+
+	std::cout << "\t-- lookups --" << std::endl;
+	printFind(mp, 37);
+	printFind(mp, 36);
+	printFind(mp, 100);
+	std::cout << "count(24): " << mp.count(24) << " count(25): " << mp.count(25) << std::endl;
+	std::cout << "visit(24): " << mp.visit(24, Append("!")) << std::endl;
+	std::cout << "visit(25): " << mp.visit(25, Append("?")) << std::endl;
+	printFind(mp, 24);
+
+	std::cout << "\t-- shards --" << std::endl;
+	int		misplaced = 0;
+	for (t_smap::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		misplaced += mp.shard(mp.shard_of(it->first)).count(it->first) != 1;
+	std::cout << "misplaced: " << misplaced << std::endl;
+
+	std::cout << "\t-- erase and clear --" << std::endl;
+	std::cout << "erase(37): " << mp.erase(37) << std::endl;
+	std::cout << "erase(37) again: " << mp.erase(37) << std::endl;
+	printSize(mp);
+	mp.clear();
+	std::cout << "empty: " << mp.empty() << " begin == end: " << (mp.begin() == mp.end()) << std::endl;
+	mp.insert(t_smap::value_type(1, "after clear"));
+	printSize(mp);
+	return (0);
+}
@@ -0,0 +1,69 @@
+#include "common.hpp"
+#include <vector>
+#include <map>
+
+#define T1 int
+#define T2 int
+
+typedef t_sharded_map<T1, T2>	t_smap;
+
+// Checks the contents, in order, against a std::map.
+static void	check(const char *what, const t_smap &mp, const std::map<T1, T2> &ref)
+{
+	int		bad = mp.size() != ref.size();
+	size_t	walked = 0;
+	std::map<T1, T2>::const_iterator	r = ref.begin();
+
+	for (t_smap::const_iterator it = mp.begin(); it != mp.end(); ++it, ++walked)
+	{
+		if (r == ref.end() || it->first != r->first || it->second != r->second)
+			++bad;
+		else
+			++r;
+	}
+	std::cout << what << ": size " << mp.size() << " walked " << walked
+		<< " bad " << bad << std::endl;
+}
+
+int		main(void)
+{
+	std::vector<std::pair<T1, T2> >	in;
+	unsigned						seed = 9;
+
+	// Random keys with repeats; of equal keys the first one wins.
+	for (int i = 0; i < 40000; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		in.push_back(std::make_pair(static_cast<T1>((seed >> 8) % 30000) - 15000, i));
+	}
+	std::map<T1, T2>	ref;
+	for (size_t i = 0; i < in.size(); ++i)
+		ref.insert(in[i]);
+
+	const size_t	threads[] = { 0, 1, 2, 3, 16, 64 };
+	for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); ++t)
+	{
+		t_smap	mp;
+		mp.insert(in.begin(), in.end(), threads[t]);
+		std::cout << "threads " << threads[t] << " -> ";
+		check("bulk", mp, ref);
+	}
+
+	std::cout << "\t-- into a non-empty map --" << std::endl;
+	t_smap				mp;
+	std::map<T1, T2>	ref2;
+	for (T1 k = -15000; k < 15000; k += 7)
+	{
+		mp.insert(t_smap::value_type(k, -1));
+		ref2.insert(std::make_pair(k, -1));
+	}
+	mp.insert(in.begin(), in.begin() + 20000, 4);
+	for (size_t i = 0; i < 20000; ++i)
+		ref2.insert(in[i]);
+	check("merged", mp, ref2);
+
+	std::cout << "\t-- empty range --" << std::endl;
+	mp.insert(in.begin(), in.begin(), 4);
+	check("unchanged", mp, ref2);
+	return (0);
+}
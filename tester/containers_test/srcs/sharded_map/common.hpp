@@ -0,0 +1,113 @@
+#include "../base.hpp"
+#if !defined(USING_STD)
+# include "sharded_map.hpp"
+#else
+# include <map>
+#endif /* !defined(STD) */
+
+#define _pair TESTED_NAMESPACE::pair
+
+#if defined(USING_STD)
+// The STL has no sharded map: a single std::map behind the same
+// interface, and a single shard.
+template <typename Key, typename Tp>
+class t_sharded_map
+{
+	public:
+		typedef std::map<Key, Tp>						shard_type;
+		typedef typename shard_type::value_type			value_type;
+		typedef typename shard_type::size_type			size_type;
+		typedef typename shard_type::const_iterator		const_iterator;
+
+		const_iterator	begin(void) const { return (this->_map.begin()); };
+		const_iterator	end(void) const { return (this->_map.end()); };
+		size_type		size(void) const { return (this->_map.size()); };
+		bool			empty(void) const { return (this->_map.empty()); };
+		size_type		count(const Key &k) const { return (this->_map.count(k)); };
+
+		bool	find(const Key &k, Tp &result) const
+		{
+			const_iterator	it = this->_map.find(k);
+
+			if (it == this->_map.end())
+				return (false);
+			result = it->second;
+			return (true);
+		};
+
+		template <typename Function>
+		bool	visit(const Key &k, Function f)
+		{
+			typename shard_type::iterator	it = this->_map.find(k);
+
+			if (it == this->_map.end())
+				return (false);
+			f(*it);
+			return (true);
+		};
+
+		bool	insert(const value_type &x) { return (this->_map.insert(x).second); };
+
+		template <typename Obj>
+		bool	insert_or_assign(const Key &k, const Obj &obj)
+		{
+			typename shard_type::iterator	it = this->_map.find(k);
+
+			if (it != this->_map.end())
+			{
+				it->second = obj;
+				return (false);
+			}
+			this->_map.insert(value_type(k, obj));
+			return (true);
+		};
+
+		template <typename InputIterator>
+		void	insert(InputIterator first, InputIterator last, std::size_t = 0)
+		{
+			for (; first != last; ++first)
+				this->_map.insert(value_type(first->first, first->second));
+		};
+
+		size_type	erase(const Key &k) { return (this->_map.erase(k)); };
+		void		clear(void) { this->_map.clear(); };
+
+		shard_type			&shard(std::size_t) { return (this->_map); };
+		const shard_type	&shard(std::size_t) const { return (this->_map); };
+		std::size_t			shard_of(const Key &) const { return (0); };
+
+	private:
+		shard_type	_map;
+};
+#else
+template <typename Key, typename Tp>
+class t_sharded_map : public ft::sharded_map<Key, Tp>
+{
+};
+#endif
+
+template <typename T>
+std::string	printPair(const T &iterator, bool nl = true, std::ostream &o = std::cout)
+{
+	o << "key: " << iterator->first << " | value: " << iterator->second;
+	if (nl)
+		o << std::endl;
+	return ("");
+}
+
+template <typename T_MAP>
+void	printSize(T_MAP const &mp, bool print_content = 1)
+{
+	std::cout << "size: " << mp.size() << std::endl;
+	if (print_content)
+	{
+		typename T_MAP::const_iterator it = mp.begin(), ite = mp.end();
+		std::cout << std::endl << "Content is:" << std::endl;
+		for (; it != ite; ++it)
+		{
+			std::cout << "- ";
+			printPair(it);
+		}
+	}
+	std::cout << "###############################################" << std::endl;
+}
@@ -0,0 +1,60 @@
+#include "common.hpp"
+#if !defined(USING_STD)
+# include "segmented_vector.hpp"
+# define t_container_ ft::segmented_vector
+#else
+# include <deque>
+# define t_container_ std::deque
+#endif /* !defined(STD) */
+
+#define TESTED_TYPE foo<int>
+typedef t_container_<TESTED_TYPE> container_type;
+#define t_stack_ TESTED_NAMESPACE::stack<TESTED_TYPE, container_type>
+
+template <class T_STACK>
+void	cmp(const T_STACK &lhs, const T_STACK &rhs)
+{
+	static int i = 0;
+
+	std::cout << "############### [" << i++ << "] ###############"  << std::endl;
+	std::cout << "eq: " << (lhs == rhs) << " | ne: " << (lhs != rhs) << std::endl;
+	std::cout << "lt: " << (lhs <  rhs) << " | le: " << (lhs <= rhs) << std::endl;
+	std::cout << "gt: " << (lhs >  rhs) << " | ge: " << (lhs >= rhs) << std::endl;
+}
+
+int		main(void)
+{
+	container_type	ctnr;
+
+	ctnr.push_back(21);
+	ctnr.push_back(42);
+	ctnr.push_back(1337);
+
+	t_stack_		stck(ctnr);
+	t_stack_		stck2;
+
+	std::cout << "empty: " << stck.empty() << " " << stck2.empty() << std::endl;
+	std::cout << "size: " << stck.size() << std::endl;
+	std::cout << "top: " << stck.top() << std::endl;
+
+	// Past a few segments and back, twice.
+	for (int round = 0; round < 2; ++round)
+	{
+		for (int i = 0; i < 3000; ++i)
+			stck2.push(i);
+		std::cout << "size: " << stck2.size() << " top: " << stck2.top() << std::endl;
+		for (int i = 0; i < 2990; ++i)
+			stck2.pop();
+		std::cout << "size: " << stck2.size() << " top: " << stck2.top() << std::endl;
+	}
+	cmp(stck, stck2);
+	cmp(stck2, stck);
+
+	stck.push(1);
+	stck.top() = 2;
+	std::cout << "Added some elements" << std::endl;
+	printSize(stck);
+	printSize(stck2);
+	cmp(stck, stck2);
+	return (0);
+}
@@ -0,0 +1,106 @@
+#include "common.hpp"
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#if !defined(USING_STD)
+# include "parallel_algorithm.hpp"
+#endif
+
+#define TESTED_TYPE int
+
+typedef TESTED_NAMESPACE::vector<TESTED_TYPE> t_vec;
+
+struct Triple
+{
+	TESTED_TYPE	operator()(TESTED_TYPE x) const { return (x * 3 + 1); };
+};
+
+struct IsNegative
+{
+	bool	operator()(TESTED_TYPE x) const { return (x < 0); };
+};
+
+// Ordered by the last digit only, so that many elements are equivalent.
+struct LastDigit
+{
+	bool	operator()(TESTED_TYPE a, TESTED_TYPE b) const { return (a % 10 < b % 10); };
+};
+
+#if defined(USING_STD)
+// The <algorithm> functions the ft::parallel ones must match.
+namespace algo
+{
+	using std::fill;
+	using std::copy;
+	using std::transform;
+	using std::find_if;
+	using std::sort;
+
+	template <typename InputIterator, typename Tp>
+	Tp	reduce(InputIterator first, InputIterator last, Tp init) { return (std::accumulate(first, last, init)); }
+}
+#else
+namespace algo = ft::parallel;
+#endif
+
+static long	checksum(const t_vec &v)
+{
+	long	sum = 0;
+
+	for (size_t i = 0; i < v.size(); ++i)
+		sum = sum * 31 + v[i];
+	return (sum);
+}
+
+int		main(void)
+{
+	const size_t	sizes[] = { 0, 1, 17, 1000, 100000, 1000000 };
+	unsigned		seed = 13;
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+	{
+		const size_t	n = sizes[s];
+		t_vec			v(n), w(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			v[i] = static_cast<TESTED_TYPE>((seed >> 8) % 200000);
+		}
+		std::cout << "\t-- " << n << " elements --" << std::endl;
+
+		algo::fill(w.begin(), w.end(), 7);
+		std::cout << "fill: " << checksum(w) << std::endl;
+		algo::copy(v.begin(), v.end(), w.begin());
+		std::cout << "copy: " << checksum(w) << std::endl;
+		algo::transform(v.begin(), v.end(), w.begin(), Triple());
+		std::cout << "transform: " << checksum(w) << std::endl;
+		std::cout << "reduce: " << algo::reduce(v.begin(), v.end(), 0L) << std::endl;
+
+		// The first match must be found even when later chunks match too.
+		if (n > 0)
+		{
+			w = v;
+			w[n / 2] = -1;
+			w[n - 1] = -2;
+			std::cout << "find_if: " << (algo::find_if(w.begin(), w.end(), IsNegative()) - w.begin()) << std::endl;
+		}
+		std::cout << "find_if none: " << (algo::find_if(v.begin(), v.end(), IsNegative()) == v.end()) << std::endl;
+
+		w = v;
+		algo::sort(w.begin(), w.end());
+		const long	sorted = checksum(w);
+		std::cout << "sort: " << sorted << std::endl;
+		algo::sort(w.begin(), w.end(), std::greater<TESTED_TYPE>());
+		std::cout << "sort reversed: " << checksum(w) << std::endl;
+
+		// Only the order of the keys can be compared: sort is not stable.
+		w = v;
+		algo::sort(w.begin(), w.end(), LastDigit());
+		int		bad = 0;
+		for (size_t i = 1; i < n; ++i)
+			bad += LastDigit()(w[i], w[i - 1]);
+		std::sort(w.begin(), w.end());
+		std::cout << "sort few keys: bad " << bad << " same elements " << (checksum(w) == sorted) << std::endl;
+	}
+	return (0);
+}